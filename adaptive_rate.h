@@ -0,0 +1,117 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// adaptive_rate.h — a read cadence that follows how fast the room changes
+//
+// A storage room sits still for hours, then moves within a minute when a
+// door opens or the fans start. AdaptiveRate looks at each room reading
+// and sets the period until the next one:
+//
+//   quiet   still within the deadband of the anchor (the reading the
+//           current stretch started from): the period grows by half, up
+//           to maxMs
+//   drift   left the deadband, slowly: the period halves (at least minMs)
+//           and the reading becomes the new anchor
+//   fast    left the deadband, and the change since the previous reading
+//           is at least the fast rate per minute: back to minMs at once
+//
+// A failed read also goes back to minMs (reset()), so a flaky probe is
+// retried and a silent one noticed as quickly as with a fixed cadence.
+// Comparing against the anchor rather than the previous reading keeps a
+// slow drift from hiding in steps smaller than the deadband. The fast test
+// only runs outside the deadband: a one-count flicker between two reads
+// 2 s apart is "6 °F/min" but no event.
+//
+// Values are fixed-point (0.1 °F, 0.1 %RH) like the history store.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+
+struct AdaptiveRateConfig {
+  uint32_t minMs;               // fastest cadence
+  uint32_t maxMs;               // slowest (≤ minMs: fixed at minMs)
+  int16_t  bandT10, bandH10;    // deadband, 0.1 °F / 0.1 %RH
+  int16_t  fastT10, fastH10;    // snap-back rate, per minute
+};
+
+enum AdaptiveMode : uint8_t {
+  ADAPTIVE_FAST = 0,            // at minMs after a fast change, a failure or boot
+  ADAPTIVE_DRIFT,
+  ADAPTIVE_QUIET,
+};
+
+class AdaptiveRate {
+public:
+  void begin(const AdaptiveRateConfig& cfg) {
+    cfg_ = cfg;
+    if (cfg_.maxMs < cfg_.minMs) cfg_.maxMs = cfg_.minMs;
+    reset();
+  }
+
+  // Back to the fastest cadence; the next reading starts a new anchor
+  void reset() {
+    periodMs_ = cfg_.minMs;
+    mode_     = ADAPTIVE_FAST;
+    anchored_ = false;
+  }
+
+  // Fold in the room reading taken at `nowMs` (halMillis()); returns the
+  // period until the next one
+  uint32_t observe(int16_t t10, int16_t h10, uint32_t nowMs) {
+    if (!anchored_) {
+      anchored_ = true;
+      setAnchor(t10, h10);
+      setLast(t10, h10, nowMs);
+      return periodMs_;
+    }
+    const int32_t dT = t10 - anchorT10_, dH = h10 - anchorH10_;
+    const bool outside = abs32(dT) > cfg_.bandT10 || abs32(dH) > cfg_.bandH10;
+    if (!outside) {
+      const uint32_t grown = periodMs_ + periodMs_ / 2;
+      periodMs_ = grown < cfg_.maxMs ? grown : cfg_.maxMs;
+      mode_     = periodMs_ > cfg_.minMs ? ADAPTIVE_QUIET : mode_;
+    } else {
+      // Change since the previous reading, scaled to a minute (integer,
+      // no division: |Δ| · 60 000 ≥ fast · elapsed)
+      const uint64_t dtMs = nowMs - lastMs_ > 0 ? nowMs - lastMs_ : 1;
+      const bool fast =
+        (uint64_t) abs32(t10 - lastT10_) * 60000 >= (uint64_t) cfg_.fastT10 * dtMs ||
+        (uint64_t) abs32(h10 - lastH10_) * 60000 >= (uint64_t) cfg_.fastH10 * dtMs;
+      if (fast) {
+        periodMs_ = cfg_.minMs;
+        mode_     = ADAPTIVE_FAST;
+      } else {
+        periodMs_ = periodMs_ / 2 > cfg_.minMs ? periodMs_ / 2 : cfg_.minMs;
+        mode_     = ADAPTIVE_DRIFT;
+      }
+      setAnchor(t10, h10);
+    }
+    setLast(t10, h10, nowMs);
+    return periodMs_;
+  }
+
+  uint32_t     periodMs() const { return periodMs_; }
+  AdaptiveMode mode()     const { return mode_; }
+  bool         fixed()    const { return cfg_.maxMs == cfg_.minMs; }
+
+private:
+  static int32_t abs32(int32_t v) { return v < 0 ? -v : v; }
+
+  void setAnchor(int16_t t10, int16_t h10) {
+    anchorT10_ = t10;
+    anchorH10_ = h10;
+  }
+
+  void setLast(int16_t t10, int16_t h10, uint32_t nowMs) {
+    lastT10_ = t10;
+    lastH10_ = h10;
+    lastMs_  = nowMs;
+  }
+
+  AdaptiveRateConfig cfg_      = {};
+  uint32_t           periodMs_ = 0;
+  AdaptiveMode       mode_     = ADAPTIVE_FAST;
+  bool               anchored_ = false;
+  int16_t            anchorT10_ = 0, anchorH10_ = 0;
+  int16_t            lastT10_   = 0, lastH10_   = 0;
+  uint32_t           lastMs_    = 0;
+};
@@ -0,0 +1,191 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// alert_rules.h — incremental alert rules with hysteresis and hold times
+//
+// A rule watches one value and fires when a condition has held for holdS:
+//
+//   ALERT_ABOVE / ALERT_BELOW   the value crosses `threshold`
+//   ALERT_RISE  / ALERT_FALL    the value moves faster than `threshold` per
+//                               hour, measured over the last `windowS`
+//   ALERT_STALE                 `threshold` seconds without a good read
+//
+// A firing rule clears once the value is back past the threshold by
+// `hysteresis` (ABOVE clears below threshold − hysteresis, and so on) and
+// has stayed there for holdS too, so a value hovering at the limit or a
+// single odd read can't make the rule flap.
+//
+// evaluate() is O(1) and allocation-free. A rate is taken against the
+// oldest of ALERT_RATE_MARKS values kept at windowS / ALERT_RATE_MARKS
+// spacing, so it needs no per-sample history. The caller computes each
+// rule's value (room or probe, °F, %RH or seconds since a good read) and
+// calls evaluate() once per sensor read.
+//
+// AlertQueue carries the resulting transitions from the sensor step to the
+// task that delivers them: a single-producer, single-consumer ring.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include <atomic>
+
+static const size_t ALERT_MAX_RULES  = 8;
+static const size_t ALERT_RATE_MARKS = 8;
+
+enum AlertKind : uint8_t {
+  ALERT_ABOVE = 0,
+  ALERT_BELOW,
+  ALERT_RISE,
+  ALERT_FALL,
+  ALERT_STALE,
+};
+
+enum AlertQuantity : uint8_t {
+  ALERT_TEMP = 0,                     // °F
+  ALERT_HUMIDITY,                     // %RH
+};
+
+static const int8_t ALERT_ROOM = -1;  // `sensor`: the room mean (STALE: any probe)
+
+struct AlertRule {
+  const char*   name;                 // short: the OLED shows up to 10 characters
+  AlertKind     kind;
+  AlertQuantity quantity;             // ignored by STALE
+  int8_t        sensor;               // probe index, or ALERT_ROOM
+  float         threshold;            // °F / %RH; per hour for RISE/FALL; seconds for STALE
+  float         hysteresis;           // same unit as threshold
+  uint32_t      windowS;              // RISE/FALL: span the rate is measured over
+  uint32_t      holdS;                // a condition must last this long to change state
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Engine state for up to N rules. The rule table itself is the caller's and
+// must outlive the engine.
+// ──────────────────────────────────────────────────────────────────────────────
+template <size_t N>
+class AlertEngine {
+public:
+  void begin(const AlertRule* rules, size_t count) {
+    rules_ = rules;
+    count_ = count < N ? count : N;
+    for (size_t i = 0; i < count_; i++) state_[i] = State();
+  }
+
+  size_t           count() const          { return count_; }
+  const AlertRule& rule(size_t i) const   { return rules_[i]; }
+  bool             firing(size_t i) const { return state_[i].firing; }
+
+  // Bit i set while rule i is firing
+  uint32_t firingMask() const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < count_; i++) mask |= (uint32_t) state_[i].firing << i;
+    return mask;
+  }
+
+  // Feed rule i its current value (NAN = nothing to judge by). Returns true if
+  // the rule changed state; `*observed` is then what was compared with the
+  // threshold (the value itself, or the rate per hour).
+  bool evaluate(size_t i, uint32_t nowMs, float value, float* observed) {
+    const AlertRule& r = rules_[i];
+    State& s = state_[i];
+    float v = value;
+    if (r.kind == ALERT_RISE || r.kind == ALERT_FALL) v = rate(r, s, nowMs, value);
+    if (isnan(v)) return false;
+
+    // Above-style test on v, or on −v for the falling/below kinds. A FALL
+    // threshold is a speed like RISE's, so it stays positive.
+    const bool  up    = r.kind == ALERT_ABOVE || r.kind == ALERT_RISE || r.kind == ALERT_STALE;
+    const float x     = up ? v : -v;
+    const float limit = r.kind == ALERT_BELOW ? -r.threshold : r.threshold;
+    const bool  want  = s.firing ? x < limit - r.hysteresis : x > limit;
+    if (!want) {
+      s.pending = false;
+      return false;
+    }
+    if (!s.pending) {
+      s.pending   = true;
+      s.pendingMs = nowMs;
+    }
+    if (nowMs - s.pendingMs < r.holdS * 1000) return false;
+    s.pending = false;
+    s.firing  = !s.firing;
+    *observed = v;
+    return true;
+  }
+
+private:
+  struct State {
+    bool     firing    = false;
+    bool     pending   = false;      // the opposite condition holds, since pendingMs
+    uint32_t pendingMs = 0;
+    float    markValue[ALERT_RATE_MARKS];
+    uint32_t markMs[ALERT_RATE_MARKS];
+    uint8_t  markHead  = 0;          // next slot to write
+    uint8_t  marks     = 0;
+  };
+
+  // Change per hour against the oldest mark, once the marks span at least
+  // three quarters of the window; NAN before that
+  static float rate(const AlertRule& r, State& s, uint32_t nowMs, float value) {
+    if (isnan(value)) return NAN;
+    const uint32_t windowMs = r.windowS * 1000;
+    const uint32_t spacing  = windowMs / ALERT_RATE_MARKS;
+    const size_t   newest   = (s.markHead + ALERT_RATE_MARKS - 1) % ALERT_RATE_MARKS;
+    if (s.marks == 0 || nowMs - s.markMs[newest] >= spacing) {
+      s.markValue[s.markHead] = value;
+      s.markMs[s.markHead]    = nowMs;
+      s.markHead = (uint8_t)((s.markHead + 1) % ALERT_RATE_MARKS);
+      if (s.marks < ALERT_RATE_MARKS) s.marks++;
+    }
+    const size_t   oldest = (s.markHead + ALERT_RATE_MARKS - s.marks) % ALERT_RATE_MARKS;
+    const uint32_t span   = nowMs - s.markMs[oldest];
+    if (span == 0 || span < windowMs / 4 * 3) return NAN;
+    return (value - s.markValue[oldest]) * 3600000.0f / span;
+  }
+
+  const AlertRule* rules_ = nullptr;
+  size_t           count_ = 0;
+  State            state_[N];
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// A rule's change of state, as queued for delivery
+// ──────────────────────────────────────────────────────────────────────────────
+struct AlertEvent {
+  uint8_t  rule;
+  bool     firing;                   // false = cleared
+  float    value;                    // what evaluate() compared with the threshold
+  uint32_t ts;                       // sample time (UNIX, or uptime before NTP)
+};
+
+// Single producer (the sensor step), single consumer (the delivery task).
+// A full queue refuses the new event; the caller counts the loss.
+template <size_t N>
+class AlertQueue {
+public:
+  bool push(const AlertEvent& e) {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= N) return false;
+    ring_[head % N] = e;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // The oldest event, left in place until pop()
+  bool front(AlertEvent* out) const {
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_.load(std::memory_order_acquire) == tail) return false;
+    *out = ring_[tail % N];
+    return true;
+  }
+
+  void pop() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  size_t size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+private:
+  AlertEvent            ring_[N];
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+};
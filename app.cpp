@@ -0,0 +1,2031 @@
+#include "app.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include "adaptive_rate.h"
+#include "glyph_atlas.h"
+#include "index_html_gz.h"  // Gzipped dashboard (generated from web/index.html)
+#include "lttb.h"
+#include "rolling_minmax.h"
+#include "sample_log.h"
+#include "sensor_scheduler.h"
+#include "trace.h"
+
+using std::min;
+using std::max;
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1) Color Definitions (16-bit 5-6-5 RGB)
+// ──────────────────────────────────────────────────────────────────────────────
+static const uint16_t COLOR_BLACK = 0x0000;
+static const uint16_t COLOR_RED   = 0xF800;
+static const uint16_t COLOR_BLUE  = 0x001F;
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2) Text metrics (glyph_atlas.h cells: the 5×7 font at size 2 ⇒ 12×16 px)
+// ──────────────────────────────────────────────────────────────────────────────
+static const int CHAR_WIDTH  = GLYPH_WIDTH;
+static const int CHAR_HEIGHT = GLYPH_HEIGHT;
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3) Four lines of text for the OLED. Must be declared before using snprintf().
+// ──────────────────────────────────────────────────────────────────────────────
+static char lineStr[4][16];  // lineStr[0] = “TEMP: XXF”, lineStr[1] = “L:XX H:YY”, etc.
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 4) Shared snapshot (see app.h) and on-device history
+//    (raw / 1 min / 1 h tiers, ≈48 KB, never allocates)
+// ──────────────────────────────────────────────────────────────────────────────
+Seqlock<SensorSnapshot> snapshot;
+HistoryStore            history;    // sensor step appends, web step streams
+AppMetrics              metrics;    // see app.h; exported by /metrics
+#if POTATO_TRACE
+TraceRecorder           tracer;     // see trace.h; served by /trace
+#endif
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 5) Sensor-step state (touched only by appSensorStep; the uplink task reads
+//    timeSynced)
+// ──────────────────────────────────────────────────────────────────────────────
+static SensorSnapshot sensorSnap;
+static std::atomic<bool> timeSynced{false};
+
+// Probes (see app.h). One read is in flight at a time; the scheduler picks
+// the next. Sensors want ~1 s after power-up, so the first reads start then.
+// A room sample (history, windows, log) is taken from a good read at most
+// once per period, and probes without a good read for three periods (as
+// they were when it was read) drop out of the room mean. Each probe keeps
+// its own 24 h min/max over 30-min blocks (≈1.6 KB each).
+//
+// The period adapts to the room (adaptive_rate.h): from APP_SENSOR_PERIOD_MS
+// while it changes up to halSensorMaxPeriodMs() while it holds within
+// 0.3 °F and 1 %RH. A change of 1 °F or 3 %RH per minute, or a failed read,
+// goes straight back to the fastest cadence.
+static const uint32_t SENSOR_WARMUP_MS = 1000;
+static const int16_t  RATE_BAND_T10    = 3;      // 0.3 °F
+static const int16_t  RATE_BAND_H10    = 10;     // 1.0 %RH
+static const int16_t  RATE_FAST_T10    = 10;     // 1 °F per minute
+static const int16_t  RATE_FAST_H10    = 30;     // 3 %RH per minute
+static SensorScheduler<APP_MAX_SENSORS> scheduler;
+static AdaptiveRate                     sampleRate;
+static RollingMinMax<1800, 48>          probe24h[APP_MAX_SENSORS];
+static uint32_t probeFreshMs[APP_MAX_SENSORS];   // how long the last good read counts
+static int      activeProbe    = -1;     // probe with a read in flight
+static uint32_t roomSampleMs   = 0;      // halMillis() of the last room sample
+static bool     haveRoomSample = false;
+
+// Min/max windows (see app.h). Block sizes keep each deque small:
+// 1 h over 1-min blocks, 24 h over 5-min blocks, 7 d over 1-h blocks (≈17 KB).
+static RollingMinMax<60,   60>  win1h;
+static RollingMinMax<300,  288> win24h;
+static RollingMinMax<3600, 168> win7d;
+static DayMinMax                winToday;
+
+// Flash log of synced samples (see sample_log.h), replayed at boot. Until
+// NTP syncs, history and the windows get provisional stamps storeBase +
+// uptime; storeBase sits just past the newest logged sample so the new ones
+// sort after it, and is 0 (plain uptime) with an empty log. /export and the
+// uplink read only sampleLog.flushedTs() and the flash itself.
+static SampleLog sampleLog;
+static uint32_t  storeBase = 0;
+
+// Alert rules (see alert_rules.h), evaluated on every read attempt. Stored
+// potatoes keep best at 45–50 °F and 80–90 %RH: warmer and they sprout,
+// colder and they turn sweet, too dry and they shrivel, wet and they rot.
+// Transitions go to the webhook through alertQueue (see appAlertStep()).
+static const AlertRule ALERT_RULES[] = {
+  // name        kind         quantity        sensor      limit  hyst  window  hold
+  { "sprouting", ALERT_ABOVE, ALERT_TEMP,     ALERT_ROOM,  50.0f, 1.0f,    0,   600 },
+  { "cold",      ALERT_BELOW, ALERT_TEMP,     ALERT_ROOM,  40.0f, 1.0f,    0,   600 },
+  { "dry",       ALERT_BELOW, ALERT_HUMIDITY, ALERT_ROOM,  80.0f, 2.0f,    0,  1800 },
+  { "damp",      ALERT_ABOVE, ALERT_HUMIDITY, ALERT_ROOM,  95.0f, 2.0f,    0,  1800 },
+  { "warming",   ALERT_RISE,  ALERT_TEMP,     ALERT_ROOM,   2.0f, 0.5f, 3600,   300 },
+  { "sensor",    ALERT_STALE, ALERT_TEMP,     ALERT_ROOM,  60.0f, 0.0f,    0,     0 },
+};
+static const size_t ALERT_RULE_COUNT = sizeof(ALERT_RULES) / sizeof(ALERT_RULES[0]);
+static_assert(ALERT_RULE_COUNT <= ALERT_MAX_RULES, "too many alert rules");
+static const size_t ALERT_QUEUE_LEN = 16;
+static AlertEngine<ALERT_MAX_RULES>  alerts;
+static AlertQueue<ALERT_QUEUE_LEN>   alertQueue;   // sensor step → alert task
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 6) Display-step state: burn-in phase, the page being shown (the OLED
+//    turns through the room, each probe if there are several, and the air
+//    page every OLED_PAGE_MS), and what is currently on the OLED per line so
+//    drawReadings() can repaint only what changed.
+// ──────────────────────────────────────────────────────────────────────────────
+static const uint32_t OLED_PAGE_MS = 5000;
+static const uint16_t PROBE_STALE_FAILURES = 3;    // page shows ERR from here on
+static int      lastPhase = -1;
+static int16_t  oledOffsetX = 0, oledOffsetY = 0;   // current burn-in shift
+static uint32_t shownVersion = 0;   // snapshot.version() last formatted
+static int      oledPages = 2;      // room, one page per probe if several, air
+static int      shownPage = 0;
+static uint32_t shownAlerts = 0;    // firing rules; adds an alert page while non-zero
+static char     drawnStr[4][16];
+static int16_t  drawnX[4], drawnY[4];
+static bool     oledDrawn = false;
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 7) Cached /sensor-data payload. Rendered once per new sample into a fixed
+//    buffer; every request in between reuses it. The ETag is a per-boot
+//    nonce plus the sample sequence number, so it changes on every sample
+//    and never collides with a tag handed out before a reboot.
+// ──────────────────────────────────────────────────────────────────────────────
+static char     sensorJson[2432];
+static size_t   sensorJsonLen = 0;
+
+// Worst case: every number at its widest (readings are checked against the
+// sensors' ranges, so "-999.0" for %.1f and 7 characters for the derived
+// values' %.2f/%.3f), 10-digit times, 5-digit failure counts, the longest
+// kind and status, and names cut to HAL_SENSOR_NAME_MAX.
+static const size_t SENSOR_JSON_NUM    = 7;
+static const size_t SENSOR_JSON_HEAD   =
+    sizeof("{\"temperature\":,\"humidity\":,\"temp_low\":,\"temp_high\":,\"hum_low\":,\"hum_high\":,"
+           "\"dew_point\":,\"abs_humidity\":,\"vpd\":,\"last_updated\":,\"sample_period_ms\":,"
+           "\"windows\":{") - 1 + 9 * SENSOR_JSON_NUM + 2 * 10;
+static const size_t SENSOR_JSON_WINDOW =
+    sizeof(",\"today\":{\"temp_low\":,\"temp_high\":,\"hum_low\":,\"hum_high\":}") - 1 + 4 * SENSOR_JSON_NUM;
+static const size_t SENSOR_JSON_PROBE  =
+    sizeof(",{\"name\":\"\",\"kind\":\"\",\"temperature\":,\"humidity\":,\"temp_low\":,\"temp_high\":,"
+           "\"hum_low\":,\"hum_high\":,\"last_updated\":,\"status\":\"\",\"failures\":}") - 1 +
+    HAL_SENSOR_NAME_MAX + sizeof("dht22") - 1 + 6 * SENSOR_JSON_NUM + 10 + sizeof("out_of_range") - 1 + 5;
+static const size_t SENSOR_JSON_TAIL   = sizeof("},\"sensors\":[") - 1 + sizeof("]}");
+static_assert(SENSOR_JSON_HEAD + 4 * SENSOR_JSON_WINDOW + APP_MAX_SENSORS * SENSOR_JSON_PROBE +
+              SENSOR_JSON_TAIL <= sizeof(sensorJson), "sensorJson[] too small for APP_MAX_SENSORS probes");
+static char     sensorEtag[24];
+static uint32_t renderedVersion = 0;  // snapshot.version() that sensorJson reflects
+static uint16_t bootNonce       = 0;
+
+// Read outcomes and probe kinds as /sensor-data and /metrics spell them
+static const char* const STATUS_NAME[DHT22_OUT_OF_RANGE + 1] = {
+  "ok", "truncated", "bad_timing", "checksum", "out_of_range"
+};
+static const char* const SENSOR_KIND_NAME[] = { "dht22", "sht3x" };
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 8) Server-Sent Events subscribers (/events), as HAL stream ids. Each open
+//    dashboard keeps one long-lived socket; capped so viewers can't exhaust
+//    lwIP's socket pool.
+// ──────────────────────────────────────────────────────────────────────────────
+static int sseStreams[HAL_MAX_STREAMS] = { -1, -1, -1, -1 };
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 9) Per-route timing: one of these at the top of each handler records its
+//    duration (and so the request count) when the handler returns, and
+//    traces it as a span named after the route.
+// ──────────────────────────────────────────────────────────────────────────────
+static_assert(TRACE_HTTP_TRACE - TRACE_HTTP_ROOT == ROUTE_TRACE - ROUTE_ROOT,
+              "trace.h's HTTP_* rows must follow AppRoute");
+
+struct RouteTimer {
+  explicit RouteTimer(AppRoute r) : route(r), start(halPerfMicros()) {
+    TRACE_BEGIN((TraceName)(TRACE_HTTP_ROOT + r), 0);
+  }
+  ~RouteTimer() {
+    metrics.route[route].observe(halPerfMicros() - start);
+    TRACE_END((TraceName)(TRACE_HTTP_ROOT + route));
+  }
+  AppRoute route;
+  uint32_t start;
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Forward declarations
+// ──────────────────────────────────────────────────────────────────────────────
+static void handleRoot();
+static void handleSensorData();
+static void handleHistory();
+static void handleEvents();
+static void handleMetrics();
+static void handleExport();
+static void handleTrend();
+#if POTATO_TRACE
+static void handleTrace();
+#endif
+static void renderSensorJson(const SensorSnapshot& snap);
+static void pushSensorEvent();
+static void drawReadings(int16_t offsetX, int16_t offsetY);
+static void formatLines(const SensorSnapshot& snap, int page);
+static uint32_t sampleTimestamp();
+static uint32_t storeTimestamp();
+static uint32_t sensorStep();
+static int32_t  localDay();
+static int32_t  localDayOf(time_t t, uint32_t* midnight);
+static void     publishWindows(SensorSnapshot& snap);
+static void     restoreFromLog();
+static void     logSample(const HistSample& s);
+static void     takeReading(size_t probe, const Dht22Reading& reading, Dht22Status status);
+static void     uplinkLoadAck();
+static void     uplinkSaveAck();
+static void     evaluateAlerts(SensorSnapshot& snap, uint32_t now);
+static void     formatAlertLines(uint32_t firing);
+static void     formatAirLines(const SensorSnapshot& snap);
+static Psychro  deriveAir(long t10F, long h10);
+static float    dewPointF(const Psychro& air);
+
+void appSetup() {
+  // — Draw initial placeholders (“--F” etc.) so you see them only briefly
+  snprintf(lineStr[0], sizeof(lineStr[0]), "TEMP: --F");
+  snprintf(lineStr[1], sizeof(lineStr[1]), "L:-- H:--");
+  snprintf(lineStr[2], sizeof(lineStr[2]), "HUMID: --%%");
+  snprintf(lineStr[3], sizeof(lineStr[3]), "L:-- H:--");
+  drawReadings(0, 0);
+  lastPhase = (int)((halMillis() / 60000UL) % 4);
+
+  // — Bring back history and min/max from before the reboot
+  restoreFromLog();
+  if (halUplinkEnabled()) uplinkLoadAck();
+
+  // — Stagger the probes' reads across one period
+  size_t probes = halSensorCount();
+  if (probes > APP_MAX_SENSORS) {
+    halLog("%u sensors configured; only the first %u are read\n",
+           (unsigned) probes, (unsigned) APP_MAX_SENSORS);
+    probes = APP_MAX_SENSORS;
+  }
+  uint32_t minInterval[APP_MAX_SENSORS];
+  for (size_t i = 0; i < probes; i++) minInterval[i] = halSensorInfo(i).minIntervalMs;
+  scheduler.begin(probes, APP_SENSOR_PERIOD_MS, minInterval, halMillis() + SENSOR_WARMUP_MS);
+  sampleRate.begin({ APP_SENSOR_PERIOD_MS, halSensorMaxPeriodMs(),
+                     RATE_BAND_T10, RATE_BAND_H10, RATE_FAST_T10, RATE_FAST_H10 });
+  oledPages = (probes > 1 ? (int) probes + 1 : 1) + 1;
+  alerts.begin(ALERT_RULES, ALERT_RULE_COUNT);
+
+  // — Publish an empty snapshot and render the placeholder /sensor-data
+  //   payload so the endpoint is valid before the first read lands
+  sensorSnap.tempF = sensorSnap.hum = NAN;
+  sensorSnap.dewPointF = sensorSnap.absHumidity = sensorSnap.vpdKPa = NAN;
+  sensorSnap.probes = (uint8_t) probes;
+  for (size_t i = 0; i < probes; i++) {
+    sensorSnap.probeTempF[i]    = sensorSnap.probeHum[i] = NAN;
+    sensorSnap.probeUpdate[i]   = 0;
+    sensorSnap.probeFailures[i] = 0;
+    sensorSnap.probeStatus[i]   = DHT22_OK;
+  }
+  sensorSnap.alerts = 0;
+  sensorSnap.samplePeriodMs = sampleRate.periodMs();
+  publishWindows(sensorSnap);
+  sensorSnap.lastUpdate = 0;
+  sensorSnap.seq        = 0;
+  snapshot.store(sensorSnap);
+  bootNonce = (uint16_t) halRandom();
+  renderSensorJson(sensorSnap);
+  renderedVersion = snapshot.version();
+
+  // — HTTP routes
+  halHttpOn("/",            handleRoot);
+  halHttpOn("/sensor-data", handleSensorData);
+  halHttpOn("/history",     handleHistory);
+  halHttpOn("/events",      handleEvents);
+  halHttpOn("/metrics",     handleMetrics);
+  halHttpOn("/export",      handleExport);
+  halHttpOn("/trend",       handleTrend);
+#if POTATO_TRACE
+  halHttpOn("/trace",       handleTrace);
+#endif
+}
+
+void appFlushLog() {
+  sampleLog.flush();
+  uplinkSaveAck();
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// A) appSensorStep() → probe reads, min/max, history, snapshot publishing
+// ──────────────────────────────────────────────────────────────────────────────
+uint32_t appSensorStep() {
+  const uint32_t t0 = halPerfMicros();
+  const uint32_t sleepMs = sensorStep();
+  metrics.sensorStep.observe(halPerfMicros() - t0);
+  return sleepMs;
+}
+
+static uint32_t sensorStep() {
+  SensorSnapshot& snap = sensorSnap;
+
+  // — Once NTP lands, convert the provisional stamps taken so far
+  if (!timeSynced) {
+    const time_t t = halTime();
+    if (t >= UNIX_TIME_VALID) {
+      halLog("NTP synced, current UNIX time = %lu\n", (unsigned long) t);
+      const uint32_t uptime = halMillis() / 1000;
+      if ((uint32_t) t > storeBase + uptime) {
+        const uint32_t offset = (uint32_t) t - (storeBase + uptime);
+        halHistoryLock();
+        history.rebase(offset, storeBase);
+        halHistoryUnlock();
+        win1h.rebase(offset, storeBase);
+        win24h.rebase(offset, storeBase);
+        win7d.rebase(offset, storeBase);
+        for (size_t i = 0; i < snap.probes; i++) probe24h[i].rebase(offset, storeBase);
+      } else {
+        // The clock is behind the log; new samples are dropped until it passes it
+        halLog("NTP time is before the newest logged sample (%lu)\n", (unsigned long) storeBase);
+      }
+      if (snap.lastUpdate < (uint32_t) UNIX_TIME_VALID) snap.lastUpdate += (uint32_t) t - uptime;
+      timeSynced = true;
+    }
+  }
+
+  // — Poll the read in flight; once it is done, start whichever probe is
+  //   due next. The drivers capture in the background and poll() never
+  //   blocks, so a step costs microseconds even mid-read.
+  if (activeProbe >= 0) {
+    halSensorPoll(activeProbe);
+    Dht22Reading reading;
+    Dht22Status  status;
+    if (halSensorTakeResult(activeProbe, reading, status)) {
+      takeReading((size_t) activeProbe, reading, status);
+      activeProbe = -1;
+    }
+  }
+  const uint32_t now = halMillis();
+  if (activeProbe < 0) {
+    const int next = scheduler.next(now);
+    if (next >= 0) {
+      metrics.sensorLateness.observe(scheduler.started(next, now) * 1000);
+      activeProbe = next;
+      TRACE_INSTANT(TRACE_READ_START, next);
+      halSensorStart(next);
+    }
+  }
+
+  // A read in flight needs polling every tick; otherwise sleep until the next one
+  if (activeProbe >= 0) return 1;
+  return min(scheduler.untilNext(now), sampleRate.periodMs());
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// A1) takeReading() → fold one finished attempt into the probe's state and
+//     the room, then publish
+// ──────────────────────────────────────────────────────────────────────────────
+static void takeReading(size_t probe, const Dht22Reading& reading, Dht22Status status) {
+  TRACE_SCOPE_ARG(TRACE_TAKE_READING, probe);
+  SensorSnapshot& snap = sensorSnap;
+  const uint32_t now = halMillis();
+  const bool ok = (status == DHT22_OK);
+  metrics.probeResults[probe][status].inc();
+  snap.probeStatus[probe] = status;
+  if (ok) {
+    metrics.probeLastOkMs[probe].set(max<uint32_t>(now, 1));
+    probeFreshMs[probe] = 3 * scheduler.periodMs(probe);
+    snap.probeFailures[probe] = 0;
+
+    // a) Temperature in 0.1 °C → °F
+    snap.probeTempF[probe] = reading.t10C / 10.0f * 9.0f / 5.0f + 32.0f;
+
+    // b) Humidity in 0.1 %RH
+    snap.probeHum[probe] = reading.h10 / 10.0f;
+
+    snap.probeUpdate[probe] = sampleTimestamp();
+    probe24h[probe].add(storeTimestamp(), (int16_t) lround(snap.probeTempF[probe] * 10.0f),
+                        (int16_t) lround(snap.probeHum[probe] * 10.0f));
+  } else {
+    TRACE_INSTANT(TRACE_READ_FAILED, probe);
+    if (snap.probeFailures[probe] < UINT16_MAX) snap.probeFailures[probe]++;
+    halLog("Error reading %s: %s\n", halSensorInfo(probe).name, dht22StatusName(status));
+  }
+
+  // c) The room: mean of the probes with a recent good read
+  float tSum = 0, hSum = 0;
+  int fresh = 0;
+  for (size_t i = 0; i < snap.probes; i++) {
+    const uint32_t okMs = metrics.probeLastOkMs[i].value();
+    if (okMs == 0 || now - okMs > probeFreshMs[i]) continue;
+    tSum += snap.probeTempF[i];
+    hSum += snap.probeHum[i];
+    fresh++;
+  }
+  if (fresh > 0) {
+    snap.tempF = tSum / fresh;
+    snap.hum   = hSum / fresh;
+
+    // c1) Dew point, absolute humidity and VPD of the room, once per read
+    //     for every reader of the snapshot
+    const Psychro air = deriveAir(lround(snap.tempF * 10.0f), lround(snap.hum * 10.0f));
+    snap.dewPointF   = dewPointF(air);
+    snap.absHumidity = air.ah100 / 100.0f;
+    snap.vpdKPa      = air.vpdPa / 1000.0f;
+  }
+
+  // d) Record “lastUpdate” (UNIX time, or uptime until NTP syncs)
+  snap.lastUpdate = sampleTimestamp();
+
+  // e) Append the room to the history store, the min/max windows and (once
+  //    the clock is real) the flash log, in fixed-point 0.1 °F / 0.1 %RH,
+  //    at most once per period however many probes report, and let it set
+  //    the next period. The calendar day rolls over on every attempt, so
+  //    failing sensors can't keep yesterday's extremes.
+  winToday.roll(localDay());
+  const uint32_t period = sampleRate.periodMs();
+  if (ok && (!haveRoomSample || now - roomSampleMs >= period - period / 16)) {
+    haveRoomSample = true;
+    roomSampleMs   = now;
+    HistSample s;
+    s.ts  = storeTimestamp();
+    s.t10 = (int16_t)  lround(snap.tempF * 10.0f);
+    s.h10 = (uint16_t) lround(snap.hum   * 10.0f);
+    halHistoryLock();
+    history.add(s);
+    halHistoryUnlock();
+
+    win1h.add(s.ts, s.t10, (int16_t) s.h10);
+    win24h.add(s.ts, s.t10, (int16_t) s.h10);
+    win7d.add(s.ts, s.t10, (int16_t) s.h10);
+    winToday.add(s.t10, (int16_t) s.h10);
+    if (timeSynced) logSample(s);
+    sampleRate.observe(s.t10, (int16_t) s.h10, now);
+  } else if (!ok) {
+    sampleRate.reset();
+  }
+  if (sampleRate.periodMs() != period) scheduler.setPeriod(sampleRate.periodMs(), now);
+  snap.samplePeriodMs = sampleRate.periodMs();
+  publishWindows(snap);
+
+  // f) Alert rules, against this read (constant work per rule)
+  evaluateAlerts(snap, now);
+
+  // g) Publish, and wake the display and alert tasks
+  snap.seq++;
+  snapshot.store(snap);
+  halNotifySample();
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// A2) evaluateAlerts() → run every rule against the state this read left,
+//     queue each change of state for the webhook and record the firing set
+//     in the snapshot (OLED alert page)
+// ──────────────────────────────────────────────────────────────────────────────
+static float alertInput(const SensorSnapshot& snap, const AlertRule& r, uint32_t now) {
+  if (r.sensor != ALERT_ROOM && (size_t) r.sensor >= snap.probes) return NAN;
+
+  // STALE: seconds since the probe's last good read (the stalest probe for
+  // ALERT_ROOM); a probe that never answered counts from boot
+  if (r.kind == ALERT_STALE) {
+    const size_t first = r.sensor == ALERT_ROOM ? 0 : (size_t) r.sensor;
+    const size_t last  = r.sensor == ALERT_ROOM ? snap.probes : first + 1;
+    uint32_t age = 0;
+    for (size_t i = first; i < last; i++) age = max(age, now - metrics.probeLastOkMs[i].value());
+    return age / 1000.0f;
+  }
+  if (r.sensor == ALERT_ROOM) return r.quantity == ALERT_TEMP ? snap.tempF : snap.hum;
+  return r.quantity == ALERT_TEMP ? snap.probeTempF[r.sensor] : snap.probeHum[r.sensor];
+}
+
+static void evaluateAlerts(SensorSnapshot& snap, uint32_t now) {
+  for (size_t i = 0; i < alerts.count(); i++) {
+    float observed;
+    if (!alerts.evaluate(i, now, alertInput(snap, alerts.rule(i), now), &observed)) continue;
+    const bool firing = alerts.firing(i);
+    halLog("Alert %s %s (%.1f)\n", alerts.rule(i).name, firing ? "firing" : "cleared", observed);
+    if (firing) metrics.alertsRaised[i].inc();
+    const AlertEvent e = { (uint8_t) i, firing, observed, snap.lastUpdate };
+    if (halWebhookEnabled() && !alertQueue.push(e)) metrics.alertsDropped.inc();
+  }
+  snap.alerts = alerts.firingMask();
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// A3) deriveAir() → dew point, absolute humidity and VPD for a reading in the
+//     store's fixed point (0.1 °F / 0.1 %RH); psychro.h works in 0.1 °C
+// ──────────────────────────────────────────────────────────────────────────────
+static Psychro deriveAir(long t10F, long h10) {
+  const long t10C = t10F >= 320 ? ((t10F - 320) * 5 + 4) / 9 : -(((320 - t10F) * 5 + 4) / 9);
+  return psychroDerive((int16_t) max(min(t10C, 2000L), -2000L),
+                       (uint16_t) max(min(h10, 1000L), 0L));
+}
+
+static float dewPointF(const Psychro& air) {
+  return air.dew10C == PSYCHRO_DEW_NONE ? NAN : air.dew10C / 10.0f * 9.0f / 5.0f + 32.0f;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// B) appDisplayStep() → keep the OLED in step with the snapshot + burn-in shift
+// ──────────────────────────────────────────────────────────────────────────────
+void appDisplayStep() {
+  TRACE_SCOPE(TRACE_DISPLAY_STEP);
+  const uint32_t t0 = halPerfMicros();
+  bool dirty = false;
+
+  // — New sample or next page → update lineStr[] so the OLED shows real
+  //   data instead of “--F”. While alerts fire, an alert page follows the
+  //   others.
+  const uint32_t version = snapshot.version();
+  SensorSnapshot snap;
+  const bool fresh = version != shownVersion;
+  if (fresh) {
+    snap = snapshot.load();
+    shownAlerts = snap.alerts;
+  }
+  const int pages = oledPages + (shownAlerts ? 1 : 0);
+  const int page  = pages > 1 ? (int)((halMillis() / OLED_PAGE_MS) % pages) : 0;
+  if (fresh || page != shownPage) {
+    if (!fresh) snap = snapshot.load();
+    shownVersion = version;
+    shownPage    = page;
+    if (snap.seq != 0) {
+      if (page == oledPages && snap.alerts) formatAlertLines(snap.alerts);
+      else if (page == oledPages - 1)       formatAirLines(snap);
+      else                                  formatLines(snap, page);
+      dirty = true;
+    }
+  }
+
+  // — Jiggle the OLED contents once per minute to prevent burn-in
+  int phase = (int)((halMillis() / 60000UL) % 4);
+  if (phase != lastPhase) {
+    lastPhase = phase;
+    switch (phase) {
+      case 0: oledOffsetX =  1; oledOffsetY =  0; break; // shift right 1px
+      case 1: oledOffsetX =  1; oledOffsetY = -1; break; // shift up    1px
+      case 2: oledOffsetX =  0; oledOffsetY = -1; break; // shift left  1px
+      case 3: oledOffsetX =  0; oledOffsetY =  0; break; // shift down  1px
+    }
+    dirty = true;
+  }
+
+  // — Repaint whatever changed (usually a glyph or two)
+  if (dirty) drawReadings(oledOffsetX, oledOffsetY);
+  metrics.displayStep.observe(halPerfMicros() - t0);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// C) appWebStep() → re-render /sensor-data and push /events once per new
+//    snapshot
+// ──────────────────────────────────────────────────────────────────────────────
+void appWebStep() {
+  const uint32_t t0 = halPerfMicros();
+  const uint32_t v = snapshot.version();
+  if (v != renderedVersion) {
+    TRACE_SCOPE(TRACE_WEB_PUBLISH);
+    renderedVersion = v;
+    renderSensorJson(snapshot.load());
+    pushSensorEvent();
+  }
+  metrics.webStep.observe(halPerfMicros() - t0);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// D) formatLines() → the four OLED lines for a snapshot. Page 0 is the room
+//    (“TEMP:”, or “ROOM:” when there are several probes); page k is probe
+//    k−1 under its name, or ERR once it has stopped answering.
+// ──────────────────────────────────────────────────────────────────────────────
+static void formatLines(const SensorSnapshot& snap, int page) {
+  float tempF = snap.tempF, hum = snap.hum;
+  const MinMax* day = &snap.win[WIN_24H];
+  bool failed = false;
+
+  // “TEMP: XXF”, “ROOM: XXF” or “NAME:XXF”
+  if (page == 0) {
+    snprintf(lineStr[0], sizeof(lineStr[0]), "%s", snap.probes > 1 ? "ROOM: " : "TEMP: ");
+  } else {
+    const size_t p = (size_t)(page - 1);
+    tempF  = snap.probeTempF[p];
+    hum    = snap.probeHum[p];
+    day    = &snap.probeDay[p];
+    failed = snap.probeFailures[p] >= PROBE_STALE_FAILURES;
+    int n = snprintf(lineStr[0], sizeof(lineStr[0]), "%.5s:", halSensorInfo(p).name);
+    for (int c = 0; c < n; c++) lineStr[0][c] = (char) toupper((unsigned char) lineStr[0][c]);
+  }
+  const size_t at = strlen(lineStr[0]);
+  if (failed)            snprintf(lineStr[0] + at, sizeof(lineStr[0]) - at, "ERR");
+  else if (isnan(tempF)) snprintf(lineStr[0] + at, sizeof(lineStr[0]) - at, "--F");
+  else                   snprintf(lineStr[0] + at, sizeof(lineStr[0]) - at, "%dF", (int) round(tempF));
+
+  // “L:XX H:YY” over the last 24 h
+  if (isnan(day->tMin)) {
+    snprintf(lineStr[1], sizeof(lineStr[1]), "L:-- H:--");
+  } else {
+    int tmin_i = (int)round(day->tMin);
+    int tmax_i = (int)round(day->tMax);
+    snprintf(lineStr[1], sizeof(lineStr[1]), "L:%d H:%d", tmin_i, tmax_i);
+  }
+
+  // “HUMID: ZZ%”
+  if (failed || isnan(hum)) {
+    snprintf(lineStr[2], sizeof(lineStr[2]), "HUMID: --%%");
+  } else {
+    int h_i = (int)round(hum);
+    snprintf(lineStr[2], sizeof(lineStr[2]), "HUMID: %d%%", h_i);
+  }
+
+  // “L:AA H:BB” over the last 24 h
+  if (isnan(day->hMin)) {
+    snprintf(lineStr[3], sizeof(lineStr[3]), "L:-- H:--");
+  } else {
+    int hmin_i = (int)round(day->hMin);
+    int hmax_i = (int)round(day->hMax);
+    snprintf(lineStr[3], sizeof(lineStr[3]), "L:%d H:%d", hmin_i, hmax_i);
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// D1) formatAlertLines() → the alert page: the first firing rule's name and
+//     condition, and how many others fire
+//
+//       ALERT!   /   SPROUTING   /   T > 50F   /   +1 MORE
+// ──────────────────────────────────────────────────────────────────────────────
+static void formatAlertLines(uint32_t firing) {
+  size_t first = 0;
+  while (!(firing >> first & 1)) first++;
+  const AlertRule& r = ALERT_RULES[first];
+
+  snprintf(lineStr[0], sizeof(lineStr[0]), "ALERT!");
+  const int n = snprintf(lineStr[1], sizeof(lineStr[1]), "%.10s", r.name);
+  for (int c = 0; c < n; c++) lineStr[1][c] = (char) toupper((unsigned char) lineStr[1][c]);
+
+  const bool  temp = r.quantity == ALERT_TEMP;
+  const char* q    = temp ? "T" : "RH";
+  const char* unit = temp ? "F" : "%";
+  const int   lim  = (int) round(r.threshold);
+  switch (r.kind) {
+    case ALERT_ABOVE: snprintf(lineStr[2], sizeof(lineStr[2]), "%s > %d%s", q, lim, unit); break;
+    case ALERT_BELOW: snprintf(lineStr[2], sizeof(lineStr[2]), "%s < %d%s", q, lim, unit); break;
+    case ALERT_RISE:  snprintf(lineStr[2], sizeof(lineStr[2]), "%s +%d%s/H", q, lim, unit); break;
+    case ALERT_FALL:  snprintf(lineStr[2], sizeof(lineStr[2]), "%s -%d%s/H", q, lim, unit); break;
+    case ALERT_STALE: snprintf(lineStr[2], sizeof(lineStr[2]), "NO READ"); break;
+  }
+
+  int others = -1;
+  for (uint32_t m = firing; m; m &= m - 1) others++;
+  if (others > 0) snprintf(lineStr[3], sizeof(lineStr[3]), "+%d MORE", others);
+  else            lineStr[3][0] = '\0';
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// D2) formatAirLines() → the air page: dew point, how far the room is above
+//     it (anything that much colder than the air sweats), absolute humidity
+//     and vapour-pressure deficit
+//
+//       DEW: 41F   /   SPREAD: 4F   /   AH:7.2G/M3   /   VPD:112PA
+// ──────────────────────────────────────────────────────────────────────────────
+static void formatAirLines(const SensorSnapshot& snap) {
+  if (isnan(snap.dewPointF)) {
+    snprintf(lineStr[0], sizeof(lineStr[0]), "DEW: --F");
+    snprintf(lineStr[1], sizeof(lineStr[1]), "SPREAD: --");
+  } else {
+    snprintf(lineStr[0], sizeof(lineStr[0]), "DEW: %dF", (int) round(snap.dewPointF));
+    snprintf(lineStr[1], sizeof(lineStr[1]), "SPREAD: %dF", (int) round(snap.tempF - snap.dewPointF));
+  }
+
+  if (isnan(snap.absHumidity))    snprintf(lineStr[2], sizeof(lineStr[2]), "AH: --");
+  else if (snap.absHumidity < 10) snprintf(lineStr[2], sizeof(lineStr[2]), "AH:%.1fG/M3", snap.absHumidity);
+  else                            snprintf(lineStr[2], sizeof(lineStr[2]), "AH:%dG/M3", (int) round(snap.absHumidity));
+
+  if (isnan(snap.vpdKPa))         snprintf(lineStr[3], sizeof(lineStr[3]), "VPD: --");
+  else if (snap.vpdKPa < 10)      snprintf(lineStr[3], sizeof(lineStr[3]), "VPD:%dPA", (int) round(snap.vpdKPa * 1000));
+  else                            snprintf(lineStr[3], sizeof(lineStr[3]), "VPD:%dKPA", (int) round(snap.vpdKPa));
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// E) sampleTimestamp() → UNIX seconds once NTP has synced, seconds since boot
+//    before that (always < UNIX_TIME_VALID, so the two can't be confused)
+// ──────────────────────────────────────────────────────────────────────────────
+static uint32_t sampleTimestamp() {
+  if (timeSynced) return (uint32_t) halTime();
+  return halMillis() / 1000;
+}
+
+// The stamp history and the windows store: the same once synced, storeBase +
+// uptime before (see section 5)
+static uint32_t storeTimestamp() {
+  if (timeSynced) return (uint32_t) halTime();
+  return storeBase + halMillis() / 1000;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// F) localDay() → local calendar day number (changes at local midnight, per
+//    the TZ the platform configured), or -1 before NTP sync
+// ──────────────────────────────────────────────────────────────────────────────
+static int32_t localDay() {
+  if (!timeSynced) return -1;
+  return localDayOf(halTime(), nullptr);
+}
+
+// Day number of `t`, optionally with the UNIX time of that day's midnight
+static int32_t localDayOf(time_t t, uint32_t* midnight) {
+  struct tm lt;
+  if (!localtime_r(&t, &lt)) return -1;
+  const int32_t day = (int32_t) lt.tm_year * 400 + lt.tm_yday;
+  if (midnight) {
+    lt.tm_hour = lt.tm_min = lt.tm_sec = 0;
+    lt.tm_isdst = -1;
+    *midnight = (uint32_t) mktime(&lt);
+  }
+  return day;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// G) publishWindows() → copy the min/max windows (room and per probe) into a
+//    snapshot, first dropping what has aged out of them: during an outage no
+//    sample arrives to do it
+// ──────────────────────────────────────────────────────────────────────────────
+static void toMinMax(bool have, const MinMax16& mm, MinMax& out) {
+  if (!have) {
+    out.tMin = out.tMax = out.hMin = out.hMax = NAN;
+    return;
+  }
+  out.tMin = mm.tMin / 10.0f;
+  out.tMax = mm.tMax / 10.0f;
+  out.hMin = mm.hMin / 10.0f;
+  out.hMax = mm.hMax / 10.0f;
+}
+
+static void publishWindows(SensorSnapshot& snap) {
+  const uint32_t now = storeTimestamp();
+  win1h.expire(now);
+  win24h.expire(now);
+  win7d.expire(now);
+  for (size_t i = 0; i < snap.probes; i++) probe24h[i].expire(now);
+
+  MinMax16 mm[WIN_COUNT];
+  const bool have[WIN_COUNT] = {
+    win1h.get(&mm[WIN_1H]), win24h.get(&mm[WIN_24H]),
+    win7d.get(&mm[WIN_7D]), winToday.get(&mm[WIN_TODAY]),
+  };
+  for (int w = 0; w < WIN_COUNT; w++) toMinMax(have[w], mm[w], snap.win[w]);
+
+  for (size_t i = 0; i < snap.probes; i++) {
+    MinMax16 day;
+    toMinMax(probe24h[i].get(&day), day, snap.probeDay[i]);
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// H) restoreFromLog() → rebuild history and the windows from the flash log.
+//    "Today" is the calendar day of the newest logged sample; NTP rolls it
+//    over if the board was off past midnight.
+// ──────────────────────────────────────────────────────────────────────────────
+static void restoreFromLog() {
+  if (!sampleLog.begin()) return;
+  const uint32_t t0 = halPerfMicros();
+  const uint32_t lastTs = sampleLog.lastTs();
+  uint32_t midnight = UINT32_MAX;
+  if (lastTs != 0) winToday.roll(localDayOf(lastTs, &midnight));
+
+  const uint32_t n = sampleLog.replay([midnight](const HistSample& s) {
+    history.add(s);
+    win1h.add(s.ts, s.t10, (int16_t) s.h10);
+    win24h.add(s.ts, s.t10, (int16_t) s.h10);
+    win7d.add(s.ts, s.t10, (int16_t) s.h10);
+    if (s.ts >= midnight) winToday.add(s.t10, (int16_t) s.h10);
+  });
+  if (lastTs != 0) storeBase = lastTs + 1;
+
+  halLog("Sample log: %lu samples replayed in %lu ms, %lu torn bytes skipped\n",
+         (unsigned long) n, (unsigned long)((halPerfMicros() - t0) / 1000),
+         (unsigned long) sampleLog.stats().tornBytes);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// I) logSample() → hand a sample to the flash log, timing the appends that
+//    actually reach flash (they stall the sensor step)
+// ──────────────────────────────────────────────────────────────────────────────
+static void logSample(const HistSample& s) {
+  TRACE_SCOPE(TRACE_LOG_APPEND);
+  const LogStats before = sampleLog.stats();
+  const uint32_t t0 = halPerfMicros();
+  sampleLog.append(s);
+  const LogStats& after = sampleLog.stats();
+  if (after.framesWritten == before.framesWritten && after.writeErrors == before.writeErrors) return;
+  metrics.logFlush.observe(halPerfMicros() - t0);
+  metrics.logBytes.inc(after.bytesWritten - before.bytesWritten);
+  metrics.logWriteErrors.inc(after.writeErrors - before.writeErrors);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1) handleRoot() → serve the dashboard
+//
+// The page lives in web/index.html and is gzipped at build time by
+// tools/embed_page.py into a const array in flash. It is streamed straight
+// from there (no String copy) and tagged with a content-hash ETag, so a
+// browser revalidating an unchanged page gets a bodyless 304.
+// ──────────────────────────────────────────────────────────────────────────────
+static void handleRoot() {
+  RouteTimer timer(ROUTE_ROOT);
+  halHttpSendHeader("ETag", INDEX_HTML_ETAG);
+  halHttpSendHeader("Cache-Control", "no-cache");
+  if (halHttpHeaderIs("If-None-Match", INDEX_HTML_ETAG)) {
+    metrics.notModified.inc();
+    halHttpSend(304, nullptr, nullptr, 0);
+    return;
+  }
+  halHttpSendHeader("Content-Encoding", "gzip");
+  halHttpSendStatic(200, "text/html", INDEX_HTML_GZ, INDEX_HTML_GZ_LEN);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2) handleSensorData() → return JSON fields for the webpage’s fetch()
+//
+// Serves the payload cached by renderSensorJson(); nothing is allocated or
+// reserialized per request. A client presenting the current ETag gets a 304.
+// ──────────────────────────────────────────────────────────────────────────────
+static void handleSensorData() {
+  RouteTimer timer(ROUTE_SENSOR_DATA);
+  halHttpSendHeader("ETag", sensorEtag);
+  halHttpSendHeader("Cache-Control", "no-cache");
+  if (halHttpHeaderIs("If-None-Match", sensorEtag)) {
+    metrics.notModified.inc();
+    halHttpSend(304, nullptr, nullptr, 0);
+    return;
+  }
+  halHttpSend(200, "application/json", sensorJson, sensorJsonLen);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2a) renderSensorJson() → serialize a snapshot into sensorJson[] and tag it
+//     with its sample sequence number. Called by the web step once per sample.
+// ──────────────────────────────────────────────────────────────────────────────
+static void renderSensorJson(const SensorSnapshot& snap) {
+  static const char* const winName[WIN_COUNT] = { "1h", "24h", "7d", "today" };
+  const MinMax& day = snap.win[WIN_24H];
+
+  // Top-level low/high are the rolling 24 h, as shown on the OLED
+  int len = snprintf(sensorJson, sizeof(sensorJson),
+                     "{\"temperature\":%.1f,\"humidity\":%.1f,"
+                     "\"temp_low\":%.1f,\"temp_high\":%.1f,"
+                     "\"hum_low\":%.1f,\"hum_high\":%.1f,"
+                     "\"dew_point\":%.1f,\"abs_humidity\":%.2f,\"vpd\":%.3f,"
+                     "\"last_updated\":%lu,\"sample_period_ms\":%lu,\"windows\":{",
+                     isnan(snap.tempF) ? -999.0 : snap.tempF,
+                     isnan(snap.hum)   ? -1.0   : snap.hum,
+                     isnan(day.tMin)   ? -999.0 : day.tMin,
+                     isnan(day.tMax)   ? -999.0 : day.tMax,
+                     isnan(day.hMin)   ? -1.0   : day.hMin,
+                     isnan(day.hMax)   ? -1.0   : day.hMax,
+                     isnan(snap.dewPointF)   ? -999.0 : snap.dewPointF,
+                     isnan(snap.absHumidity) ? -1.0   : snap.absHumidity,
+                     isnan(snap.vpdKPa)      ? -1.0   : snap.vpdKPa,
+                     (unsigned long) snap.lastUpdate, (unsigned long) snap.samplePeriodMs);
+  for (int w = 0; w < WIN_COUNT; w++) {
+    const MinMax& m = snap.win[w];
+    len += snprintf(sensorJson + len, sizeof(sensorJson) - len,
+                    "%s\"%s\":{\"temp_low\":%.1f,\"temp_high\":%.1f,"
+                    "\"hum_low\":%.1f,\"hum_high\":%.1f}",
+                    w ? "," : "", winName[w],
+                    isnan(m.tMin) ? -999.0 : m.tMin,
+                    isnan(m.tMax) ? -999.0 : m.tMax,
+                    isnan(m.hMin) ? -1.0   : m.hMin,
+                    isnan(m.hMax) ? -1.0   : m.hMax);
+  }
+
+  // Per probe: current reading, rolling 24 h low/high and read status
+  len += snprintf(sensorJson + len, sizeof(sensorJson) - len, "},\"sensors\":[");
+  // Sized for the worst case (above), but never trusted: once the buffer
+  // is full nothing more is appended, and the payload is cut there
+  for (size_t i = 0; i < snap.probes && len < (int) sizeof(sensorJson); i++) {
+    const MinMax& m = snap.probeDay[i];
+    const bool pending = snap.probeUpdate[i] == 0 && snap.probeFailures[i] == 0;
+    len += snprintf(sensorJson + len, sizeof(sensorJson) - len,
+                    "%s{\"name\":\"%.*s\",\"kind\":\"%s\","
+                    "\"temperature\":%.1f,\"humidity\":%.1f,"
+                    "\"temp_low\":%.1f,\"temp_high\":%.1f,"
+                    "\"hum_low\":%.1f,\"hum_high\":%.1f,"
+                    "\"last_updated\":%lu,\"status\":\"%s\",\"failures\":%u}",
+                    i ? "," : "", (int) HAL_SENSOR_NAME_MAX, halSensorInfo(i).name,
+                    SENSOR_KIND_NAME[halSensorInfo(i).kind],
+                    isnan(snap.probeTempF[i]) ? -999.0 : snap.probeTempF[i],
+                    isnan(snap.probeHum[i])   ? -1.0   : snap.probeHum[i],
+                    isnan(m.tMin) ? -999.0 : m.tMin,
+                    isnan(m.tMax) ? -999.0 : m.tMax,
+                    isnan(m.hMin) ? -1.0   : m.hMin,
+                    isnan(m.hMax) ? -1.0   : m.hMax,
+                    (unsigned long) snap.probeUpdate[i],
+                    pending ? "pending" : STATUS_NAME[snap.probeStatus[i]],
+                    (unsigned) snap.probeFailures[i]);
+  }
+  if (len < (int) sizeof(sensorJson)) len += snprintf(sensorJson + len, sizeof(sensorJson) - len, "]}");
+  sensorJsonLen = min((size_t) len, sizeof(sensorJson) - 1);
+
+  snprintf(sensorEtag, sizeof(sensorEtag), "\"%04x-%lu\"",
+           bootNonce, (unsigned long) snap.seq);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2b) handleHistory() → stream /history?from=&to=&res= as JSON
+//
+//   from, to : UNIX seconds (defaults: everything held / now)
+//   res      : raw | 1m | 1h | auto (default: finest tier that reaches `from`)
+//
+// The response's "res" is the spacing of the rows in seconds: 60 or 3600,
+// or for raw the mean gap between the reads in range (2-30 s, as adaptive
+// sampling backs off).
+//
+// Rows are copied out of the store a few at a time and written through one
+// small fixed buffer with chunked transfer encoding, so the response is never
+// built in memory as a whole.
+//   raw rows : [ts, temp, hum, dew]
+//   1m/1h    : [ts, temp_avg, hum_avg, temp_low, temp_high, hum_low, hum_high, dew_avg]
+//
+// The dew point is not stored: each row's is derived from its temperature
+// and humidity (the averages, for 1m/1h) as it is written out, −999 when
+// below the table.
+// ──────────────────────────────────────────────────────────────────────────────
+static void handleHistory() {
+  RouteTimer timer(ROUTE_HISTORY);
+  char arg[16];
+  uint32_t from = halHttpArg("from", arg, sizeof(arg)) ? strtoul(arg, nullptr, 10) : 0;
+  uint32_t to   = halHttpArg("to",   arg, sizeof(arg)) ? strtoul(arg, nullptr, 10) : UINT32_MAX;
+
+  HistTier tier;
+  if (!halHttpArg("res", arg, sizeof(arg))) arg[0] = '\0';
+  if      (strcmp(arg, "raw") == 0) tier = HIST_RAW;
+  else if (strcmp(arg, "1m")  == 0) tier = HIST_MINUTE;
+  else if (strcmp(arg, "1h")  == 0) tier = HIST_HOUR;
+  else if (arg[0] == '\0' || strcmp(arg, "auto") == 0) {
+    halHistoryLock();
+    tier = history.tierFor(from);
+    halHistoryUnlock();
+  }
+  else {
+    static const char err[] = "{\"error\":\"res must be raw, 1m, 1h or auto\"}";
+    halHttpSend(400, "application/json", err, sizeof(err) - 1);
+    return;
+  }
+
+  halHistoryLock();
+  const uint32_t res = history.spacing(tier, from, to);
+  halHistoryUnlock();
+
+  halHttpBeginChunked(200, "application/json");
+
+  static char out[512];
+  int len = snprintf(out, sizeof(out), "{\"res\":%lu,\"samples\":[", (unsigned long) res);
+
+  HistCursor cur;
+  HistAggregate rows[16];
+  bool first = true;
+  for (;;) {
+    // Hold the lock only while copying rows out, never across a socket write
+    halHistoryLock();
+    size_t n = history.read(tier, from, to, cur, rows, 16);
+    halHistoryUnlock();
+    if (n == 0) break;
+
+    for (size_t i = 0; i < n; i++) {
+      const HistAggregate& a = rows[i];
+      if (sizeof(out) - len < 112) {
+        halHttpChunk(out, len);
+        len = 0;
+      }
+      const float dew = dewPointF(deriveAir(a.tAvg, a.hAvg));
+      if (tier == HIST_RAW) {
+        len += snprintf(out + len, sizeof(out) - len, "%s[%lu,%.1f,%.1f,%.1f]",
+                        first ? "" : ",", (unsigned long) a.ts,
+                        a.tAvg / 10.0, a.hAvg / 10.0, isnan(dew) ? -999.0 : dew);
+      } else {
+        len += snprintf(out + len, sizeof(out) - len,
+                        "%s[%lu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f]",
+                        first ? "" : ",", (unsigned long) a.ts,
+                        a.tAvg / 10.0, a.hAvg / 10.0,
+                        a.tMin / 10.0, a.tMax / 10.0,
+                        a.hMin / 10.0, a.hMax / 10.0, isnan(dew) ? -999.0 : dew);
+      }
+      first = false;
+    }
+  }
+  len += snprintf(out + len, sizeof(out) - len, "]}");
+  halHttpChunk(out, len);
+  halHttpEndChunked();
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2c) handleEvents() → subscribe to the /events Server-Sent Events stream
+//
+// The connection is detached from the server and kept as a raw stream; the
+// response header is written by hand (no Content-Length, no chunking).
+// Returns 503 when every stream slot is taken, which makes the page fall back
+// to polling /sensor-data.
+// ──────────────────────────────────────────────────────────────────────────────
+static void handleEvents() {
+  RouteTimer timer(ROUTE_EVENTS);
+  int slot = -1;
+  for (int i = 0; i < HAL_MAX_STREAMS; i++) {
+    if (sseStreams[i] >= 0 && !halStreamOpen(sseStreams[i])) {
+      halStreamClose(sseStreams[i]);
+      sseStreams[i] = -1;
+    }
+    if (sseStreams[i] < 0 && slot < 0) slot = i;
+  }
+  int id = slot < 0 ? -1 : halHttpDetach();
+  if (id < 0) {
+    metrics.sseRejected.inc();
+    static const char busy[] = "Too many event subscribers\n";
+    halHttpSend(503, "text/plain", busy, sizeof(busy) - 1);
+    return;
+  }
+
+  static char buf[sizeof(sensorJson) + 160];   // web task only; too big for its stack
+  int len = snprintf(buf, sizeof(buf),
+                     "HTTP/1.1 200 OK\r\n"
+                     "Content-Type: text/event-stream\r\n"
+                     "Cache-Control: no-cache\r\n"
+                     "Connection: keep-alive\r\n"
+                     "\r\n"
+                     "retry: 3000\n"
+                     "data: %.*s\n\n",
+                     (int) sensorJsonLen, sensorJson);
+  if (!halStreamWrite(id, buf, len)) {
+    halStreamClose(id);
+    return;
+  }
+  sseStreams[slot] = id;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2d) pushSensorEvent() → send the freshly rendered payload to every
+//     subscriber. A short write means the peer is gone or stuck; drop it.
+// ──────────────────────────────────────────────────────────────────────────────
+static void pushSensorEvent() {
+  static char buf[sizeof(sensorJson) + 16];    // web task only; too big for its stack
+  int len = snprintf(buf, sizeof(buf), "data: %.*s\n\n",
+                     (int) sensorJsonLen, sensorJson);
+  for (int i = 0; i < HAL_MAX_STREAMS; i++) {
+    if (sseStreams[i] < 0) continue;
+    if (!halStreamWrite(sseStreams[i], buf, len)) {
+      halStreamClose(sseStreams[i]);
+      sseStreams[i] = -1;
+    }
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2e) handleMetrics() → runtime health in the Prometheus text format
+//
+// Written through one fixed buffer with chunked encoding, like /history.
+// The other tasks keep updating the metrics during a scrape; relaxed loads
+// may leave it a few observations behind, never corrupt.
+// ──────────────────────────────────────────────────────────────────────────────
+static const char* const ROUTE_PATH[ROUTE_COUNT] = {
+  "/", "/sensor-data", "/history", "/events", "/metrics", "/export", "/trend", "/trace"
+};
+
+static char   metricsOut[512];
+static size_t metricsLen = 0;
+
+static void metricsLine(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+static void metricsLine(const char* fmt, ...) {
+  // Format into what's left of the buffer; if it doesn't fit, flush and retry
+  for (int attempt = 0; attempt < 2; attempt++) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(metricsOut + metricsLen, sizeof(metricsOut) - metricsLen, fmt, ap);
+    va_end(ap);
+    if (n < 0) return;
+    if ((size_t) n < sizeof(metricsOut) - metricsLen) {
+      metricsLen += n;
+      return;
+    }
+    if (metricsLen == 0) {                    // longer than the whole buffer
+      metricsLen = sizeof(metricsOut) - 1;
+      return;
+    }
+    halHttpChunk(metricsOut, metricsLen);
+    metricsLen = 0;
+  }
+}
+
+static void metricsHeader(const char* name, const char* type, const char* help) {
+  metricsLine("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+// `label` is one `key="value"` pair
+static void metricsHistogram(const char* name, const char* label, const MetricHistogram& h) {
+  // `label` may be null for an unlabelled series
+  char sel[48] = "";
+  if (label) snprintf(sel, sizeof(sel), "{%s}", label);
+  uint32_t cumulative = 0;
+  for (size_t i = 0; i <= METRIC_BUCKETS; i++) {
+    cumulative += h.bucket(i);
+    metricsLine("%s_bucket{%s%sle=\"%s\"} %lu\n", name, label ? label : "", label ? "," : "",
+                i < METRIC_BUCKETS ? METRIC_BUCKET_LE[i] : "+Inf", (unsigned long) cumulative);
+  }
+  metricsLine("%s_sum%s %.6f\n", name, sel, h.sumUs() / 1e6);
+  metricsLine("%s_count%s %lu\n", name, sel, (unsigned long) cumulative);
+}
+
+static uint32_t histogramCount(const MetricHistogram& h) {
+  uint32_t n = 0;
+  for (size_t i = 0; i <= METRIC_BUCKETS; i++) n += h.bucket(i);
+  return n;
+}
+
+static void handleMetrics() {
+  RouteTimer timer(ROUTE_METRICS);
+  halHttpBeginChunked(200, "text/plain; version=0.0.4");
+  metricsLen = 0;
+
+  metricsHeader("potato_uptime_seconds", "gauge", "Seconds since boot.");
+  metricsLine("potato_uptime_seconds %lu\n", (unsigned long)(halMillis() / 1000));
+
+  HalHeapInfo heap;
+  halHeapInfo(&heap);
+  metricsHeader("potato_heap_free_bytes", "gauge", "Free heap.");
+  metricsLine("potato_heap_free_bytes %lu\n", (unsigned long) heap.freeBytes);
+  metricsHeader("potato_heap_min_free_bytes", "gauge", "Lowest free heap since boot.");
+  metricsLine("potato_heap_min_free_bytes %lu\n", (unsigned long) heap.minFreeBytes);
+  metricsHeader("potato_heap_largest_free_block_bytes", "gauge",
+                "Largest allocatable block; falling while free heap holds means fragmentation.");
+  metricsLine("potato_heap_largest_free_block_bytes %lu\n", (unsigned long) heap.largestFreeBlock);
+
+  HalCpuInfo cpu;
+  halCpuInfo(&cpu);
+  metricsHeader("potato_cpu_idle_seconds_total", "counter",
+                "Time each CPU had nothing to run; rate() is the idle fraction.");
+  for (int i = 0; i < cpu.cpus; i++) {
+    metricsLine("potato_cpu_idle_seconds_total{cpu=\"%d\"} %.3f\n", i, cpu.idleUs[i] / 1e6);
+  }
+
+  HalTaskStack stacks[HAL_MAX_TASKS];
+  const size_t tasks = halTaskStacks(stacks, HAL_MAX_TASKS);
+  metricsHeader("potato_task_stack_bytes", "gauge", "Stack size of each task.");
+  for (size_t i = 0; i < tasks; i++) {
+    metricsLine("potato_task_stack_bytes{task=\"%s\"} %lu\n", stacks[i].name,
+                (unsigned long) stacks[i].sizeBytes);
+  }
+  metricsHeader("potato_task_stack_min_free_bytes", "gauge",
+                "Least stack each task has had free since it started (high-water mark).");
+  for (size_t i = 0; i < tasks; i++) {
+    metricsLine("potato_task_stack_min_free_bytes{task=\"%s\"} %lu\n", stacks[i].name,
+                (unsigned long) stacks[i].minFreeBytes);
+  }
+
+  metricsHeader("potato_step_duration_seconds", "histogram",
+                "One pass of each task step (http = one HTTP server pass, net = Wi-Fi/NTP upkeep).");
+  metricsHistogram("potato_step_duration_seconds", "step=\"sensor\"",  metrics.sensorStep);
+  metricsHistogram("potato_step_duration_seconds", "step=\"display\"", metrics.displayStep);
+  metricsHistogram("potato_step_duration_seconds", "step=\"web\"",     metrics.webStep);
+  metricsHistogram("potato_step_duration_seconds", "step=\"http\"",    metrics.httpService);
+  metricsHistogram("potato_step_duration_seconds", "step=\"net\"",     metrics.netStep);
+
+  char label[40];
+  metricsHeader("potato_http_request_duration_seconds", "histogram", "Handler time per route.");
+  for (int r = 0; r < ROUTE_COUNT; r++) {
+    snprintf(label, sizeof(label), "route=\"%s\"", ROUTE_PATH[r]);
+    metricsHistogram("potato_http_request_duration_seconds", label, metrics.route[r]);
+  }
+  metricsHeader("potato_http_requests_total", "counter", "Requests per route.");
+  for (int r = 0; r < ROUTE_COUNT; r++) {
+    metricsLine("potato_http_requests_total{route=\"%s\"} %lu\n",
+                ROUTE_PATH[r], (unsigned long) histogramCount(metrics.route[r]));
+  }
+  metricsHeader("potato_http_not_modified_total", "counter", "304 responses (ETag matched).");
+  metricsLine("potato_http_not_modified_total %lu\n", (unsigned long) metrics.notModified.value());
+
+  HalHttpInfo pool;
+  halHttpInfo(&pool);
+  metricsHeader("potato_http_connections", "gauge", "Connections held in the pool.");
+  metricsLine("potato_http_connections %u\n", (unsigned) pool.open);
+  metricsHeader("potato_http_connection_slots", "gauge", "Pool size.");
+  metricsLine("potato_http_connection_slots %u\n", (unsigned) pool.slots);
+  metricsHeader("potato_http_connections_accepted_total", "counter", "Connections given a pool slot.");
+  metricsLine("potato_http_connections_accepted_total %lu\n", (unsigned long) pool.accepted);
+  metricsHeader("potato_http_connections_rejected_total", "counter",
+                "Connections turned away with 503 because every slot was mid-request.");
+  metricsLine("potato_http_connections_rejected_total %lu\n", (unsigned long) pool.rejected);
+  metricsHeader("potato_http_connections_timed_out_total", "counter",
+                "Connections closed for a stalled request head or response.");
+  metricsLine("potato_http_connections_timed_out_total %lu\n", (unsigned long) pool.timedOut);
+  metricsHeader("potato_http_connections_evicted_total", "counter",
+                "Idle keep-alive connections closed to make room for a new one.");
+  metricsLine("potato_http_connections_evicted_total %lu\n", (unsigned long) pool.evicted);
+  metricsHeader("potato_http_keepalive_requests_total", "counter",
+                "Requests served on a connection that had already served one.");
+  metricsLine("potato_http_keepalive_requests_total %lu\n", (unsigned long) pool.reused);
+
+  int subscribers = 0;
+  for (int i = 0; i < HAL_MAX_STREAMS; i++) subscribers += sseStreams[i] >= 0;
+  metricsHeader("potato_sse_subscribers", "gauge", "Open /events streams.");
+  metricsLine("potato_sse_subscribers %d\n", subscribers);
+  metricsHeader("potato_sse_rejected_total", "counter", "/events requests refused with 503.");
+  metricsLine("potato_sse_rejected_total %lu\n", (unsigned long) metrics.sseRejected.value());
+
+  const SensorSnapshot snap = snapshot.load();
+  metricsHeader("potato_sensor_reads_total", "counter", "Finished reads per probe by outcome.");
+  for (size_t i = 0; i < snap.probes; i++) {
+    for (int st = DHT22_OK; st <= DHT22_OUT_OF_RANGE; st++) {
+      metricsLine("potato_sensor_reads_total{sensor=\"%.*s\",kind=\"%s\",result=\"%s\"} %lu\n",
+                  (int) HAL_SENSOR_NAME_MAX, halSensorInfo(i).name, SENSOR_KIND_NAME[halSensorInfo(i).kind],
+                  STATUS_NAME[st],
+                  (unsigned long) metrics.probeResults[i][st].value());
+    }
+  }
+  metricsHeader("potato_sensor_consecutive_failures", "gauge", "Failed reads since the probe's last good one.");
+  for (size_t i = 0; i < snap.probes; i++) {
+    metricsLine("potato_sensor_consecutive_failures{sensor=\"%.*s\"} %u\n",
+                (int) HAL_SENSOR_NAME_MAX, halSensorInfo(i).name, (unsigned) snap.probeFailures[i]);
+  }
+  metricsHeader("potato_sensor_last_success_age_seconds", "gauge", "Seconds since the probe's last good read.");
+  for (size_t i = 0; i < snap.probes; i++) {
+    const uint32_t lastOk = metrics.probeLastOkMs[i].value();
+    if (lastOk == 0) {
+      metricsLine("potato_sensor_last_success_age_seconds{sensor=\"%.*s\"} NaN\n",
+                  (int) HAL_SENSOR_NAME_MAX, halSensorInfo(i).name);
+    } else {
+      metricsLine("potato_sensor_last_success_age_seconds{sensor=\"%.*s\"} %.1f\n",
+                  (int) HAL_SENSOR_NAME_MAX, halSensorInfo(i).name, (halMillis() - lastOk) / 1000.0);
+    }
+  }
+  metricsHeader("potato_sensor_schedule_lateness_seconds", "histogram",
+                "How far behind its slot each read started.");
+  metricsHistogram("potato_sensor_schedule_lateness_seconds", nullptr, metrics.sensorLateness);
+  metricsHeader("potato_sensor_read_period_seconds", "gauge",
+                "Read cadence now in effect; longer while the room holds still.");
+  metricsLine("potato_sensor_read_period_seconds %.1f\n", snap.samplePeriodMs / 1000.0);
+
+  metricsHeader("potato_samples_total", "counter", "Published samples (good or failed reads).");
+  metricsLine("potato_samples_total %lu\n", (unsigned long) snap.seq);
+
+  static const char* const tierName[] = { "raw", "1m", "1h" };
+  metricsHeader("potato_history_entries", "gauge", "Entries held per history tier.");
+  halHistoryLock();
+  size_t held[3] = { history.size(HIST_RAW), history.size(HIST_MINUTE), history.size(HIST_HOUR) };
+  halHistoryUnlock();
+  for (int t = 0; t < 3; t++) {
+    metricsLine("potato_history_entries{tier=\"%s\"} %lu\n", tierName[t], (unsigned long) held[t]);
+  }
+
+  metricsHeader("potato_log_flush_duration_seconds", "histogram",
+                "Sample-log frame appends to flash (stalls the sensor step).");
+  metricsHistogram("potato_log_flush_duration_seconds", nullptr, metrics.logFlush);
+  metricsHeader("potato_log_written_bytes_total", "counter", "Bytes appended to the flash sample log.");
+  metricsLine("potato_log_written_bytes_total %lu\n", (unsigned long) metrics.logBytes.value());
+  metricsHeader("potato_log_write_errors_total", "counter", "Sample-log frames lost to a failed append.");
+  metricsLine("potato_log_write_errors_total %lu\n", (unsigned long) metrics.logWriteErrors.value());
+
+  metricsHeader("potato_uplink_batches_total", "counter", "Batch POSTs to the collector by outcome.");
+  metricsLine("potato_uplink_batches_total{result=\"ok\"} %lu\n", (unsigned long) metrics.uplinkBatches.value());
+  metricsLine("potato_uplink_batches_total{result=\"failed\"} %lu\n", (unsigned long) metrics.uplinkFailures.value());
+  metricsHeader("potato_uplink_sent_bytes_total", "counter", "Bytes of batches the collector accepted.");
+  metricsLine("potato_uplink_sent_bytes_total %lu\n", (unsigned long) metrics.uplinkBytes.value());
+  metricsHeader("potato_uplink_post_duration_seconds", "histogram", "One batch POST, answered or not.");
+  metricsHistogram("potato_uplink_post_duration_seconds", nullptr, metrics.uplinkPost);
+  const uint32_t acked = metrics.uplinkAckedTs.value();
+  const time_t   now   = halTime();
+  metricsHeader("potato_uplink_lag_seconds", "gauge", "Age of the newest sample the collector has confirmed.");
+  if (acked == 0 || now < UNIX_TIME_VALID) metricsLine("potato_uplink_lag_seconds NaN\n");
+  else metricsLine("potato_uplink_lag_seconds %ld\n", (long)(now - (time_t) acked));
+
+  metricsHeader("potato_alert_firing", "gauge", "1 while the alert rule is firing.");
+  for (size_t i = 0; i < alerts.count(); i++) {
+    metricsLine("potato_alert_firing{rule=\"%s\"} %u\n", ALERT_RULES[i].name, (unsigned)(snap.alerts >> i & 1));
+  }
+  metricsHeader("potato_alerts_raised_total", "counter", "Times each alert rule started firing.");
+  for (size_t i = 0; i < alerts.count(); i++) {
+    metricsLine("potato_alerts_raised_total{rule=\"%s\"} %lu\n",
+                ALERT_RULES[i].name, (unsigned long) metrics.alertsRaised[i].value());
+  }
+  metricsHeader("potato_alert_webhook_posts_total", "counter", "Webhook POSTs by outcome.");
+  metricsLine("potato_alert_webhook_posts_total{result=\"ok\"} %lu\n", (unsigned long) metrics.alertDeliveries.value());
+  metricsLine("potato_alert_webhook_posts_total{result=\"failed\"} %lu\n", (unsigned long) metrics.alertFailures.value());
+  metricsHeader("potato_alert_webhook_post_duration_seconds", "histogram", "One webhook POST, answered or not.");
+  metricsHistogram("potato_alert_webhook_post_duration_seconds", nullptr, metrics.alertPost);
+  metricsHeader("potato_alert_events_queued", "gauge", "Alert transitions waiting for the webhook.");
+  metricsLine("potato_alert_events_queued %lu\n", (unsigned long) alertQueue.size());
+  metricsHeader("potato_alert_events_dropped_total", "counter", "Alert transitions lost to a full queue.");
+  metricsLine("potato_alert_events_dropped_total %lu\n", (unsigned long) metrics.alertsDropped.value());
+
+  halHttpChunk(metricsOut, metricsLen);
+  halHttpEndChunked();
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2f) handleExport() → stream stored samples in bulk
+//
+//   /export?from=&to=&format=bin|csv
+//
+// Samples come from the flash log frame by frame, then the newest ones not
+// yet flushed from the RAW history tier, through one fixed buffer; nothing
+// grows with the range. `bin` is a 16-byte header followed by sample-log
+// frames verbatim (see sample_log.h, tools/export_decode.py). Frames are
+// whole, so a binary client drops the few samples outside [from, to]
+// itself; `csv` is decoded and filtered here.
+// ──────────────────────────────────────────────────────────────────────────────
+struct ExportHeader {
+  char     magic[4];          // "PEX1"
+  uint8_t  version;           // 1
+  uint8_t  headerLen;         // sizeof(ExportHeader)
+  uint16_t frameHeaderLen;    // sizeof(LogFrameHeader)
+  uint32_t from, to;          // requested range, UNIX seconds
+};
+
+static LogScanner      exportScan;
+static LogFrameBuilder exportTail;
+static uint8_t  exportPayload[LOG_PAYLOAD_MAX];
+static uint8_t  exportOut[1024];
+static size_t   exportLen  = 0;
+static bool     exportCsv  = false;
+static uint32_t exportFrom = 0, exportTo = 0;
+
+static void exportWrite(const void* data, size_t len) {
+  if (exportLen + len > sizeof(exportOut)) {
+    halHttpChunk(exportOut, exportLen);
+    exportLen = 0;
+  }
+  memcpy(exportOut + exportLen, data, len);
+  exportLen += len;
+}
+
+static char* putUnsigned(char* p, uint32_t v) {
+  char digits[10];
+  int n = 0;
+  do { digits[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+  while (n) *p++ = digits[--n];
+  return p;
+}
+
+static char* putTenths(char* p, int32_t v) {
+  if (v < 0) { *p++ = '-'; v = -v; }
+  p = putUnsigned(p, (uint32_t) v / 10);
+  *p++ = '.';
+  *p++ = (char)('0' + v % 10);
+  return p;
+}
+
+// One "ts,temp_f,humidity" row; snprintf("%.1f") would dominate the export
+static void exportCsvRow(const HistSample& s) {
+  if (s.ts < exportFrom || s.ts > exportTo) return;
+  char row[32];
+  char* p = putUnsigned(row, s.ts);
+  *p++ = ',';
+  p = putTenths(p, s.t10);
+  *p++ = ',';
+  p = putTenths(p, s.h10);
+  *p++ = '\n';
+  exportWrite(row, p - row);
+}
+
+static void exportFrame(const LogFrameHeader& h, const uint8_t* payload) {
+  if (h.lastTs < exportFrom || h.firstTs > exportTo) return;
+  if (exportCsv) {
+    logDecodeFrame(h, payload, exportCsvRow);
+    return;
+  }
+  exportWrite(&h, sizeof(h));
+  exportWrite(payload, h.len);
+}
+
+static void exportTailFrame() {
+  exportTail.finish(0);
+  LogFrameHeader h;
+  memcpy(&h, exportTail.data(), sizeof(h));
+  exportFrame(h, exportTail.data() + sizeof(h));
+}
+
+static void handleExport() {
+  RouteTimer timer(ROUTE_EXPORT);
+  char arg[16];
+  exportFrom = halHttpArg("from", arg, sizeof(arg)) ? strtoul(arg, nullptr, 10) : 0;
+  exportTo   = halHttpArg("to",   arg, sizeof(arg)) ? strtoul(arg, nullptr, 10) : UINT32_MAX;
+  if (!halHttpArg("format", arg, sizeof(arg))) strcpy(arg, "bin");
+  if      (strcmp(arg, "bin") == 0) exportCsv = false;
+  else if (strcmp(arg, "csv") == 0) exportCsv = true;
+  else {
+    static const char err[] = "{\"error\":\"format must be bin or csv\"}";
+    halHttpSend(400, "application/json", err, sizeof(err) - 1);
+    return;
+  }
+
+  halHttpSendHeader("Content-Disposition", exportCsv ? "attachment; filename=\"potato-export.csv\""
+                                                     : "attachment; filename=\"potato-export.bin\"");
+  halHttpBeginChunked(200, exportCsv ? "text/csv" : "application/octet-stream");
+  exportLen = 0;
+  if (exportCsv) {
+    static const char head[] = "timestamp,temperature_f,humidity\n";
+    exportWrite(head, sizeof(head) - 1);
+  } else {
+    const ExportHeader head = { { 'P', 'E', 'X', '1' }, 1, sizeof(ExportHeader),
+                                sizeof(LogFrameHeader), exportFrom, exportTo };
+    exportWrite(&head, sizeof(head));
+  }
+
+  // — Everything already in flash. Frames flushed after this point are
+  //   left to the RAM pass, so no sample is sent twice.
+  const uint32_t flushed = sampleLog.flushedTs();
+  LogFrameHeader h;
+  exportScan.open();
+  while (flushed != 0 && exportScan.next(&h, exportPayload)) {
+    if (h.lastTs > flushed) break;
+    exportFrame(h, exportPayload);
+  }
+
+  // — The rest from the RAW tier, framed the same way
+  const uint32_t tailFrom = max(exportFrom, flushed + (flushed != 0));
+  HistCursor cur;
+  HistAggregate rows[16];
+  for (;;) {
+    halHistoryLock();
+    size_t n = history.read(HIST_RAW, tailFrom, exportTo, cur, rows, 16);
+    halHistoryUnlock();
+    if (n == 0) break;
+    for (size_t i = 0; i < n; i++) {
+      const HistSample s = { rows[i].ts, rows[i].tAvg, rows[i].hAvg };
+      if (exportTail.full(s)) exportTailFrame();
+      exportTail.add(s);
+    }
+  }
+  if (exportTail.count() > 0) exportTailFrame();
+
+  if (exportLen > 0) halHttpChunk(exportOut, exportLen);
+  halHttpEndChunked();
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2g) handleTrend() → at most `points` samples per series over the last
+//     `window`, picked by LTTB (lttb.h) for the dashboard chart
+//
+//   /trend?window=&points=
+//   window : 1h, 24h, 7d… (s/m/h/d suffix or plain seconds; default 24h,
+//            at most 30d)
+//   points : 16–500 per series (default 200)
+//
+// One streaming pass: rows are copied out of the store a few at a time and
+// fed through the LTTB, and temperature picks are written out as soon as
+// they are decided. Humidity picks wait in a fixed array until temperature
+// is done. The tier is the finest one that doesn't mean scanning more than
+// TREND_SCAN_FACTOR × points rows, unless the next coarser one has fewer
+// than `points` to give, so time and payload follow `points`, not the window.
+//
+//   {"from":…,"to":…,"res":60,"samples":1440,
+//    "temperature":[[ts,temp],…],"humidity":[[ts,hum],…]}
+// ──────────────────────────────────────────────────────────────────────────────
+static const size_t   TREND_MIN_POINTS   = 16;
+static const size_t   TREND_MAX_POINTS   = 500;
+static const size_t   TREND_SCAN_FACTOR  = 8;
+static const uint32_t TREND_MAX_WINDOW_S = 30 * 86400;
+// Two of the widest buckets any tier can produce at TREND_MIN_POINTS
+static const size_t   TREND_BUFFER =
+    2 * ((HIST_RAW_CAPACITY - 2 + TREND_MIN_POINTS - 3) / (TREND_MIN_POINTS - 2));
+
+typedef LttbStream<TREND_BUFFER, 2> TrendLttb;
+static TrendLttb        trendLttb;
+static TrendLttb::Point trendHum[TREND_MAX_POINTS];
+static size_t           trendHumCount = 0;
+static char             trendOut[512];
+static size_t           trendLen = 0;
+static bool             trendFirst = true;
+
+// "24h" → 86400; false if malformed, zero or longer than the longest tier
+static bool parseSpan(const char* s, uint32_t* out) {
+  char* end;
+  const unsigned long v = strtoul(s, &end, 10);
+  uint32_t unit = 1;
+  if (end == s) return false;
+  switch (*end) {
+    case '\0': case 's': break;
+    case 'm': unit = 60;    break;
+    case 'h': unit = 3600;  break;
+    case 'd': unit = 86400; break;
+    default:  return false;
+  }
+  if ((*end && end[1]) || v == 0 || v > TREND_MAX_WINDOW_S / unit) return false;
+  *out = (uint32_t) v * unit;
+  return true;
+}
+
+// "[ts,value]" for one kept point
+static void trendPoint(const TrendLttb::Point& p, size_t channel) {
+  if (sizeof(trendOut) - trendLen < 32) {
+    halHttpChunk(trendOut, trendLen);
+    trendLen = 0;
+  }
+  char* o = trendOut + trendLen;
+  if (!trendFirst) *o++ = ',';
+  *o++ = '[';
+  o = putUnsigned(o, p.x);
+  *o++ = ',';
+  o = putTenths(o, p.y[channel]);
+  *o++ = ']';
+  trendLen   = o - trendOut;
+  trendFirst = false;
+}
+
+static void trendEmit(size_t channel, const TrendLttb::Point& p) {
+  if (channel == 0)                        trendPoint(p, 0);
+  else if (trendHumCount < TREND_MAX_POINTS) trendHum[trendHumCount++] = p;
+}
+
+static void handleTrend() {
+  RouteTimer timer(ROUTE_TREND);
+  char arg[16];
+  uint32_t window = 86400;
+  size_t   points = 200;
+  if (halHttpArg("window", arg, sizeof(arg)) && !parseSpan(arg, &window)) {
+    static const char err[] = "{\"error\":\"window must be like 90m, 24h or 7d, at most 30d\"}";
+    halHttpSend(400, "application/json", err, sizeof(err) - 1);
+    return;
+  }
+  if (halHttpArg("points", arg, sizeof(arg))) {
+    points = strtoul(arg, nullptr, 10);
+    if (points < TREND_MIN_POINTS || points > TREND_MAX_POINTS) {
+      static const char err[] = "{\"error\":\"points must be 16-500\"}";
+      halHttpSend(400, "application/json", err, sizeof(err) - 1);
+      return;
+    }
+  }
+  const uint32_t to   = storeTimestamp();
+  const uint32_t from = to > window ? to - window : 0;
+
+  // Coarser while this tier misses more than one coarser bucket of the
+  // window and the coarser one holds it, or while this tier would mean a
+  // long scan and the coarser one still has `points` rows
+  halHistoryLock();
+  HistTier tier = HIST_RAW;
+  size_t   n    = history.count(tier, from, to);
+  while (tier != HIST_HOUR) {
+    const HistTier coarser = (HistTier)(tier + 1);
+    const uint32_t period  = HistoryStore::periodOf(coarser);
+    const size_t   m       = history.count(coarser, from, to);
+    const bool reachesFurther = m > 0 && (n == 0 || (history.oldest(tier) > from + period &&
+        history.oldest(coarser) + period < history.oldest(tier)));
+    if (!reachesFurther && !(n > TREND_SCAN_FACTOR * points && m >= points)) break;
+    tier = coarser;
+    n    = m;
+  }
+  const uint32_t res = history.spacing(tier, from, to);
+  halHistoryUnlock();
+  trendLttb.begin(n, points);
+
+  halHttpBeginChunked(200, "application/json");
+  trendLen = snprintf(trendOut, sizeof(trendOut),
+                      "{\"from\":%lu,\"to\":%lu,\"res\":%lu,\"samples\":%u,\"temperature\":[",
+                      (unsigned long) from, (unsigned long) to,
+                      (unsigned long) res, (unsigned) n);
+  trendFirst    = true;
+  trendHumCount = 0;
+
+  HistCursor cur;
+  HistAggregate rows[16];
+  for (;;) {
+    halHistoryLock();
+    const size_t got = history.read(tier, from, to, cur, rows, 16);
+    halHistoryUnlock();
+    if (got == 0) break;
+    for (size_t i = 0; i < got; i++) {
+      const TrendLttb::Point p = { rows[i].ts, { rows[i].tAvg, (int16_t) rows[i].hAvg } };
+      trendLttb.add(p, trendEmit);
+    }
+  }
+  trendLttb.finish(trendEmit);
+
+  if (sizeof(trendOut) - trendLen < 16) {
+    halHttpChunk(trendOut, trendLen);
+    trendLen = 0;
+  }
+  trendLen  += snprintf(trendOut + trendLen, sizeof(trendOut) - trendLen, "],\"humidity\":[");
+  trendFirst = true;
+  for (size_t i = 0; i < trendHumCount; i++) trendPoint(trendHum[i], 1);
+  if (sizeof(trendOut) - trendLen < 4) {
+    halHttpChunk(trendOut, trendLen);
+    trendLen = 0;
+  }
+  trendLen += snprintf(trendOut + trendLen, sizeof(trendOut) - trendLen, "]}");
+  halHttpChunk(trendOut, trendLen);
+  halHttpEndChunked();
+}
+
+#if POTATO_TRACE
+// ──────────────────────────────────────────────────────────────────────────────
+// 2h) handleTrace() → the trace rings (trace.h) as Chrome trace-event JSON,
+//     for ui.perfetto.dev or chrome://tracing
+//
+//   /trace
+//
+// Each CPU is one thread ("cpu 0", "cpu 1"). A TraceCursor walks its ring
+// oldest-first straight into one fixed buffer sent with chunked encoding,
+// like /export; nothing is copied out of the rings first. Recording goes on
+// meanwhile: events overwritten before the walk reaches them are skipped
+// and counted in "overwritten", and this request's own span is still open.
+//
+//   {"traceEvents":[…,{"ph":"B","pid":1,"tid":1,"ts":5123.456,
+//     "name":"display_step","cat":"display"},…],"displayTimeUnit":"ms",
+//    "otherData":{"cycles_per_us":240,"overwritten":18211}}
+// ──────────────────────────────────────────────────────────────────────────────
+static TraceCursor traceCursor;
+static char        traceOut[512];
+static size_t      traceLen = 0;
+
+static void traceWrite(const char* data, size_t len) {
+  if (traceLen + len > sizeof(traceOut)) {
+    halHttpChunk(traceOut, traceLen);
+    traceLen = 0;
+  }
+  memcpy(traceOut + traceLen, data, len);
+  traceLen += len;
+}
+
+static char* putUnsigned64(char* p, uint64_t v) {
+  char digits[20];
+  int n = 0;
+  do { digits[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+  while (n) *p++ = digits[--n];
+  return p;
+}
+
+static void handleTrace() {
+  RouteTimer timer(ROUTE_TRACE);
+  const uint32_t cyclesPerUs = halCyclesPerUs();
+  uint32_t overwritten = 0;
+  char line[192];
+
+  halHttpBeginChunked(200, "application/json");
+  traceLen = 0;
+  static const char head[] =
+    "{\"traceEvents\":[\n{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"potato\"}}";
+  traceWrite(head, sizeof(head) - 1);
+
+  for (int cpu = 0; cpu < HAL_MAX_CPUS; cpu++) {
+    traceCursor.begin(tracer.ring(cpu), cyclesPerUs);
+    overwritten += traceCursor.lost();
+    if (traceCursor.empty()) continue;
+    int n = snprintf(line, sizeof(line),
+                     ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"cpu %d\"}}",
+                     cpu, cpu);
+    traceWrite(line, n);
+
+    const uint32_t before = traceCursor.lost();
+    TraceEvent e;
+    uint64_t   ns;
+    while (traceCursor.next(&e, &ns)) {
+      // "ts" in µs with three decimals
+      char ts[28];
+      char* t = putUnsigned64(ts, ns / 1000);
+      const unsigned frac = (unsigned)(ns % 1000);
+      *t++ = '.';
+      *t++ = (char)('0' + frac / 100);
+      *t++ = (char)('0' + frac / 10 % 10);
+      *t++ = (char)('0' + frac % 10);
+      *t   = '\0';
+
+      const TraceNameInfo& info = TRACE_NAME_INFO[e.name];
+      n = snprintf(line, sizeof(line), ",\n{\"ph\":\"%c\",%s\"pid\":1,\"tid\":%d,\"ts\":%s,\"name\":\"%s\",\"cat\":\"%s\"",
+                   (char) e.phase, e.phase == TRACE_PHASE_INSTANT ? "\"s\":\"t\"," : "", cpu, ts,
+                   info.name, info.category);
+      if (info.arg && e.phase != TRACE_PHASE_END) {
+        n += snprintf(line + n, sizeof(line) - n, ",\"args\":{\"%s\":%u}", info.arg, (unsigned) e.arg);
+      }
+      line[n++] = '}';
+      traceWrite(line, n);
+    }
+    overwritten += traceCursor.lost() - before;
+  }
+
+  const int n = snprintf(line, sizeof(line),
+                         "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"cycles_per_us\":%lu,\"overwritten\":%lu}}",
+                         (unsigned long) cyclesPerUs, (unsigned long) overwritten);
+  traceWrite(line, n);
+  halHttpChunk(traceOut, traceLen);
+  halHttpEndChunked();
+}
+#endif
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3) drawReadings(offsetX, offsetY) → bring the OLED in line with lineStr[]
+//
+// Only the first call clears the panel. After that, each line is compared
+// with what drawnStr[] says is on screen:
+//   • same position → re-blit each run of 12×16 cells whose characters
+//                     changed
+//   • moved         → blit the whole line at its new spot, then black out
+//                     what's left of the old one (burn-in shift, or the
+//                     centred width changed)
+//   • unchanged     → no SPI traffic at all
+// Lines are handled top to bottom, so a shift must stay under the 8 px gap
+// between them: erasing one line's old spot must not reach the line above.
+// Text goes out as opaque atlas cells (glyph_atlas.h), one address window
+// per run instead of one per lit font pixel, so a changed digit costs one
+// window and 384 pixel bytes. Cheap enough to call after every sample.
+// ──────────────────────────────────────────────────────────────────────────────
+static uint16_t blitBuf[SCREEN_WIDTH * CHAR_HEIGHT];   // one on-screen run of cells
+
+// Cells [first, first + count) of a line starting at x, clipped to the
+// screen's width, as one blit. Cells past the text are blank.
+static void blitCells(int16_t x, int16_t y, const char* text, int len, int first, int count,
+                      uint16_t color) {
+  const int x0 = max(x + first * CHAR_WIDTH, 0);
+  const int x1 = min(x + (first + count) * CHAR_WIDTH, SCREEN_WIDTH);
+  if (x0 >= x1) return;
+  glyphAtlasRender(text, len, x0 - x, x1 - x0, color, COLOR_BLACK, blitBuf);
+  halDisplayBlit(x0, y, x1 - x0, CHAR_HEIGHT, blitBuf);
+}
+
+// Black out the part of rectangle a that rectangle b doesn't cover (at most
+// four strips; a 1 px burn-in shift leaves one or two thin ones)
+static void eraseOutside(int ax, int ay, int aw, int ah, int bx, int by, int bw, int bh) {
+  const int ix0 = max(ax, bx), ix1 = min(ax + aw, bx + bw);
+  const int iy0 = max(ay, by), iy1 = min(ay + ah, by + bh);
+  if (ix0 >= ix1 || iy0 >= iy1) {
+    halDisplayFillRect(ax, ay, aw, ah, COLOR_BLACK);
+    return;
+  }
+  if (iy0 > ay)      halDisplayFillRect(ax, ay, aw, iy0 - ay, COLOR_BLACK);
+  if (iy1 < ay + ah) halDisplayFillRect(ax, iy1, aw, ay + ah - iy1, COLOR_BLACK);
+  if (ix0 > ax)      halDisplayFillRect(ax, iy0, ix0 - ax, iy1 - iy0, COLOR_BLACK);
+  if (ix1 < ax + aw) halDisplayFillRect(ix1, iy0, ax + aw - ix1, iy1 - iy0, COLOR_BLACK);
+}
+
+static void drawReadings(int16_t offsetX, int16_t offsetY) {
+  TRACE_SCOPE_ARG(TRACE_DRAW_READINGS, shownPage);
+  static const uint16_t lineColor[4] = { COLOR_RED, COLOR_RED, COLOR_BLUE, COLOR_BLUE };
+
+  // Total height: 4 lines × 16px + 3 gaps × 8px = 88px
+  const int totalBlockH = 4 * CHAR_HEIGHT + 3 * 8;
+  const int yStart = (SCREEN_HEIGHT - totalBlockH) / 2; // = 20px
+
+  if (!oledDrawn) {
+    halDisplayFillScreen(COLOR_BLACK);
+    for (int i = 0; i < 4; i++) drawnStr[i][0] = '\0';
+  }
+
+  for (int i = 0; i < 4; i++) {
+    const char* text = lineStr[i];
+    const int   len  = strlen(text);
+    const int16_t x = (SCREEN_WIDTH - len * CHAR_WIDTH) / 2 + offsetX;
+    const int16_t y = yStart + i * (CHAR_HEIGHT + 8) + offsetY;
+    const uint16_t color = lineColor[i];
+
+    const int oldLen = strlen(drawnStr[i]);
+    if (!oledDrawn || x != drawnX[i] || y != drawnY[i]) {
+      // Moved: the new line in one blit, then whatever it doesn't cover
+      blitCells(x, y, text, len, 0, len, color);
+      if (oldLen > 0) {
+        eraseOutside(drawnX[i], drawnY[i], oldLen * CHAR_WIDTH, CHAR_HEIGHT,
+                     x, y, len * CHAR_WIDTH, CHAR_HEIGHT);
+      }
+    } else {
+      // Same place: one blit per run of cells whose character differs
+      const int span = max(len, oldLen);
+      for (int c = 0; c < span; c++) {
+        int end = c;
+        while (end < span && (end < len ? text[end] : ' ') != (end < oldLen ? drawnStr[i][end] : ' ')) {
+          end++;
+        }
+        if (end > c) blitCells(x, y, text, len, c, end - c, color);
+        c = end;
+      }
+    }
+
+    memcpy(drawnStr[i], text, len + 1);
+    drawnX[i] = x;
+    drawnY[i] = y;
+  }
+  oledDrawn = true;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 4) appUplinkStep() → store-and-forward batches to the collector
+//
+// The queue is the data the unit keeps anyway: flash-log frames past the
+// collector's position, then the RAW history tier for what isn't flushed
+// yet. The only state of its own is that position, uplinkAcked (the newest
+// sample the collector confirmed). An outage is bridged for as far back as
+// the log reaches (≈2 weeks), or the RAW tier's hour without flash.
+//
+// A batch is an /export?format=bin stream over (uplinkAcked, uplinkTo]: the
+// 16-byte header and whole sample-log frames, at most UPLINK_BATCH_MAX
+// bytes, so tools/export_decode.py reads it as is. Only a 2xx answer moves
+// uplinkAcked; anything else resends the same batch after an exponential
+// backoff (5 s → 5 min). Delivery is at least once: a lost answer, or a
+// reboot before the position was saved, sends samples again, and the
+// collector drops timestamps it already has (tools/collector.py).
+//
+// Caught up, one small batch goes out per UPLINK_PERIOD_MS, which keeps the
+// radio idle between POSTs; behind, full batches go back to back. Nothing
+// is sent before NTP syncs, while stamps are still provisional. The
+// position is appended to /uplink.ack every UPLINK_ACK_SAVE_S of progress.
+// ──────────────────────────────────────────────────────────────────────────────
+static const size_t   UPLINK_BATCH_MAX    = 4096;
+static const uint32_t UPLINK_PERIOD_MS    = 60000;
+static const uint32_t UPLINK_TIMEOUT_MS   = 10000;
+static const uint32_t UPLINK_RETRY_MIN_MS = 5000;
+static const uint32_t UPLINK_RETRY_MAX_MS = 300000;
+static const uint32_t UPLINK_ACK_SAVE_S   = 600;
+static const size_t   UPLINK_ACK_FILE_MAX = 4096;
+static const char     UPLINK_ACK_PATH[]   = "/uplink.ack";
+
+// The scanner stays open between batches, so draining a backlog reads the
+// log once; uplinkHead is the frame it returned that didn't fit yet
+static LogScanner      uplinkScan;
+static bool            uplinkScanning  = false;
+static LogFrameHeader  uplinkHead;
+static uint8_t         uplinkPayload[LOG_PAYLOAD_MAX];
+static bool            uplinkHaveFrame = false;
+static LogFrameBuilder uplinkTail;
+
+static uint8_t  uplinkBody[UPLINK_BATCH_MAX];
+static size_t   uplinkLen     = 0;        // batch awaiting a 2xx (0 = none built)
+static uint32_t uplinkTo      = 0;        // its newest sample
+static bool     uplinkMore    = false;    // it filled up before the queue ran out
+static uint32_t uplinkAcked   = 0;
+static uint32_t uplinkSaved   = 0;        // uplinkAcked as last written to flash
+static uint32_t uplinkRetryMs = 0;        // current backoff (0 = last POST succeeded)
+
+static bool uplinkPut(const LogFrameHeader& h, const uint8_t* payload) {
+  if (uplinkLen + sizeof(h) + h.len > sizeof(uplinkBody)) return false;
+  memcpy(uplinkBody + uplinkLen, &h, sizeof(h));
+  memcpy(uplinkBody + uplinkLen + sizeof(h), payload, h.len);
+  uplinkLen += sizeof(h) + h.len;
+  uplinkTo   = h.lastTs;
+  return true;
+}
+
+static bool uplinkPutTail() {
+  uplinkTail.finish(0);
+  LogFrameHeader h;
+  memcpy(&h, uplinkTail.data(), sizeof(h));
+  return uplinkPut(h, uplinkTail.data() + sizeof(h));
+}
+
+// Fill uplinkBody with what follows uplinkAcked. False if nothing does.
+static bool uplinkBuild() {
+  const uint32_t from = uplinkAcked + 1;
+  uplinkLen  = sizeof(ExportHeader);
+  uplinkTo   = uplinkAcked;
+  uplinkMore = false;
+
+  // — Flash frames first. One flushed after `flushed` was read is left to
+  //   the RAM pass, as in /export.
+  const uint32_t flushed = sampleLog.flushedTs();
+  if (uplinkAcked >= flushed) {
+    uplinkScanning = false;
+  } else {
+    if (!uplinkScanning) {
+      uplinkScan.open();
+      uplinkScanning  = true;
+      uplinkHaveFrame = false;
+    }
+    for (;;) {
+      if (!uplinkHaveFrame) uplinkHaveFrame = uplinkScan.next(&uplinkHead, uplinkPayload);
+      if (!uplinkHaveFrame) {
+        uplinkScanning = false;               // reopened next time if still behind
+        break;
+      }
+      if (uplinkHead.lastTs <= uplinkAcked) { uplinkHaveFrame = false; continue; }
+      if (uplinkHead.lastTs > flushed) break;
+      if (!uplinkPut(uplinkHead, uplinkPayload)) { uplinkMore = true; break; }
+      uplinkHaveFrame = false;
+    }
+  }
+
+  // — Then the RAW tier past the log, framed the same way
+  if (!uplinkMore) {
+    HistCursor cur;
+    HistAggregate rows[16];
+    for (;;) {
+      halHistoryLock();
+      const size_t n = history.read(HIST_RAW, max(from, flushed + 1), UINT32_MAX, cur, rows, 16);
+      halHistoryUnlock();
+      if (n == 0) break;
+      for (size_t i = 0; i < n && !uplinkMore; i++) {
+        const HistSample s = { rows[i].ts, rows[i].tAvg, rows[i].hAvg };
+        if (uplinkTail.full(s) && !uplinkPutTail()) uplinkMore = true;
+        else uplinkTail.add(s);
+      }
+      if (uplinkMore) break;
+    }
+    if (uplinkTail.count() > 0 && !uplinkPutTail()) uplinkMore = true;
+  }
+
+  if (uplinkTo == uplinkAcked) {
+    uplinkLen = 0;
+    return false;
+  }
+  const ExportHeader head = { { 'P', 'E', 'X', '1' }, 1, sizeof(ExportHeader),
+                              sizeof(LogFrameHeader), from, uplinkTo };
+  memcpy(uplinkBody, &head, sizeof(head));
+  return true;
+}
+
+// /uplink.ack is a run of u32 positions; the last one counts
+static void uplinkLoadAck() {
+  uint32_t ts;
+  const size_t size = halFsSize(UPLINK_ACK_PATH);
+  if (size < sizeof(ts)) return;
+  if (halFsRead(UPLINK_ACK_PATH, (uint32_t)(size / sizeof(ts) - 1) * sizeof(ts), &ts, sizeof(ts)) != sizeof(ts)) return;
+  uplinkAcked = uplinkSaved = ts;
+  metrics.uplinkAckedTs.set(ts);
+  halLog("Uplink: collector has samples up to %lu\n", (unsigned long) ts);
+}
+
+static void uplinkSaveAck() {
+  if (!halFsMounted() || uplinkAcked == uplinkSaved) return;
+  if (halFsSize(UPLINK_ACK_PATH) + sizeof(uplinkAcked) > UPLINK_ACK_FILE_MAX) halFsRemove(UPLINK_ACK_PATH);
+  if (halFsAppend(UPLINK_ACK_PATH, &uplinkAcked, sizeof(uplinkAcked))) uplinkSaved = uplinkAcked;
+}
+
+uint32_t appUplinkStep() {
+  if (!halUplinkEnabled()) return UPLINK_PERIOD_MS;
+  if (!timeSynced) return 1000;
+  if (uplinkLen == 0 && !uplinkBuild()) return UPLINK_PERIOD_MS;
+
+  const uint32_t t0 = halPerfMicros();
+  TRACE_BEGIN(TRACE_UPLINK_POST, min<size_t>(uplinkLen, UINT16_MAX));
+  const int status = halUplinkPost(uplinkBody, uplinkLen, UPLINK_TIMEOUT_MS);
+  TRACE_END(TRACE_UPLINK_POST);
+  metrics.uplinkPost.observe(halPerfMicros() - t0);
+  if (status < 200 || status > 299) {
+    metrics.uplinkFailures.inc();
+    if (uplinkRetryMs == 0) halLog("Uplink: POST failed (%d); retrying with backoff\n", status);
+    uplinkRetryMs = uplinkRetryMs == 0 ? UPLINK_RETRY_MIN_MS : min(uplinkRetryMs * 2, UPLINK_RETRY_MAX_MS);
+    return uplinkRetryMs;
+  }
+
+  const bool recovered = uplinkRetryMs != 0;
+  if (recovered) halLog("Uplink: collector reachable again\n");
+  uplinkRetryMs = 0;
+  metrics.uplinkBatches.inc();
+  metrics.uplinkBytes.inc(uplinkLen);
+  uplinkAcked = uplinkTo;
+  metrics.uplinkAckedTs.set(uplinkAcked);
+  uplinkLen = 0;
+  if (uplinkAcked - uplinkSaved >= UPLINK_ACK_SAVE_S) uplinkSaveAck();
+
+  // A backlog (a full batch, or what queued up during an outage) goes next
+  return uplinkMore || recovered ? 0 : UPLINK_PERIOD_MS;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 5) appAlertStep() → deliver alert transitions to the webhook
+//
+// The sensor step queues each rule's change of state and wakes this step,
+// so a transition goes out within the read that caused it; the POST itself
+// blocks only the alert task. One event is sent per POST, oldest first. A
+// failed POST keeps the event at the head of the queue and retries after an
+// exponential backoff (5 s → 5 min); if the queue fills meanwhile, newer
+// transitions are dropped and counted (potato_alert_events_dropped_total).
+//
+// The body is JSON with a "text" line, so chat webhooks (Slack, Mattermost)
+// can show it as is:
+//
+//   {"text":"sprouting firing: room temperature 51.2 F (above 50.0 F)",
+//    "rule":"sprouting","state":"firing","sensor":"room","measure":"temperature",
+//    "value":51.2,"threshold":50.0,"unit":"F","time":1750000000}
+// ──────────────────────────────────────────────────────────────────────────────
+static const uint32_t ALERT_IDLE_MS      = 60000;
+static const uint32_t ALERT_TIMEOUT_MS   = 5000;
+static const uint32_t ALERT_RETRY_MIN_MS = 5000;
+static const uint32_t ALERT_RETRY_MAX_MS = 300000;
+
+static char     alertBody[512];
+static uint32_t alertRetryMs = 0;        // current backoff (0 = last POST succeeded)
+static uint32_t alertRetryAt = 0;        // halMillis() of the next attempt while backing off
+
+static size_t renderAlert(const AlertEvent& e) {
+  static const char* const KIND_WORD[] = { "above", "below", "rising", "falling", "limit" };
+  const AlertRule& r = ALERT_RULES[e.rule];
+  const bool  stale = r.kind == ALERT_STALE;
+  const bool  rate  = r.kind == ALERT_RISE || r.kind == ALERT_FALL;
+  const bool  temp  = r.quantity == ALERT_TEMP;
+  const char* measure = stale ? "read_age" : temp ? "temperature" : "humidity";
+  const char* unit    = stale ? "s" : rate ? (temp ? "F/h" : "%RH/h") : (temp ? "F" : "%RH");
+  const char* state   = e.firing ? "firing" : "cleared";
+
+  char sensor[24];
+  if (r.sensor != ALERT_ROOM) snprintf(sensor, sizeof(sensor), "%s", halSensorInfo(r.sensor).name);
+  else snprintf(sensor, sizeof(sensor), "%s", stale ? "any probe" : "room");
+
+  char limit[32] = "";
+  if (e.firing) snprintf(limit, sizeof(limit), " (%s %.1f %s)", KIND_WORD[r.kind], r.threshold, unit);
+
+  const int n = snprintf(alertBody, sizeof(alertBody),
+      "{\"text\":\"%s %s: %s %s %.1f %s%s\","
+      "\"rule\":\"%s\",\"state\":\"%s\",\"sensor\":\"%s\",\"measure\":\"%s\","
+      "\"value\":%.1f,\"threshold\":%.1f,\"unit\":\"%s\",\"time\":%lu}",
+      r.name, state, sensor, stale ? "silent for" : measure, e.value, unit, limit,
+      r.name, state, sensor, measure, e.value, r.threshold, unit, (unsigned long) e.ts);
+  return min((size_t) max(n, 0), sizeof(alertBody) - 1);
+}
+
+uint32_t appAlertStep() {
+  if (!halWebhookEnabled()) return ALERT_IDLE_MS;
+  const uint32_t now = halMillis();
+  if (alertRetryMs != 0 && (int32_t)(alertRetryAt - now) > 0) return alertRetryAt - now;
+  AlertEvent e;
+  if (!alertQueue.front(&e)) return ALERT_IDLE_MS;
+
+  const size_t len = renderAlert(e);
+  const uint32_t t0 = halPerfMicros();
+  TRACE_BEGIN(TRACE_ALERT_POST, min<size_t>(len, UINT16_MAX));
+  const int status = halWebhookPost(alertBody, len, ALERT_TIMEOUT_MS);
+  TRACE_END(TRACE_ALERT_POST);
+  metrics.alertPost.observe(halPerfMicros() - t0);
+  if (status < 200 || status > 299) {
+    metrics.alertFailures.inc();
+    if (alertRetryMs == 0) halLog("Alerts: webhook POST failed (%d); retrying with backoff\n", status);
+    alertRetryMs = alertRetryMs == 0 ? ALERT_RETRY_MIN_MS : min(alertRetryMs * 2, ALERT_RETRY_MAX_MS);
+    alertRetryAt = halMillis() + alertRetryMs;
+    return alertRetryMs;
+  }
+
+  if (alertRetryMs != 0) halLog("Alerts: webhook reachable again\n");
+  alertRetryMs = 0;
+  metrics.alertDeliveries.inc();
+  alertQueue.pop();
+  return alertQueue.size() > 0 ? 0 : ALERT_IDLE_MS;
+}
@@ -0,0 +1,158 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// app.h — platform-independent application logic
+//
+// Sampling, min/max, history, OLED rendering and the HTTP handlers live in
+// app.cpp and talk to hardware only through hal.h. The ESP32 build (main.cpp)
+// runs each step function in its own FreeRTOS task; the host simulation
+// (host/sim_main.cpp) calls them round-robin against a virtual clock.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <time.h>
+#include "hal.h"
+#include "alert_rules.h"
+#include "history_store.h"
+#include "metrics.h"
+#include "psychro.h"
+#include "seqlock.h"
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Min/max windows. The rolling ones slide with every sample; TODAY is the
+// local calendar day and resets at midnight once NTP has set the clock.
+// The OLED's and /sensor-data's plain L/H values are WIN_24H.
+// ──────────────────────────────────────────────────────────────────────────────
+enum AppWindow : uint8_t {
+  WIN_1H = 0,
+  WIN_24H,
+  WIN_7D,
+  WIN_TODAY,
+  WIN_COUNT
+};
+
+struct MinMax {
+  float tMin, tMax;             // °F; NAN while the window is empty
+  float hMin, hMax;             // %RH
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Probes. The platform's table (hal.h section 3) may list up to
+// APP_MAX_SENSORS; each is read every APP_SENSOR_PERIOD_MS (or its own
+// minimum interval, if longer), staggered so reads never bunch up. While
+// the room holds still the period stretches toward halSensorMaxPeriodMs().
+// ──────────────────────────────────────────────────────────────────────────────
+static const size_t   APP_MAX_SENSORS      = 8;
+static const uint32_t APP_SENSOR_PERIOD_MS = 2000;
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Current reading + min/max windows + last update timestamp, published as
+// one snapshot by the sensor step. The display and web steps only ever read
+// it through the seqlock, so they never see a torn temperature/humidity pair.
+//
+// The top-level reading is the room: the mean of every probe with a recent
+// good read (with one probe, simply that probe). History, the windows and the
+// flash log follow the room. Per-probe state is kept as one array per field.
+// ──────────────────────────────────────────────────────────────────────────────
+struct SensorSnapshot {
+  float    tempF, hum;          // NAN until the first good read
+  float    dewPointF;           // derived from tempF / hum (psychro.h); NAN below −60 °C
+  float    absHumidity;         // g/m³
+  float    vpdKPa;              // vapour-pressure deficit
+  MinMax   win[WIN_COUNT];
+  uint32_t lastUpdate;          // UNIX timestamp (seconds since boot until NTP syncs)
+  uint32_t seq;                 // sample sequence number (0 = no read yet)
+  uint32_t samplePeriodMs;      // read cadence now in effect (adaptive_rate.h)
+
+  uint8_t  probes;                          // probes in use (≤ APP_MAX_SENSORS)
+  float    probeTempF[APP_MAX_SENSORS];     // last good read; NAN until one
+  float    probeHum[APP_MAX_SENSORS];
+  MinMax   probeDay[APP_MAX_SENSORS];       // rolling 24 h
+  uint32_t probeUpdate[APP_MAX_SENSORS];    // lastUpdate of the last good read (0 = never)
+  uint16_t probeFailures[APP_MAX_SENSORS];  // failed attempts since the last good one
+  uint8_t  probeStatus[APP_MAX_SENSORS];    // Dht22Status of the latest attempt
+
+  uint32_t alerts;                          // bit i: alert rule i is firing
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Runtime health, exported by /metrics. app.cpp records its own steps and
+// handlers; the platform records the parts it owns (HTTP service loop, the
+// network task) into the fields marked so.
+// ──────────────────────────────────────────────────────────────────────────────
+enum AppRoute : uint8_t {
+  ROUTE_ROOT = 0,
+  ROUTE_SENSOR_DATA,
+  ROUTE_HISTORY,
+  ROUTE_EVENTS,
+  ROUTE_METRICS,
+  ROUTE_EXPORT,
+  ROUTE_TREND,
+  ROUTE_TRACE,
+  ROUTE_COUNT
+};
+
+struct AppMetrics {
+  MetricHistogram sensorStep, displayStep, webStep;
+  MetricHistogram httpService;              // platform: one HTTP server pass
+  MetricHistogram netStep;                  // platform: one network-task pass
+  MetricHistogram route[ROUTE_COUNT];       // handler duration; count = requests
+  MetricCounter   notModified;              // 304s from / and /sensor-data
+  MetricCounter   sseRejected;              // /events refused, all slots busy
+  MetricCounter   probeResults[APP_MAX_SENSORS][DHT22_OUT_OF_RANGE + 1];  // by Dht22Status
+  MetricGauge     probeLastOkMs[APP_MAX_SENSORS];   // halMillis() of last good read (0 = never)
+  MetricHistogram sensorLateness;           // read starts behind their scheduled time
+  MetricHistogram logFlush;                 // sample-log appends that hit flash
+  MetricCounter   logBytes;                 // bytes appended to the sample log
+  MetricCounter   logWriteErrors;           // frames dropped by a failed append
+  MetricHistogram uplinkPost;               // one batch POST, answered or not
+  MetricCounter   uplinkBatches;            // batches the collector accepted
+  MetricCounter   uplinkFailures;           // POSTs without a 2xx answer
+  MetricCounter   uplinkBytes;              // bytes of accepted batches
+  MetricGauge     uplinkAckedTs;            // newest sample the collector has (0 = none yet)
+  MetricCounter   alertsRaised[ALERT_MAX_RULES];   // times each rule started firing
+  MetricCounter   alertsDropped;            // transitions lost to a full delivery queue
+  MetricHistogram alertPost;                // one webhook POST, answered or not
+  MetricCounter   alertDeliveries;          // transitions the webhook accepted
+  MetricCounter   alertFailures;            // POSTs without a 2xx answer
+};
+
+extern Seqlock<SensorSnapshot> snapshot;
+extern HistoryStore            history;
+extern AppMetrics              metrics;
+
+// Wall-clock values below this are "seconds since boot", not UNIX time.
+static const time_t UNIX_TIME_VALID = 1600000000;
+
+// Replay the flash sample log into history and the min/max windows, draw
+// the placeholder screen, publish the snapshot and register the HTTP routes.
+// Call once, after the HAL is up and before any step function.
+void appSetup();
+
+// One pass of the sensor work: NTP rebase, probe scheduling and decoding,
+// min/max, history append, alert rules, snapshot publish. Returns how many ms may pass
+// before it needs to run again.
+uint32_t appSensorStep();
+
+// Repaint the OLED if a new snapshot arrived or the burn-in phase changed.
+void appDisplayStep();
+
+// Re-render the cached /sensor-data payload and push it to /events once per
+// new snapshot. Call after servicing HTTP.
+void appWebStep();
+
+// One pass of the store-and-forward uplink: POST the next batch of samples
+// the collector hasn't confirmed yet (hal.h section 9). Blocks for the POST,
+// so it needs a task of its own. Returns how many ms may pass before it needs
+// to run again.
+uint32_t appUplinkStep();
+
+// One pass of alert delivery: POST the oldest queued rule transition to the
+// webhook (hal.h section 10), retrying with backoff. Blocks for the POST, so
+// it needs a task of its own; halNotifySample() wakes it when the sensor
+// step may have queued one. Returns how many ms may pass before it needs to
+// run again.
+uint32_t appAlertStep();
+
+// Write samples still buffered for the flash log, and the uplink's position. Only for a planned stop
+// with the steps halted (the simulation's exit); a power cut loses at most
+// LOG_FLUSH_AGE_S of samples.
+void appFlushLog();
@@ -0,0 +1,112 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// dht22.h — non-blocking DHT22 driver (GPIO edge interrupts)
+//
+// The stock DHT library bit-bangs the ≈5 ms transfer with interrupts off,
+// stalling loop() and Wi-Fi. This driver never waits:
+//
+//   start()  drive the line low (≥1 ms start signal) and return
+//   poll()   called every loop(): releases the line after 1.1 ms, lets the
+//            CHANGE interrupt timestamp each edge, and once the frame is in
+//            (or 8 ms have passed) decodes it with dht22Decode()
+//   takeResult()  hands out each finished attempt exactly once
+//
+// The ISR only stores micros() into a fixed array; decoding and checksum
+// happen in poll(), outside interrupt context. The interrupt stays attached
+// for the driver's lifetime and ignores edges unless a capture is running,
+// so the host's own start pulse is never recorded.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <Arduino.h>
+#include "dht22_decode.h"
+
+class Dht22 {
+public:
+  explicit Dht22(uint8_t pin) : pin_(pin) {}
+
+  void begin() {
+    pinMode(pin_, INPUT_PULLUP);
+    attachInterruptArg(digitalPinToInterrupt(pin_), onEdge, this, CHANGE);
+  }
+
+  bool busy() const { return state_ != State::Idle; }
+
+  // Begin a read. Ignored while one is already in flight.
+  void start() {
+    if (busy()) return;
+    hasResult_ = false;
+    capturing_ = false;
+    edgeCount_ = 0;
+    pinMode(pin_, OUTPUT);
+    digitalWrite(pin_, LOW);
+    stateSince_ = micros();
+    state_ = State::StartLow;
+  }
+
+  void poll() {
+    const uint32_t now = micros();
+    switch (state_) {
+      case State::Idle:
+        break;
+
+      case State::StartLow:
+        if (now - stateSince_ >= START_LOW_US) {
+          capturing_ = true;              // the release edge is captured too;
+          pinMode(pin_, INPUT_PULLUP);    // dht22Decode() skips over it
+          stateSince_ = now;
+          state_ = State::Capture;
+        }
+        break;
+
+      case State::Capture:
+        // Release edge + 83 frame edges + the sensor letting go at the end
+        if (edgeCount_ >= DHT22_FRAME_EDGES + 2 || now - stateSince_ >= CAPTURE_TIMEOUT_US) {
+          capturing_ = false;
+          uint32_t edges[MAX_EDGES];
+          const size_t n = edgeCount_;
+          for (size_t i = 0; i < n; i++) edges[i] = edges_[i];
+          status_    = dht22Decode(edges, n, &reading_);
+          hasResult_ = true;
+          state_     = State::Idle;
+        }
+        break;
+    }
+  }
+
+  // True once per finished attempt; `status` says whether `r` is valid.
+  bool takeResult(Dht22Reading& r, Dht22Status& status) {
+    if (!hasResult_) return false;
+    hasResult_ = false;
+    r      = reading_;
+    status = status_;
+    return true;
+  }
+
+private:
+  enum class State : uint8_t { Idle, StartLow, Capture };
+
+  static const uint32_t START_LOW_US       = 1100;
+  static const uint32_t CAPTURE_TIMEOUT_US = 8000;
+  static const size_t   MAX_EDGES          = DHT22_FRAME_EDGES + 8;
+
+  static void IRAM_ATTR onEdge(void* arg) {
+    Dht22* self = static_cast<Dht22*>(arg);
+    if (!self->capturing_) return;
+    size_t n = self->edgeCount_;
+    if (n < MAX_EDGES) {
+      self->edges_[n] = micros();
+      self->edgeCount_ = n + 1;
+    }
+  }
+
+  const uint8_t     pin_;
+  State             state_      = State::Idle;
+  uint32_t          stateSince_ = 0;
+
+  volatile bool     capturing_  = false;
+  volatile size_t   edgeCount_  = 0;
+  volatile uint32_t edges_[MAX_EDGES];
+
+  bool              hasResult_  = false;
+  Dht22Status       status_     = DHT22_TRUNCATED;
+  Dht22Reading      reading_    = { 0, 0 };
+};
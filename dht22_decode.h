@@ -0,0 +1,102 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// dht22_decode.h — pure DHT22/AM2302 frame decoder
+//
+// Input is the list of edge timestamps (µs, any monotonic clock) captured
+// after the host released the data line. A complete transfer looks like:
+//
+//        response        bit 0             bit 1            …   bit 39   end
+//   ‾‾‾\_______/‾‾‾‾‾‾‾\_____/‾‾‾‾‾\_____/‾‾‾‾‾‾‾‾‾\ …  _____/‾‾‾‾‾\_____/‾‾
+//       80 µs     80 µs  50 µs 26–28 µs 50 µs  70 µs          50 µs  0/1  50 µs
+//       e0       e1      e2    e3      e4    e5                     e82
+//
+// i.e. 2 response edges + 2 per bit + 1 closing edge = 83 edges. Bit k is the
+// high pulse e[3+2k] → e[4+2k]; long (≈70 µs) = 1, short (≈27 µs) = 0.
+// The frame is aligned on the sensor's 80/80 µs response, so a stray leading
+// edge (the bus rising when the host lets go) and the trailing release edge
+// are both tolerated.
+//
+// Kept apart from dht22.h's interrupt capture so host/dht22_check.cpp and
+// the simulator can feed it edge lists directly.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+
+static const size_t DHT22_FRAME_EDGES = 83;
+
+enum Dht22Status : uint8_t {
+  DHT22_OK = 0,
+  DHT22_TRUNCATED,      // fewer edges than a full frame (no reply, or cut short)
+  DHT22_BAD_TIMING,     // a pulse outside the datasheet window (noise/glitch)
+  DHT22_CHECKSUM,       // bits decoded but byte 4 ≠ sum of bytes 0–3
+  DHT22_OUT_OF_RANGE,   // checksum fine but values impossible for a DHT22
+};
+
+struct Dht22Reading {
+  int16_t  t10C;   // temperature, 0.1 °C
+  uint16_t h10;    // humidity,    0.1 %RH
+};
+
+inline const char* dht22StatusName(Dht22Status s) {
+  switch (s) {
+    case DHT22_OK:           return "ok";
+    case DHT22_TRUNCATED:    return "truncated frame";
+    case DHT22_BAD_TIMING:   return "bad pulse timing";
+    case DHT22_CHECKSUM:     return "checksum mismatch";
+    case DHT22_OUT_OF_RANGE: return "value out of range";
+  }
+  return "?";
+}
+
+// Pulse-width windows (µs). Generous to absorb interrupt latency jitter.
+static const uint32_t DHT22_RESP_MIN  = 50, DHT22_RESP_MAX  = 110;
+static const uint32_t DHT22_LOW_MIN   = 30, DHT22_LOW_MAX   = 80;
+static const uint32_t DHT22_ZERO_MIN  = 10, DHT22_ZERO_MAX  = 45;
+static const uint32_t DHT22_ONE_MIN   = 50, DHT22_ONE_MAX   = 95;
+
+inline bool dht22IsResponse(const uint32_t* e) {
+  const uint32_t respLow  = e[1] - e[0];
+  const uint32_t respHigh = e[2] - e[1];
+  return respLow  >= DHT22_RESP_MIN && respLow  <= DHT22_RESP_MAX &&
+         respHigh >= DHT22_RESP_MIN && respHigh <= DHT22_RESP_MAX;
+}
+
+inline Dht22Status dht22Decode(const uint32_t* edges, size_t count, Dht22Reading* out) {
+  if (count < DHT22_FRAME_EDGES) return DHT22_TRUNCATED;
+
+  // Find the response preamble; at most a couple of leading edges are junk.
+  const uint32_t* e = nullptr;
+  for (size_t skip = 0; skip + DHT22_FRAME_EDGES <= count && skip < 3; skip++) {
+    if (dht22IsResponse(edges + skip)) { e = edges + skip; break; }
+  }
+  if (!e) return DHT22_BAD_TIMING;
+
+  uint8_t bytes[5] = { 0, 0, 0, 0, 0 };
+  for (size_t k = 0; k < 40; k++) {
+    const uint32_t low  = e[3 + 2 * k] - e[2 + 2 * k];
+    const uint32_t high = e[4 + 2 * k] - e[3 + 2 * k];
+    if (low < DHT22_LOW_MIN || low > DHT22_LOW_MAX) return DHT22_BAD_TIMING;
+
+    uint8_t bit;
+    if      (high >= DHT22_ZERO_MIN && high <= DHT22_ZERO_MAX) bit = 0;
+    else if (high >= DHT22_ONE_MIN  && high <= DHT22_ONE_MAX)  bit = 1;
+    else return DHT22_BAD_TIMING;
+
+    bytes[k / 8] = (uint8_t)((bytes[k / 8] << 1) | bit);
+  }
+
+  if ((uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]) != bytes[4]) {
+    return DHT22_CHECKSUM;
+  }
+
+  const uint16_t h10 = (uint16_t)((bytes[0] << 8) | bytes[1]);
+  int16_t t10 = (int16_t)(((bytes[2] & 0x7F) << 8) | bytes[3]);
+  if (bytes[2] & 0x80) t10 = (int16_t)-t10;
+
+  // DHT22 spec: 0–100 %RH, −40…80 °C
+  if (h10 > 1000 || t10 < -400 || t10 > 800) return DHT22_OUT_OF_RANGE;
+
+  out->t10C = t10;
+  out->h10  = h10;
+  return DHT22_OK;
+}
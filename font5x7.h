@@ -0,0 +1,84 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// font5x7.h — the glyphs the OLED screen actually uses, in the classic
+// Adafruit GFX 5×7 font (glcdfont.c)
+//
+// Each glyph is 5 column bytes, bit 0 = top row; the 6th column is spacing.
+// Only the characters drawReadings() can produce are included: the fixed
+// labels, digits, A–Z for the (upper-cased) probe and alert rule names, and
+// the comparison signs of the alert page. Anything else comes back as nullptr so callers can draw
+// a placeholder box.
+//
+// glyph_atlas.h rasterizes these at compile time for the OLED; the host sim
+// also draws them pixel by pixel, as Adafruit GFX would, to check the atlas.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+
+static const int FONT5X7_COLS = 5;
+static const int FONT5X7_ROWS = 7;
+
+// X-macro so other tables (glyph_atlas.h) can be built from the same data:
+// G(char, col0, col1, col2, col3, col4)
+#define FONT5X7_GLYPHS(G) \
+  G(' ', 0x00, 0x00, 0x00, 0x00, 0x00) \
+  G('!', 0x00, 0x00, 0x5F, 0x00, 0x00) \
+  G('%', 0x23, 0x13, 0x08, 0x64, 0x62) \
+  G('+', 0x08, 0x08, 0x3E, 0x08, 0x08) \
+  G('-', 0x08, 0x08, 0x08, 0x08, 0x08) \
+  G('.', 0x00, 0x60, 0x60, 0x00, 0x00) \
+  G('/', 0x20, 0x10, 0x08, 0x04, 0x02) \
+  G('0', 0x3E, 0x51, 0x49, 0x45, 0x3E) \
+  G('1', 0x00, 0x42, 0x7F, 0x40, 0x00) \
+  G('2', 0x72, 0x49, 0x49, 0x49, 0x46) \
+  G('3', 0x21, 0x41, 0x49, 0x4D, 0x33) \
+  G('4', 0x18, 0x14, 0x12, 0x7F, 0x10) \
+  G('5', 0x27, 0x45, 0x45, 0x45, 0x39) \
+  G('6', 0x3C, 0x4A, 0x49, 0x49, 0x31) \
+  G('7', 0x41, 0x21, 0x11, 0x09, 0x07) \
+  G('8', 0x36, 0x49, 0x49, 0x49, 0x36) \
+  G('9', 0x46, 0x49, 0x49, 0x29, 0x1E) \
+  G(':', 0x00, 0x36, 0x36, 0x00, 0x00) \
+  G('<', 0x08, 0x14, 0x22, 0x41, 0x00) \
+  G('>', 0x00, 0x41, 0x22, 0x14, 0x08) \
+  G('A', 0x7C, 0x12, 0x11, 0x12, 0x7C) \
+  G('B', 0x7F, 0x49, 0x49, 0x49, 0x36) \
+  G('C', 0x3E, 0x41, 0x41, 0x41, 0x22) \
+  G('D', 0x7F, 0x41, 0x41, 0x41, 0x3E) \
+  G('E', 0x7F, 0x49, 0x49, 0x49, 0x41) \
+  G('F', 0x7F, 0x09, 0x09, 0x09, 0x01) \
+  G('G', 0x3E, 0x41, 0x41, 0x51, 0x73) \
+  G('H', 0x7F, 0x08, 0x08, 0x08, 0x7F) \
+  G('I', 0x00, 0x41, 0x7F, 0x41, 0x00) \
+  G('J', 0x20, 0x40, 0x41, 0x3F, 0x01) \
+  G('K', 0x7F, 0x08, 0x14, 0x22, 0x41) \
+  G('L', 0x7F, 0x40, 0x40, 0x40, 0x40) \
+  G('M', 0x7F, 0x02, 0x1C, 0x02, 0x7F) \
+  G('N', 0x7F, 0x04, 0x08, 0x10, 0x7F) \
+  G('O', 0x3E, 0x41, 0x41, 0x41, 0x3E) \
+  G('P', 0x7F, 0x09, 0x09, 0x09, 0x06) \
+  G('Q', 0x3E, 0x41, 0x51, 0x21, 0x5E) \
+  G('R', 0x7F, 0x09, 0x19, 0x29, 0x46) \
+  G('S', 0x26, 0x49, 0x49, 0x49, 0x32) \
+  G('T', 0x01, 0x01, 0x7F, 0x01, 0x01) \
+  G('U', 0x3F, 0x40, 0x40, 0x40, 0x3F) \
+  G('V', 0x1F, 0x20, 0x40, 0x20, 0x1F) \
+  G('W', 0x3F, 0x40, 0x38, 0x40, 0x3F) \
+  G('X', 0x63, 0x14, 0x08, 0x14, 0x63) \
+  G('Y', 0x03, 0x04, 0x78, 0x04, 0x03) \
+  G('Z', 0x61, 0x59, 0x49, 0x4D, 0x43)
+
+struct Font5x7Glyph {
+  char    c;
+  uint8_t cols[FONT5X7_COLS];
+};
+
+#define FONT5X7_ENTRY(ch, c0, c1, c2, c3, c4) { ch, { c0, c1, c2, c3, c4 } },
+static const Font5x7Glyph FONT5X7[] = { FONT5X7_GLYPHS(FONT5X7_ENTRY) };
+#undef FONT5X7_ENTRY
+
+inline const uint8_t* font5x7Find(char c) {
+  for (const Font5x7Glyph& g : FONT5X7) {
+    if (g.c == c) return g.cols;
+  }
+  return nullptr;
+}
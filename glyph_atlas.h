@@ -0,0 +1,82 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// glyph_atlas.h — font5x7.h pre-rasterized at text size 2, for windowed blits
+//
+// Adafruit GFX draws a size-2 character as one 2×2 fillRect per lit font
+// pixel, and each fillRect is its own SPI address window: a "8" is 25
+// windows for 100 pixels. The atlas holds every glyph as a finished 12×16
+// cell instead (spacing column and bottom rows included, 1 bit per pixel,
+// 32 B each), built by the compiler from the font table. glyphAtlasRender()
+// turns a run of cells into RGB565 so the whole run goes out as one window
+// and one bulk transfer (halDisplayBlit), with the background painted too.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+#include "font5x7.h"
+
+static const int GLYPH_SCALE  = 2;
+static const int GLYPH_WIDTH  = (FONT5X7_COLS + 1) * GLYPH_SCALE;   // 12
+static const int GLYPH_HEIGHT = (FONT5X7_ROWS + 1) * GLYPH_SCALE;   // 16
+
+// One pixel row of a cell: bit 11 is the leftmost pixel. Row r shows font
+// row r / 2 with every column doubled.
+constexpr uint16_t glyphAtlasBits(uint8_t col, int r) {
+  return r / GLYPH_SCALE < FONT5X7_ROWS ? (col >> (r / GLYPH_SCALE)) & 1 : 0;
+}
+constexpr uint16_t glyphAtlasRow(uint8_t c0, uint8_t c1, uint8_t c2, uint8_t c3, uint8_t c4, int r) {
+  return (uint16_t)(glyphAtlasBits(c0, r) * 0xC00 | glyphAtlasBits(c1, r) * 0x300 |
+                    glyphAtlasBits(c2, r) * 0x0C0 | glyphAtlasBits(c3, r) * 0x030 |
+                    glyphAtlasBits(c4, r) * 0x00C);
+}
+
+struct GlyphAtlasCell {
+  char     c;
+  uint16_t rows[GLYPH_HEIGHT];
+};
+
+#define GLYPH_ATLAS_ROWS(a, b, c, d, e, r) \
+  glyphAtlasRow(a, b, c, d, e, r),     glyphAtlasRow(a, b, c, d, e, r + 1), \
+  glyphAtlasRow(a, b, c, d, e, r + 2), glyphAtlasRow(a, b, c, d, e, r + 3)
+#define GLYPH_ATLAS_ENTRY(ch, a, b, c, d, e) \
+  { ch, { GLYPH_ATLAS_ROWS(a, b, c, d, e, 0),  GLYPH_ATLAS_ROWS(a, b, c, d, e, 4), \
+          GLYPH_ATLAS_ROWS(a, b, c, d, e, 8),  GLYPH_ATLAS_ROWS(a, b, c, d, e, 12) } },
+static constexpr GlyphAtlasCell GLYPH_ATLAS[] = { FONT5X7_GLYPHS(GLYPH_ATLAS_ENTRY) };
+#undef GLYPH_ATLAS_ENTRY
+#undef GLYPH_ATLAS_ROWS
+
+static_assert(sizeof(GLYPH_ATLAS) / sizeof(GLYPH_ATLAS[0]) ==
+              sizeof(FONT5X7) / sizeof(FONT5X7[0]), "atlas and font differ");
+static_assert(GLYPH_ATLAS[7].c == '0' && GLYPH_ATLAS[7].rows[0] == 0x3F0 &&
+              GLYPH_ATLAS[7].rows[15] == 0, "atlas rasterized wrong");
+
+// Unknown characters get a solid 10×14 box, as the sim always drew them
+static const uint16_t GLYPH_ATLAS_BOX[GLYPH_HEIGHT] = {
+  0xFFC, 0xFFC, 0xFFC, 0xFFC, 0xFFC, 0xFFC, 0xFFC,
+  0xFFC, 0xFFC, 0xFFC, 0xFFC, 0xFFC, 0xFFC, 0xFFC, 0, 0,
+};
+
+inline const uint16_t* glyphAtlasFind(char c) {
+  for (const GlyphAtlasCell& g : GLYPH_ATLAS) {
+    if (g.c == c) return g.rows;
+  }
+  return GLYPH_ATLAS_BOX;
+}
+
+// Pixel columns [x0, x0 + w) of a run of cells into `out` (w × GLYPH_HEIGHT,
+// row-major), lit pixels `fg`, the rest `bg`. Cell i shows text[i], or a
+// blank past `len`.
+inline void glyphAtlasRender(const char* text, size_t len, int x0, int w,
+                             uint16_t fg, uint16_t bg, uint16_t* out) {
+  if (w <= 0) return;
+  for (int cell = x0 / GLYPH_WIDTH; cell * GLYPH_WIDTH < x0 + w; cell++) {
+    const uint16_t* rows = glyphAtlasFind((size_t) cell < len ? text[cell] : ' ');
+    const int left = cell * GLYPH_WIDTH;
+    const int c0 = x0 > left ? x0 - left : 0;
+    const int c1 = x0 + w < left + GLYPH_WIDTH ? x0 + w - left : GLYPH_WIDTH;
+    uint16_t* o = out + (left + c0 - x0);
+    for (int r = 0; r < GLYPH_HEIGHT; r++, o += w) {
+      const uint16_t bits = rows[r];
+      for (int c = c0; c < c1; c++) o[c - c0] = bits & (0x800 >> c) ? fg : bg;
+    }
+  }
+}
@@ -0,0 +1,205 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// hal.h — the thin layer between the application (app.cpp) and the platform
+//
+// Everything app.cpp needs from the outside world goes through these calls.
+// Two implementations exist:
+//
+//   main.cpp           ESP32: Adafruit_SSD1351, Dht22/Sht3x, http_server.h,
+//                      FreeRTOS, LittleFS, HTTPClient
+//   host/hal_host.cpp  Linux simulation: virtual clock, CSV-replayed probes,
+//                      in-memory 128×128 framebuffer, real local HTTP listener,
+//                      a directory standing in for flash, plain-socket POSTs
+//
+// The API is deliberately C-style and mirrors the Arduino calls it replaced,
+// so the application code reads the same as before the split.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include "dht22_decode.h"
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1) Clock
+// ──────────────────────────────────────────────────────────────────────────────
+uint32_t halMillis();                 // monotonic ms since boot
+time_t   halTime();                   // wall clock; < UNIX_TIME_VALID until synced
+uint32_t halPerfMicros();             // free-running µs for timing work (metrics);
+                                      // real time even when the host clock is virtual
+
+// Trace clock (trace.h), cheap enough to read on every event: the calling
+// CPU's cycle counter (wraps; CPUs may disagree) and a coarse real-time ms
+// tick shared by all CPUs that places it
+uint32_t halCycleCount();
+uint32_t halCyclesPerUs();
+uint32_t halTickMs();
+uint8_t  halCpuId();                  // 0 … HAL_MAX_CPUS − 1
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2) Logging (Serial on the device, stderr on the host)
+// ──────────────────────────────────────────────────────────────────────────────
+void halLog(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3) Sensors — the platform's fixed probe table, addressed by index
+//    0 … halSensorCount()−1. Each probe has the Dht22 driver's contract:
+//    start() kicks off a read, poll() advances it without blocking,
+//    takeResult() yields each finished attempt once. Every kind reports in
+//    DHT22 terms (0.1 °C, 0.1 %RH, Dht22Status).
+// ──────────────────────────────────────────────────────────────────────────────
+enum HalSensorKind : uint8_t {
+  SENSOR_DHT22 = 0,                   // one GPIO each, ≈5.5 ms per read
+  SENSOR_SHT3X,                       // shared I2C bus, ≈16 ms per read
+};
+
+static const size_t HAL_SENSOR_NAME_MAX = 16;   // longer names are cut to this
+
+struct HalSensorInfo {
+  const char*   name;                 // short label for the OLED, JSON and metrics
+  HalSensorKind kind;
+  uint32_t      minIntervalMs;        // never start reads closer together than this
+};
+
+size_t               halSensorCount();
+const HalSensorInfo& halSensorInfo(size_t i);
+void halSensorStart(size_t i);
+void halSensorPoll(size_t i);
+bool halSensorBusy(size_t i);         // a read is in flight and needs polling
+bool halSensorTakeResult(size_t i, Dht22Reading& r, Dht22Status& status);
+
+// Longest the application may stretch the read cadence to while the room
+// holds still (see adaptive_rate.h); APP_SENSOR_PERIOD_MS or less keeps it
+// fixed
+uint32_t halSensorMaxPeriodMs();
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 4) Display (128×128 RGB565, already rotated). Each call is one SPI
+//    address window; text is pre-rendered (glyph_atlas.h) and blitted.
+// ──────────────────────────────────────────────────────────────────────────────
+static const int SCREEN_WIDTH  = 128;
+static const int SCREEN_HEIGHT = 128;
+
+void halDisplayFillScreen(uint16_t color);
+void halDisplayFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+// w × h pixels, row-major, in one window and one bulk transfer; clipped to
+// the screen
+void halDisplayBlit(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* pixels);
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 5) HTTP server. Connections are multiplexed (http_server.h), but handlers
+//    run one at a time, WebServer-style: inside a handler the halHttp*
+//    request/response calls refer to that request.
+// ──────────────────────────────────────────────────────────────────────────────
+typedef void (*HalHttpHandler)();
+
+void halHttpOn(const char* path, HalHttpHandler handler);
+
+// Query argument → `out` (NUL-terminated, truncated to cap). False if absent.
+bool halHttpArg(const char* name, char* out, size_t cap);
+// True if request header `name` is present and equal to `value`.
+bool halHttpHeaderIs(const char* name, const char* value);
+
+void halHttpSendHeader(const char* name, const char* value);
+void halHttpSend(int code, const char* contentType, const void* body, size_t len);
+// Same, without copying `body`: it must stay valid after the handler returns.
+void halHttpSendStatic(int code, const char* contentType, const void* body, size_t len);
+
+// Chunked response of unknown length: begin, any number of chunks, end.
+void halHttpBeginChunked(int code, const char* contentType);
+void halHttpChunk(const void* data, size_t len);
+void halHttpEndChunked();
+
+// Take the current connection over as a raw long-lived stream (e.g. SSE).
+// Returns a stream id, or -1 if every stream slot is in use.
+static const int HAL_MAX_STREAMS = 4;
+int  halHttpDetach();
+bool halStreamWrite(int id, const void* data, size_t len);   // false → closed
+bool halStreamOpen(int id);
+void halStreamClose(int id);
+
+// Connection pool, for /metrics. Counters run from boot.
+struct HalHttpInfo {
+  uint8_t  open, slots;           // connections held / pool size
+  uint32_t accepted;              // given a slot
+  uint32_t rejected;              // turned away with 503, pool busy
+  uint32_t timedOut;              // closed for a stalled request or response
+  uint32_t evicted;               // idle keep-alive closed to make room
+  uint32_t requests;
+  uint32_t reused;                // requests on an already-used connection
+};
+
+void halHttpInfo(HalHttpInfo* out);
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 6) Concurrency. The device runs sensor/display/web as separate tasks; the
+//    host simulation runs them round-robin on one thread.
+// ──────────────────────────────────────────────────────────────────────────────
+void halHistoryLock();
+void halHistoryUnlock();
+void halNotifySample();               // a new snapshot is out: wake the tasks that follow it
+uint32_t halRandom();
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 7) Heap and CPU health, for /metrics
+// ──────────────────────────────────────────────────────────────────────────────
+struct HalHeapInfo {
+  uint32_t freeBytes;
+  uint32_t minFreeBytes;        // low-water mark since boot
+  uint32_t largestFreeBlock;    // biggest single allocation that would succeed
+};
+
+void halHeapInfo(HalHeapInfo* out);
+
+// Time each CPU spent with nothing to run. idleUs[i] / sinceUs is the idle
+// fraction since counting began; rates over a scrape interval give a recent one.
+static const int HAL_MAX_CPUS = 2;
+
+struct HalCpuInfo {
+  uint8_t  cpus;
+  uint64_t sinceUs;                     // span the counters cover
+  uint64_t idleUs[HAL_MAX_CPUS];
+};
+
+void halCpuInfo(HalCpuInfo* out);
+
+// Each running task's stack and the least of it ever left free (FreeRTOS's
+// high-water mark). The host runs the steps on one thread and has none.
+static const int HAL_MAX_TASKS = 6;
+
+struct HalTaskStack {
+  const char* name;
+  uint32_t    sizeBytes;
+  uint32_t    minFreeBytes;             // low-water mark since the task started
+};
+
+size_t halTaskStacks(HalTaskStack* out, size_t max);   // number filled in
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 8) Flash files (LittleFS on the device, a directory on the host). Each call
+//    opens, acts and closes, so no handle outlives it; paths are absolute
+//    ("/name"). Used by the sample log (sample_log.h).
+// ──────────────────────────────────────────────────────────────────────────────
+bool   halFsMounted();
+size_t halFsSize(const char* path);                                    // 0 if missing
+size_t halFsRead(const char* path, uint32_t offset, void* buf, size_t len);
+bool   halFsAppend(const char* path, const void* data, size_t len);   // creates; false on a short write
+bool   halFsRemove(const char* path);
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 9) Uplink — one HTTP POST to the collector the platform was configured
+//    with (none → halUplinkEnabled() is false). The platform adds the unit's
+//    id as an X-Potato-Unit header. Blocks for up to `timeoutMs`, so only
+//    the uplink task may call it. Returns the HTTP status, or < 0 if no
+//    answer came (no network, refused, timed out).
+// ──────────────────────────────────────────────────────────────────────────────
+bool halUplinkEnabled();
+int  halUplinkPost(const void* body, size_t len, uint32_t timeoutMs);
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 10) Alert webhook — one HTTP POST of a JSON body to the URL the platform
+//     was configured with (none → halWebhookEnabled() is false). Same
+//     contract as halUplinkPost(): X-Potato-Unit is added, only the alert
+//     task may call it, and the result is the HTTP status or < 0.
+// ──────────────────────────────────────────────────────────────────────────────
+bool halWebhookEnabled();
+int  halWebhookPost(const char* json, size_t len, uint32_t timeoutMs);
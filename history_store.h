@@ -0,0 +1,280 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// history_store.h — fixed-RAM, multi-resolution time-series store
+//
+// Three tiers of preallocated ring buffers, filled incrementally as samples
+// arrive (no allocation after boot):
+//
+//   RAW   : every sample            × 1800 → 1-15 hours    (8 B each)
+//   MINUTE: 1-minute min/max/avg    × 1440 → last day      (16 B each)
+//   HOUR  : 1-hour   min/max/avg    ×  720 → last 30 days  (16 B each)
+//
+// RAW's span follows the read period: an hour of 2 s reads, up to 15 hours
+// while adaptive sampling backs off to 30 s. spacing() reports the cadence
+// a range was actually read at.
+//
+// Values are fixed-point: temperature in 0.1 °F (int16), humidity in 0.1 %RH
+// (uint16). Total footprint is sizeof(HistoryStore) ≈ 48 KB.
+//
+// Deliberately free of Arduino headers so it can be compiled on the host.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+
+struct HistSample {
+  uint32_t ts;    // UNIX seconds
+  int16_t  t10;   // temperature, 0.1 °F
+  uint16_t h10;   // humidity,    0.1 %RH
+};
+
+struct HistAggregate {
+  uint32_t ts;    // bucket start, UNIX seconds
+  int16_t  tMin, tMax, tAvg;
+  uint16_t hMin, hMax, hAvg;
+};
+
+enum HistTier : uint8_t { HIST_RAW = 0, HIST_MINUTE = 1, HIST_HOUR = 2, HIST_TIER_COUNT = 3 };
+
+static const uint32_t HIST_RAW_PERIOD_S    = 2;      // fastest read period
+static const uint32_t HIST_MINUTE_PERIOD_S = 60;
+static const uint32_t HIST_HOUR_PERIOD_S   = 3600;
+
+static const size_t HIST_RAW_CAPACITY    = 3600 / HIST_RAW_PERIOD_S;  // 1 hour at 2 s
+static const size_t HIST_MINUTE_CAPACITY = 24 * 60;                   // 1 day
+static const size_t HIST_HOUR_CAPACITY   = 30 * 24;                   // 30 days
+
+// Fixed-capacity ring. Entries are addressed by an absolute sequence number
+// (0 = first entry ever pushed) so a reader's position stays valid while the
+// ring keeps wrapping underneath it.
+template <typename T, size_t N>
+class HistRing {
+public:
+  void push(const T& v) {
+    buf_[total_ % N] = v;
+    total_++;
+  }
+  T&       atSeq(uint32_t seq)       { return buf_[seq % N]; }
+  uint32_t firstSeq() const { return total_ > N ? total_ - (uint32_t)N : 0; }
+  uint32_t endSeq()   const { return total_; }
+  size_t   size()     const { return total_ > N ? N : total_; }
+  const T& atSeq(uint32_t seq) const { return buf_[seq % N]; }
+
+private:
+  T        buf_[N];
+  uint32_t total_ = 0;
+};
+
+// Running min/max/sum for one bucket of a coarser tier.
+struct HistAccumulator {
+  uint32_t bucket = 0;      // bucket start (ts rounded down to the period)
+  uint32_t n      = 0;
+  int32_t  tSum   = 0;
+  uint32_t hSum   = 0;
+  int16_t  tMin = 0, tMax = 0;
+  uint16_t hMin = 0, hMax = 0;
+
+  void reset(uint32_t b) { bucket = b; n = 0; tSum = 0; hSum = 0; }
+
+  void add(const HistSample& s) {
+    if (n == 0) {
+      tMin = tMax = s.t10;
+      hMin = hMax = s.h10;
+    } else {
+      if (s.t10 < tMin) tMin = s.t10;
+      if (s.t10 > tMax) tMax = s.t10;
+      if (s.h10 < hMin) hMin = s.h10;
+      if (s.h10 > hMax) hMax = s.h10;
+    }
+    tSum += s.t10;
+    hSum += s.h10;
+    n++;
+  }
+
+  HistAggregate result() const {
+    HistAggregate a;
+    a.ts   = bucket;
+    a.tMin = tMin;  a.tMax = tMax;
+    a.hMin = hMin;  a.hMax = hMax;
+    // Rounded integer average (tSum may be negative).
+    a.tAvg = (int16_t)(tSum >= 0 ? (tSum + (int32_t)n / 2) / (int32_t)n
+                                 : (tSum - (int32_t)n / 2) / (int32_t)n);
+    a.hAvg = (uint16_t)((hSum + n / 2) / n);
+    return a;
+  }
+};
+
+// Read position for HistoryStore::read(). Zero-initialise before the first call.
+struct HistCursor {
+  uint32_t seq     = 0;
+  bool     started = false;
+};
+
+class HistoryStore {
+public:
+  // Feed one sample. Timestamps are expected to be non-decreasing; a sample
+  // older than the newest stored one is dropped.
+  void add(const HistSample& s) {
+    if (raw_.size() > 0 && s.ts < raw_.atSeq(raw_.endSeq() - 1).ts) return;
+    raw_.push(s);
+    roll(minuteAcc_, minute_, s, HIST_MINUTE_PERIOD_S);
+    roll(hourAcc_,   hour_,   s, HIST_HOUR_PERIOD_S);
+  }
+
+  // Convert provisional timestamps to UNIX time: every stored timestamp at
+  // or above `from` (i.e. taken before NTP sync — seconds since boot, or
+  // since the newest logged sample) gets `offset` added. Buckets that
+  // straddled the sync point keep their provisional alignment; the open
+  // accumulators are flushed on their next sample.
+  void rebase(uint32_t offset, uint32_t from) {
+    for (uint32_t q = raw_.firstSeq(); q < raw_.endSeq(); q++) {
+      if (raw_.atSeq(q).ts >= from) raw_.atSeq(q).ts += offset;
+    }
+    for (uint32_t q = minute_.firstSeq(); q < minute_.endSeq(); q++) {
+      if (minute_.atSeq(q).ts >= from) minute_.atSeq(q).ts += offset;
+    }
+    for (uint32_t q = hour_.firstSeq(); q < hour_.endSeq(); q++) {
+      if (hour_.atSeq(q).ts >= from) hour_.atSeq(q).ts += offset;
+    }
+    if (minuteAcc_.bucket >= from) minuteAcc_.bucket += offset;
+    if (hourAcc_.bucket   >= from) hourAcc_.bucket   += offset;
+  }
+
+  // Number of entries currently held in a tier.
+  size_t size(HistTier tier) const {
+    switch (tier) {
+      case HIST_RAW:    return raw_.size();
+      case HIST_MINUTE: return minute_.size();
+      default:          return hour_.size();
+    }
+  }
+
+  // Timestamp of the oldest entry in a tier (0 if the tier is empty).
+  uint32_t oldest(HistTier tier) const {
+    if (size(tier) == 0) return 0;
+    return entry(tier, firstSeq(tier)).ts;
+  }
+
+  // Number of entries with from <= ts <= to in a tier (two binary searches).
+  size_t count(HistTier tier, uint32_t from, uint32_t to) const {
+    if (to < from) return 0;
+    const uint32_t lo = lowerBound(tier, from);
+    const uint32_t hi = to == UINT32_MAX ? endSeq(tier) : lowerBound(tier, to + 1);
+    return hi > lo ? hi - lo : 0;
+  }
+
+  // Finest tier whose retained span still reaches back to `from`.
+  HistTier tierFor(uint32_t from) const {
+    if (size(HIST_RAW)    > 0 && oldest(HIST_RAW)    <= from) return HIST_RAW;
+    if (size(HIST_MINUTE) > 0 && oldest(HIST_MINUTE) <= from) return HIST_MINUTE;
+    if (size(HIST_HOUR)   > 0) return HIST_HOUR;
+    if (size(HIST_MINUTE) > 0) return HIST_MINUTE;
+    return HIST_RAW;
+  }
+
+  // Copy up to `max` entries with from <= ts <= to into `out`, continuing from
+  // `cur`. Raw samples are widened to aggregates with min == max == avg.
+  // Returns the number copied; 0 means the range is exhausted.
+  size_t read(HistTier tier, uint32_t from, uint32_t to, HistCursor& cur,
+              HistAggregate* out, size_t max) const {
+    const uint32_t first = firstSeq(tier);
+    const uint32_t end   = endSeq(tier);
+    if (!cur.started) {
+      cur.seq     = lowerBound(tier, from);
+      cur.started = true;
+    }
+    if (cur.seq < first) cur.seq = first;   // overwritten while we streamed
+
+    size_t n = 0;
+    while (n < max && cur.seq < end) {
+      HistAggregate a = entry(tier, cur.seq);
+      if (a.ts > to) { cur.seq = end; break; }
+      out[n++] = a;
+      cur.seq++;
+    }
+    return n;
+  }
+
+  // Seconds between the entries with from <= ts <= to. MINUTE and HOUR rows
+  // are their bucket period apart; RAW rows are as far apart as the reads
+  // were, so theirs is the mean gap from the first to the last, rounded
+  // (outages included). Fewer than two RAW rows → HIST_RAW_PERIOD_S.
+  uint32_t spacing(HistTier tier, uint32_t from, uint32_t to) const {
+    if (tier != HIST_RAW) return periodOf(tier);
+    const uint32_t lo = lowerBound(tier, from);
+    const uint32_t hi = to == UINT32_MAX ? endSeq(tier) : lowerBound(tier, to + 1);
+    if (to < from || hi < lo + 2) return HIST_RAW_PERIOD_S;
+    const uint32_t gaps = hi - lo - 1;
+    return (raw_.atSeq(hi - 1).ts - raw_.atSeq(lo).ts + gaps / 2) / gaps;
+  }
+
+  // Bucket period of a tier; for RAW, the fastest read period
+  static uint32_t periodOf(HistTier tier) {
+    switch (tier) {
+      case HIST_RAW:    return HIST_RAW_PERIOD_S;
+      case HIST_MINUTE: return HIST_MINUTE_PERIOD_S;
+      default:          return HIST_HOUR_PERIOD_S;
+    }
+  }
+
+private:
+  template <size_t N>
+  static void roll(HistAccumulator& acc, HistRing<HistAggregate, N>& ring,
+                   const HistSample& s, uint32_t period) {
+    const uint32_t b = s.ts - (s.ts % period);
+    if (acc.n > 0 && b != acc.bucket) {
+      ring.push(acc.result());
+      acc.reset(b);
+    } else if (acc.n == 0) {
+      acc.reset(b);
+    }
+    acc.add(s);
+  }
+
+  uint32_t firstSeq(HistTier tier) const {
+    switch (tier) {
+      case HIST_RAW:    return raw_.firstSeq();
+      case HIST_MINUTE: return minute_.firstSeq();
+      default:          return hour_.firstSeq();
+    }
+  }
+
+  uint32_t endSeq(HistTier tier) const {
+    switch (tier) {
+      case HIST_RAW:    return raw_.endSeq();
+      case HIST_MINUTE: return minute_.endSeq();
+      default:          return hour_.endSeq();
+    }
+  }
+
+  HistAggregate entry(HistTier tier, uint32_t seq) const {
+    switch (tier) {
+      case HIST_RAW: {
+        const HistSample& s = raw_.atSeq(seq);
+        HistAggregate a;
+        a.ts   = s.ts;
+        a.tMin = a.tMax = a.tAvg = s.t10;
+        a.hMin = a.hMax = a.hAvg = s.h10;
+        return a;
+      }
+      case HIST_MINUTE: return minute_.atSeq(seq);
+      default:          return hour_.atSeq(seq);
+    }
+  }
+
+  // First sequence number whose timestamp is >= ts (binary search).
+  uint32_t lowerBound(HistTier tier, uint32_t ts) const {
+    uint32_t lo = firstSeq(tier), hi = endSeq(tier);
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2;
+      if (entry(tier, mid).ts < ts) lo = mid + 1;
+      else                          hi = mid;
+    }
+    return lo;
+  }
+
+  HistRing<HistSample,    HIST_RAW_CAPACITY>    raw_;
+  HistRing<HistAggregate, HIST_MINUTE_CAPACITY> minute_;
+  HistRing<HistAggregate, HIST_HOUR_CAPACITY>   hour_;
+  HistAccumulator minuteAcc_;
+  HistAccumulator hourAcc_;
+};
@@ -0,0 +1,315 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// adaptive_rate_check.cpp — AdaptiveRate's quiet / drift / fast steps
+//
+//   adaptive_rate_check [--seed N] [--runs N]
+//
+// With the app's settings (2 s to 30 s, 0.3 °F / 1 %RH deadband, 1 °F or
+// 3 %RH per minute fast), one step at a time:
+//
+//   - readings inside the deadband, its edges and one-count flickers
+//     included, grow the period by half up to the maximum; a creep of one
+//     count per read leaves it once it is past the band from the anchor
+//   - a slow move out of the band halves the period, down to the minimum,
+//     and becomes the new anchor
+//   - a move out of the band at the fast rate or more (exactly at it too,
+//     across a halMillis() wrap too) goes straight back to the minimum
+//   - reset() after a failed read: the minimum at once, and the next reading
+//     anchors afresh however far it is from the old anchor
+//   - maxMs ≤ minMs pins the cadence at minMs
+//
+// Then random walks of quiet stretches, slow drifts, jumps, flickers and
+// failed reads, each step checked against a model written from the rules
+// in adaptive_rate.h.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "../adaptive_rate.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+
+static const AdaptiveRateConfig APP = { 2000, 30000, 3, 10, 10, 30 };   // app.cpp, main.cpp
+
+static const char* modeName(AdaptiveMode m) {
+  return m == ADAPTIVE_FAST ? "fast" : m == ADAPTIVE_DRIFT ? "drift" : "quiet";
+}
+
+// A rate fed by hand: one reading `afterMs` after the previous one
+struct Rig {
+  AdaptiveRate rate;
+  uint32_t     nowMs;
+
+  explicit Rig(uint32_t startMs, const AdaptiveRateConfig& cfg = APP) : nowMs(startMs) { rate.begin(cfg); }
+
+  uint32_t read(int16_t t10, int16_t h10, uint32_t afterMs) {
+    nowMs += afterMs;
+    return rate.observe(t10, h10, nowMs);
+  }
+
+  // The next reading, one period on
+  uint32_t next(int16_t t10, int16_t h10) { return read(t10, h10, rate.periodMs()); }
+
+  // Steady readings until the period is at the maximum (a dozen at most)
+  void settle(int16_t t10, int16_t h10) {
+    for (int i = 0; i < 12 && rate.periodMs() < APP.maxMs; i++) next(t10, h10);
+    CHECK(rate.periodMs() == APP.maxMs, "steady at (%d, %d): %u ms", t10, h10, rate.periodMs());
+  }
+};
+
+static uint32_t grow(uint32_t p) { return p + p / 2 < APP.maxMs ? p + p / 2 : APP.maxMs; }
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1. Deadband growth
+// ──────────────────────────────────────────────────────────────────────────────
+static void quiet() {
+  Rig r(5000);
+  CHECK(r.rate.periodMs() == APP.minMs && r.rate.mode() == ADAPTIVE_FAST, "boot: %u ms, %s",
+        r.rate.periodMs(), modeName(r.rate.mode()));
+  CHECK(r.read(450, 850, 0) == APP.minMs, "the first reading changed the period");
+
+  // Edges of the band and one-count flickers 2 s apart: 3 → 0.3 °F / 1 %RH
+  // against the anchor, "6 °F per minute" against the previous reading
+  static const int16_t DT[] = { 0, 3, -3, 1, -1, 0, 2, -2, 3, 0, -3, 1 };
+  static const int16_t DH[] = { 0, -10, 10, 1, -1, 10, 0, -10, 5, -5, 0, 1 };
+  uint32_t want = APP.minMs;
+  for (size_t i = 0; i < sizeof(DT) / sizeof(DT[0]); i++) {
+    want = grow(want);
+    const uint32_t got = r.next(450 + DT[i], 850 + DH[i]);
+    CHECK(got == want && r.rate.mode() == ADAPTIVE_QUIET, "quiet step %zu: %u ms (%s), want %u", i, got,
+          modeName(r.rate.mode()), want);
+  }
+  CHECK(r.rate.periodMs() == APP.maxMs, "didn't reach the maximum: %u ms", r.rate.periodMs());
+
+  // A creep of one count per read stays quiet while within the band of the
+  // anchor, however slow
+  for (int16_t d = 1; d <= 3; d++) {
+    CHECK(r.next(450 + d, 850) == APP.maxMs && r.rate.mode() == ADAPTIVE_QUIET,
+          "creep of %d left the band", d);
+  }
+  CHECK(r.next(454, 850) == APP.maxMs / 2 && r.rate.mode() == ADAPTIVE_DRIFT,
+        "creep past the band: %u ms (%s)", r.rate.periodMs(), modeName(r.rate.mode()));
+
+  // The same for humidity, from the new anchor
+  Rig h(0);
+  h.read(450, 850, 0);
+  h.settle(450, 850);
+  for (int16_t d = 1; d <= 10; d++) h.next(450, (int16_t)(850 - d));
+  CHECK(h.rate.mode() == ADAPTIVE_QUIET, "humidity creep within the band left it");
+  CHECK(h.next(450, 839) == APP.maxMs / 2 && h.rate.mode() == ADAPTIVE_DRIFT,
+        "humidity creep past the band: %u ms (%s)", h.rate.periodMs(), modeName(h.rate.mode()));
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2. Drift: halving, down to the minimum, and a new anchor each time
+// ──────────────────────────────────────────────────────────────────────────────
+static void drift() {
+  Rig r(UINT32_MAX - 60000);         // wraps a minute in
+  r.read(450, 850, 0);
+  r.settle(450, 850);
+
+  // 0.4 °F per reading at 30 s and longer is under 1 °F per minute
+  int16_t t10 = 450;
+  uint32_t want = APP.maxMs;
+  for (int i = 0; i < 6; i++) {
+    t10 += 4;
+    want = want / 2 > APP.minMs ? want / 2 : APP.minMs;
+    const uint32_t got = r.read(t10, 850, 30000);
+    CHECK(got == want && r.rate.mode() == ADAPTIVE_DRIFT, "drift step %d: %u ms (%s), want %u", i, got,
+          modeName(r.rate.mode()), want);
+  }
+  CHECK(r.rate.periodMs() == APP.minMs, "drift didn't reach the minimum");
+
+  // The last drifted reading is the anchor: within the band of it is quiet,
+  // although it is far from where the drift started
+  CHECK(r.next(t10 + 3, 850) == grow(APP.minMs) && r.rate.mode() == ADAPTIVE_QUIET,
+        "not quiet around the new anchor: %s", modeName(r.rate.mode()));
+
+  // Humidity drifts alone, and does the same
+  r.settle(t10, 850);
+  CHECK(r.read(t10, 861, 30000) == APP.maxMs / 2 && r.rate.mode() == ADAPTIVE_DRIFT,
+        "humidity drift: %u ms (%s)", r.rate.periodMs(), modeName(r.rate.mode()));
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3. Fast: back to the minimum in one step, at and above the rate
+// ──────────────────────────────────────────────────────────────────────────────
+static void fast() {
+  struct Case {
+    int16_t  dT, dH;
+    uint32_t afterMs;
+    bool     fast;
+  };
+  static const Case CASES[] = {
+    {  5,   0, 30000, true  },   // exactly 1 °F per minute
+    {  4,   0, 30000, false },
+    { -5,   0, 30000, true  },
+    {  0,  15, 30000, true  },   // exactly 3 %RH per minute
+    {  0, -14, 30000, false },
+    {  4,  14, 30000, false },   // both under: still a drift
+    {  4,  15, 30000, true  },   // either one is enough
+    { 40,   0, 240001, false },  // a big step over a long gap
+    {  4,   0, 2000,  true  },   // just out of the band, 2 s after the last read
+    {  4,   0, 0,     true  },   // the same millisecond
+  };
+  for (const Case& c : CASES) {
+    // From the maximum, and across halMillis() wrapping right before the read
+    Rig r(UINT32_MAX - 200000);
+    r.read(450, 850, 0);
+    r.settle(450, 850);
+    r.nowMs = UINT32_MAX - c.afterMs / 2;
+    r.read(450, 850, 0);
+    const uint32_t got = r.read((int16_t)(450 + c.dT), (int16_t)(850 + c.dH), c.afterMs);
+    const uint32_t want = c.fast ? APP.minMs : APP.maxMs / 2;
+    const AdaptiveMode mode = c.fast ? ADAPTIVE_FAST : ADAPTIVE_DRIFT;
+    CHECK(got == want && r.rate.mode() == mode, "%+d °F/10, %+d %%RH/10 after %u ms: %u ms (%s), want %u (%s)",
+          c.dT, c.dH, c.afterMs, got, modeName(r.rate.mode()), want, modeName(mode));
+  }
+
+  // The fast test is against the previous reading, not the anchor: a slow
+  // creep out of the band is a drift, a door opening 2 s later is fast
+  Rig r(0);
+  r.read(450, 850, 0);
+  r.settle(450, 850);
+  r.read(453, 850, 30000);
+  CHECK(r.read(454, 850, 30000) == APP.maxMs / 2 && r.rate.mode() == ADAPTIVE_DRIFT,
+        "a one-count step out of the band in 30 s was fast");
+  CHECK(r.read(448, 850, 2000) == APP.minMs && r.rate.mode() == ADAPTIVE_FAST,
+        "0.6 °F in 2 s wasn't fast");
+  CHECK(r.next(448, 850) == grow(APP.minMs) && r.rate.mode() == ADAPTIVE_QUIET,
+        "not quiet after the fast step");
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 4. reset() after a failed read, and a pinned cadence
+// ──────────────────────────────────────────────────────────────────────────────
+static void resets() {
+  Rig r(0);
+  r.read(450, 850, 0);
+  r.settle(450, 850);
+  r.rate.reset();
+  CHECK(r.rate.periodMs() == APP.minMs && r.rate.mode() == ADAPTIVE_FAST, "reset: %u ms (%s)",
+        r.rate.periodMs(), modeName(r.rate.mode()));
+
+  // The next reading anchors: 10 °F away, an hour later, is neither drift
+  // nor fast, and doesn't grow the period either
+  CHECK(r.read(550, 700, 3600000) == APP.minMs && r.rate.mode() == ADAPTIVE_FAST,
+        "first reading after reset: %u ms (%s)", r.rate.periodMs(), modeName(r.rate.mode()));
+  CHECK(r.next(551, 701) == grow(APP.minMs) && r.rate.mode() == ADAPTIVE_QUIET,
+        "not quiet around the new anchor: %u ms (%s)", r.rate.periodMs(), modeName(r.rate.mode()));
+
+  // Failed reads in a row keep it at the minimum
+  for (int i = 0; i < 3; i++) {
+    r.next(551, 701);
+    r.rate.reset();
+    CHECK(r.rate.periodMs() == APP.minMs, "reset %d: %u ms", i, r.rate.periodMs());
+  }
+
+  // maxMs at or under minMs: fixed at minMs whatever the readings
+  for (uint32_t maxMs : { APP.minMs, APP.minMs / 2, 0u }) {
+    AdaptiveRateConfig cfg = APP;
+    cfg.maxMs = maxMs;
+    Rig f(0, cfg);
+    CHECK(f.rate.fixed(), "max %u ms: not fixed", maxMs);
+    for (int i = 0; i < 40; i++) {
+      const uint32_t got = f.read((int16_t)(450 + (i % 7 == 6 ? 20 : i % 3)), 850, 2000);
+      CHECK(got == APP.minMs, "max %u ms, step %d: %u ms", maxMs, i, got);
+      if (i % 13 == 12) f.rate.reset();
+    }
+  }
+  CHECK(!Rig(0).rate.fixed(), "the app's settings read as fixed");
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 5. Random walks against a model
+// ──────────────────────────────────────────────────────────────────────────────
+struct Model {
+  uint32_t     periodMs = APP.minMs;
+  AdaptiveMode mode     = ADAPTIVE_FAST;
+  bool         anchored = false;
+  int          anchorT = 0, anchorH = 0, lastT = 0, lastH = 0;
+  uint32_t     lastMs = 0;
+
+  void observe(int t, int h, uint32_t nowMs) {
+    if (anchored) {
+      if (abs(t - anchorT) <= APP.bandT10 && abs(h - anchorH) <= APP.bandH10) {
+        periodMs = (uint32_t) std::min<uint64_t>((uint64_t) periodMs * 3 / 2, APP.maxMs);
+        if (periodMs > APP.minMs) mode = ADAPTIVE_QUIET;
+        lastT = t, lastH = h, lastMs = nowMs;
+        return;
+      }
+      // Per minute, in double; a reading in the same millisecond counts as 1 ms on
+      const double minutes = (nowMs - lastMs ? nowMs - lastMs : 1) / 60000.0;
+      if (abs(t - lastT) / minutes >= APP.fastT10 || abs(h - lastH) / minutes >= APP.fastH10) {
+        periodMs = APP.minMs;
+        mode     = ADAPTIVE_FAST;
+      } else {
+        periodMs = std::max(periodMs / 2, APP.minMs);
+        mode     = ADAPTIVE_DRIFT;
+      }
+    }
+    anchored = true;
+    anchorT = t, anchorH = h;
+    lastT = t, lastH = h, lastMs = nowMs;
+  }
+};
+
+static void randomWalk(std::mt19937& rng, uint64_t& steps, uint64_t (&modes)[3]) {
+  AdaptiveRate rate;
+  rate.begin(APP);
+  Model model;
+  uint32_t nowMs = rng();
+  int t = 300 + (int)(rng() % 400), h = 500 + (int)(rng() % 450);
+
+  for (int seg = 0; seg < 200; seg++) {
+    // quiet, slow drift, a jump, flicker, or failed reads
+    const uint32_t kind = rng() % 5, len = 1 + rng() % 40;
+    const int dir = rng() % 2 ? 1 : -1;
+    for (uint32_t k = 0; k < len; k++) {
+      nowMs += model.periodMs + (rng() % 8 == 0 ? rng() % 5000 : 0);
+      if (kind == 4 && rng() % 2) {
+        rate.reset();
+        model = Model();
+        CHECK(rate.periodMs() == APP.minMs && rate.mode() == ADAPTIVE_FAST, "reset: %u ms (%s)",
+              rate.periodMs(), modeName(rate.mode()));
+        continue;
+      }
+      if (kind == 1 && rng() % 3 == 0) t += dir;
+      if (kind == 1 && rng() % 4 == 0) h += dir * (int)(1 + rng() % 3);
+      if (kind == 2 && k == 0) { t += dir * (int)(rng() % 40); h += dir * (int)(rng() % 100); }
+      const int ft = kind == 3 ? t + (int)(rng() % 3) - 1 : t, fh = kind == 3 ? h + (int)(rng() % 3) - 1 : h;
+
+      const uint32_t got = rate.observe((int16_t) ft, (int16_t) fh, nowMs);
+      model.observe(ft, fh, nowMs);
+      steps++;
+      modes[rate.mode()]++;
+      CHECK(got == model.periodMs && rate.periodMs() == got && rate.mode() == model.mode,
+            "step %llu (%d, %d): %u ms (%s), model %u ms (%s)", (unsigned long long) steps, ft, fh, got,
+            modeName(rate.mode()), model.periodMs, modeName(model.mode));
+      CHECK(got >= APP.minMs && got <= APP.maxMs, "period %u ms out of range", got);
+      if (checkFailures) return;
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  uint32_t seed = 1;
+  int runs = 2000;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if      (strcmp(argv[i], "--seed") == 0) seed = (uint32_t) strtoul(argv[i + 1], nullptr, 10);
+    else if (strcmp(argv[i], "--runs") == 0) runs = atoi(argv[i + 1]);
+  }
+
+  quiet();
+  drift();
+  fast();
+  resets();
+
+  std::mt19937 rng(seed);
+  uint64_t steps = 0, modes[3] = {};
+  for (int i = 0; i < runs && checkFailures == 0; i++) randomWalk(rng, steps, modes);
+
+  printf("  %d random walks from seed %u: %llu readings, %llu fast, %llu drift, %llu quiet\n", runs, seed,
+         (unsigned long long) steps, (unsigned long long) modes[ADAPTIVE_FAST],
+         (unsigned long long) modes[ADAPTIVE_DRIFT], (unsigned long long) modes[ADAPTIVE_QUIET]);
+  return checkResult("adaptive_rate_check");
+}
@@ -0,0 +1,379 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// alert_rules_check.cpp — AlertEngine and AlertQueue
+//
+//   alert_rules_check [--seed N] [--runs N]
+//
+// Feeds single rules shaped like the app's table by hand, with halMillis()
+// wrapping partway:
+//
+//   - ABOVE / BELOW values flapping across the threshold, and hovering inside
+//     the hysteresis band once firing, must not change state; a condition
+//     that lasts the hold time must, at the first read that reaches it
+//   - the hold time runs from the first read that met the condition, across
+//     failed reads and gaps, and one read that doesn't meet it restarts it
+//   - RISE / FALL stay quiet until their marks span ¾ of the window, however
+//     steep the ramp; after that a step shows at once, and they clear once
+//     the window has moved past it
+//
+// Then random ABOVE / BELOW / STALE rules on random walks around their
+// thresholds, each transition checked against a scan of the reads since the
+// previous one. AlertQueue is filled until it refuses a push, and then run
+// against a std::deque.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "../alert_rules.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string.h>
+#include <deque>
+#include <random>
+#include <vector>
+
+// One rule on its own engine, fed by hand. Not copyable: the engine keeps a
+// pointer to `rule`.
+struct Rig {
+  struct Change {
+    uint32_t ms;                     // since the start
+    bool     firing;
+    float    observed;
+  };
+
+  AlertRule           rule;
+  AlertEngine<1>      eng;
+  uint32_t            t0;
+  std::vector<Change> changes;
+
+  Rig(const AlertRule& r, uint32_t startMs) : rule(r), t0(startMs) { eng.begin(&rule, 1); }
+  Rig(const Rig&) = delete;
+
+  // Evaluate `value` `ms` after the start; true if the rule changed state
+  bool at(uint32_t ms, float value) {
+    float observed = NAN;
+    if (!eng.evaluate(0, t0 + ms, value, &observed)) return false;
+    changes.push_back({ ms, eng.firing(0), observed });
+    return true;
+  }
+
+  // value(s) every stepS seconds from fromS up to toS; returns how many
+  // transitions that made
+  template <class F>
+  size_t run(uint32_t fromS, uint32_t toS, uint32_t stepS, F value) {
+    const size_t before = changes.size();
+    for (uint32_t s = fromS; s < toS; s += stepS) at(s * 1000, value(s));
+    return changes.size() - before;
+  }
+
+  const Change& last() const { return changes.back(); }
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1. Hysteresis: `sign` is +1 for ABOVE, −1 for BELOW, and the values below
+//    are offsets from the threshold in the direction that fires
+// ──────────────────────────────────────────────────────────────────────────────
+static void hysteresis(const AlertRule& rule, float sign, uint32_t stepS, uint32_t startMs) {
+  Rig r(rule, startMs);
+  const char* name = rule.name;
+  const uint32_t H = rule.holdS;
+  const float thr = rule.threshold, h = rule.hysteresis;
+  auto at = [&](float d) { return thr + sign * d; };
+
+  // Across the threshold on every read, then past it for one read short of
+  // the hold time
+  uint32_t s = 0;
+  CHECK(r.run(s, s + 6 * H, stepS, [&](uint32_t t) { return at(t / stepS % 2 ? -0.1f * h : 0.1f * h); }) == 0,
+        "%s: flapped across the threshold", name);
+  s += 6 * H;
+  CHECK(r.run(s, s + H, stepS, [&](uint32_t) { return at(0.5f * h); }) == 0,
+        "%s: fired before its hold time", name);
+  s += H;
+  CHECK(!r.at(s * 1000, at(0.0f)), "%s: fired at the threshold itself", name);
+  s += stepS;
+
+  // Held: fires on the read that completes the hold time, with that value
+  CHECK(r.run(s, s + 3 * H, stepS, [&](uint32_t) { return at(0.5f * h); }) == 1,
+        "%s: didn't fire once", name);
+  if (!r.changes.empty()) {
+    CHECK(r.last().ms == (s + H) * 1000 && r.last().firing && r.last().observed == at(0.5f * h),
+          "%s: fired at %u ms (want %u) with %.2f", name, r.last().ms, (s + H) * 1000, r.last().observed);
+  }
+  s += 3 * H;
+
+  // Anywhere in the band, its far edge included, leaves it firing; so does
+  // a dip past it one read short of the hold time
+  CHECK(r.run(s, s + 12 * H, stepS, [&](uint32_t t) { return at(-h + (float)(t / stepS % 20) * h / 10); }) == 0,
+        "%s: cleared inside the hysteresis band", name);
+  s += 12 * H;
+  CHECK(r.run(s, s + H, stepS, [&](uint32_t) { return at(-1.5f * h); }) == 0,
+        "%s: cleared before its hold time", name);
+  s += H;
+  CHECK(!r.at(s * 1000, at(-0.5f * h)), "%s: cleared inside the band", name);
+  s += stepS;
+
+  CHECK(r.run(s, s + 3 * H, stepS, [&](uint32_t) { return at(-1.1f * h); }) == 1,
+        "%s: didn't clear once", name);
+  if (r.changes.size() == 2) {
+    CHECK(r.last().ms == (s + H) * 1000 && !r.last().firing && r.last().observed == at(-1.1f * h),
+          "%s: cleared at %u ms (want %u) with %.2f", name, r.last().ms, (s + H) * 1000, r.last().observed);
+  }
+  s += 3 * H;
+
+  // Cleared, up to the threshold itself stays quiet
+  CHECK(r.run(s, s + 12 * H, stepS, [&](uint32_t t) { return at(-h + (float)(t / stepS % 11) * h / 10); }) == 0,
+        "%s: fired at or short of the threshold", name);
+  CHECK(r.changes.size() == 2, "%s: %zu transitions (want 2)", name, r.changes.size());
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2. Hold time to the millisecond, across failed reads and gaps
+// ──────────────────────────────────────────────────────────────────────────────
+static void holdTimes() {
+  const AlertRule above = { "hold", ALERT_ABOVE, ALERT_TEMP, ALERT_ROOM, 50.0f, 1.0f, 0, 600 };
+  Rig r(above, UINT32_MAX - 300000);   // wraps 5 min in
+
+  r.at(0, 51.0f);
+  CHECK(!r.at(599999, 51.0f), "fired 1 ms before the hold time");
+  CHECK(r.at(600000, 51.0f), "didn't fire at the hold time");
+
+  // Failed reads neither hold the condition nor break it
+  r.at(700000, 48.0f);
+  for (uint32_t ms = 701000; ms < 1300000; ms += 1000) {
+    CHECK(!r.at(ms, NAN), "changed on a failed read at %u ms", ms);
+  }
+  CHECK(r.at(1300000, 48.0f), "a failed read restarted the hold time");
+
+  // A long gap: the first read after the hold time ran out changes state
+  r.at(2000000, 51.0f);
+  CHECK(r.at(2000000 + 3600000, 51.5f) && r.last().observed == 51.5f, "didn't fire after a gap");
+
+  // One read short of the condition restarts the hold time
+  r.at(6000000, 48.0f);
+  r.at(6300000, 49.0f);
+  r.at(6300001, 48.0f);
+  CHECK(!r.at(6900000, 48.0f), "a read inside the band didn't restart the hold time");
+  CHECK(r.at(6900001, 48.0f), "didn't clear at the restarted hold time");
+  CHECK(r.changes.size() == 4, "%zu transitions (want 4)", r.changes.size());
+
+  // No hold time (the app's STALE "sensor" rule): the first read decides
+  const AlertRule stale = { "sensor", ALERT_STALE, ALERT_TEMP, ALERT_ROOM, 60.0f, 0.0f, 0, 0 };
+  Rig st(stale, UINT32_MAX);
+  CHECK(!st.at(0, 60.0f), "STALE fired at its threshold");
+  CHECK(st.at(1000, 61.0f) && st.last().firing, "STALE didn't fire past its threshold");
+  CHECK(!st.at(2000, 60.0f), "STALE cleared at its threshold");
+  CHECK(st.at(3000, 0.0f) && !st.last().firing, "STALE didn't clear on a good read");
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3. RISE / FALL: `sign` as for hysteresis(), rates in units per hour
+// ──────────────────────────────────────────────────────────────────────────────
+static void rates(const AlertRule& rule, float sign, uint32_t stepS, uint32_t startMs) {
+  Rig r(rule, startMs);
+  const char* name = rule.name;
+  const uint32_t W = rule.windowS, span = W / 4 * 3, settle = W + W / ALERT_RATE_MARKS;
+  const uint32_t fireAt = span + rule.holdS;
+  const float clearBelow = rule.threshold - rule.hysteresis;
+  float base = 45.0f;
+  auto ramp = [&](uint32_t from, float perHour) {
+    return [=](uint32_t t) { return base + sign * perHour * (float)(t - from) / 3600; };
+  };
+
+  // Failed reads first: the window starts at the first good one
+  uint32_t s = 0;
+  CHECK(r.run(s, s + W, stepS, [](uint32_t) { return NAN; }) == 0, "%s: changed on failed reads", name);
+  s += W;
+
+  // Ten times the threshold still waits for the span, and stays firing
+  // while the ramp goes on
+  const float steep = 10 * rule.threshold;
+  CHECK(r.run(s, s + fireAt, stepS, ramp(s, steep)) == 0, "%s: fired before its marks spanned %u s", name, span);
+  CHECK(r.run(s + fireAt, s + 3 * W, stepS, ramp(s, steep)) == 1, "%s: didn't fire once on a steep ramp", name);
+  if (!r.changes.empty()) {
+    CHECK(r.last().ms == (s + fireAt) * 1000 && r.last().firing, "%s: fired at %u ms (want %u)",
+          name, r.last().ms, (s + fireAt) * 1000);
+    CHECK(fabsf(r.last().observed - sign * steep) < 0.01f * steep, "%s: rate %.3f/h (want %.3f)",
+          name, r.last().observed, sign * steep);
+  }
+  base = ramp(s, steep)(s + 3 * W);
+  s += 3 * W;
+
+  // Flat: clears once the rate drops past the hysteresis, at the latest when
+  // every mark is on the flat
+  CHECK(r.run(s, s + 2 * W, stepS, [&](uint32_t) { return base; }) == 1, "%s: didn't clear once flat", name);
+  if (r.changes.size() == 2) {
+    CHECK(!r.last().firing && r.last().ms <= (s + settle + rule.holdS) * 1000,
+          "%s: cleared %u s into the flat (want ≤ %u)", name, r.last().ms / 1000 - s, settle + rule.holdS);
+    CHECK(sign * r.last().observed < clearBelow, "%s: cleared at %.3f/h", name, r.last().observed);
+  }
+  s += 2 * W;
+
+  // Just under the threshold for hours
+  CHECK(r.run(s, s + 4 * W, stepS, ramp(s, 0.95f * rule.threshold)) == 0,
+        "%s: fired below its threshold", name);
+  base = ramp(s, 0.95f * rule.threshold)(s + 4 * W);
+  s += 4 * W;
+  CHECK(r.run(s, s + 2 * W, stepS, [&](uint32_t) { return base; }) == 0, "%s: fired on the flat", name);
+  s += 2 * W;
+
+  // Past the span, a step of 1.5 × threshold·window shows on the read after
+  // the hold time, and clears once the window has moved past it
+  base += sign * 1.5f * rule.threshold * W / 3600;
+  CHECK(r.run(s, s + 3 * W, stepS, [&](uint32_t) { return base; }) == 2, "%s: step didn't fire and clear", name);
+  if (r.changes.size() == 4) {
+    CHECK(r.changes[2].ms == (s + rule.holdS) * 1000 && r.changes[2].firing,
+          "%s: step fired at %u ms (want %u)", name, r.changes[2].ms, (s + rule.holdS) * 1000);
+    CHECK(r.last().ms <= (s + settle + rule.holdS) * 1000, "%s: step cleared %u s on (want ≤ %u)",
+          name, r.last().ms / 1000 - s, settle + rule.holdS);
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 4. Random rules against a scan of the reads since the last transition
+// ──────────────────────────────────────────────────────────────────────────────
+struct Stats {
+  uint64_t reads = 0, transitions = 0, refused = 0;
+};
+
+// Whether a rule that is (not) firing is asked to change by value v
+static bool wants(const AlertRule& r, bool firing, float v) {
+  if (r.kind == ALERT_BELOW) return firing ? v > r.threshold + r.hysteresis : v < r.threshold;
+  return firing ? v < r.threshold - r.hysteresis : v > r.threshold;
+}
+
+static void randomRule(std::mt19937& rng, Stats& st) {
+  static const AlertKind KINDS[] = { ALERT_ABOVE, ALERT_BELOW, ALERT_STALE };
+  static const float     HYST[]  = { 0.0f, 0.5f, 1.0f, 2.0f };
+  static const uint32_t  HOLD[]  = { 0, 60, 600, 1800 };
+  AlertRule r = { "random", KINDS[rng() % 3], ALERT_TEMP, ALERT_ROOM, 0, 0, 0, 0 };
+  r.threshold  = r.kind == ALERT_STALE ? 60.0f : (float)(rng() % 100);
+  r.hysteresis = HYST[rng() % 4];
+  r.holdS      = HOLD[rng() % 4];
+
+  AlertEngine<1> eng;
+  eng.begin(&r, 1);
+  struct Read {
+    uint32_t ms;
+    float    v;
+  };
+  std::vector<Read> reads;
+  size_t since = 0;                  // first read after the last transition
+  bool firing = false;
+  uint32_t ms = rng();
+  std::uniform_real_distribution<float> level(-3.0f, 3.0f), noise(-0.3f, 0.3f);
+
+  for (int seg = 0; seg < 200; seg++) {
+    // A level around the threshold, held for up to twice the hold time
+    const float at = r.threshold + level(rng) * (r.hysteresis > 1.0f ? r.hysteresis : 1.0f);
+    const uint32_t endMs = ms + (uint32_t)(rng() % (2 * r.holdS + 60)) * 1000;
+    while ((int32_t)(endMs - ms) > 0) {
+      const uint32_t pick = rng() % 100;
+      ms += pick < 80 ? 2000 : pick < 98 ? rng() % 30000 : rng() % (2 * r.holdS * 1000 + 1000);
+      const float v = rng() % 20 == 0 ? NAN : at + noise(rng);
+      reads.push_back({ ms, v });
+      st.reads++;
+
+      bool expect = false;
+      if (!isnan(v) && wants(r, firing, v)) {
+        size_t start = reads.size() - 1;
+        for (size_t j = start; j-- > since;) {
+          if (isnan(reads[j].v)) continue;
+          if (!wants(r, firing, reads[j].v)) break;
+          start = j;
+        }
+        expect = ms - reads[start].ms >= r.holdS * 1000;
+      }
+      float observed = NAN;
+      const bool changed = eng.evaluate(0, ms, v, &observed);
+      CHECK(changed == expect, "kind %d, threshold %.1f, hysteresis %.1f, hold %u s: read %zu (%.2f) %s",
+            r.kind, r.threshold, r.hysteresis, r.holdS, reads.size(), v,
+            changed ? "changed state" : "didn't change state");
+      if (changed != expect) return;
+      if (changed) {
+        CHECK(observed == v, "observed %.2f for a read of %.2f", observed, v);
+        firing = !firing;
+        since  = reads.size();
+        st.transitions++;
+      }
+    }
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 5. AlertQueue: a full queue refuses, and otherwise it's a FIFO
+// ──────────────────────────────────────────────────────────────────────────────
+static AlertEvent event(uint32_t n) { return { (uint8_t)(n % ALERT_MAX_RULES), n % 2 == 0, n / 4.0f, n }; }
+
+template <size_t N>
+static void queue(std::mt19937& rng, Stats& st) {
+  AlertQueue<N> q;
+  AlertEvent e;
+  for (uint32_t n = 0; n < N; n++) CHECK(q.push(event(n)), "queue of %zu: push %u refused", N, n);
+  CHECK(!q.push(event(N)), "queue of %zu: push onto a full queue accepted", N);
+  CHECK(q.size() == N, "queue of %zu: size %zu when full", N, q.size());
+  for (uint32_t n = 0; n < N; n++) {
+    CHECK(q.front(&e) && e.ts == n && e.rule == event(n).rule && e.firing == event(n).firing,
+          "queue of %zu: event %u came out wrong after a refused push", N, n);
+    q.pop();
+  }
+  CHECK(!q.front(&e) && q.size() == 0, "queue of %zu: not empty after draining", N);
+
+  // Pushes a little more often than pops, so it spends time full
+  std::deque<uint32_t> model;
+  uint32_t next = N + 1;
+  for (int op = 0; op < 200000; op++) {
+    if (rng() % 100 < 55) {
+      const bool ok = q.push(event(next));
+      CHECK(ok == (model.size() < N), "queue of %zu: push %s at size %zu", N, ok ? "accepted" : "refused",
+            model.size());
+      if (ok) model.push_back(next);
+      else st.refused++;
+      next++;
+    } else {
+      const bool has = q.front(&e);
+      CHECK(has == !model.empty(), "queue of %zu: front() %s at size %zu", N, has ? "found an event" : "found none",
+            model.size());
+      if (has && !model.empty()) {
+        CHECK(e.ts == model.front(), "queue of %zu: front() gave %u, want %u", N, e.ts, model.front());
+        q.pop();
+        model.pop_front();
+      }
+    }
+    CHECK(q.size() == model.size(), "queue of %zu: size %zu, want %zu", N, q.size(), model.size());
+    if (checkFailures) return;
+  }
+}
+
+int main(int argc, char** argv) {
+  uint32_t seed = 1;
+  int runs = 400;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if      (strcmp(argv[i], "--seed") == 0) seed = (uint32_t) strtoul(argv[i + 1], nullptr, 10);
+    else if (strcmp(argv[i], "--runs") == 0) runs = atoi(argv[i + 1]);
+  }
+
+  // The app's rules (app.cpp), some with the hold time cut so rates fire on
+  // the read their marks reach the span
+  const AlertRule sprouting = { "sprouting", ALERT_ABOVE, ALERT_TEMP,     ALERT_ROOM, 50.0f, 1.0f, 0,  600 };
+  const AlertRule dry       = { "dry",       ALERT_BELOW, ALERT_HUMIDITY, ALERT_ROOM, 80.0f, 2.0f, 0, 1800 };
+  const AlertRule warming   = { "warming",   ALERT_RISE,  ALERT_TEMP,     ALERT_ROOM,  2.0f, 0.5f, 3600, 300 };
+  const AlertRule warming0  = { "warming0",  ALERT_RISE,  ALERT_TEMP,     ALERT_ROOM,  2.0f, 0.5f, 3600,   0 };
+  const AlertRule cooling   = { "cooling",   ALERT_FALL,  ALERT_TEMP,     ALERT_ROOM,  2.0f, 0.5f, 3600,   0 };
+  const AlertRule drying    = { "drying",    ALERT_FALL,  ALERT_HUMIDITY, ALERT_ROOM,  5.0f, 1.0f, 1800,  60 };
+
+  hysteresis(sprouting, 1.0f, 2, UINT32_MAX - 3600000);
+  hysteresis(dry, -1.0f, 3, 0);
+  holdTimes();
+  rates(warming, 1.0f, 2, UINT32_MAX - 7200000);
+  rates(warming0, 1.0f, 2, 0);
+  rates(cooling, -1.0f, 10, UINT32_MAX / 2);
+  rates(drying, -1.0f, 30, UINT32_MAX - 1000);
+
+  std::mt19937 rng(seed);
+  Stats st;
+  for (int i = 0; i < runs && checkFailures == 0; i++) randomRule(rng, st);
+  queue<ALERT_MAX_RULES * 2>(rng, st);
+  queue<3>(rng, st);
+  queue<1>(rng, st);
+
+  printf("  %d random rules from seed %u: %llu reads, %llu transitions; %llu pushes refused by full queues\n",
+         runs, seed, (unsigned long long) st.reads, (unsigned long long) st.transitions,
+         (unsigned long long) st.refused);
+  return checkResult("alert_rules_check");
+}
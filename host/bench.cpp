@@ -0,0 +1,1265 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// bench.cpp — latency / allocation / output-size benchmarks for app.cpp
+//
+//   potato_bench [--iterations N] [--clients N] [--slow-clients N] [--load-seconds S]
+//                [--export-runs N] [--port P] [--fleet-units N] [--fleet-seconds S]
+//                [--label TEXT] [--json FILE]
+//
+// Runs against the host HAL (hal_host.cpp), after two virtual days of
+// sampling so every history tier and the flash sample log (in a temporary
+// directory) hold real data:
+//
+//   micro   each app step and HTTP handler, N times: p50/p99/max latency,
+//           heap allocations per call, bytes produced per call (HTTP
+//           response bytes, or estimated SPI bytes for the display)
+//   load    N local clients polling /sensor-data over keep-alive sockets,
+//           plus M slow ones, while sampling runs in real time: throughput,
+//           request latency, 503s, and how late the sensor step ran
+//           relative to its deadline
+//   export  /export?format=bin and =csv fetched whole over a local socket:
+//           samples per second and bytes per sample
+//   kernels psychro.h time (and TSC ticks, on x86-64) per evaluation next
+//           to the expf/logf version (psychro_check covers its accuracy);
+//           lttb.h input points per second, two series, 10 000 down to
+//           200; trace.h spans, 1000 per call (two events each)
+//   text    OLED text drawn GFX-style (a window per lit font pixel) and as
+//           glyph_atlas.h blits: SPI bytes, address windows and time for a
+//           full page and a one-digit update
+//   sensor  one sample period of /sensor-data polls (1, 4 and 16 per
+//           sample), serialized per request vs the cached payload vs ETag
+//           revalidation: time and response bytes per period
+//   fleet   potato_fleet's scraper (fleet.h) against N local stand-in
+//           units, some of them stalled: scrapes per second, scrape
+//           latency, timeouts, and stored bytes per reading
+//
+// A readable table goes to stderr; JSON goes to stdout (or --json FILE) for
+// tools/bench_compare.py. Host numbers are for spotting regressions
+// between builds, not for predicting ESP32 timings. Exits 1 if a
+// /sensor-data response differs from the cached one.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "hal_host.h"
+#include "fleet.h"
+#include "../app.h"
+#include "../glyph_atlas.h"
+#include "../lttb.h"
+#include "../psychro.h"
+#include "../sample_log.h"
+#include "../trace.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1) Allocation counting. malloc/calloc/realloc are interposed (operator new
+//    goes through malloc too) and counted only while armed, on this thread.
+// ──────────────────────────────────────────────────────────────────────────────
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+
+static thread_local bool allocArmed = false;
+static thread_local uint64_t allocCount = 0;
+
+extern "C" void* malloc(size_t n)            { if (allocArmed) allocCount++; return __libc_malloc(n); }
+extern "C" void* calloc(size_t n, size_t m)  { if (allocArmed) allocCount++; return __libc_calloc(n, m); }
+extern "C" void* realloc(void* p, size_t n)  { if (allocArmed) allocCount++; return __libc_realloc(p, n); }
+
+static uint64_t wallNanos() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2) Results
+// ──────────────────────────────────────────────────────────────────────────────
+struct Summary {
+  uint64_t p50 = 0, p99 = 0, max = 0;
+  double   mean = 0;
+};
+
+static Summary summarize(std::vector<uint64_t>& v) {
+  Summary s;
+  if (v.empty()) return s;
+  std::sort(v.begin(), v.end());
+  s.p50 = v[v.size() / 2];
+  s.p99 = v[std::min(v.size() - 1, v.size() * 99 / 100)];
+  s.max = v.back();
+  uint64_t total = 0;
+  for (uint64_t x : v) total += x;
+  s.mean = (double) total / v.size();
+  return s;
+}
+
+struct Bench {
+  std::string name;
+  std::vector<uint64_t> ns;
+  uint64_t allocs = 0;
+  uint64_t bytes  = 0;
+
+  explicit Bench(const char* n, size_t reserve) : name(n) { ns.reserve(reserve); }
+
+  // Time one call; `produced` reports the bytes it generated
+  template <typename F>
+  void run(F call) {
+    const uint64_t a0 = allocCount;
+    allocArmed = true;
+    const uint64_t t0 = wallNanos();
+    const uint64_t produced = call();
+    const uint64_t dt = wallNanos() - t0;
+    allocArmed = false;
+    allocs += allocCount - a0;
+    bytes  += produced;
+    ns.push_back(dt);
+  }
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3) The cooperative loop of sim_main.cpp, without pacing or HTTP
+// ──────────────────────────────────────────────────────────────────────────────
+static uint64_t nextSensor = 0, nextDisplay = 1000000;
+
+static void advanceTo(uint64_t endUs) {
+  while (simMicros() < endUs) {
+    const uint64_t now = simMicros();
+    if (now >= nextSensor) nextSensor = now + (uint64_t) std::max<uint32_t>(appSensorStep(), 1) * 1000;
+    if (simTakeDisplayNotify() || now >= nextDisplay) {
+      appDisplayStep();
+      nextDisplay = now + 1000000;
+    }
+    appWebStep();
+    simSetMicros(std::min(std::min(nextSensor, nextDisplay), endUs));
+  }
+}
+
+// One loop pass per virtual deadline, timing each step of the passes that
+// publish a new sample separately from idle passes.
+static void benchLoop(size_t samples, Bench& passSample, Bench& passIdle,
+                      Bench& sensor, Bench& display, Bench& web) {
+  const SimStats& st = simStats();
+  size_t taken = 0;
+  while (taken < samples) {
+    const uint64_t now = simMicros();
+    const uint32_t before = snapshot.version();
+    const uint64_t t0 = wallNanos();
+    const uint64_t a0 = allocCount;
+    const uint64_t spi0 = st.spiBytes, sse0 = st.streamBytes;
+
+    uint64_t sensorNs = 0, displayNs = 0, webNs = 0, spi = 0;
+    uint64_t sensorAllocs = 0, displayAllocs = 0;
+    bool ranSensor = false;
+    allocArmed = true;
+    if (now >= nextSensor) {
+      const uint64_t s0 = wallNanos(), c0 = allocCount;
+      nextSensor = now + (uint64_t) std::max<uint32_t>(appSensorStep(), 1) * 1000;
+      sensorNs = wallNanos() - s0;
+      sensorAllocs = allocCount - c0;
+      ranSensor = true;
+    }
+    if (simTakeDisplayNotify() || now >= nextDisplay) {
+      const uint64_t s0 = wallNanos(), c0 = allocCount;
+      appDisplayStep();
+      displayNs = wallNanos() - s0;
+      displayAllocs = allocCount - c0;
+      spi = st.spiBytes - spi0;
+      nextDisplay = now + 1000000;
+    }
+    const uint64_t w0 = wallNanos(), c0 = allocCount;
+    appWebStep();
+    webNs = wallNanos() - w0;
+    const uint64_t webAllocs = allocCount - c0;
+    allocArmed = false;
+
+    const uint64_t total  = wallNanos() - t0;
+    const uint64_t allocs = allocCount - a0;
+    const uint64_t sse    = st.streamBytes - sse0;
+    if (snapshot.version() != before) {
+      passSample.ns.push_back(total);
+      passSample.allocs += allocs;
+      passSample.bytes  += spi + sse;
+      sensor.ns.push_back(sensorNs);
+      sensor.allocs += sensorAllocs;
+      display.ns.push_back(displayNs);
+      display.allocs += displayAllocs;
+      display.bytes  += spi;
+      web.ns.push_back(webNs);
+      web.allocs += webAllocs;
+      web.bytes  += sse;
+      taken++;
+    } else if (ranSensor) {
+      passIdle.ns.push_back(total);
+      passIdle.allocs += allocs;
+    }
+    simSetMicros(std::min(nextSensor, nextDisplay));
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 4) Load scenario. Fast clients poll /sensor-data back to back over one
+//    keep-alive connection each; slow clients stand in for phones on bad
+//    Wi-Fi, alternately dribbling a request head a byte at a time and
+//    reading the page a few hundred bytes at a time. A fast client turned
+//    away with 503 (pool full) or whose connection was closed reconnects.
+// ──────────────────────────────────────────────────────────────────────────────
+struct LoadResult {
+  uint64_t requests = 0, errors = 0, bytes = 0;
+  uint64_t rejected = 0, reconnects = 0;
+  std::vector<uint64_t> latencyNs;     // fast clients, request sent → response read
+  std::vector<uint64_t> slowNs;        // slow clients, connect → response read
+  uint64_t slowErrors = 0;
+  std::vector<uint64_t> latenessNs;    // sensor step start − deadline (wall)
+  uint64_t samples = 0, samplesExpected = 0;
+  double   seconds = 0;
+};
+
+struct ClientStats {
+  std::vector<uint64_t> ns;
+  uint64_t bytes = 0, errors = 0, rejected = 0, reconnects = 0;
+};
+
+static std::atomic<bool> clientsStop{false};
+static const uint32_t SLOW_STEP_MS = 40;      // between a slow client's bytes / reads
+
+static int connectLocal(int port, int rcvbuf = 0) {
+  sockaddr_in addr = {};
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  if (rcvbuf) setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  if (connect(fd, (sockaddr*) &addr, sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Read one Content-Length response; `chunk` > 0 reads that much per
+// SLOW_STEP_MS. Returns the status code (0 = connection closed or garbled)
+// and sets *closing if the server said it will close.
+static int readResponse(int fd, char* buf, size_t cap, size_t chunk, size_t* total, bool* closing) {
+  size_t len = 0;
+  const char* headEnd = nullptr;
+  while (!headEnd) {
+    if (len + 1 >= cap) return 0;
+    const ssize_t n = recv(fd, buf + len, chunk ? std::min(chunk, cap - 1 - len) : cap - 1 - len, 0);
+    if (n <= 0) return 0;
+    len += n;
+    buf[len] = '\0';
+    headEnd = strstr(buf, "\r\n\r\n");
+    if (!headEnd && chunk) usleep(SLOW_STEP_MS * 1000);
+  }
+  if (strncmp(buf, "HTTP/1.1 ", 9) != 0) return 0;
+  const int status = atoi(buf + 9);
+  const char* cl = strcasestr(buf, "Content-Length: ");
+  size_t body = cl && cl < headEnd ? strtoul(cl + 16, nullptr, 10) : 0;
+  *closing = strcasestr(buf, "Connection: close") != nullptr;
+  const size_t head = headEnd + 4 - buf;
+  size_t have = len - head;
+  while (have < body) {
+    if (chunk) usleep(SLOW_STEP_MS * 1000);
+    const ssize_t n = recv(fd, buf, chunk ? std::min(chunk, cap) : cap, 0);
+    if (n <= 0) return 0;
+    have += n;
+  }
+  *total += head + body;
+  return status;
+}
+
+static void fastClient(int port, ClientStats* st) {
+  static const char req[] = "GET /sensor-data HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  char buf[4096];
+  int fd = -1;
+  while (!clientsStop.load(std::memory_order_relaxed)) {
+    if (fd < 0 && (fd = connectLocal(port)) < 0) {
+      st->errors++;
+      usleep(10000);
+      continue;
+    }
+    const uint64_t t0 = wallNanos();
+    bool closing = false;
+    const int status = send(fd, req, sizeof(req) - 1, MSG_NOSIGNAL) == (ssize_t)(sizeof(req) - 1)
+                     ? readResponse(fd, buf, sizeof(buf), 0, &st->bytes, &closing) : 0;
+    if (status == 200) st->ns.push_back(wallNanos() - t0);
+    if (status == 503) st->rejected++;
+    else if (status == 0) st->reconnects++;        // evicted or timed out: a browser retries
+    else if (status != 200) st->errors++;
+    if (status != 200 || closing) {
+      close(fd);
+      fd = -1;
+      if (status == 503) usleep(20000);
+    }
+  }
+  if (fd >= 0) close(fd);
+}
+
+static void slowClient(int port, bool dribble, ClientStats* st) {
+  static const char headReq[] = "GET /sensor-data HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+  static const char pageReq[] = "GET / HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+  char buf[8192];
+  while (!clientsStop.load(std::memory_order_relaxed)) {
+    const uint64_t t0 = wallNanos();
+    const int fd = connectLocal(port, dribble ? 0 : 1024);
+    bool ok = fd >= 0;
+    if (ok && dribble) {
+      for (size_t i = 0; ok && i < sizeof(headReq) - 1 && !clientsStop.load(); i++) {
+        ok = send(fd, headReq + i, 1, MSG_NOSIGNAL) == 1;
+        usleep(SLOW_STEP_MS * 1000);
+      }
+    } else if (ok) {
+      ok = send(fd, pageReq, sizeof(pageReq) - 1, MSG_NOSIGNAL) == (ssize_t)(sizeof(pageReq) - 1);
+    }
+    // A 503 can arrive before the request is out; read whatever came back
+    bool closing = false;
+    const int status = fd >= 0 ? readResponse(fd, buf, sizeof(buf), dribble ? 0 : 256, &st->bytes, &closing) : 0;
+    if (fd >= 0) close(fd);
+    if (status == 200)      st->ns.push_back(wallNanos() - t0);
+    else if (status == 503) { st->rejected++; usleep(20000); }
+    else if (!clientsStop.load()) st->errors++;
+  }
+}
+
+static LoadResult runLoad(int port, int clients, int slowClients, double seconds) {
+  LoadResult r;
+  std::vector<ClientStats> fast(clients), slow(slowClients);
+  std::vector<std::thread> threads;
+
+  // Virtual time follows wall time from here on
+  const uint64_t wall0 = wallNanos() / 1000, virt0 = simMicros();
+  nextSensor = std::max(nextSensor, virt0);
+  const uint64_t endUs = virt0 + (uint64_t)(seconds * 1e6);
+  const uint32_t version0 = snapshot.version();
+
+  clientsStop = false;
+  for (int i = 0; i < clients; i++)     threads.emplace_back(fastClient, port, &fast[i]);
+  for (int i = 0; i < slowClients; i++) threads.emplace_back(slowClient, port, i % 2 == 0, &slow[i]);
+
+  while (simMicros() < endUs) {
+    simSetMicros(virt0 + (wallNanos() / 1000 - wall0));
+    const uint64_t now = simMicros();
+    if (now >= nextSensor) {
+      r.latenessNs.push_back((now - nextSensor) * 1000);
+      nextSensor = now + (uint64_t) std::max<uint32_t>(appSensorStep(), 1) * 1000;
+    }
+    if (simTakeDisplayNotify() || now >= nextDisplay) {
+      appDisplayStep();
+      nextDisplay = now + 1000000;
+    }
+    appWebStep();
+
+    const uint64_t next = std::min(std::min(nextSensor, nextDisplay), endUs);
+    const uint64_t nowWall = virt0 + (wallNanos() / 1000 - wall0);
+    simHttpPoll(next > nowWall ? next - nowWall : 0);
+  }
+
+  // Serve the stragglers while the clients notice they should stop
+  clientsStop = true;
+  std::atomic<bool> joined{false};
+  std::thread joiner([&] {
+    for (std::thread& t : threads) t.join();
+    joined = true;
+  });
+  while (!joined.load()) simHttpPoll(1000);
+  joiner.join();
+
+  r.seconds = seconds;
+  r.samples = snapshot.version() - version0;
+  r.samplesExpected = (uint64_t)(seconds / 2.0);
+  for (const ClientStats& c : fast) {
+    r.requests   += c.ns.size();
+    r.errors     += c.errors;
+    r.bytes      += c.bytes;
+    r.rejected   += c.rejected;
+    r.reconnects += c.reconnects;
+    r.latencyNs.insert(r.latencyNs.end(), c.ns.begin(), c.ns.end());
+  }
+  for (const ClientStats& c : slow) {
+    r.slowErrors += c.errors;
+    r.rejected   += c.rejected;
+    r.slowNs.insert(r.slowNs.end(), c.ns.begin(), c.ns.end());
+  }
+  return r;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 5) Export throughput. A client thread fetches the whole export while this
+//    thread serves it; samples are counted from the decoded body afterwards.
+// ──────────────────────────────────────────────────────────────────────────────
+struct ExportResult {
+  uint64_t samples = 0, bytes = 0;      // per run (body bytes, de-chunked)
+  std::vector<uint64_t> ns;             // request sent → last byte, per run
+  bool     ok = true;
+};
+
+static bool fetchAll(int port, const char* target, std::string* body) {
+  char req[128];
+  const int reqLen = snprintf(req, sizeof(req),
+                              "GET %s HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n", target);
+
+  std::string raw;
+  int fd = connectLocal(port);
+  bool ok = fd >= 0 && send(fd, req, reqLen, MSG_NOSIGNAL) == reqLen;
+  char buf[16384];
+  ssize_t n;
+  while (ok && (n = recv(fd, buf, sizeof(buf), 0)) > 0) raw.append(buf, n);
+  if (fd >= 0) close(fd);
+  if (!ok || raw.compare(0, 12, "HTTP/1.1 200") != 0) return false;
+
+  // De-chunk
+  size_t at = raw.find("\r\n\r\n");
+  if (at == std::string::npos) return false;
+  at += 4;
+  body->clear();
+  for (;;) {
+    const size_t len = strtoul(raw.c_str() + at, nullptr, 16);
+    at = raw.find("\r\n", at);
+    if (at == std::string::npos) return false;
+    at += 2;
+    if (len == 0) return true;
+    if (at + len > raw.size()) return false;
+    body->append(raw, at, len);
+    at += len + 2;
+  }
+}
+
+static uint64_t countBinSamples(const std::string& body) {
+  uint64_t n = 0;
+  size_t at = 16;                              // export header
+  LogFrameHeader h;
+  while (at + sizeof(h) <= body.size()) {
+    memcpy(&h, body.data() + at, sizeof(h));
+    const uint8_t* payload = (const uint8_t*) body.data() + at + sizeof(h);
+    if (h.magic != LOG_MAGIC || at + sizeof(h) + h.len > body.size()) return 0;
+    LogFrameHeader zeroed = h;
+    zeroed.crc = 0;
+    if (logCrc32(logCrc32(0, &zeroed, sizeof(zeroed)), payload, h.len) != h.crc) return 0;
+    n += logDecodeFrame(h, payload, [](const HistSample&) {});
+    at += sizeof(h) + h.len;
+  }
+  return n;
+}
+
+static ExportResult runExport(int port, const char* target, bool csv, int runs) {
+  ExportResult r;
+  for (int i = 0; i < runs && r.ok; i++) {
+    std::string body;
+    std::atomic<bool> done{false};
+    uint64_t ns = 0;
+    bool ok = false;
+    std::thread client([&] {
+      const uint64_t t0 = wallNanos();
+      ok = fetchAll(port, target, &body);
+      ns = wallNanos() - t0;
+      done = true;
+    });
+    while (!done.load()) simHttpPoll(1000);
+    client.join();
+
+    const uint64_t samples = csv ? std::count(body.begin(), body.end(), '\n') - 1
+                                 : countBinSamples(body);
+    if (!ok || samples == 0 || (i > 0 && samples != r.samples)) r.ok = false;
+    r.samples = samples;
+    r.bytes   = body.size();
+    r.ns.push_back(ns);
+  }
+  return r;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 6) Psychrometric kernels. The float version is what app.cpp would
+//    otherwise run per sample (expf + logf).
+// ──────────────────────────────────────────────────────────────────────────────
+struct KernelResult {
+  double fixedNs = 0, floatNs = 0;       // per evaluation
+  double fixedTicks = 0, floatTicks = 0; // TSC per evaluation (0 = no TSC)
+};
+
+static Psychro floatDerive(float tC, float rh) {
+  const float es = 611.2f * expf(17.62f * tC / (243.12f + tC));
+  const float e  = es * rh / 100.0f;
+  const float g  = logf(e / 611.2f);
+  Psychro p;
+  p.dew10C = (int16_t) lroundf(2431.2f * g / (17.62f - g));
+  p.ah100  = (uint32_t) lroundf(216.679f * e / (tC + 273.15f));
+  p.vpdPa  = (uint32_t) lroundf(es - e);
+  return p;
+}
+
+static uint64_t ticks() {
+#if defined(__x86_64__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static KernelResult runKernels(size_t iterations, Bench& fixedBench, Bench& floatBench) {
+  KernelResult r;
+
+  // Batches of EVALS pseudo-random readings over the sensors' whole range
+  // (−40…125 °C, 0…100 %RH)
+  static const size_t EVALS = 1000;
+  static int16_t  t10s[EVALS];
+  static uint16_t h10s[EVALS];
+  uint32_t seed = 1;
+  for (size_t i = 0; i < EVALS; i++) {
+    seed = seed * 1664525 + 1013904223;
+    t10s[i] = (int16_t)(-400 + (int)(seed >> 8) % 1651);
+    h10s[i] = (uint16_t)((seed >> 20) % 1001);
+  }
+  volatile uint32_t sink = 0;
+  uint64_t fixedTicks = 0, floatTicks = 0;
+  for (size_t i = 0; i < iterations / 10 + 1; i++) {
+    uint64_t t0 = ticks();
+    fixedBench.run([&] {
+      uint32_t acc = 0;
+      for (size_t k = 0; k < EVALS; k++) {
+        const Psychro p = psychroDerive(t10s[k], h10s[k]);
+        acc += (uint32_t) p.dew10C + p.ah100 + p.vpdPa;
+      }
+      sink = sink + acc;
+      return (uint64_t) 0;
+    });
+    fixedTicks += ticks() - t0;
+    t0 = ticks();
+    floatBench.run([&] {
+      uint32_t acc = 0;
+      for (size_t k = 0; k < EVALS; k++) {
+        const Psychro p = floatDerive(t10s[k] / 10.0f, h10s[k] / 10.0f);
+        acc += (uint32_t) p.dew10C + p.ah100 + p.vpdPa;
+      }
+      sink = sink + acc;
+      return (uint64_t) 0;
+    });
+    floatTicks += ticks() - t0;
+  }
+  const size_t batches = fixedBench.ns.size();
+  std::vector<uint64_t> a = fixedBench.ns, b = floatBench.ns;
+  r.fixedNs    = summarize(a).p50 / (double) EVALS;
+  r.floatNs    = summarize(b).p50 / (double) EVALS;
+  r.fixedTicks = (double) fixedTicks / (batches * EVALS);
+  r.floatTicks = (double) floatTicks / (batches * EVALS);
+  return r;
+}
+
+// LTTB throughput: a noisy two-series walk of LTTB_POINTS points down to
+// LTTB_KEEP per call, as /trend would stream it (one series emitted, the other
+// collected). Returns input points per second at the median.
+static const size_t LTTB_POINTS = 10000;
+static const size_t LTTB_KEEP   = 200;
+
+static double runLttb(size_t iterations, Bench& bench) {
+  typedef LttbStream<2 * ((LTTB_POINTS - 2) / (LTTB_KEEP - 2) + 1), 2> Stream;
+  static Stream::Point input[LTTB_POINTS];
+  uint32_t seed = 7;
+  int t = 450, h = 880;
+  for (size_t i = 0; i < LTTB_POINTS; i++) {
+    seed = seed * 1664525 + 1013904223;
+    t += (int)(seed >> 29) - 3;
+    h += (int)(seed >> 13 & 7) - 3;
+    input[i] = { (uint32_t)(1700000000 + 2 * i), { (int16_t) t, (int16_t) h } };
+  }
+  static Stream stream;
+  volatile uint32_t sink = 0;
+  for (size_t i = 0; i < iterations / 10 + 1; i++) {
+    bench.run([&] {
+      uint32_t acc = 0;
+      size_t kept = 0;
+      auto emit = [&](size_t channel, const Stream::Point& p) { acc += p.x + p.y[channel]; kept++; };
+      stream.begin(LTTB_POINTS, LTTB_KEEP);
+      for (size_t k = 0; k < LTTB_POINTS; k++) stream.add(input[k], emit);
+      stream.finish(emit);
+      sink = sink + acc;
+      return (uint64_t) kept;
+    });
+  }
+  std::vector<uint64_t> ns = bench.ns;
+  const uint64_t p50 = summarize(ns).p50;
+  return p50 ? LTTB_POINTS * 1e9 / p50 : 0;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 7) OLED text. A full page of four lines and a one-digit update, timed
+//    GFX-style (simDrawCharGfx on a blacked-out cell, as drawReadings used
+//    to) and as atlas blits, with their SPI bytes and address windows. That
+//    both draw the same pixels is oled_check's job.
+// ──────────────────────────────────────────────────────────────────────────────
+struct TextCost {
+  uint64_t bytes = 0, windows = 0;    // per draw
+};
+
+struct TextResult {
+  TextCost gfxPage, atlasPage, gfxDigit, atlasDigit;
+};
+
+static const uint16_t TEXT_COLORS[4] = { 0xF800, 0xF800, 0x001F, 0x001F };
+static const int      TEXT_Y0 = 20, TEXT_PITCH = 24;  // drawReadings' layout
+
+static void drawLineGfx(int x, int y, const char* s, uint16_t color) {
+  const int len = (int) strlen(s);
+  halDisplayFillRect(x, y, len * GLYPH_WIDTH, GLYPH_HEIGHT, 0);
+  for (int c = 0; c < len; c++) simDrawCharGfx(x + c * GLYPH_WIDTH, y, s[c], color, GLYPH_SCALE);
+}
+
+static void drawLineAtlas(int x, int y, const char* s, uint16_t color) {
+  static uint16_t buf[SCREEN_WIDTH * GLYPH_HEIGHT];
+  const int len = (int) strlen(s);
+  const int x0 = std::max(x, 0), x1 = std::min(x + len * GLYPH_WIDTH, SCREEN_WIDTH);
+  if (x0 >= x1) return;
+  glyphAtlasRender(s, len, x0 - x, x1 - x0, color, 0, buf);
+  halDisplayBlit(x0, y, x1 - x0, GLYPH_HEIGHT, buf);
+}
+
+static TextResult runText(size_t iterations, Bench& gfxPage, Bench& atlasPage,
+                          Bench& gfxDigit, Bench& atlasDigit) {
+  TextResult r;
+
+  // A whole page, then one digit of it changing
+  const char* page[4] = { "TEMP: 47F", "L:45 H:49", "HUMID: 88%", "L:85 H:92" };
+  const SimStats& st = simStats();
+  auto measure = [&](Bench& b, TextCost& cost, auto draw) {
+    const uint64_t b0 = st.spiBytes, w0 = st.spiWindows;
+    for (size_t i = 0; i < iterations / 10 + 1; i++) {
+      b.run([&] {
+        const uint64_t s0 = st.spiBytes;
+        draw();
+        return st.spiBytes - s0;
+      });
+    }
+    cost.bytes   = (st.spiBytes - b0) / b.ns.size();
+    cost.windows = (st.spiWindows - w0) / b.ns.size();
+  };
+  auto lineX = [](const char* s) { return (SCREEN_WIDTH - (int) strlen(s) * GLYPH_WIDTH) / 2; };
+  measure(gfxPage, r.gfxPage, [&] {
+    for (int i = 0; i < 4; i++) drawLineGfx(lineX(page[i]), TEXT_Y0 + i * TEXT_PITCH, page[i], TEXT_COLORS[i]);
+  });
+  measure(atlasPage, r.atlasPage, [&] {
+    for (int i = 0; i < 4; i++) drawLineAtlas(lineX(page[i]), TEXT_Y0 + i * TEXT_PITCH, page[i], TEXT_COLORS[i]);
+  });
+  const int digitX = lineX(page[0]) + 7 * GLYPH_WIDTH;   // "TEMP: 47F" → "TEMP: 48F"
+  measure(gfxDigit, r.gfxDigit, [&] { drawLineGfx(digitX, TEXT_Y0, "8", TEXT_COLORS[0]); });
+  measure(atlasDigit, r.atlasDigit, [&] { drawLineAtlas(digitX, TEXT_Y0, "8", TEXT_COLORS[0]); });
+  return r;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 8) /sensor-data per sample. A dashboard polls several times per reading,
+//    so one sample period is timed three ways for each polling rate: the
+//    JSON serialized again for every request (as before the cache), every
+//    request served from the cached payload, and ETag revalidation, where
+//    only the first poll after the new sample gets a body and the rest are
+//    304s. Each period republishes the snapshot, so the web step renders.
+// ──────────────────────────────────────────────────────────────────────────────
+static const int SENSOR_POLLS[] = { 1, 4, 16 };
+static const size_t SENSOR_RATES = sizeof(SENSOR_POLLS) / sizeof(SENSOR_POLLS[0]);
+enum { SENSOR_RENDER, SENSOR_CACHED, SENSOR_ETAG, SENSOR_MODES };
+
+struct SensorDataResult {
+  uint64_t ns[SENSOR_RATES][SENSOR_MODES]    = {};  // p50 per sample period
+  uint64_t bytes[SENSOR_RATES][SENSOR_MODES] = {};  // response bytes per sample period
+  uint64_t allocs = 0;                              // heap allocations, all modes
+  bool ok = true;                                   // every body matched, every 304 was one
+};
+
+static SensorDataResult runSensorData(size_t periods, std::string& out) {
+  SensorDataResult r;
+  std::vector<uint64_t> ns;
+  ns.reserve(periods);
+
+  // The body every mode must serve, and the ETag a poller holds after the
+  // first 200 of a period; republishing the same reading keeps both
+  snapshot.store(snapshot.load());
+  appWebStep();
+  out.clear();
+  simHttpRequest("/sensor-data", nullptr, &out);
+  const std::string full = out;
+  const size_t at = full.find("ETag: ") + 6;
+  const std::string etag = full.substr(at, full.find("\r\n", at) - at);
+
+  for (size_t p = 0; p < SENSOR_RATES; p++) {
+    const int polls = SENSOR_POLLS[p];
+    for (int mode = 0; mode < SENSOR_MODES; mode++) {
+      ns.clear();
+      uint64_t bytes = 0;
+      for (size_t i = 0; i < periods; i++) {
+        out.clear();
+        snapshot.store(snapshot.load());
+        const uint64_t a0 = allocCount;
+        allocArmed = true;
+        const uint64_t t0 = wallNanos();
+        if (mode != SENSOR_RENDER) appWebStep();
+        for (int k = 0; k < polls; k++) {
+          if (mode == SENSOR_RENDER) {
+            if (k) snapshot.store(snapshot.load());
+            appWebStep();
+          }
+          const char* ifNoneMatch = mode == SENSOR_ETAG && k ? etag.c_str() : nullptr;
+          bytes += simHttpRequest("/sensor-data", ifNoneMatch, &out);
+        }
+        ns.push_back(wallNanos() - t0);
+        allocArmed = false;
+        r.allocs += allocCount - a0;
+
+        // Off the clock: the first response is the full body, and the rest
+        // are either the same body again or bodyless 304s
+        const size_t each = mode == SENSOR_ETAG ? 0 : full.size();
+        r.ok = r.ok && out.compare(0, full.size(), full) == 0;
+        for (size_t pos = full.size(); r.ok && pos < out.size();) {
+          if (each) {
+            r.ok = out.compare(pos, each, full) == 0;
+            pos += each;
+          } else {
+            const size_t end = out.find("\r\n\r\n", pos);
+            r.ok = end != std::string::npos && out.compare(pos, 12, "HTTP/1.1 304") == 0;
+            pos = end + 4;
+          }
+        }
+      }
+      r.ns[p][mode]    = summarize(ns).p50;
+      r.bytes[p][mode] = bytes / periods;
+    }
+  }
+  return r;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 9) Fleet collector. N stand-in units on ephemeral local ports, served by
+//    one epoll thread over keep-alive: each answers GET with the app's own
+//    /sensor-data body, its last_updated advanced by one per response so
+//    every answer is a new reading. Every FLEET_STALL_EVERY-th unit accepts
+//    and never answers. fleet.h's scraper runs back to back (interval 0)
+//    into fleet_store.h files in a temporary directory.
+// ──────────────────────────────────────────────────────────────────────────────
+static const int      FLEET_STALL_EVERY = 16;
+static const uint32_t FLEET_BENCH_TIMEOUT_MS = 250;
+
+struct FleetBenchResult {
+  uint64_t scrapes = 0, rows = 0, timeouts = 0, failures = 0, fileBytes = 0, stalled = 0;
+  std::vector<uint64_t> latencyNs;
+  double seconds = 0;
+};
+
+struct FleetBenchSink {
+  FleetUnit*       units;
+  FleetColumnFile* files;
+  FleetBenchResult* r;
+};
+
+static void fleetBenchStore(void* ctx, FleetUnit& unit, const FleetRow& row) {
+  FleetBenchSink* s = (FleetBenchSink*) ctx;
+  s->files[&unit - s->units].add(row);
+  s->r->latencyNs.push_back((uint64_t) unit.latencyUs * 1000);
+}
+
+static void fleetStandIns(const std::vector<int>* listeners, const std::string* body,
+                          std::atomic<bool>* stop) {
+  const int ep = epoll_create1(EPOLL_CLOEXEC);
+  std::vector<int> unitOf;                  // fd → unit index, −1 = not a connection
+  std::vector<std::string> pending;         // fd → request bytes so far
+  std::vector<uint32_t> counter(listeners->size(), 1700000000);
+  std::vector<bool> isListener;
+  for (int fd : *listeners) {
+    if ((size_t) fd >= isListener.size()) isListener.resize(fd + 1, false);
+    isListener[fd] = true;
+    epoll_event ev = {};
+    ev.events  = EPOLLIN;
+    ev.data.fd = fd;
+    epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev);
+  }
+  const size_t tsAt = body->find("\"last_updated\":") + 15;
+  char head[160];
+  std::string resp;
+  epoll_event ev[64];
+  while (!stop->load()) {
+    const int n = epoll_wait(ep, ev, 64, 20);
+    for (int i = 0; i < n; i++) {
+      const int fd = ev[i].data.fd;
+      if ((size_t) fd < isListener.size() && isListener[fd]) {
+        const int c = accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (c < 0) continue;
+        if ((size_t) c >= unitOf.size()) {
+          unitOf.resize(c + 1, -1);
+          pending.resize(c + 1);
+        }
+        unitOf[c] = (int)(std::find(listeners->begin(), listeners->end(), fd) - listeners->begin());
+        pending[c].clear();
+        epoll_event cev = {};
+        cev.events  = EPOLLIN | EPOLLRDHUP;
+        cev.data.fd = c;
+        epoll_ctl(ep, EPOLL_CTL_ADD, c, &cev);
+        continue;
+      }
+      char buf[1024];
+      const ssize_t got = recv(fd, buf, sizeof(buf), 0);
+      if (got <= 0) {
+        epoll_ctl(ep, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        continue;
+      }
+      const int unit = unitOf[fd];
+      if (unit % FLEET_STALL_EVERY == FLEET_STALL_EVERY - 1) continue;   // never answers
+      pending[fd].append(buf, got);
+      size_t end;
+      while ((end = pending[fd].find("\r\n\r\n")) != std::string::npos) {
+        pending[fd].erase(0, end + 4);
+        resp.assign(head, snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                                   "Content-Length: %zu\r\nConnection: keep-alive\r\n\r\n", body->size()));
+        const size_t at = resp.size() + tsAt;
+        resp += *body;
+        char ts[16];
+        snprintf(ts, sizeof(ts), "%010lu", (unsigned long) counter[unit]++);
+        memcpy(&resp[at], ts, 10);
+        if (send(fd, resp.data(), resp.size(), MSG_NOSIGNAL) != (ssize_t) resp.size()) break;
+      }
+    }
+  }
+  for (size_t fd = 0; fd < unitOf.size(); fd++) {
+    if (unitOf[fd] >= 0) close((int) fd);
+  }
+  close(ep);
+}
+
+static FleetBenchResult runFleet(int units, double seconds, const std::string& body) {
+  FleetBenchResult r;
+  char dir[] = "/tmp/potato_fleet_bench.XXXXXX";
+  if (!mkdtemp(dir)) return r;
+
+  // Listeners first, so the scraper's units can be given their ports
+  std::vector<int> listeners;
+  std::unique_ptr<FleetUnit[]>       unit(new FleetUnit[units]);
+  std::unique_ptr<FleetColumnFile[]> file(new FleetColumnFile[units]);
+  for (int i = 0; i < units; i++) {
+    const int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    sockaddr_in addr = {};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    if (fd < 0 || bind(fd, (sockaddr*) &addr, sizeof(addr)) != 0 || listen(fd, 16) != 0 ||
+        getsockname(fd, (sockaddr*) &addr, &len) != 0) {
+      fprintf(stderr, "bench: fleet stand-in %d: %s\n", i, strerror(errno));
+      return r;
+    }
+    listeners.push_back(fd);
+    char line[64], err[128], path[96];
+    snprintf(line, sizeof(line), "unit%03d 127.0.0.1:%d", i, ntohs(addr.sin_port));
+    fleetParseUnit(line, &unit[i], err, sizeof(err));
+    snprintf(path, sizeof(path), "%s/%s.pfc", dir, unit[i].name);
+    file[i].open(path);
+    if (i % FLEET_STALL_EVERY == FLEET_STALL_EVERY - 1) r.stalled++;
+  }
+  std::atomic<bool> stop{false};
+  std::thread server(fleetStandIns, &listeners, &body, &stop);
+
+  FleetOptions opt;
+  opt.intervalMs   = 0;
+  opt.timeoutMs    = FLEET_BENCH_TIMEOUT_MS;
+  opt.maxBackoffMs = 1000;
+  FleetBenchSink sink = { unit.get(), file.get(), &r };
+  r.latencyNs.reserve(1 << 20);
+  FleetScraper scraper;
+  scraper.begin(unit.get(), units, opt, fleetBenchStore, &sink);
+  const uint64_t t0 = FleetScraper::nowUs(), endUs = t0 + (uint64_t)(seconds * 1e6);
+  while (FleetScraper::nowUs() < endUs) scraper.step(10000);
+  r.seconds = (FleetScraper::nowUs() - t0) / 1e6;
+  scraper.end();
+  stop = true;
+  server.join();
+
+  for (int i = 0; i < units; i++) {
+    file[i].flush();
+    r.scrapes   += unit[i].stats.samples + unit[i].stats.unchanged;
+    r.rows      += unit[i].stats.samples;
+    r.timeouts  += unit[i].stats.timeouts;
+    r.failures  += unit[i].stats.failures;
+    r.fileBytes += file[i].bytes();
+    file[i].close();
+    char path[96];
+    snprintf(path, sizeof(path), "%s/%s.pfc", dir, unit[i].name);
+    unlink(path);
+    close(listeners[i]);
+  }
+  rmdir(dir);
+  return r;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 10) Command line + report
+// ──────────────────────────────────────────────────────────────────────────────
+static void usage() {
+  fprintf(stderr,
+    "usage: potato_bench [options]\n"
+    "  --iterations N     calls per micro benchmark (default 20000)\n"
+    "  --clients N        fast keep-alive clients in the load scenario (default 4, 0 = skip)\n"
+    "  --slow-clients N   slow clients alongside them (default 2)\n"
+    "  --load-seconds S   load scenario length in real seconds (default 10)\n"
+    "  --export-runs N    fetches per export format (default 5, 0 = skip)\n"
+    "  --port P           local port for the socket scenarios (default 18080)\n"
+    "  --fleet-units N    stand-in units for the fleet collector (default 64, 0 = skip)\n"
+    "  --fleet-seconds S  fleet scenario length in real seconds (default 5)\n"
+    "  --label TEXT       stored in the JSON (e.g. a git revision)\n"
+    "  --json FILE        write JSON there instead of stdout\n");
+}
+
+int main(int argc, char** argv) {
+  size_t iterations = 20000;
+  int    clients    = 4;
+  int    slowClients = 2;
+  double loadSeconds = 10;
+  int    exportRuns = 5;
+  int    port       = 18080;
+  int    fleetUnits = 64;
+  double fleetSeconds = 5;
+  const char* label    = "";
+  const char* jsonPath = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!v)                                 { usage(); return 2; }
+    if      (!strcmp(a, "--iterations"))    iterations  = strtoul(v, nullptr, 10);
+    else if (!strcmp(a, "--clients"))       clients     = atoi(v);
+    else if (!strcmp(a, "--slow-clients"))  slowClients = atoi(v);
+    else if (!strcmp(a, "--load-seconds"))  loadSeconds = atof(v);
+    else if (!strcmp(a, "--export-runs"))   exportRuns  = atoi(v);
+    else if (!strcmp(a, "--port"))          port        = atoi(v);
+    else if (!strcmp(a, "--fleet-units"))   fleetUnits  = atoi(v);
+    else if (!strcmp(a, "--fleet-seconds")) fleetSeconds = atof(v);
+    else if (!strcmp(a, "--label"))         label       = v;
+    else if (!strcmp(a, "--json"))          jsonPath    = v;
+    else                                    { usage(); return 2; }
+    i++;
+  }
+  if (iterations == 0) { usage(); return 2; }
+
+  char flashDir[] = "/tmp/potato_bench.XXXXXX";
+  if (!mkdtemp(flashDir)) {
+    fprintf(stderr, "bench: cannot create a flash directory\n");
+    return 1;
+  }
+  SimConfig cfg;
+  cfg.port     = clients > 0 || exportRuns > 0 ? port : 0;
+  cfg.epoch    = 1700000000;
+  cfg.flashDir = flashDir;
+  // Fixed 2 s reads: the tiers fill as before, and the load scenario can
+  // count the samples it expects
+  cfg.maxPeriodMs = APP_SENSOR_PERIOD_MS;
+  if (!simInit(cfg)) return 1;
+  appSetup();
+
+  // Two virtual days: raw, minute and hour tiers all hold real data
+  fprintf(stderr, "bench: warming up (2 virtual days)…\n");
+  advanceTo(simMicros() + 2ULL * 86400 * 1000000);
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Micro benchmarks
+  // ────────────────────────────────────────────────────────────────────────────
+  std::vector<Bench> benches;
+  benches.reserve(32);
+  auto add = [&](const char* name) -> Bench& { benches.emplace_back(name, iterations); return benches.back(); };
+
+  Bench& passSample = add("loop_pass_sample");
+  Bench& passIdle   = add("loop_pass_idle");
+  Bench& sensorStep = add("sensor_step_sample");
+  Bench& drawStep   = add("display_step_sample");
+  Bench& webStep    = add("web_step_sample");
+  passIdle.ns.reserve(iterations * 8);
+  benchLoop(iterations, passSample, passIdle, sensorStep, drawStep, webStep);
+
+  std::string out;
+  out.reserve(256 * 1024);
+  const uint32_t now = (uint32_t) halTime();
+  char target[96];
+
+  // ETags for the 304 paths, as a client would have them from a first GET
+  auto etagOf = [&](const char* target) {
+    out.clear();
+    simHttpRequest(target, nullptr, &out);
+    const size_t at = out.find("ETag: ") + 6;
+    return out.substr(at, out.find("\r\n", at) - at);
+  };
+  const std::string sensorEtag = etagOf("/sensor-data");
+  const std::string rootEtag   = etagOf("/");
+  snprintf(target, sizeof(target), "/history?res=1m&from=%lu", (unsigned long)(now - 86400));
+
+  struct HttpCase { const char* name; const char* target; const std::string* etag; };
+  const HttpCase cases[] = {
+    { "handle_sensor_data_200", "/sensor-data",     nullptr },
+    { "handle_sensor_data_304", "/sensor-data",     &sensorEtag },
+    { "handle_root_200",        "/",                nullptr },
+    { "handle_root_304",        "/",                &rootEtag },
+    { "handle_history_raw_1h",  "/history?res=raw", nullptr },
+    { "handle_history_1m_1d",   target,             nullptr },
+    { "handle_history_1h_all",  "/history?res=1h",  nullptr },
+    { "handle_metrics",         "/metrics",         nullptr },
+    { "handle_trend_1h_500",    "/trend?window=1h&points=500",  nullptr },
+    { "handle_trend_24h_200",   "/trend?window=24h&points=200", nullptr },
+    { "handle_trend_30d_200",   "/trend?window=30d&points=200", nullptr },
+#if POTATO_TRACE
+    { "handle_trace",           "/trace",           nullptr },
+#endif
+  };
+  for (const HttpCase& c : cases) {
+    Bench& b = add(c.name);
+    const char* etag = c.etag ? c.etag->c_str() : nullptr;
+    for (size_t i = 0; i < iterations; i++) {
+      out.clear();
+      b.run([&] { return simHttpRequest(c.target, etag, &out); });
+    }
+  }
+
+  // /sensor-data per sample: rendered per request, cached, revalidated
+  fprintf(stderr, "bench: /sensor-data per sample…\n");
+  const SensorDataResult sensorData = runSensorData(std::max<size_t>(iterations / 10, 1), out);
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Kernels (1000 evaluations per call)
+  // ────────────────────────────────────────────────────────────────────────────
+  fprintf(stderr, "bench: kernels…\n");
+  Bench& psychroFixed = add("psychro_derive_x1000");
+  Bench& psychroFloat = add("psychro_libm_x1000");
+  const KernelResult kernels = runKernels(iterations, psychroFixed, psychroFloat);
+  const double lttbRate = runLttb(iterations, add("lttb_10k_to_200"));
+#if POTATO_TRACE
+  Bench& traceScope = add("trace_scope_x1000");
+  for (size_t i = 0; i < iterations; i++) {
+    traceScope.run([] {
+      for (uint16_t k = 0; k < 1000; k++) {
+        TRACE_SCOPE_ARG(TRACE_TAKE_READING, k);
+      }
+      return (uint64_t) 0;
+    });
+  }
+#endif
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // OLED text, GFX vs atlas (redraws the framebuffer; the app repaints it
+  // on its next full draw)
+  // ────────────────────────────────────────────────────────────────────────────
+  Bench& gfxPage    = add("oled_page_gfx");
+  Bench& atlasPage  = add("oled_page_atlas");
+  Bench& gfxDigit   = add("oled_digit_gfx");
+  Bench& atlasDigit = add("oled_digit_atlas");
+  const TextResult text = runText(iterations, gfxPage, atlasPage, gfxDigit, atlasDigit);
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Load scenario
+  // ────────────────────────────────────────────────────────────────────────────
+  LoadResult load;
+  if (clients > 0) {
+    fprintf(stderr, "bench: load, %d fast + %d slow clients for %.0f s…\n",
+            clients, slowClients, loadSeconds);
+    load = runLoad(port, clients, slowClients, loadSeconds);
+  }
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Export throughput
+  // ────────────────────────────────────────────────────────────────────────────
+  ExportResult exportBin, exportCsv;
+  if (exportRuns > 0) {
+    fprintf(stderr, "bench: export, %d runs per format…\n", exportRuns);
+    appFlushLog();
+    exportBin = runExport(port, "/export?format=bin", false, exportRuns);
+    exportCsv = runExport(port, "/export?format=csv", true,  exportRuns);
+  }
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Fleet collector
+  // ────────────────────────────────────────────────────────────────────────────
+  FleetBenchResult fleet;
+  if (fleetUnits > 0) {
+    fprintf(stderr, "bench: fleet, %d units for %.0f s…\n", fleetUnits, fleetSeconds);
+    out.clear();
+    simHttpRequest("/sensor-data", nullptr, &out);
+    fleet = runFleet(fleetUnits, fleetSeconds, out.substr(out.find("\r\n\r\n") + 4));
+  }
+
+  // The temporary flash directory holds only the log's slot files
+  if (DIR* d = opendir(flashDir)) {
+    while (dirent* e = readdir(d)) {
+      if (e->d_name[0] != '.') unlink((std::string(flashDir) + "/" + e->d_name).c_str());
+    }
+    closedir(d);
+  }
+  rmdir(flashDir);
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Report
+  // ────────────────────────────────────────────────────────────────────────────
+  FILE* json = jsonPath ? fopen(jsonPath, "w") : stdout;
+  if (!json) {
+    fprintf(stderr, "bench: cannot write %s\n", jsonPath);
+    return 1;
+  }
+
+  fprintf(stderr, "\n%-24s %8s %10s %10s %10s %10s %10s\n",
+          "benchmark", "calls", "p50 ns", "p99 ns", "max ns", "allocs", "bytes");
+  fprintf(json, "{\n  \"schema\": 1,\n  \"label\": \"%s\",\n  \"iterations\": %zu,\n  \"benchmarks\": [\n",
+          label, iterations);
+  for (size_t i = 0; i < benches.size(); i++) {
+    Bench& b = benches[i];
+    const size_t calls = b.ns.size();
+    const Summary s = summarize(b.ns);
+    const double allocs = calls ? (double) b.allocs / calls : 0;
+    const double bytes  = calls ? (double) b.bytes  / calls : 0;
+    fprintf(stderr, "%-24s %8zu %10llu %10llu %10llu %10.2f %10.1f\n", b.name.c_str(), calls,
+            (unsigned long long) s.p50, (unsigned long long) s.p99, (unsigned long long) s.max,
+            allocs, bytes);
+    fprintf(json, "    {\"name\": \"%s\", \"calls\": %zu, \"p50_ns\": %llu, \"p99_ns\": %llu, "
+                  "\"max_ns\": %llu, \"mean_ns\": %.1f, \"allocs_per_call\": %.3f, "
+                  "\"bytes_per_call\": %.1f}%s\n",
+            b.name.c_str(), calls, (unsigned long long) s.p50, (unsigned long long) s.p99,
+            (unsigned long long) s.max, s.mean, allocs, bytes,
+            i + 1 < benches.size() ? "," : "");
+  }
+  fprintf(json, "  ]");
+
+  fprintf(stderr, "\nsensor-data per sample period (p50, response bytes)%s\n"
+                  "  polls    rendered per request       cached payload         ETag + 304\n",
+          sensorData.ok ? "" : "  FAILED");
+  fprintf(json, ",\n  \"sensor_data\": {\"allocs\": %llu, \"ok\": %s",
+          (unsigned long long) sensorData.allocs, sensorData.ok ? "true" : "false");
+  for (size_t p = 0; p < SENSOR_RATES; p++) {
+    const uint64_t* ns = sensorData.ns[p];
+    const uint64_t* bytes = sensorData.bytes[p];
+    fprintf(stderr, "  %5d   %8.1f µs %7llu B   %8.1f µs %7llu B   %8.1f µs %7llu B   (%.1fx, %.1fx)\n",
+            SENSOR_POLLS[p], ns[SENSOR_RENDER] / 1e3, (unsigned long long) bytes[SENSOR_RENDER],
+            ns[SENSOR_CACHED] / 1e3, (unsigned long long) bytes[SENSOR_CACHED],
+            ns[SENSOR_ETAG] / 1e3, (unsigned long long) bytes[SENSOR_ETAG],
+            ns[SENSOR_CACHED] ? (double) ns[SENSOR_RENDER] / ns[SENSOR_CACHED] : 0.0,
+            ns[SENSOR_ETAG] ? (double) ns[SENSOR_RENDER] / ns[SENSOR_ETAG] : 0.0);
+    fprintf(json, ",\n    \"polls_%d\": {\"render_ns\": %llu, \"render_bytes\": %llu, "
+                  "\"cached_ns\": %llu, \"cached_bytes\": %llu, \"etag_ns\": %llu, \"etag_bytes\": %llu}",
+            SENSOR_POLLS[p], (unsigned long long) ns[SENSOR_RENDER], (unsigned long long) bytes[SENSOR_RENDER],
+            (unsigned long long) ns[SENSOR_CACHED], (unsigned long long) bytes[SENSOR_CACHED],
+            (unsigned long long) ns[SENSOR_ETAG], (unsigned long long) bytes[SENSOR_ETAG]);
+  }
+  fprintf(json, "}");
+
+  fprintf(stderr, "\nkernels: psychro.h %.1f ns/eval (%.0f TSC), expf/logf %.1f ns/eval (%.0f TSC)\n",
+          kernels.fixedNs, kernels.fixedTicks, kernels.floatNs, kernels.floatTicks);
+  fprintf(stderr, "  lttb.h %.1f M input points/s (%zu → %zu, two series)\n",
+          lttbRate / 1e6, LTTB_POINTS, LTTB_KEEP);
+  fprintf(json, ",\n  \"kernels\": {\"psychro\": {\"ns_per_eval\": %.2f, \"tsc_per_eval\": %.1f, "
+                "\"libm_ns_per_eval\": %.2f, \"libm_tsc_per_eval\": %.1f},\n"
+                "    \"lttb\": {\"points\": %zu, \"keep\": %zu, \"points_per_s\": %.0f}}",
+          kernels.fixedNs, kernels.fixedTicks, kernels.floatNs, kernels.floatTicks,
+          LTTB_POINTS, LTTB_KEEP, lttbRate);
+
+  fprintf(stderr, "\ntext: GFX-style vs glyph_atlas.h\n");
+  fprintf(stderr, "  full page     GFX %6llu B in %4llu windows   atlas %6llu B in %4llu windows\n"
+                  "  one digit     GFX %6llu B in %4llu windows   atlas %6llu B in %4llu windows\n",
+          (unsigned long long) text.gfxPage.bytes, (unsigned long long) text.gfxPage.windows,
+          (unsigned long long) text.atlasPage.bytes, (unsigned long long) text.atlasPage.windows,
+          (unsigned long long) text.gfxDigit.bytes, (unsigned long long) text.gfxDigit.windows,
+          (unsigned long long) text.atlasDigit.bytes, (unsigned long long) text.atlasDigit.windows);
+  fprintf(json, ",\n  \"text\": {\n"
+                "    \"page\": {\"gfx_bytes\": %llu, \"gfx_windows\": %llu, \"atlas_bytes\": %llu, \"atlas_windows\": %llu},\n"
+                "    \"digit\": {\"gfx_bytes\": %llu, \"gfx_windows\": %llu, \"atlas_bytes\": %llu, \"atlas_windows\": %llu}}",
+          (unsigned long long) text.gfxPage.bytes, (unsigned long long) text.gfxPage.windows,
+          (unsigned long long) text.atlasPage.bytes, (unsigned long long) text.atlasPage.windows,
+          (unsigned long long) text.gfxDigit.bytes, (unsigned long long) text.gfxDigit.windows,
+          (unsigned long long) text.atlasDigit.bytes, (unsigned long long) text.atlasDigit.windows);
+
+  if (clients > 0) {
+    const Summary lat  = summarize(load.latencyNs);
+    const Summary slow = summarize(load.slowNs);
+    const Summary late = summarize(load.latenessNs);
+    fprintf(stderr, "\nload: %d fast + %d slow clients, %.0f s: %llu requests (%.0f/s), "
+                    "%llu rejected (503), %llu reconnects, %llu errors\n",
+            clients, slowClients, load.seconds, (unsigned long long) load.requests,
+            load.requests / load.seconds, (unsigned long long) load.rejected,
+            (unsigned long long) load.reconnects, (unsigned long long) load.errors);
+    fprintf(stderr, "  request latency   p50 %8.1f µs  p99 %8.1f µs  max %8.1f µs\n",
+            lat.p50 / 1e3, lat.p99 / 1e3, lat.max / 1e3);
+    fprintf(stderr, "  slow clients      %llu done, p50 %.0f ms, %llu errors\n",
+            (unsigned long long) load.slowNs.size(), slow.p50 / 1e6,
+            (unsigned long long) load.slowErrors);
+    fprintf(stderr, "  sensor lateness   p50 %8.1f µs  p99 %8.1f µs  max %8.1f µs\n",
+            late.p50 / 1e3, late.p99 / 1e3, late.max / 1e3);
+    fprintf(stderr, "  samples           %llu of %llu expected\n",
+            (unsigned long long) load.samples, (unsigned long long) load.samplesExpected);
+    fprintf(json, ",\n  \"load\": {\"clients\": %d, \"slow_clients\": %d, \"seconds\": %.1f, "
+                  "\"requests\": %llu, \"errors\": %llu, \"rejected\": %llu, \"reconnects\": %llu, "
+                  "\"requests_per_s\": %.1f, \"bytes\": %llu,\n"
+                  "    \"latency_ns\": {\"p50\": %llu, \"p99\": %llu, \"max\": %llu},\n"
+                  "    \"slow_ns\": {\"count\": %zu, \"p50\": %llu, \"max\": %llu},\n"
+                  "    \"sensor_lateness_ns\": {\"p50\": %llu, \"p99\": %llu, \"max\": %llu},\n"
+                  "    \"samples\": %llu, \"samples_expected\": %llu}",
+            clients, slowClients, load.seconds, (unsigned long long) load.requests,
+            (unsigned long long) load.errors, (unsigned long long) load.rejected,
+            (unsigned long long) load.reconnects, load.requests / load.seconds,
+            (unsigned long long) load.bytes,
+            (unsigned long long) lat.p50, (unsigned long long) lat.p99, (unsigned long long) lat.max,
+            load.slowNs.size(), (unsigned long long) slow.p50, (unsigned long long) slow.max,
+            (unsigned long long) late.p50, (unsigned long long) late.p99, (unsigned long long) late.max,
+            (unsigned long long) load.samples, (unsigned long long) load.samplesExpected);
+  }
+  if (exportRuns > 0) {
+    fprintf(stderr, "\nexport: %d runs per format\n", exportRuns);
+    fprintf(json, ",\n  \"export\": {");
+    const struct { const char* name; ExportResult* r; } formats[] = {
+      { "bin", &exportBin }, { "csv", &exportCsv },
+    };
+    for (size_t f = 0; f < 2; f++) {
+      ExportResult& r = *formats[f].r;
+      const Summary t = summarize(r.ns);
+      const double rate = t.p50 ? r.samples * 1e9 / t.p50 : 0;
+      fprintf(stderr, "  %-4s %8llu samples  %9llu bytes (%.2f B/sample)  p50 %7.1f ms  "
+                      "%10.0f samples/s  %6.1f MB/s%s\n",
+              formats[f].name, (unsigned long long) r.samples, (unsigned long long) r.bytes,
+              r.samples ? (double) r.bytes / r.samples : 0.0, t.p50 / 1e6, rate,
+              t.p50 ? r.bytes * 1e3 / t.p50 : 0.0, r.ok ? "" : "  FAILED");
+      fprintf(json, "%s\n    \"%s\": {\"samples\": %llu, \"bytes\": %llu, \"p50_ns\": %llu, "
+                    "\"samples_per_s\": %.0f, \"ok\": %s}",
+              f ? "," : "", formats[f].name, (unsigned long long) r.samples,
+              (unsigned long long) r.bytes, (unsigned long long) t.p50, rate,
+              r.ok ? "true" : "false");
+    }
+    fprintf(json, "\n  }");
+  }
+  if (fleetUnits > 0) {
+    const Summary lat = summarize(fleet.latencyNs);
+    const double perRow = fleet.rows ? (double) fleet.fileBytes / fleet.rows : 0;
+    fprintf(stderr, "\nfleet: %d units (%llu stalled), %.0f s: %llu scrapes (%.0f/s), "
+                    "%llu timeouts, %llu failures\n",
+            fleetUnits, (unsigned long long) fleet.stalled, fleet.seconds,
+            (unsigned long long) fleet.scrapes, fleet.seconds > 0 ? fleet.scrapes / fleet.seconds : 0.0,
+            (unsigned long long) fleet.timeouts, (unsigned long long) fleet.failures);
+    fprintf(stderr, "  scrape latency    p50 %8.1f µs  p99 %8.1f µs  max %8.1f µs\n",
+            lat.p50 / 1e3, lat.p99 / 1e3, lat.max / 1e3);
+    fprintf(stderr, "  stored            %llu rows in %llu bytes (%.2f B/row)\n",
+            (unsigned long long) fleet.rows, (unsigned long long) fleet.fileBytes, perRow);
+    fprintf(json, ",\n  \"fleet\": {\"units\": %d, \"stalled\": %llu, \"seconds\": %.1f, "
+                  "\"scrapes\": %llu, \"scrapes_per_s\": %.1f, \"timeouts\": %llu, \"failures\": %llu,\n"
+                  "    \"latency_ns\": {\"p50\": %llu, \"p99\": %llu, \"max\": %llu},\n"
+                  "    \"rows\": %llu, \"file_bytes\": %llu, \"bytes_per_row\": %.2f}",
+            fleetUnits, (unsigned long long) fleet.stalled, fleet.seconds,
+            (unsigned long long) fleet.scrapes, fleet.seconds > 0 ? fleet.scrapes / fleet.seconds : 0.0,
+            (unsigned long long) fleet.timeouts, (unsigned long long) fleet.failures,
+            (unsigned long long) lat.p50, (unsigned long long) lat.p99, (unsigned long long) lat.max,
+            (unsigned long long) fleet.rows, (unsigned long long) fleet.fileBytes, perRow);
+  }
+  fprintf(json, "\n}\n");
+  if (json != stdout) fclose(json);
+  return sensorData.ok ? 0 : 1;
+}
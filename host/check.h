@@ -0,0 +1,30 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// check.h — what the host/*_check.cpp programs share
+//
+// Each check is a plain program run by ctest: CHECK() reports a failed
+// condition with its line and carries on, checkResult() prints
+// "<name>: OK" or "<name>: FAILED" and gives the exit status.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdio.h>
+
+static int checkFailures = 0;
+
+#define CHECK(cond, ...)                                             \
+  do {                                                               \
+    if (!(cond)) {                                                   \
+      checkFailures++;                                               \
+      fprintf(stderr, "  %s:%d: ", __FILE__, __LINE__);              \
+      fprintf(stderr, __VA_ARGS__);                                  \
+      fputc('\n', stderr);                                           \
+    }                                                                \
+  } while (0)
+
+static int checkResult(const char* name) {
+  if (checkFailures) {
+    printf("%s: FAILED (%d)\n", name, checkFailures);
+    return 1;
+  }
+  printf("%s: OK\n", name);
+  return 0;
+}
@@ -0,0 +1,163 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// dht22_check.cpp — dht22Decode() on edge captures
+//
+// Each capture is the gaps (µs) between the edges the driver's ISR
+// timestamps, as poll() hands them to the decoder: the host's release edge
+// (unless the ISR missed it), the 80/80 µs response, 40 bits and the
+// closing edge. They are timed with the ±4 µs scatter of interrupt latency,
+// not an ideal 26/70 µs. Every capture is checked as recorded and again
+// placed just before micros() wraps.
+//
+// From the storage-room capture the check derives the faults the driver
+// sees: a flipped data bit, frames cut short, no reply at all, a high
+// pulse stretched past the "1" window and a low one squeezed below its
+// window.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "../dht22_decode.h"
+#include "check.h"
+#include <string.h>
+#include <initializer_list>
+
+// 87.4 %RH, 7.2 °C (bytes 03 6a 00 48 b5)
+static const uint8_t STORAGE[] = {
+   32,  77,  83,  50,  22,  46,  24,  53,  27,  51,  22,  50,  29,  49,  28,  54,
+   74,  47,  69,  54,  26,  47,  72,  51,  67,  51,  28,  50,  73,  47,  25,  50,
+   67,  46,  25,  51,  29,  49,  30,  54,  22,  51,  25,  52,  26,  51,  23,  47,
+   30,  54,  25,  47,  26,  50,  69,  52,  29,  49,  24,  49,  74,  46,  25,  48,
+   22,  51,  30,  50,  71,  52,  30,  52,  70,  48,  73,  46,  24,  52,  72,  47,
+   29,  49,  67,  51,
+};
+
+// 65.2 %RH, −6.5 °C: sign bit plus magnitude (bytes 02 8c 80 41 4f)
+static const uint8_t FROST[] = {
+   30,  83,  83,  52,  23,  54,  28,  53,  26,  52,  23,  49,  26,  53,  29,  48,
+   66,  46,  30,  47,  70,  51,  25,  50,  30,  53,  27,  54,  70,  52,  72,  53,
+   26,  53,  29,  53,  68,  52,  29,  50,  29,  51,  27,  48,  28,  50,  27,  52,
+   29,  48,  26,  54,  22,  53,  66,  48,  22,  47,  27,  51,  29,  46,  25,  48,
+   26,  46,  72,  54,  29,  47,  73,  49,  23,  51,  27,  48,  69,  51,  68,  46,
+   67,  47,  66,  52,
+};
+
+// 91.3 %RH, 10.4 °C, the release edge missed (bytes 03 91 00 68 fc)
+static const uint8_t NO_RELEASE[] = {
+   83,  83,  47,  22,  54,  24,  47,  24,  50,  29,  53,  22,  48,  25,  53,  73,
+   53,  73,  54,  70,  53,  23,  50,  27,  50,  71,  46,  23,  54,  26,  50,  26,
+   53,  72,  53,  27,  46,  23,  49,  25,  54,  22,  48,  27,  51,  22,  46,  25,
+   52,  27,  47,  24,  47,  72,  54,  68,  53,  29,  47,  68,  47,  27,  54,  22,
+   48,  30,  48,  68,  50,  68,  54,  72,  49,  69,  48,  72,  48,  71,  49,  30,
+   46,  28,  48,
+};
+
+static const size_t MAX_EDGES = 96;
+
+struct Capture {
+  uint32_t edges[MAX_EDGES];
+  size_t   count;
+};
+
+static Capture fromGaps(const uint8_t* gaps, size_t n, uint32_t start) {
+  Capture c;
+  c.count = 0;
+  uint32_t at = start;
+  c.edges[c.count++] = at;
+  for (size_t i = 0; i < n; i++) c.edges[c.count++] = at += gaps[i];
+  return c;
+}
+
+static Dht22Status decode(const Capture& c, Dht22Reading* r) {
+  return dht22Decode(c.edges, c.count, r);
+}
+
+// Gap indices in a capture with the release edge: release → pull-low, the
+// two response pulses, then each bit's low and high pulse
+static size_t bitLow(size_t k)  { return 3 + 2 * k; }
+static size_t bitHigh(size_t k) { return 4 + 2 * k; }
+
+// Make gap `i` last `us`, moving every later edge with it
+static void setGap(Capture& c, size_t i, uint32_t us) {
+  const uint32_t delta = us - (c.edges[i + 1] - c.edges[i]);
+  for (size_t e = i + 1; e < c.count; e++) c.edges[e] += delta;
+}
+
+static void checkGood(const char* name, const uint8_t* gaps, size_t n, int16_t t10C, uint16_t h10) {
+  for (uint32_t start : { 1843270112u, 0xFFFFFFFFu - 2000 }) {
+    const Capture c = fromGaps(gaps, n, start);
+    Dht22Reading r = {};
+    const Dht22Status s = decode(c, &r);
+    CHECK(s == DHT22_OK, "%s at %u: %s", name, start, dht22StatusName(s));
+    CHECK(r.t10C == t10C && r.h10 == h10, "%s at %u: %d / %u, expected %d / %u",
+          name, start, r.t10C, r.h10, t10C, h10);
+  }
+}
+
+static void checkFault(const char* what, const Capture& c, Dht22Status expected) {
+  Dht22Reading r = {};
+  const Dht22Status s = decode(c, &r);
+  CHECK(s == expected, "%s: %s, expected %s", what, dht22StatusName(s), dht22StatusName(expected));
+}
+
+int main() {
+  checkGood("storage",    STORAGE,    sizeof(STORAGE),    72,  874);
+  checkGood("frost",      FROST,      sizeof(FROST),      -65, 652);
+  checkGood("no release", NO_RELEASE, sizeof(NO_RELEASE), 104, 913);
+
+  const Capture good = fromGaps(STORAGE, sizeof(STORAGE), 1843270112u);
+
+  // Bit 31 (the temperature's last bit, a 0) read as a 1: checksum fails
+  Capture flipped = good;
+  setGap(flipped, bitHigh(31), 70);
+  checkFault("flipped bit", flipped, DHT22_CHECKSUM);
+
+  // The checksum byte's own first bit (a 1) read as a 0
+  Capture flippedSum = good;
+  setGap(flippedSum, bitHigh(32), 26);
+  checkFault("flipped checksum bit", flippedSum, DHT22_CHECKSUM);
+
+  // Too few edges: cut anywhere short of the last bit, or no reply at all
+  for (size_t keep : { (size_t) 1, (size_t) 4, (size_t) 60, DHT22_FRAME_EDGES - 1 }) {
+    Capture cut = good;
+    cut.count = keep;
+    char what[32];
+    snprintf(what, sizeof(what), "%zu edges", keep);
+    checkFault(what, cut, DHT22_TRUNCATED);
+  }
+  checkFault("no edges", Capture{ {}, 0 }, DHT22_TRUNCATED);
+
+  // The closing edge lost: bit 39 ends on the edge before it, so the frame
+  // still decodes
+  Capture noClose = good;
+  noClose.count--;
+  checkFault("closing edge lost", noClose, DHT22_OK);
+
+  // A bit's high pulse stretched past the "1" window (the line held by
+  // noise), and one between the windows
+  Capture stretched = good;
+  setGap(stretched, bitHigh(17), 120);
+  checkFault("stretched bit", stretched, DHT22_BAD_TIMING);
+  Capture between = good;
+  setGap(between, bitHigh(17), 48);
+  checkFault("bit between windows", between, DHT22_BAD_TIMING);
+
+  // A bit's low pulse too short (a glitch splitting it)
+  Capture squeezed = good;
+  setGap(squeezed, bitLow(5), 15);
+  checkFault("squeezed low", squeezed, DHT22_BAD_TIMING);
+
+  // No 80/80 µs response where it should be
+  Capture noResponse = good;
+  setGap(noResponse, 2, 140);
+  checkFault("no response", noResponse, DHT22_BAD_TIMING);
+
+  // A valid frame whose values no DHT22 reports: 120.0 %RH
+  uint8_t bytes[5] = { 0x04, 0xb0, 0x00, 0x48, 0 };
+  bytes[4] = (uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]);
+  uint8_t gaps[sizeof(STORAGE)];
+  memcpy(gaps, STORAGE, sizeof(gaps));
+  for (size_t k = 0; k < 40; k++) {
+    const bool one = (bytes[k / 8] >> (7 - k % 8)) & 1;
+    gaps[bitHigh(k)] = one ? 70 : 26;
+  }
+  checkFault("120 %RH", fromGaps(gaps, sizeof(gaps), 0), DHT22_OUT_OF_RANGE);
+
+  return checkResult("dht22_check");
+}
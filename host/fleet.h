@@ -0,0 +1,516 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// fleet.h — scrape many units' /sensor-data concurrently from one epoll loop
+//
+// Every unit gets a small state machine (idle → connecting → writing →
+// reading → idle) over a non-blocking socket, all driven by one thread:
+// step() starts the scrapes that are due, waits in epoll_wait() until the
+// next socket is ready or the next deadline passes, and moves each unit
+// along as far as its socket allows. A slow or dead unit only holds its own
+// socket.
+//
+//   schedule    each unit is scraped every intervalMs, the fleet spread
+//               evenly over the first interval
+//   deadline    a scrape (connect + request + response) must finish within
+//               timeoutMs
+//   backoff     after a failure the unit waits interval · 2^(n−1), at
+//               most maxBackoffMs, ±10 % jitter; one success resets it
+//   keep-alive  the connection is reused while the interval is shorter
+//               than the unit's idle timeout (FLEET_KEEPALIVE_MAX_MS). A
+//               reused socket the unit has meanwhile closed is retried
+//               once on a fresh connection, without counting a failure.
+//   304         If-None-Match with the last ETag: an unchanged reading
+//               costs the unit a header-only answer
+//
+// Responses land in a fixed buffer per unit, and the body is parsed in
+// place (fleetParseSensorData) into a FleetRow for the sink: no allocation
+// after begin().
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include "fleet_store.h"
+
+static const size_t   FLEET_NAME_MAX         = 32;
+static const size_t   FLEET_RESPONSE_MAX     = 4096;   // head + /sensor-data (≤ 2432 B)
+static const uint32_t FLEET_KEEPALIVE_MAX_MS = 4000;   // under the unit's 5 s idle timeout
+static const uint32_t FLEET_BACKOFF_MIN_MS   = 500;    // first retry, when interval is shorter
+static const int      FLEET_EPOLL_BATCH      = 64;
+
+struct FleetOptions {
+  uint32_t intervalMs   = 10000;
+  uint32_t timeoutMs    = 2000;
+  uint32_t maxBackoffMs = 300000;
+};
+
+enum FleetState : uint8_t { FLEET_IDLE, FLEET_CONNECTING, FLEET_WRITING, FLEET_READING };
+
+struct FleetUnitStats {
+  uint64_t attempts  = 0;   // scrapes started
+  uint64_t samples   = 0;   // new readings handed to the sink
+  uint64_t unchanged = 0;   // 304, the same reading again, or none yet
+  uint64_t failures  = 0;   // refused, reset, bad status or body
+  uint64_t timeouts  = 0;
+  uint64_t bytes     = 0;   // response bytes received
+};
+
+struct FleetUnit {
+  // Set before begin()
+  char             name[FLEET_NAME_MAX + 1];
+  char             host[64];           // Host header
+  sockaddr_storage addr;
+  socklen_t        addrLen = 0;
+
+  // Scrape state
+  FleetState state      = FLEET_IDLE;
+  int        fd         = -1;
+  bool       reused     = false;       // request went out on a kept-alive socket
+  uint64_t   dueUs      = 0;
+  uint64_t   startUs    = 0;
+  uint64_t   deadlineUs = 0;
+  uint32_t   failStreak = 0;
+  uint32_t   lastTs     = 0;           // newest reading handed to the sink
+  uint32_t   latencyUs  = 0;           // of the last complete response
+  char       etag[40]   = "";
+  char       lastError[80] = "";
+  size_t     reqLen = 0, sent = 0, len = 0;
+  char       req[256];
+  char       buf[FLEET_RESPONSE_MAX];
+  FleetUnitStats stats;
+};
+
+// "name host[:port]" → unit (port 80 by default; the name is resolved now,
+// blocking). False with a message in `err` if the line is malformed or the
+// name doesn't resolve.
+inline bool fleetParseUnit(const char* line, FleetUnit* u, char* err, size_t errCap) {
+  char name[64], hostPort[128];
+  if (sscanf(line, "%63s %127s", name, hostPort) != 2) {
+    snprintf(err, errCap, "expected \"name host[:port]\"");
+    return false;
+  }
+  const size_t nameLen = strlen(name);
+  if (nameLen > FLEET_NAME_MAX || strspn(name, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                               "0123456789_.-") != nameLen || name[0] == '.') {
+    snprintf(err, errCap, "unit name must be 1-32 of [A-Za-z0-9_.-]");
+    return false;
+  }
+  const char* host = hostPort;
+  if (!strncmp(host, "http://", 7)) host += 7;
+  char hostOnly[128];
+  snprintf(hostOnly, sizeof(hostOnly), "%s", host);
+  char* slash = strchr(hostOnly, '/');
+  if (slash) *slash = '\0';
+  if (strlen(hostOnly) >= sizeof(u->host)) {
+    snprintf(err, errCap, "host name too long");
+    return false;
+  }
+  memcpy(u->host, hostOnly, strlen(hostOnly) + 1);
+  const char* port = "80";
+  char* colon = strrchr(hostOnly, ':');
+  if (colon) {
+    *colon = '\0';
+    port   = colon + 1;
+  }
+  addrinfo hints = {}, *res = nullptr;
+  hints.ai_socktype = SOCK_STREAM;
+  const int rc = getaddrinfo(hostOnly, port, &hints, &res);
+  if (rc != 0) {
+    snprintf(err, errCap, "%s: %s", hostOnly, gai_strerror(rc));
+    return false;
+  }
+  memcpy(&u->addr, res->ai_addr, res->ai_addrlen);
+  u->addrLen = res->ai_addrlen;
+  freeaddrinfo(res);
+  memcpy(u->name, name, nameLen + 1);
+  return true;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// /sensor-data body → FleetRow: "last_updated" and FLEET_COLUMN[]'s keys at
+// the top level, as fixed-point. Nested objects ("windows", "sensors") are
+// skipped by depth, so their own "temperature" keys don't match. The body is
+// only read. False if a field is missing or malformed.
+// ──────────────────────────────────────────────────────────────────────────────
+inline bool fleetParseFixed(const char*& p, const char* end, int32_t scale, int64_t* out) {
+  bool neg = false;
+  if (p < end && *p == '-') {
+    neg = true;
+    p++;
+  }
+  if (p >= end || *p < '0' || *p > '9') return false;
+  int64_t v = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    v = v * 10 + (*p++ - '0');
+    if (v > UINT32_MAX) return false;
+  }
+  v *= scale;
+  if (p < end && *p == '.') {
+    p++;
+    int32_t place = scale / 10;
+    bool    first = true;
+    while (p < end && *p >= '0' && *p <= '9') {
+      const int d = *p++ - '0';
+      if (place > 0)   v += d * place;
+      else if (first) { v += d >= 5; first = false; }   // round on the first digit past scale
+      place /= 10;
+    }
+  }
+  if (p < end && (*p == 'e' || *p == 'E')) return false;
+  *out = neg ? -v : v;
+  return true;
+}
+
+inline bool fleetParseSensorData(const char* p, const char* end, FleetRow* row) {
+  uint32_t found = 0;                      // bit c: column c; bit FLEET_COLUMNS: ts
+  const uint32_t all = (1u << (FLEET_COLUMNS + 1)) - 1;
+  int depth = 0;
+  while (p < end) {
+    const char c = *p;
+    if (c == '"') {
+      const char* key = ++p;
+      while (p < end && *p != '"') p += *p == '\\' ? 2 : 1;
+      if (p >= end) return false;
+      const size_t keyLen = p++ - key;
+      if (depth != 1) continue;
+      while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+      if (p >= end || *p != ':') continue;          // a string value, not a key
+      p++;
+      while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+      if (keyLen == 12 && !memcmp(key, "last_updated", 12)) {
+        int64_t ts;
+        if (!fleetParseFixed(p, end, 1, &ts) || ts < 0) return false;
+        row->ts = (uint32_t) ts;
+        found |= 1u << FLEET_COLUMNS;
+        continue;
+      }
+      for (size_t col = 0; col < FLEET_COLUMNS; col++) {
+        if (strlen(FLEET_COLUMN[col].key) != keyLen || memcmp(key, FLEET_COLUMN[col].key, keyLen)) continue;
+        int64_t v;
+        if (!fleetParseFixed(p, end, FLEET_COLUMN[col].scale, &v) || v < INT32_MIN || v > INT32_MAX) {
+          return false;
+        }
+        row->v[col] = (int32_t) v;
+        found |= 1u << col;
+        break;
+      }
+      continue;
+    }
+    if (c == '{' || c == '[')      depth++;
+    else if (c == '}' || c == ']') depth--;
+    p++;
+  }
+  return found == all;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Scraper
+// ──────────────────────────────────────────────────────────────────────────────
+class FleetScraper {
+public:
+  // A new reading from `unit` (newer than any before it)
+  typedef void (*Sink)(void* ctx, FleetUnit& unit, const FleetRow& row);
+
+  ~FleetScraper() { end(); }
+
+  static uint64_t nowUs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+  }
+
+  // Units must stay put until end(). Their lastTs may be preset (from the
+  // store) so a restart doesn't hand the sink the same reading again.
+  bool begin(FleetUnit* units, size_t n, const FleetOptions& opt, Sink sink, void* ctx) {
+    epfd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd_ < 0) return false;
+    units_ = units;
+    n_     = n;
+    opt_   = opt;
+    sink_  = sink;
+    ctx_   = ctx;
+    rng_   = (uint32_t) nowUs() | 1;
+    const uint64_t now = nowUs();
+    for (size_t i = 0; i < n; i++) {
+      units[i].state = FLEET_IDLE;
+      units[i].fd    = -1;
+      units[i].dueUs = now + (uint64_t) opt.intervalMs * 1000 * i / (n ? n : 1);
+    }
+    return true;
+  }
+
+  void end() {
+    for (size_t i = 0; i < n_; i++) closeUnit(units_[i]);
+    if (epfd_ >= 0) close(epfd_);
+    epfd_ = -1;
+    n_    = 0;
+  }
+
+  // Start what is due, wait up to maxWaitUs for sockets or deadlines, and
+  // handle them
+  void step(uint64_t maxWaitUs) {
+    uint64_t now  = nowUs();
+    uint64_t wake = now + maxWaitUs;
+    for (size_t i = 0; i < n_; i++) {
+      FleetUnit& u = units_[i];
+      if (u.state == FLEET_IDLE && u.dueUs <= now) start(u, now);
+      const uint64_t next = u.state == FLEET_IDLE ? u.dueUs : u.deadlineUs;
+      if (next < wake) wake = next;
+    }
+
+    now = nowUs();
+    const int waitMs = wake > now ? (int)((wake - now + 999) / 1000) : 0;
+    epoll_event ev[FLEET_EPOLL_BATCH];
+    const int ready = epoll_wait(epfd_, ev, FLEET_EPOLL_BATCH, waitMs);
+    for (int i = 0; i < ready; i++) {
+      onEvent(*(FleetUnit*) ev[i].data.ptr, ev[i].events);
+    }
+
+    now = nowUs();
+    for (size_t i = 0; i < n_; i++) {
+      FleetUnit& u = units_[i];
+      if (u.state != FLEET_IDLE && now >= u.deadlineUs) {
+        u.stats.timeouts++;
+        fail(u, now, "timed out");
+      }
+    }
+  }
+
+private:
+  void start(FleetUnit& u, uint64_t now) {
+    u.stats.attempts++;
+    u.startUs    = now;
+    u.deadlineUs = now + (uint64_t) opt_.timeoutMs * 1000;
+    u.len = u.sent = 0;
+    const bool keep = opt_.intervalMs < FLEET_KEEPALIVE_MAX_MS;
+    int n = snprintf(u.req, sizeof(u.req), "GET /sensor-data HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\n",
+                     u.host, keep ? "keep-alive" : "close");
+    if (u.etag[0]) n += snprintf(u.req + n, sizeof(u.req) - n, "If-None-Match: %s\r\n", u.etag);
+    n += snprintf(u.req + n, sizeof(u.req) - n, "\r\n");
+    u.reqLen = (size_t) n < sizeof(u.req) ? (size_t) n : sizeof(u.req) - 1;
+    if (u.fd >= 0) {
+      u.reused = true;
+      u.state  = FLEET_WRITING;
+      watch(u, EPOLLOUT);
+      return;
+    }
+    connectUnit(u, now);
+  }
+
+  void connectUnit(FleetUnit& u, uint64_t now) {
+    u.reused = false;
+    u.fd = socket(u.addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (u.fd < 0) {
+      fail(u, now, "socket: %s", strerror(errno));
+      return;
+    }
+    int one = 1;
+    setsockopt(u.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(u.fd, (const sockaddr*) &u.addr, u.addrLen) != 0 && errno != EINPROGRESS) {
+      fail(u, now, "connect: %s", strerror(errno));
+      return;
+    }
+    u.state = FLEET_CONNECTING;
+    epoll_event ev = {};
+    ev.events   = EPOLLOUT;
+    ev.data.ptr = &u;
+    epoll_ctl(epfd_, EPOLL_CTL_ADD, u.fd, &ev);
+  }
+
+  void watch(FleetUnit& u, uint32_t events) {
+    epoll_event ev = {};
+    ev.events   = events;
+    ev.data.ptr = &u;
+    epoll_ctl(epfd_, EPOLL_CTL_MOD, u.fd, &ev);
+  }
+
+  void closeUnit(FleetUnit& u) {
+    if (u.fd < 0) return;
+    epoll_ctl(epfd_, EPOLL_CTL_DEL, u.fd, nullptr);
+    close(u.fd);
+    u.fd = -1;
+  }
+
+  void onEvent(FleetUnit& u, uint32_t events) {
+    const uint64_t now = nowUs();
+    switch (u.state) {
+      case FLEET_IDLE:
+        // A kept-alive socket stirred: the unit closed it (idle timeout or
+        // eviction). Reconnect at the next scrape.
+        closeUnit(u);
+        return;
+      case FLEET_CONNECTING: {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        getsockopt(u.fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        if (err || (events & EPOLLERR)) {
+          fail(u, now, "connect: %s", strerror(err ? err : ECONNREFUSED));
+          return;
+        }
+        u.state = FLEET_WRITING;
+      }
+      // fall through
+      case FLEET_WRITING:
+        while (u.sent < u.reqLen) {
+          const ssize_t n = send(u.fd, u.req + u.sent, u.reqLen - u.sent, MSG_NOSIGNAL);
+          if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+          if (n <= 0) {
+            lost(u, now, "send: %s", strerror(errno));
+            return;
+          }
+          u.sent += n;
+        }
+        u.state = FLEET_READING;
+        watch(u, EPOLLIN | EPOLLRDHUP);
+        return;
+      case FLEET_READING:
+        for (;;) {
+          if (u.len == sizeof(u.buf)) {
+            fail(u, now, "response over %u bytes", (unsigned) sizeof(u.buf));
+            return;
+          }
+          const ssize_t n = recv(u.fd, u.buf + u.len, sizeof(u.buf) - u.len, 0);
+          if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+          if (n <= 0) {
+            lost(u, now, n == 0 ? "connection closed mid-response" : strerror(errno));
+            return;
+          }
+          u.len += n;
+          u.stats.bytes += n;
+          if (complete(u, now)) return;
+        }
+    }
+  }
+
+  // The connection broke. On a reused socket with nothing received, the
+  // unit had closed it while idle: retry once on a fresh connection.
+  template <typename... A>
+  void lost(FleetUnit& u, uint64_t now, const char* fmt, A... args) {
+    if (u.reused && u.len == 0) {
+      closeUnit(u);
+      u.sent = 0;
+      connectUnit(u, now);
+      return;
+    }
+    fail(u, now, fmt, args...);
+  }
+
+  template <typename... A>
+  void fail(FleetUnit& u, uint64_t now, const char* fmt, A... args) {
+    closeUnit(u);
+    snprintf(u.lastError, sizeof(u.lastError), fmt, args...);
+    u.state = FLEET_IDLE;
+    if (strcmp(u.lastError, "timed out") != 0) u.stats.failures++;
+    uint64_t delay = opt_.intervalMs > FLEET_BACKOFF_MIN_MS ? opt_.intervalMs : FLEET_BACKOFF_MIN_MS;
+    delay <<= u.failStreak < 20 ? u.failStreak : 20;
+    if (delay > opt_.maxBackoffMs) delay = opt_.maxBackoffMs;
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 17;
+    rng_ ^= rng_ << 5;
+    delay = delay * (90 + rng_ % 21) / 100;
+    u.dueUs = now + delay * 1000;
+    if (u.failStreak++ == 0) {
+      fprintf(stderr, "fleet: %s down: %s (retrying with backoff)\n", u.name, u.lastError);
+    }
+  }
+
+  // Parse what has arrived. True once the response is complete and handled
+  // (or rejected).
+  bool complete(FleetUnit& u, uint64_t now) {
+    const char* head = u.buf;
+    const char* headEnd = (const char*) memmem(head, u.len, "\r\n\r\n", 4);
+    if (!headEnd) return false;
+    const char* body = headEnd + 4;
+    if (u.len < 12 || strncmp(head, "HTTP/1.", 7) != 0) {
+      fail(u, now, "not an HTTP response");
+      return true;
+    }
+    const int status = atoi(head + 9);
+
+    // Headers: Content-Length, Connection, ETag
+    long contentLength = status == 304 ? 0 : -1;
+    bool closing = false;
+    const char* etag = nullptr;
+    size_t etagLen = 0;
+    for (const char* line = (const char*) memchr(head, '\n', headEnd + 2 - head) + 1; line < headEnd;) {
+      const char* eol = (const char*) memchr(line, '\r', headEnd + 2 - line);
+      const char* v   = strchr(line, ':');
+      if (v && v < eol) {
+        for (v++; *v == ' '; v++) {}
+        if      (!strncasecmp(line, "Content-Length:", 15)) contentLength = atol(v);
+        else if (!strncasecmp(line, "Connection:", 11))     closing = !strncasecmp(v, "close", 5);
+        else if (!strncasecmp(line, "ETag:", 5)) {
+          etag    = v;
+          etagLen = eol - v;
+        }
+      }
+      line = eol + 2;
+    }
+    if (contentLength < 0) {
+      fail(u, now, "HTTP %d without Content-Length", status);
+      return true;
+    }
+    if ((size_t)(body - head) + contentLength > sizeof(u.buf)) {
+      fail(u, now, "response over %u bytes", (unsigned) sizeof(u.buf));
+      return true;
+    }
+    if (u.len < (size_t)(body - head) + contentLength) return false;
+    u.latencyUs = (uint32_t)(now - u.startUs);
+
+    if (status == 200) {
+      FleetRow row;
+      if (!fleetParseSensorData(body, body + contentLength, &row)) {
+        fail(u, now, "unreadable /sensor-data body");
+        return true;
+      }
+      // No reading yet (−999), or the one already stored
+      if (row.ts == 0 || row.v[0] == -999 * FLEET_COLUMN[0].scale || row.ts <= u.lastTs) {
+        u.stats.unchanged++;
+      } else {
+        u.lastTs = row.ts;
+        u.stats.samples++;
+        sink_(ctx_, u, row);
+      }
+      if (etag && etagLen < sizeof(u.etag)) {
+        memcpy(u.etag, etag, etagLen);
+        u.etag[etagLen] = '\0';
+      }
+    } else if (status == 304) {
+      u.stats.unchanged++;
+    } else {
+      fail(u, now, "HTTP %d", status);
+      return true;
+    }
+
+    // Success: keep the socket if the unit will still hold it next time
+    if (u.failStreak > 0) {
+      fprintf(stderr, "fleet: %s up again after %u failed scrapes\n", u.name, (unsigned) u.failStreak);
+    }
+    u.failStreak = 0;
+    u.state = FLEET_IDLE;
+    const bool exact = u.len == (size_t)(body - head) + contentLength;
+    if (closing || !exact || opt_.intervalMs >= FLEET_KEEPALIVE_MAX_MS) closeUnit(u);
+    else watch(u, EPOLLIN | EPOLLRDHUP);
+    const uint64_t next = u.dueUs + (uint64_t) opt_.intervalMs * 1000;
+    u.dueUs = next > now ? next : now;
+    return true;
+  }
+
+  FleetUnit*   units_ = nullptr;
+  size_t       n_     = 0;
+  FleetOptions opt_;
+  Sink         sink_  = nullptr;
+  void*        ctx_   = nullptr;
+  int          epfd_  = -1;
+  uint32_t     rng_   = 1;
+};
@@ -0,0 +1,327 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// fleet_main.cpp — potato_fleet: scrape a fleet of units, query what it kept
+//
+//   potato_fleet scrape --units FILE --dir DIR [--interval T] [--timeout T]
+//                       [--max-backoff T] [--flush T] [--duration T] [--json FILE]
+//   potato_fleet query  --dir DIR --unit NAME [--from UNIX] [--to UNIX] [--summary]
+//
+// scrape reads every unit's /sensor-data concurrently from one epoll loop
+// (fleet.h) and appends each new reading to DIR/<name>.pfc (fleet_store.h).
+// FILE lists one unit per line, "name host[:port]" (port 80 by default);
+// blank lines and # comments are skipped, and names are resolved once at
+// startup. Units going down and coming back are logged as they happen. On
+// exit (--duration, or Ctrl-C) it flushes every file and prints a line per
+// unit; --json writes the same per-unit counters as JSON.
+//
+// query prints one unit's stored readings between --from and --to (UNIX
+// seconds, both optional) as CSV, the unit's own "none" values (−999, −1)
+// included, or with --summary the row count, span and ranges.
+//
+// Durations take ms/s/m/h/d suffixes (plain numbers are seconds).
+// ──────────────────────────────────────────────────────────────────────────────
+#include "fleet.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <memory>
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int) { stopRequested = 1; }
+
+static void usage() {
+  fprintf(stderr,
+    "usage: potato_fleet scrape --units FILE --dir DIR [options]\n"
+    "  --interval T      between scrapes of one unit (default 10s)\n"
+    "  --timeout T       for one scrape, connect to last byte (default 2s)\n"
+    "  --max-backoff T   longest wait after repeated failures (default 5m)\n"
+    "  --flush T         write buffered readings at least this often (default 60s)\n"
+    "  --duration T      stop after this long (default: until Ctrl-C)\n"
+    "  --json FILE       per-unit counters as JSON on exit\n"
+    "       potato_fleet query --dir DIR --unit NAME [--from UNIX] [--to UNIX] [--summary]\n");
+}
+
+// "500ms", "10s", "5m" → milliseconds; false if malformed
+static bool parseDurationMs(const char* s, uint64_t* out) {
+  char* end;
+  const double v = strtod(s, &end);
+  if (end == s || v < 0) return false;
+  double unit = 1000;
+  if      (!strcmp(end, "ms")) unit = 1;
+  else if (!strcmp(end, "") || !strcmp(end, "s")) unit = 1000;
+  else if (!strcmp(end, "m"))  unit = 60000;
+  else if (!strcmp(end, "h"))  unit = 3600000;
+  else if (!strcmp(end, "d"))  unit = 86400000;
+  else return false;
+  *out = (uint64_t)(v * unit);
+  return true;
+}
+
+static void unitPath(const char* dir, const char* name, char* out, size_t cap) {
+  snprintf(out, cap, "%s/%s.pfc", dir, name);
+}
+
+// Fixed-point column value as text: 448 at scale 10 → "44.8"
+static int formatFixed(char* out, size_t cap, int32_t v, int32_t scale) {
+  int decimals = 0;
+  for (int32_t s = scale; s > 1; s /= 10) decimals++;
+  const uint32_t mag = v < 0 ? 0u - (uint32_t) v : (uint32_t) v;
+  if (decimals == 0) return snprintf(out, cap, "%s%u", v < 0 ? "-" : "", mag);
+  return snprintf(out, cap, "%s%u.%0*u", v < 0 ? "-" : "", mag / scale, decimals, mag % scale);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1) scrape
+// ──────────────────────────────────────────────────────────────────────────────
+struct ScrapeContext {
+  FleetUnit*       units;
+  FleetColumnFile* files;
+  uint64_t         rows = 0;
+};
+
+static void storeRow(void* ctx, FleetUnit& unit, const FleetRow& row) {
+  ScrapeContext* c = (ScrapeContext*) ctx;
+  if (c->files[&unit - c->units].add(row)) c->rows++;
+}
+
+static int scrape(const char* unitsPath, const char* dir, const FleetOptions& opt,
+                  uint64_t flushMs, uint64_t durationMs, const char* jsonPath) {
+  FILE* f = fopen(unitsPath, "r");
+  if (!f) {
+    fprintf(stderr, "fleet: cannot read %s\n", unitsPath);
+    return 1;
+  }
+  char line[256];
+  size_t n = 0, lineNo = 0;
+  while (fgets(line, sizeof(line), f)) {
+    const char* p = line + strspn(line, " \t");
+    if (*p && *p != '#' && *p != '\n' && *p != '\r') n++;
+  }
+  if (n == 0) {
+    fprintf(stderr, "fleet: no units in %s\n", unitsPath);
+    fclose(f);
+    return 1;
+  }
+
+  // Everything per unit is allocated here, once
+  std::unique_ptr<FleetUnit[]>       units(new FleetUnit[n]);
+  std::unique_ptr<FleetColumnFile[]> files(new FleetColumnFile[n]);
+  mkdir(dir, 0755);
+  rewind(f);
+  size_t u = 0;
+  while (fgets(line, sizeof(line), f)) {
+    lineNo++;
+    const char* p = line + strspn(line, " \t");
+    if (!*p || *p == '#' || *p == '\n' || *p == '\r') continue;
+    char err[160], path[512];
+    if (!fleetParseUnit(p, &units[u], err, sizeof(err))) {
+      fprintf(stderr, "fleet: %s:%zu: %s\n", unitsPath, lineNo, err);
+      fclose(f);
+      return 1;
+    }
+    for (size_t k = 0; k < u; k++) {
+      if (!strcmp(units[k].name, units[u].name)) {
+        fprintf(stderr, "fleet: %s:%zu: unit %s listed twice\n", unitsPath, lineNo, units[u].name);
+        fclose(f);
+        return 1;
+      }
+    }
+    unitPath(dir, units[u].name, path, sizeof(path));
+    if (!files[u].open(path)) {
+      fprintf(stderr, "fleet: cannot open %s: %s\n", path, strerror(errno));
+      fclose(f);
+      return 1;
+    }
+    units[u].lastTs = files[u].lastTs();
+    u++;
+  }
+  fclose(f);
+
+  ScrapeContext ctx;
+  ctx.units = units.get();
+  ctx.files = files.get();
+  FleetScraper scraper;
+  if (!scraper.begin(units.get(), n, opt, storeRow, &ctx)) {
+    fprintf(stderr, "fleet: epoll: %s\n", strerror(errno));
+    return 1;
+  }
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  signal(SIGPIPE, SIG_IGN);
+  fprintf(stderr, "fleet: scraping %zu units every %u ms into %s\n", n, (unsigned) opt.intervalMs, dir);
+
+  const uint64_t startUs = FleetScraper::nowUs();
+  uint64_t nextFlush = startUs + flushMs * 1000;
+  while (!stopRequested) {
+    const uint64_t now = FleetScraper::nowUs();
+    if (durationMs && now - startUs >= durationMs * 1000) break;
+    if (now >= nextFlush) {
+      for (size_t i = 0; i < n; i++) files[i].flush();
+      nextFlush = now + flushMs * 1000;
+    }
+    uint64_t wait = nextFlush - now;
+    if (durationMs && startUs + durationMs * 1000 - now < wait) wait = startUs + durationMs * 1000 - now;
+    scraper.step(wait < 1000000 ? wait : 1000000);
+  }
+  scraper.end();
+  for (size_t i = 0; i < n; i++) files[i].flush();
+
+  // Report
+  const double secs = (FleetScraper::nowUs() - startUs) / 1e6;
+  uint64_t attempts = 0;
+  fprintf(stderr, "\nfleet: %.0f s, %llu readings stored\n", secs, (unsigned long long) ctx.rows);
+  fprintf(stderr, "  %-20s %8s %8s %9s %8s %8s %10s  %s\n",
+          "unit", "scrapes", "samples", "unchanged", "failed", "timeout", "file B", "last error");
+  for (size_t i = 0; i < n; i++) {
+    const FleetUnit& x = units[i];
+    attempts += x.stats.attempts;
+    fprintf(stderr, "  %-20s %8llu %8llu %9llu %8llu %8llu %10llu  %s\n", x.name,
+            (unsigned long long) x.stats.attempts, (unsigned long long) x.stats.samples,
+            (unsigned long long) x.stats.unchanged, (unsigned long long) x.stats.failures,
+            (unsigned long long) x.stats.timeouts, (unsigned long long) files[i].bytes(),
+            x.failStreak ? x.lastError : "");
+  }
+  fprintf(stderr, "  %.1f scrapes/s\n", secs > 0 ? attempts / secs : 0.0);
+
+  if (jsonPath) {
+    FILE* j = fopen(jsonPath, "w");
+    if (!j) {
+      fprintf(stderr, "fleet: cannot write %s\n", jsonPath);
+      return 1;
+    }
+    fprintf(j, "{\"seconds\": %.1f, \"units\": [", secs);
+    for (size_t i = 0; i < n; i++) {
+      const FleetUnit& x = units[i];
+      fprintf(j, "%s\n  {\"name\": \"%s\", \"attempts\": %llu, \"samples\": %llu, \"unchanged\": %llu, "
+                 "\"failures\": %llu, \"timeouts\": %llu, \"bytes\": %llu, \"file_bytes\": %llu, "
+                 "\"down\": %s}",
+              i ? "," : "", x.name, (unsigned long long) x.stats.attempts,
+              (unsigned long long) x.stats.samples, (unsigned long long) x.stats.unchanged,
+              (unsigned long long) x.stats.failures, (unsigned long long) x.stats.timeouts,
+              (unsigned long long) x.stats.bytes, (unsigned long long) files[i].bytes(),
+              x.failStreak ? "true" : "false");
+    }
+    fprintf(j, "\n]}\n");
+    fclose(j);
+  }
+  return 0;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2) query
+// ──────────────────────────────────────────────────────────────────────────────
+static int query(const char* dir, const char* unit, uint32_t from, uint32_t to, bool summary) {
+  char path[512];
+  unitPath(dir, unit, path, sizeof(path));
+
+  uint64_t rows = 0;
+  uint32_t first = 0, last = 0;
+  int32_t  lo[FLEET_COLUMNS], hi[FLEET_COLUMNS];
+  int64_t  sum[FLEET_COLUMNS] = {};
+  uint64_t count[FLEET_COLUMNS] = {};
+  if (!summary) {
+    printf("timestamp");
+    for (const FleetColumn& c : FLEET_COLUMN) printf(",%s", c.csvName);
+    printf("\n");
+  }
+  const bool ok = fleetQuery(path, from, to, [&](const FleetRow& r) {
+    if (rows++ == 0) first = r.ts;
+    last = r.ts;
+    if (!summary) {
+      char line[128];
+      int len = snprintf(line, sizeof(line), "%lu", (unsigned long) r.ts);
+      for (size_t c = 0; c < FLEET_COLUMNS; c++) {
+        line[len++] = ',';
+        len += formatFixed(line + len, sizeof(line) - len, r.v[c], FLEET_COLUMN[c].scale);
+      }
+      line[len++] = '\n';
+      fwrite(line, 1, len, stdout);
+      return;
+    }
+    for (size_t c = 0; c < FLEET_COLUMNS; c++) {
+      // Skip the unit's "none" values (−999, −1)
+      if (r.v[c] == -999 * FLEET_COLUMN[c].scale || r.v[c] == -FLEET_COLUMN[c].scale) continue;
+      if (count[c]++ == 0) lo[c] = hi[c] = r.v[c];
+      if (r.v[c] < lo[c]) lo[c] = r.v[c];
+      if (r.v[c] > hi[c]) hi[c] = r.v[c];
+      sum[c] += r.v[c];
+    }
+  });
+  if (!ok) {
+    fprintf(stderr, "fleet: cannot read %s: %s\n", path, strerror(errno));
+    return 1;
+  }
+  if (!summary) return 0;
+
+  struct stat st = {};
+  stat(path, &st);
+  printf("unit      %s\nrows      %llu\n", unit, (unsigned long long) rows);
+  if (rows) printf("span      %lu .. %lu (%.1f h)\n", (unsigned long) first, (unsigned long) last, (last - first) / 3600.0);
+  printf("file      %lld bytes (%.2f per row, whole file)\n", (long long) st.st_size,
+         rows ? (double) st.st_size / rows : 0.0);
+  for (size_t c = 0; c < FLEET_COLUMNS; c++) {
+    if (!count[c]) continue;
+    char a[24], b[24], m[24];
+    formatFixed(a, sizeof(a), lo[c], FLEET_COLUMN[c].scale);
+    formatFixed(b, sizeof(b), hi[c], FLEET_COLUMN[c].scale);
+    formatFixed(m, sizeof(m), (int32_t)(sum[c] / (int64_t) count[c]), FLEET_COLUMN[c].scale);
+    printf("%-13s min %s  mean %s  max %s\n", FLEET_COLUMN[c].csvName, a, m, b);
+  }
+  return 0;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3) Command line
+// ──────────────────────────────────────────────────────────────────────────────
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    usage();
+    return 2;
+  }
+  const bool isScrape = !strcmp(argv[1], "scrape");
+  const bool isQuery  = !strcmp(argv[1], "query");
+  if (!isScrape && !isQuery) {
+    usage();
+    return 2;
+  }
+
+  FleetOptions opt;
+  const char* unitsPath = nullptr;
+  const char* dir       = nullptr;
+  const char* unit      = nullptr;
+  const char* jsonPath  = nullptr;
+  uint64_t flushMs = 60000, durationMs = 0;
+  uint32_t from = 0, to = UINT32_MAX;
+  bool summary = false;
+  for (int i = 2; i < argc; i++) {
+    const char* a = argv[i];
+    if (!strcmp(a, "--summary")) {
+      summary = true;
+      continue;
+    }
+    const char* v = i + 1 < argc ? argv[++i] : nullptr;
+    uint64_t ms = 0;
+    const bool isTime = v && parseDurationMs(v, &ms);
+    if (!v)                                        { usage(); return 2; }
+    if      (!strcmp(a, "--units"))                unitsPath = v;
+    else if (!strcmp(a, "--dir"))                  dir       = v;
+    else if (!strcmp(a, "--unit"))                 unit      = v;
+    else if (!strcmp(a, "--json"))                 jsonPath  = v;
+    else if (!strcmp(a, "--from"))                 from = strtoul(v, nullptr, 10);
+    else if (!strcmp(a, "--to"))                   to   = strtoul(v, nullptr, 10);
+    else if (!strcmp(a, "--interval") && isTime)   opt.intervalMs   = (uint32_t) ms;
+    else if (!strcmp(a, "--timeout") && isTime)    opt.timeoutMs    = (uint32_t) ms;
+    else if (!strcmp(a, "--max-backoff") && isTime) opt.maxBackoffMs = (uint32_t) ms;
+    else if (!strcmp(a, "--flush") && isTime)      flushMs    = ms;
+    else if (!strcmp(a, "--duration") && isTime)   durationMs = ms;
+    else                                           { usage(); return 2; }
+  }
+  if (!dir || (isScrape && !unitsPath) || (isQuery && !unit) || opt.timeoutMs == 0 || flushMs == 0) {
+    usage();
+    return 2;
+  }
+  return isScrape ? scrape(unitsPath, dir, opt, flushMs, durationMs, jsonPath)
+                  : query(dir, unit, from, to, summary);
+}
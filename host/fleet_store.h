@@ -0,0 +1,241 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// fleet_store.h — compact columnar sample files for the fleet collector
+//
+// One append-only file per unit (DIR/<unit>.pfc) holding the readings
+// potato_fleet scraped from its /sensor-data. Samples collect in a RAM
+// block and are written as one append when FLEET_BLOCK_ROWS have
+// accumulated or the collector flushes (every --flush seconds, and on
+// exit). Each block is self-contained:
+//
+//   FleetBlockHeader (20 B) │ payload: the columns, one after another
+//
+//   ts          rows − 1 varints: seconds since the previous row
+//   temperature rows zigzag varints: change since the previous row, 0.1 °F
+//   humidity                         …  0.1 %RH
+//   dew_point                        …  0.1 °F  (−9990 = none)
+//   vpd                              …  Pa      (−1000 = none)
+//
+// A column is a run of small deltas of one quantity, so a steady room
+// costs about five bytes per row. The header carries the block's first and
+// last timestamp, so a range query skips blocks without decoding them.
+// The CRC-32 (sample_log.h's) covers header and payload: a block torn by a
+// crash fails it, and open() cuts the file back to the last good block.
+//
+// Single-threaded; no allocation after open().
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../sample_log.h"
+
+static const uint32_t FLEET_MAGIC      = 0x31434650;    // "PFC1"
+static const size_t   FLEET_BLOCK_ROWS = 256;
+static const size_t   FLEET_COLUMNS    = 4;             // after the timestamp
+static const size_t   FLEET_VARINT_MAX = 5;
+static const size_t   FLEET_PAYLOAD_MAX = FLEET_BLOCK_ROWS * (1 + FLEET_COLUMNS) * FLEET_VARINT_MAX;
+
+// The /sensor-data fields stored, in column order, and their fixed-point
+// scale (stored value = JSON value × scale, so the unit's "none" values,
+// −999 and −1, stay recognisable)
+struct FleetColumn {
+  const char* key;
+  const char* csvName;
+  int32_t     scale;
+};
+static const FleetColumn FLEET_COLUMN[FLEET_COLUMNS] = {
+  { "temperature", "temperature_f", 10 },
+  { "humidity",    "humidity",      10 },
+  { "dew_point",   "dew_point_f",   10 },
+  { "vpd",         "vpd_kpa",       1000 },
+};
+
+struct FleetBlockHeader {
+  uint32_t magic;
+  uint32_t firstTs;
+  uint32_t lastTs;
+  uint16_t rows;
+  uint16_t len;       // payload bytes after the header
+  uint32_t crc;       // CRC-32 of header (crc = 0) + payload
+};
+
+struct FleetRow {
+  uint32_t ts;
+  int32_t  v[FLEET_COLUMNS];
+};
+
+inline uint8_t* fleetPutVarint(uint8_t* p, uint32_t v) {
+  while (v >= 0x80) {
+    *p++ = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  *p++ = (uint8_t) v;
+  return p;
+}
+
+inline bool fleetGetVarint(const uint8_t*& p, const uint8_t* end, uint32_t* v) {
+  *v = 0;
+  for (int shift = 0; shift < 35 && p < end; shift += 7) {
+    const uint8_t b = *p++;
+    *v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+inline uint32_t fleetZigzag(int32_t v)   { return ((uint32_t) v << 1) ^ (uint32_t)(v >> 31); }
+inline int32_t  fleetUnzigzag(uint32_t z) { return (int32_t)(z >> 1) ^ -(int32_t)(z & 1); }
+
+// Decode one checked block's rows, oldest first, into visit(const FleetRow&).
+// False if the payload is malformed.
+template <typename F>
+inline bool fleetDecodeBlock(const FleetBlockHeader& h, const uint8_t* p, F&& visit) {
+  static FleetRow rows[FLEET_BLOCK_ROWS];
+  const uint8_t* end = p + h.len;
+  if (h.rows == 0 || h.rows > FLEET_BLOCK_ROWS) return false;
+  uint32_t z;
+  rows[0].ts = h.firstTs;
+  for (size_t r = 1; r < h.rows; r++) {
+    if (!fleetGetVarint(p, end, &z)) return false;
+    rows[r].ts = rows[r - 1].ts + z;
+  }
+  for (size_t c = 0; c < FLEET_COLUMNS; c++) {
+    int32_t v = 0;
+    for (size_t r = 0; r < h.rows; r++) {
+      if (!fleetGetVarint(p, end, &z)) return false;
+      v += fleetUnzigzag(z);
+      rows[r].v[c] = v;
+    }
+  }
+  for (size_t r = 0; r < h.rows; r++) visit(rows[r]);
+  return true;
+}
+
+// Read the checked blocks of an open file from the start, calling
+// block(header, payload) for each; stops at the first bad one. Returns the
+// offset just past the last good block.
+template <typename F>
+inline off_t fleetScanBlocks(int fd, F&& block) {
+  static uint8_t payload[FLEET_PAYLOAD_MAX];
+  off_t at = 0;
+  for (;;) {
+    FleetBlockHeader h;
+    if (pread(fd, &h, sizeof(h), at) != (ssize_t) sizeof(h)) break;
+    if (h.magic != FLEET_MAGIC || h.len > FLEET_PAYLOAD_MAX || h.rows == 0) break;
+    if (pread(fd, payload, h.len, at + sizeof(h)) != (ssize_t) h.len) break;
+    FleetBlockHeader zeroed = h;
+    zeroed.crc = 0;
+    if (logCrc32(logCrc32(0, &zeroed, sizeof(zeroed)), payload, h.len) != h.crc) break;
+    block(h, (const uint8_t*) payload);
+    at += sizeof(h) + h.len;
+  }
+  return at;
+}
+
+// Every row with from <= ts <= to in the file at `path`, oldest first.
+// False if the file can't be opened.
+template <typename F>
+inline bool fleetQuery(const char* path, uint32_t from, uint32_t to, F&& visit) {
+  const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return false;
+  fleetScanBlocks(fd, [&](const FleetBlockHeader& h, const uint8_t* p) {
+    if (h.lastTs < from || h.firstTs > to) return;
+    fleetDecodeBlock(h, p, [&](const FleetRow& r) {
+      if (r.ts >= from && r.ts <= to) visit(r);
+    });
+  });
+  close(fd);
+  return true;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Writer: one per unit, owned by the collector
+// ──────────────────────────────────────────────────────────────────────────────
+class FleetColumnFile {
+public:
+  ~FleetColumnFile() { close(); }
+
+  // Open (or create) `path` for appending. A torn or corrupt tail is cut
+  // off; rows at or before the newest stored timestamp are refused later.
+  bool open(const char* path) {
+    close();
+    fd_ = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) return false;
+    lastTs_ = 0;
+    const off_t good = fleetScanBlocks(fd_, [&](const FleetBlockHeader& h, const uint8_t*) {
+      lastTs_ = h.lastTs;
+    });
+    if (lseek(fd_, 0, SEEK_END) != good &&
+        (ftruncate(fd_, good) != 0 || lseek(fd_, good, SEEK_SET) != good)) {
+      return false;
+    }
+    bytes_ = good;
+    rows_  = 0;
+    return true;
+  }
+
+  void close() {
+    if (fd_ < 0) return;
+    flush();
+    ::close(fd_);
+    fd_ = -1;
+  }
+
+  // Buffer one row; false (and nothing stored) if it is not newer than the
+  // last one. A full block is written at once.
+  bool add(const FleetRow& row) {
+    if (fd_ < 0 || row.ts <= lastTs_) return false;
+    pending_[rows_++] = row;
+    lastTs_ = row.ts;
+    if (rows_ == FLEET_BLOCK_ROWS) flush();
+    return true;
+  }
+
+  // Write the pending rows as one block. False on a write error (the rows
+  // are dropped; the next block starts clean).
+  bool flush() {
+    if (fd_ < 0 || rows_ == 0) return true;
+    static uint8_t block[sizeof(FleetBlockHeader) + FLEET_PAYLOAD_MAX];
+    uint8_t* p = block + sizeof(FleetBlockHeader);
+    for (size_t r = 1; r < rows_; r++) p = fleetPutVarint(p, pending_[r].ts - pending_[r - 1].ts);
+    for (size_t c = 0; c < FLEET_COLUMNS; c++) {
+      int32_t prev = 0;
+      for (size_t r = 0; r < rows_; r++) {
+        p = fleetPutVarint(p, fleetZigzag(pending_[r].v[c] - prev));
+        prev = pending_[r].v[c];
+      }
+    }
+    FleetBlockHeader h;
+    h.magic   = FLEET_MAGIC;
+    h.firstTs = pending_[0].ts;
+    h.lastTs  = pending_[rows_ - 1].ts;
+    h.rows    = (uint16_t) rows_;
+    h.len     = (uint16_t)(p - block - sizeof(h));
+    h.crc     = 0;
+    h.crc     = logCrc32(logCrc32(0, &h, sizeof(h)), block + sizeof(h), h.len);
+    memcpy(block, &h, sizeof(h));
+    const size_t len = p - block;
+    rows_ = 0;
+    if (write(fd_, block, len) != (ssize_t) len) {
+      // Cut a partial block back off so the file stays readable
+      if (ftruncate(fd_, bytes_) == 0) lseek(fd_, bytes_, SEEK_SET);
+      return false;
+    }
+    bytes_ += len;
+    return true;
+  }
+
+  uint32_t lastTs()  const { return lastTs_; }
+  size_t   pending() const { return rows_; }
+  uint64_t bytes()   const { return (uint64_t) bytes_; }
+
+private:
+  int      fd_     = -1;
+  uint32_t lastTs_ = 0;
+  off_t    bytes_  = 0;
+  size_t   rows_   = 0;
+  FleetRow pending_[FLEET_BLOCK_ROWS];
+};
@@ -0,0 +1,711 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// hal_host.cpp — hal.h for the Linux simulation
+//
+//   clock     virtual, advanced by sim_main (real time, N× or flat out)
+//   sensors   1–8 probes (DHT22, then alternating SHT3x/DHT22) reading a
+//             CSV trace or a synthetic day/night cycle plus a per-probe
+//             offset, encoded into the edges the ESP32 ISR captures or the
+//             bytes the I2C read returns and run through dht22Decode() /
+//             sht3xDecode(), so the decoders are exercised on every read
+//   display   128×128 RGB565 framebuffer, 5×7 font, SPI byte estimate
+//   HTTP      http_server.h on a real local port (keep-alive pool),
+//             detachable streams for /events
+//   flash     files in a directory, with an optional power cut after N bytes
+//   uplink    blocking POSTs over a plain socket to a local stand-in collector
+//             and alert webhook
+// ──────────────────────────────────────────────────────────────────────────────
+#include "hal_host.h"
+#include "../hal.h"
+#include "../app.h"
+#include "../font5x7.h"
+#include "../http_server.h"
+#include "../sht3x_decode.h"
+#include "../trace.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <malloc.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+static SimConfig config;
+static SimStats  stats;
+static std::mt19937 rng(12345);
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1) Clock
+// ──────────────────────────────────────────────────────────────────────────────
+static uint64_t nowUs = 0;
+
+uint64_t simMicros()            { return nowUs; }
+void     simSetMicros(uint64_t us) { if (us > nowUs) nowUs = us; }
+
+uint32_t halMillis() { return (uint32_t)(nowUs / 1000); }
+
+static uint64_t wallMicros() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+uint32_t halPerfMicros() { return (uint32_t) wallMicros(); }
+
+// Trace clock: real nanoseconds stand in for cycles (they wrap every 4.3 s,
+// so the tick does the same job as on the device); one CPU
+static uint64_t wallNanos() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+uint32_t halCycleCount()  { return (uint32_t) wallNanos(); }
+uint32_t halCyclesPerUs() { return 1000; }
+uint32_t halTickMs()      { return (uint32_t)(wallNanos() / 1000000); }
+uint8_t  halCpuId()       { return 0; }
+
+// Before the configured NTP delay the clock reads seconds since boot, like an
+// ESP32 whose SNTP client hasn't answered yet.
+time_t halTime() {
+  const uint64_t s = nowUs / 1000000;
+  if (s < config.ntpDelayS) return (time_t) s;
+  return config.epoch + (time_t) s;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2) Logging, prefixed with virtual uptime
+// ──────────────────────────────────────────────────────────────────────────────
+void halLog(const char* fmt, ...) {
+  fprintf(stderr, "[%10.3f] ", nowUs / 1e6);
+  va_list ap;
+  va_start(ap, fmt);
+  vfprintf(stderr, fmt, ap);
+  va_end(ap);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3) Sensors
+//
+// CSV rows are "seconds,temp_c,humidity" (header and '#' lines ignored).
+// Seconds may be UNIX time or an offset; the first row is boot. Each read
+// returns the latest row at or before the current virtual time, shifted by
+// the probe's fixed offset (none for probe 0, so one probe reads the trace).
+// A row with only the seconds ("120,,") unplugs every probe until the next
+// row: reads get no reply.
+// ──────────────────────────────────────────────────────────────────────────────
+struct TraceRow {
+  uint32_t t;        // seconds after the first row
+  int16_t  t10C;
+  uint16_t h10;
+  bool     absent;   // no sensor answers
+};
+
+static std::vector<TraceRow> trace;
+static size_t   traceIdx  = 0;
+static bool     traceDone = false;
+
+static const uint32_t DHT_FRAME_US = 5500;   // 1.1 ms start pulse + ≈4.4 ms transfer
+static const uint32_t SHT_FRAME_US = SHT3X_MEASURE_US + 600;   // + the 6-byte read
+
+static_assert(SIM_MAX_SENSORS == APP_MAX_SENSORS, "sim probe table must match the app's");
+
+struct SimProbe {
+  HalSensorInfo info;
+  char          name[8];
+  int16_t       dT10;                 // offset from the trace, 0.1 °C / 0.1 %RH
+  int16_t       dH10;
+  bool          busy      = false;
+  uint64_t      doneAt    = 0;
+  bool          hasResult = false;
+  Dht22Reading  result;
+  Dht22Status   status;
+};
+
+static SimProbe probes[SIM_MAX_SENSORS];
+static size_t   probeCount = 1;
+static uint32_t startCommonMs = 0;   // cadence seen by the last halSensorStart()
+
+static bool loadTrace(const char* path, time_t* firstUnix) {
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "sim: cannot open %s: %s\n", path, strerror(errno));
+    return false;
+  }
+  char line[256];
+  double t0 = -1;
+  while (fgets(line, sizeof(line), f)) {
+    double t, c = 0, h = 0;
+    if (line[0] == '#') continue;
+    const int fields = sscanf(line, "%lf,%lf,%lf", &t, &c, &h);
+    if (fields != 3 && !(fields == 1 && strstr(line, ",,"))) continue;
+    if (t0 < 0) t0 = t;
+    if (t < t0) continue;                       // out of order; skip
+    TraceRow r;
+    r.t      = (uint32_t)(t - t0);
+    r.t10C   = (int16_t)  lround(c * 10.0);
+    r.h10    = (uint16_t) lround(std::max(0.0, h) * 10.0);
+    r.absent = fields == 1;
+    trace.push_back(r);
+  }
+  fclose(f);
+  if (trace.empty()) {
+    fprintf(stderr, "sim: %s has no \"seconds,temp_c,humidity\" rows\n", path);
+    return false;
+  }
+  *firstUnix = t0 >= (double) UNIX_TIME_VALID ? (time_t) t0 : 0;
+  return true;
+}
+
+bool simTraceDone() { return traceDone; }
+
+// The value the sensor would report right now; false if it wouldn't answer
+static bool sensorValue(int16_t* t10C, uint16_t* h10) {
+  const uint32_t s = (uint32_t)(nowUs / 1000000);
+  if (!trace.empty()) {
+    while (traceIdx + 1 < trace.size() && trace[traceIdx + 1].t <= s) traceIdx++;
+    if (traceIdx + 1 == trace.size() && s >= trace.back().t) traceDone = true;
+    *t10C = trace[traceIdx].t10C;
+    *h10  = trace[traceIdx].h10;
+    return !trace[traceIdx].absent;
+  }
+  // Synthetic storage room: 7 °C ± 1.5 over the day, 92 %RH ± 3 in antiphase
+  const double day = 2 * M_PI * (s % 86400) / 86400.0;
+  *t10C = (int16_t)  lround(70 + 15 * sin(day));
+  *h10  = (uint16_t) lround(920 - 30 * sin(day));
+  return true;
+}
+
+// Encode a reading into the edge timestamps the ESP32 ISR would capture:
+// host release edge, 80/80 µs response, 40 × (50 µs low + 27/70 µs high),
+// closing low and the final release. See dht22_decode.h.
+static size_t encodeFrame(int16_t t10C, uint16_t h10, bool corrupt, uint32_t* edges) {
+  const uint16_t t = t10C < 0 ? (uint16_t)(0x8000 | -t10C) : (uint16_t) t10C;
+  uint8_t b[5] = { (uint8_t)(h10 >> 8), (uint8_t) h10, (uint8_t)(t >> 8), (uint8_t) t, 0 };
+  b[4] = (uint8_t)(b[0] + b[1] + b[2] + b[3] + (corrupt ? 1 : 0));
+
+  std::uniform_int_distribution<int> jitter(-3, 3);
+  size_t n = 0;
+  uint32_t at = 0;
+  edges[n++] = at;                              // host lets go
+  edges[n++] = at += 25;                        // sensor pulls low
+  edges[n++] = at += 80 + jitter(rng);
+  edges[n++] = at += 80 + jitter(rng);
+  for (int k = 0; k < 40; k++) {
+    const bool one = (b[k / 8] >> (7 - k % 8)) & 1;
+    edges[n++] = at += 50 + jitter(rng);
+    edges[n++] = at += (one ? 70 : 27) + jitter(rng);
+  }
+  edges[n++] = at += 50;                        // bus released
+  return n;
+}
+
+// The six bytes an SHT3x returns for a reading: two CRC-8 protected words
+static void encodeSht3x(int16_t t10C, uint16_t h10, bool corrupt, uint8_t* frame) {
+  const uint32_t rawT  = (uint32_t) lround((t10C + 450) * 65535.0 / 1750.0);
+  const uint32_t rawRh = (uint32_t) lround(std::min<uint16_t>(h10, 1000) * 65535.0 / 1000.0);
+  frame[0] = (uint8_t)(rawT >> 8);
+  frame[1] = (uint8_t) rawT;
+  frame[2] = sht3xCrc8(frame, 2);
+  frame[3] = (uint8_t)(rawRh >> 8);
+  frame[4] = (uint8_t) rawRh;
+  frame[5] = (uint8_t)(sht3xCrc8(frame + 3, 2) ^ (corrupt ? 1 : 0));
+}
+
+static void setupProbes(size_t count) {
+  probeCount = std::min<size_t>(std::max<size_t>(count, 1), SIM_MAX_SENSORS);
+  for (size_t i = 0; i < probeCount; i++) {
+    SimProbe& p = probes[i];
+    const bool sht = (i % 2) == 1;
+    if (i == 0) snprintf(p.name, sizeof(p.name), "pile");
+    else        snprintf(p.name, sizeof(p.name), "%s%zu", sht ? "sht" : "dht", i);
+    p.info = { p.name, sht ? SENSOR_SHT3X : SENSOR_DHT22, sht ? 100u : 2000u };
+    p.dT10 = (int16_t)(i == 0 ? 0 : (int)(i * 7 % 11) - 5);     // within ±0.5 °C
+    p.dH10 = (int16_t)(i == 0 ? 0 : (int)(i * 13 % 21) - 10);   // within ±1 %RH
+  }
+}
+
+size_t               halSensorCount()        { return probeCount; }
+const HalSensorInfo& halSensorInfo(size_t i) { return probes[i].info; }
+uint32_t             halSensorMaxPeriodMs()  { return config.maxPeriodMs; }
+
+void halSensorStart(size_t i) {
+  SimProbe& p = probes[i];
+  if (p.busy) return;
+  p.busy      = true;
+  p.hasResult = false;
+  p.doneAt    = nowUs + (p.info.kind == SENSOR_SHT3X ? SHT_FRAME_US : DHT_FRAME_US);
+
+  // Spacing against the period the scheduler has for this probe now: the
+  // cadence the sensor step last published, raised to the probe's minimum
+  // interval. A gap that spans a cadence change only counts if it came
+  // early, since setPeriod() may place the read anywhere past one period.
+  const uint32_t common = snapshot.load().samplePeriodMs;
+  if (common != startCommonMs) {
+    if (startCommonMs) stats.periodChanges++;
+    startCommonMs = common;
+  }
+  const uint64_t periodUs = (uint64_t) std::max(common ? common : APP_SENSOR_PERIOD_MS,
+                                                p.info.minIntervalMs) * 1000;
+  SimProbeStats& ps = stats.probes[i];
+  if (ps.starts > 0) {
+    const uint64_t gap = nowUs - ps.lastStartUs;
+    ps.minGapUs = ps.starts == 1 ? gap : std::min(ps.minGapUs, gap);
+    ps.maxGapUs = std::max(ps.maxGapUs, gap);
+    const bool steady = ps.periodEpoch == stats.periodChanges && ps.periodUs == periodUs;
+    const uint64_t off = gap < periodUs ? periodUs - gap : steady ? gap - periodUs : 0;
+    ps.maxJitterUs = std::max(ps.maxJitterUs, off);
+  }
+  ps.starts++;
+  ps.lastStartUs = nowUs;
+  ps.periodUs    = periodUs;
+  ps.periodEpoch = stats.periodChanges;
+}
+
+void halSensorPoll(size_t i) {
+  SimProbe& p = probes[i];
+  if (!p.busy || nowUs < p.doneAt) return;
+  int16_t t10C;
+  uint16_t h10;
+  const bool present = sensorValue(&t10C, &h10);
+  t10C = (int16_t)(t10C + p.dT10);
+  h10  = (uint16_t) std::max(0, h10 + p.dH10);
+  std::uniform_real_distribution<double> u(0.0, 1.0);
+  const bool corrupt = u(rng) < config.failRate;
+  if (p.info.kind == SENSOR_SHT3X) {
+    uint8_t frame[SHT3X_FRAME_BYTES];
+    encodeSht3x(t10C, h10, corrupt, frame);
+    p.status = sht3xDecode(frame, present ? sizeof(frame) : 0, &p.result);   // NACK
+  } else {
+    uint32_t edges[DHT22_FRAME_EDGES + 2];
+    const size_t n = encodeFrame(t10C, h10, corrupt, edges);
+    p.status = dht22Decode(edges, present ? n : 1, &p.result);   // only the host's release edge
+  }
+  p.busy      = false;
+  p.hasResult = true;
+  stats.sensorReads++;
+  stats.probes[i].reads++;
+  if (p.status != DHT22_OK) {
+    stats.sensorFailures++;
+    stats.probes[i].failures++;
+  }
+}
+
+bool halSensorBusy(size_t i) { return probes[i].busy; }
+
+bool halSensorTakeResult(size_t i, Dht22Reading& r, Dht22Status& status) {
+  SimProbe& p = probes[i];
+  if (!p.hasResult) return false;
+  p.hasResult = false;
+  r      = p.result;
+  status = p.status;
+  return true;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 4) Display
+//
+// SPI cost follows what Adafruit_SSD1351 sends: every filled rectangle or
+// blit is a 7-byte address window (0x15/0x75/0x5C + 4 args) plus 2 bytes
+// per pixel. GFX's drawChar() with a transparent background (kept only as
+// the reference for glyph_atlas.h) fills one size×size square per lit font
+// pixel.
+// ──────────────────────────────────────────────────────────────────────────────
+static uint16_t fb[SCREEN_WIDTH * SCREEN_HEIGHT];
+static const uint32_t SPI_WINDOW_BYTES = 7;
+
+static void fillRect(int x, int y, int w, int h, uint16_t color) {
+  int x0 = std::max(x, 0), y0 = std::max(y, 0);
+  int x1 = std::min(x + w, SCREEN_WIDTH), y1 = std::min(y + h, SCREEN_HEIGHT);
+  if (x0 >= x1 || y0 >= y1) return;
+  for (int py = y0; py < y1; py++) {
+    std::fill(fb + py * SCREEN_WIDTH + x0, fb + py * SCREEN_WIDTH + x1, color);
+  }
+  stats.spiBytes += SPI_WINDOW_BYTES + 2u * (x1 - x0) * (y1 - y0);
+  stats.spiWindows++;
+}
+
+void halDisplayFillScreen(uint16_t color) {
+  stats.displayCalls++;
+  fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, color);
+}
+
+void halDisplayFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  stats.displayCalls++;
+  fillRect(x, y, w, h, color);
+}
+
+void halDisplayBlit(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* pixels) {
+  stats.displayCalls++;
+  int x0 = std::max<int>(x, 0), y0 = std::max<int>(y, 0);
+  int x1 = std::min(x + w, SCREEN_WIDTH), y1 = std::min(y + h, SCREEN_HEIGHT);
+  if (x0 >= x1 || y0 >= y1) return;
+  for (int py = y0; py < y1; py++) {
+    const uint16_t* src = pixels + (py - y) * w + (x0 - x);
+    std::copy(src, src + (x1 - x0), fb + py * SCREEN_WIDTH + x0);
+  }
+  stats.spiBytes += SPI_WINDOW_BYTES + 2u * (x1 - x0) * (y1 - y0);
+  stats.spiWindows++;
+}
+
+void simDrawCharGfx(int16_t x, int16_t y, char c, uint16_t color, uint8_t size) {
+  stats.displayCalls++;
+  const uint8_t* cols = font5x7Find(c);
+  for (int cx = 0; cx < FONT5X7_COLS; cx++) {
+    const uint8_t bits = cols ? cols[cx] : 0x7F;   // unknown glyph → solid box
+    for (int cy = 0; cy < FONT5X7_ROWS; cy++) {
+      if (bits & (1 << cy)) fillRect(x + cx * size, y + cy * size, size, size, color);
+    }
+  }
+}
+
+const uint16_t* simFramebuffer() { return fb; }
+
+bool simWritePpm(const char* path) {
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  fprintf(f, "P6\n%d %d\n255\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+  for (uint16_t p : fb) {
+    const uint8_t rgb[3] = {
+      (uint8_t)(((p >> 11) & 0x1F) * 255 / 31),
+      (uint8_t)(((p >>  5) & 0x3F) * 255 / 63),
+      (uint8_t)(( p        & 0x1F) * 255 / 31),
+    };
+    fwrite(rgb, 1, 3, f);
+  }
+  return fclose(f) == 0;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 5) HTTP — the device's own server (http_server.h) on real sockets, so the
+//    dashboard, keep-alive and the pool limits behave as on the ESP32.
+//
+// simHttpRequest() runs a handler without a socket and collects the response
+// in memory; potato_bench relies on it to attribute allocations to app.cpp
+// alone.
+// ──────────────────────────────────────────────────────────────────────────────
+static HttpServer http;
+
+void halHttpOn(const char* path, HalHttpHandler handler)     { http.on(path, handler); }
+bool halHttpArg(const char* name, char* out, size_t cap)    { return http.arg(name, out, cap); }
+bool halHttpHeaderIs(const char* name, const char* value)   { return http.headerIs(name, value); }
+void halHttpSendHeader(const char* name, const char* value) { http.sendHeader(name, value); }
+void halHttpBeginChunked(int code, const char* contentType) { http.beginChunked(code, contentType); }
+void halHttpChunk(const void* data, size_t len)             { http.chunk(data, len); }
+void halHttpEndChunked()                                    { http.endChunked(); }
+int  halHttpDetach()                                        { return http.detach(); }
+bool halStreamOpen(int id)                                  { return http.streamOpen(id); }
+void halStreamClose(int id)                                 { http.streamClose(id); }
+void halHttpInfo(HalHttpInfo* out)                          { http.info(out); }
+
+void halHttpSend(int code, const char* contentType, const void* body, size_t len) {
+  http.send(code, contentType, body, len);
+}
+
+void halHttpSendStatic(int code, const char* contentType, const void* body, size_t len) {
+  http.sendStatic(code, contentType, body, len);
+}
+
+bool halStreamWrite(int id, const void* data, size_t len) {
+  if (!http.streamWrite(id, data, len)) return false;
+  stats.streamBytes += len;
+  return true;
+}
+
+size_t simHttpRequest(const char* target, const char* ifNoneMatch, std::string* out) {
+  const size_t before = out->size();
+  http.handleInMemory(target, ifNoneMatch, [](void* ctx, const void* data, size_t len) {
+    ((std::string*) ctx)->append((const char*) data, len);
+  }, out);
+  return out->size() - before;
+}
+
+// Time spent blocked here is the sim's idle time (halCpuInfo)
+static uint64_t idleWallUs = 0;
+
+bool simHttpPoll(uint64_t timeoutUs) {
+  pollfd fds[HTTP_POLL_FDS];
+  const int n = http.pollSet(fds);
+  timeoutUs = std::min<uint64_t>(timeoutUs, http.untilTimeoutUs());
+  timespec ts = { (time_t)(timeoutUs / 1000000), (long)(timeoutUs % 1000000) * 1000 };
+  const uint64_t w0 = wallMicros();
+  int ready = 0;
+  if (n == 0) {
+    if (timeoutUs > 0) nanosleep(&ts, nullptr);
+  } else {
+    ready = ppoll(fds, n, &ts, nullptr);
+  }
+  idleWallUs += wallMicros() - w0;
+
+  const uint32_t t0 = halPerfMicros();
+  if (ready > 0) TRACE_BEGIN(TRACE_HTTP_PASS, 0);
+  const int handled = http.process(fds, ready > 0 ? n : 0);
+  if (ready > 0) {
+    TRACE_END(TRACE_HTTP_PASS);
+    metrics.httpService.observe(halPerfMicros() - t0);
+  }
+  return handled > 0;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 6) Concurrency — one thread, so the lock is a no-op and a "notification" is
+//    a flag sim_main polls
+// ──────────────────────────────────────────────────────────────────────────────
+static bool displayNotified = false;
+static bool alertNotified   = false;
+
+void halHistoryLock()   {}
+void halHistoryUnlock() {}
+void halNotifySample() { displayNotified = alertNotified = true; }
+
+bool simTakeDisplayNotify() {
+  const bool n = displayNotified;
+  displayNotified = false;
+  return n;
+}
+
+bool simTakeAlertNotify() {
+  const bool n = alertNotified;
+  alertNotified = false;
+  return n;
+}
+
+uint32_t halRandom() { return rng(); }
+
+// glibc can't report its largest free block or a low-water mark; free heap
+// stands in for all three.
+void halHeapInfo(HalHeapInfo* out) {
+  const struct mallinfo2 mi = mallinfo2();
+  out->freeBytes = out->minFreeBytes = out->largestFreeBlock = (uint32_t) mi.fordblks;
+}
+
+// One thread: idle is real time spent blocked waiting for HTTP or the next
+// deadline, against real time since simInit()
+static uint64_t wallStartUs = 0;
+
+void halCpuInfo(HalCpuInfo* out) {
+  out->cpus      = 1;
+  out->sinceUs   = wallMicros() - wallStartUs;
+  out->idleUs[0] = idleWallUs;
+}
+
+size_t halTaskStacks(HalTaskStack*, size_t) { return 0; }
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 7) Flash — "/name" maps to flashDir/name. A power cut truncates the append
+//    that crosses the byte budget (a torn write) and fails every one after.
+// ──────────────────────────────────────────────────────────────────────────────
+static bool powerLost = false;
+
+// Plain syscalls and a stack path: stdio would allocate inside the sensor
+// step and show up in potato_bench's allocation counts
+static const char* flashPath(const char* path, char* out, size_t cap) {
+  snprintf(out, cap, "%s%s", config.flashDir, path);
+  return out;
+}
+
+bool simPowerLost() { return powerLost; }
+
+bool halFsMounted() { return config.flashDir != nullptr; }
+
+size_t halFsSize(const char* path) {
+  char full[512];
+  struct stat st;
+  if (!config.flashDir || stat(flashPath(path, full, sizeof(full)), &st) != 0) return 0;
+  return (size_t) st.st_size;
+}
+
+size_t halFsRead(const char* path, uint32_t offset, void* buf, size_t len) {
+  char full[512];
+  if (!config.flashDir) return 0;
+  const int fd = open(flashPath(path, full, sizeof(full)), O_RDONLY);
+  if (fd < 0) return 0;
+  const ssize_t n = pread(fd, buf, len, offset);
+  close(fd);
+  return n > 0 ? (size_t) n : 0;
+}
+
+bool halFsAppend(const char* path, const void* data, size_t len) {
+  char full[512];
+  if (!config.flashDir || powerLost) return false;
+  size_t n = len;
+  if (config.powerCutAfter) {
+    n = (size_t) std::min<uint64_t>(len, config.powerCutAfter - stats.flashBytes);
+    powerLost = n < len || stats.flashBytes + n == config.powerCutAfter;
+  }
+  const int fd = open(flashPath(path, full, sizeof(full)), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd < 0) return false;
+  const ssize_t wrote = write(fd, data, n);
+  close(fd);
+  if (wrote > 0) stats.flashBytes += (uint64_t) wrote;
+  stats.flashWrites++;
+  return wrote == (ssize_t) len;
+}
+
+bool halFsRemove(const char* path) {
+  char full[512];
+  if (!config.flashDir || powerLost) return false;
+  return unlink(flashPath(path, full, sizeof(full))) == 0 || errno == ENOENT;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 8) Uplink and alert webhook — HTTP/1.1 POST with Connection: close, one
+//    socket per POST like the ESP32's HTTPClient. Waits in real time
+//    (connect, send, status line) while the virtual clock stands still, as
+//    the uplink and alert tasks would block.
+// ──────────────────────────────────────────────────────────────────────────────
+struct PostTarget {
+  sockaddr_storage addr;
+  socklen_t        addrLen = 0;       // 0 → not configured
+  char             host[128];
+  char             path[256];
+};
+
+static PostTarget uplinkTarget, webhookTarget;
+
+static bool writeAll(int fd, const void* data, size_t len) {
+  const char* p = (const char*) data;
+  while (len > 0) {
+    ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    len -= n;
+  }
+  return true;
+}
+
+static bool parseUrl(const char* url, PostTarget* t) {
+  static const char scheme[] = "http://";
+  if (strncmp(url, scheme, sizeof(scheme) - 1) != 0) return false;
+  const char* host  = url + sizeof(scheme) - 1;
+  const char* slash = strchr(host, '/');
+  const size_t hostLen = slash ? (size_t)(slash - host) : strlen(host);
+  if (hostLen == 0 || hostLen >= sizeof(t->host)) return false;
+  snprintf(t->host, sizeof(t->host), "%.*s", (int) hostLen, host);
+  snprintf(t->path, sizeof(t->path), "%s", slash ? slash : "/");
+
+  char name[128];
+  const char* port = "80";
+  snprintf(name, sizeof(name), "%s", t->host);
+  if (char* colon = strrchr(name, ':')) {
+    *colon = '\0';
+    port = t->host + (colon - name) + 1;
+  }
+  addrinfo hints = {};
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* res = nullptr;
+  if (getaddrinfo(name, port, &hints, &res) != 0 || !res) return false;
+  memcpy(&t->addr, res->ai_addr, res->ai_addrlen);
+  t->addrLen = res->ai_addrlen;
+  freeaddrinfo(res);
+  return true;
+}
+
+// The HTTP status, or -1; *sent says whether the body went out in full
+static int postTo(const PostTarget& t, const char* contentType, const void* body, size_t len,
+                  uint32_t timeoutMs, bool* sent) {
+  *sent = false;
+  const int fd = socket(t.addr.ss_family, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  timeval tv = { (time_t)(timeoutMs / 1000), (suseconds_t)(timeoutMs % 1000) * 1000 };
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+  int status = -1;
+  char head[512];
+  const int headLen = snprintf(head, sizeof(head),
+      "POST %s HTTP/1.1\r\nHost: %s\r\nContent-Type: %s\r\n"
+      "X-Potato-Unit: %s\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n",
+      t.path, t.host, contentType, config.unitId, len);
+  // Linux applies SO_SNDTIMEO to connect() as well
+  if (connect(fd, (const sockaddr*) &t.addr, t.addrLen) == 0 &&
+      writeAll(fd, head, headLen) && writeAll(fd, body, len)) {
+    *sent = true;
+    // "HTTP/1.1 204 No Content" — only the status code matters
+    char resp[64];
+    size_t got = 0;
+    while (got < sizeof(resp) - 1 && !memchr(resp, '\n', got)) {
+      const ssize_t n = recv(fd, resp + got, sizeof(resp) - 1 - got, 0);
+      if (n <= 0) break;
+      got += n;
+    }
+    resp[got] = '\0';
+    const char* sp = strchr(resp, ' ');
+    if (memchr(resp, '\n', got) && strncmp(resp, "HTTP/", 5) == 0 && sp) status = atoi(sp + 1);
+  }
+  close(fd);
+  return status;
+}
+
+bool halUplinkEnabled() { return uplinkTarget.addrLen > 0; }
+
+int halUplinkPost(const void* body, size_t len, uint32_t timeoutMs) {
+  if (!halUplinkEnabled()) return -1;
+  stats.uplinkPosts++;
+  bool sent;
+  const int status = postTo(uplinkTarget, "application/octet-stream", body, len, timeoutMs, &sent);
+  if (sent) stats.uplinkBytes += len;
+  return status;
+}
+
+bool halWebhookEnabled() { return webhookTarget.addrLen > 0; }
+
+int halWebhookPost(const char* json, size_t len, uint32_t timeoutMs) {
+  if (!halWebhookEnabled()) return -1;
+  stats.webhookPosts++;
+  bool sent;
+  return postTo(webhookTarget, "application/json", json, len, timeoutMs, &sent);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 9) Setup / stats
+// ──────────────────────────────────────────────────────────────────────────────
+bool simInit(const SimConfig& cfg) {
+  config = cfg;
+  wallStartUs = wallMicros();
+  signal(SIGPIPE, SIG_IGN);
+
+  time_t traceStart = 0;
+  if (cfg.csvPath && !loadTrace(cfg.csvPath, &traceStart)) return false;
+  if (config.epoch == 0) config.epoch = traceStart ? traceStart : time(nullptr);
+  setupProbes(cfg.sensors);
+
+  if (cfg.flashDir && mkdir(cfg.flashDir, 0755) != 0 && errno != EEXIST) {
+    fprintf(stderr, "sim: cannot create %s: %s\n", cfg.flashDir, strerror(errno));
+    return false;
+  }
+  if (cfg.port > 0 && !http.begin(cfg.port)) {
+    fprintf(stderr, "sim: cannot listen on port %d: %s\n", cfg.port, strerror(errno));
+    return false;
+  }
+  if (cfg.uplinkUrl && !parseUrl(cfg.uplinkUrl, &uplinkTarget)) {
+    fprintf(stderr, "sim: cannot use uplink %s (want http://host:port/path)\n", cfg.uplinkUrl);
+    return false;
+  }
+  if (cfg.webhookUrl && !parseUrl(cfg.webhookUrl, &webhookTarget)) {
+    fprintf(stderr, "sim: cannot use webhook %s (want http://host:port/path)\n", cfg.webhookUrl);
+    return false;
+  }
+  return true;
+}
+
+const SimStats& simStats() {
+  HalHttpInfo info;
+  http.info(&info);
+  stats.httpRequests = info.requests;
+  return stats;
+}
@@ -0,0 +1,102 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// hal_host.h — controls for the Linux implementation of hal.h
+//
+// Only sim_main.cpp uses these; the application sees nothing but hal.h.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include <string>
+
+struct SimConfig {
+  const char* csvPath   = nullptr;  // sensor trace to replay (nullptr → synthetic)
+  time_t      epoch     = 0;        // wall clock at boot once "NTP" syncs (0 → now / CSV start)
+  uint32_t    ntpDelayS = 0;        // seconds after boot before halTime() is valid
+  double      failRate  = 0.0;      // fraction of sensor frames delivered with a bad checksum
+  size_t      sensors   = 1;        // probes: DHT22, then alternating SHT3x / DHT22
+  uint32_t    maxPeriodMs = 30000;  // slowest adaptive read cadence (2000 → fixed)
+  int         port      = 8080;     // HTTP listener (0 → none)
+  const char* flashDir  = nullptr;  // directory standing in for LittleFS (nullptr → none)
+  uint64_t    powerCutAfter = 0;    // lose power once this many bytes reached flash (0 → never)
+  const char* uplinkUrl = nullptr;  // collector, "http://host:port/path" (nullptr → no uplink)
+  const char* unitId    = "sim";    // sent as X-Potato-Unit
+  const char* webhookUrl = nullptr; // alert webhook, "http://host:port/path" (nullptr → none)
+};
+
+bool simInit(const SimConfig& cfg);
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Virtual clock (µs since boot). Only sim_main moves it, and only forwards.
+// ──────────────────────────────────────────────────────────────────────────────
+uint64_t simMicros();
+void     simSetMicros(uint64_t us);
+
+// True once the CSV trace has been replayed to its last row.
+bool simTraceDone();
+
+// Consume the halNotifySample() flag, one copy each for the display and
+// alert steps.
+bool simTakeDisplayNotify();
+bool simTakeAlertNotify();
+
+// Serve pending HTTP connections, waiting up to `timeoutUs` for the first one.
+// Without a listener this just sleeps. Returns true if a request was handled.
+bool simHttpPoll(uint64_t timeoutUs);
+
+// Run the handler for `target` ("/path?query") as if a client had requested
+// it, appending the raw HTTP response to `out`. Returns the bytes appended.
+// No heap use beyond growing `out`, so reserve it up front when measuring.
+size_t simHttpRequest(const char* target, const char* ifNoneMatch, std::string* out);
+
+// Write the framebuffer as a binary PPM (P6).
+bool simWritePpm(const char* path);
+
+// The framebuffer, SCREEN_WIDTH × SCREEN_HEIGHT RGB565, row-major.
+const uint16_t* simFramebuffer();
+
+// Draw one character the way Adafruit GFX's drawChar() does with a
+// transparent background: a size×size fillRect per lit font pixel. The app
+// blits from glyph_atlas.h instead; oled_check compares the two pixel for
+// pixel and potato_bench times them.
+void simDrawCharGfx(int16_t x, int16_t y, char c, uint16_t color, uint8_t size);
+
+// True once --power-cut-after has been reached: the append that crossed it
+// was cut short, and sim_main stops as if the board lost power.
+bool simPowerLost();
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Counters for the end-of-run report
+// ──────────────────────────────────────────────────────────────────────────────
+static const size_t SIM_MAX_SENSORS = 8;
+
+struct SimProbeStats {
+  uint64_t reads        = 0;
+  uint64_t failures     = 0;
+  uint64_t starts       = 0;
+  uint64_t lastStartUs  = 0;
+  uint64_t minGapUs     = 0;  // between consecutive read starts (virtual µs)
+  uint64_t maxGapUs     = 0;
+  uint64_t maxJitterUs  = 0;  // worst gap off the period in effect at its start
+  uint64_t periodUs     = 0;  // that period, at the last start
+  uint32_t periodEpoch  = 0;  // simStats().periodChanges at the last start
+};
+
+struct SimStats {
+  uint64_t sensorReads    = 0;
+  uint64_t sensorFailures = 0;  // frames that decoded to anything but DHT22_OK
+  uint64_t spiBytes       = 0;  // estimated SSD1351 command + pixel bytes
+  uint64_t spiWindows     = 0;  // address windows set (one per rectangle or blit)
+  uint64_t displayCalls   = 0;  // halDisplay* calls
+  uint64_t httpRequests   = 0;
+  uint64_t streamBytes    = 0;  // written to detached (SSE) streams
+  uint64_t flashBytes     = 0;  // appended to flash files
+  uint64_t flashWrites    = 0;  // halFsAppend() calls
+  uint64_t uplinkPosts    = 0;  // halUplinkPost() calls
+  uint64_t uplinkBytes    = 0;  // request bodies sent, answered or not
+  uint64_t webhookPosts   = 0;  // halWebhookPost() calls
+  uint32_t periodChanges  = 0;  // read cadence changes seen by halSensorStart()
+  SimProbeStats probes[SIM_MAX_SENSORS];
+};
+
+const SimStats& simStats();
@@ -0,0 +1,285 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// history_store_check.cpp — HistoryStore against a naive model
+//
+//   history_store_check [--seed N] [--runs N]
+//
+// Feeds samples until even the 30-day HOUR ring has wrapped by two days
+// into a HistoryStore and into a model that keeps
+// every sample and every closed bucket in plain vectors. The stream reads
+// every 2 s, sometimes slower or twice in the same second, drops out for
+// hours now and then, and goes backwards (which add() must drop). Every few
+// thousand samples, and at the end, the check compares:
+//
+//   rollover   each tier's rows with the model's last N closed buckets,
+//              min/max and the average rounded half away from zero
+//   wraparound size() and oldest() at and past capacity
+//   ranges     count(), spacing() and read() in random chunk sizes over
+//              ranges that start and end on, just beside and outside stored
+//              stamps, and tierFor() with the finest tier still reaching
+//              `from`
+//
+// It also starts reads, adds enough samples to wrap the ring underneath the
+// cursor, and finishes them: the rows must carry on from the oldest entry
+// still held, never from stale slots.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "../history_store.h"
+#include "check.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+static const HistTier TIERS[]     = { HIST_RAW, HIST_MINUTE, HIST_HOUR };
+static const char*    TIER_NAME[] = { "raw", "1m", "1h" };
+
+static size_t capacityOf(HistTier tier) {
+  switch (tier) {
+    case HIST_RAW:    return HIST_RAW_CAPACITY;
+    case HIST_MINUTE: return HIST_MINUTE_CAPACITY;
+    default:          return HIST_HOUR_CAPACITY;
+  }
+}
+
+static bool same(const HistAggregate& a, const HistAggregate& b) {
+  return a.ts == b.ts && a.tMin == b.tMin && a.tMax == b.tMax && a.tAvg == b.tAvg &&
+         a.hMin == b.hMin && a.hMax == b.hMax && a.hAvg == b.hAvg;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1) Model: every entry a tier ever held, indexed by sequence number
+// ──────────────────────────────────────────────────────────────────────────────
+struct Model {
+  std::vector<HistAggregate> rows[HIST_TIER_COUNT];
+  std::vector<HistSample>    open[HIST_TIER_COUNT];   // the unclosed bucket
+
+  static HistAggregate aggregate(uint32_t bucket, const std::vector<HistSample>& in) {
+    HistAggregate a;
+    a.ts = bucket;
+    double tSum = 0, hSum = 0;
+    a.tMin = a.tMax = in[0].t10;
+    a.hMin = a.hMax = in[0].h10;
+    for (const HistSample& s : in) {
+      a.tMin = std::min(a.tMin, s.t10);
+      a.tMax = std::max(a.tMax, s.t10);
+      a.hMin = std::min(a.hMin, s.h10);
+      a.hMax = std::max(a.hMax, s.h10);
+      tSum += s.t10;
+      hSum += s.h10;
+    }
+    a.tAvg = (int16_t) lround(tSum / in.size());
+    a.hAvg = (uint16_t) lround(hSum / in.size());
+    return a;
+  }
+
+  void add(const HistSample& s) {
+    if (!rows[HIST_RAW].empty() && s.ts < rows[HIST_RAW].back().ts) return;
+    rows[HIST_RAW].push_back({ s.ts, s.t10, s.t10, s.t10, s.h10, s.h10, s.h10 });
+    for (HistTier tier : { HIST_MINUTE, HIST_HOUR }) {
+      const uint32_t period = HistoryStore::periodOf(tier);
+      std::vector<HistSample>& acc = open[tier];
+      if (!acc.empty() && acc[0].ts / period != s.ts / period) {
+        rows[tier].push_back(aggregate(acc[0].ts / period * period, acc));
+        acc.clear();
+      }
+      acc.push_back(s);
+    }
+  }
+
+  size_t first(HistTier tier) const {
+    return rows[tier].size() > capacityOf(tier) ? rows[tier].size() - capacityOf(tier) : 0;
+  }
+  size_t end(HistTier tier) const { return rows[tier].size(); }
+
+  // First held sequence number with ts >= `ts`
+  size_t lowerBound(HistTier tier, uint32_t ts) const {
+    size_t q = first(tier);
+    while (q < end(tier) && rows[tier][q].ts < ts) q++;
+    return q;
+  }
+
+  HistTier tierFor(uint32_t from) const {
+    for (HistTier tier : { HIST_RAW, HIST_MINUTE }) {
+      if (end(tier) > first(tier) && rows[tier][first(tier)].ts <= from) return tier;
+    }
+    if (end(HIST_HOUR) > 0)   return HIST_HOUR;
+    if (end(HIST_MINUTE) > 0) return HIST_MINUTE;
+    return HIST_RAW;
+  }
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2) Comparisons
+// ──────────────────────────────────────────────────────────────────────────────
+struct Stats {
+  uint64_t samples = 0, compares = 0, ranges = 0, wrappedReads = 0;
+};
+
+// Read [from, to] from `store` in chunks of 1–20 rows
+static std::vector<HistAggregate> readAll(const HistoryStore& store, HistTier tier, uint32_t from,
+                                          uint32_t to, std::mt19937& rng) {
+  std::vector<HistAggregate> out;
+  HistCursor cur;
+  HistAggregate buf[20];
+  for (;;) {
+    const size_t max = std::uniform_int_distribution<size_t>(1, 20)(rng);
+    const size_t n = store.read(tier, from, to, cur, buf, max);
+    if (n == 0) break;
+    out.insert(out.end(), buf, buf + n);
+  }
+  return out;
+}
+
+static void checkRange(const HistoryStore& store, const Model& m, HistTier tier, uint32_t from,
+                       uint32_t to, std::mt19937& rng) {
+  std::vector<HistAggregate> want;
+  for (size_t q = m.lowerBound(tier, from); q < m.end(tier) && m.rows[tier][q].ts <= to; q++) {
+    want.push_back(m.rows[tier][q]);
+  }
+  if (to < from) want.clear();
+  const size_t n = store.count(tier, from, to);
+  CHECK(n == want.size(), "%s %u..%u: count %zu, expected %zu", TIER_NAME[tier], from, to, n, want.size());
+  uint32_t spacing = HistoryStore::periodOf(tier);
+  if (tier == HIST_RAW && want.size() >= 2) {
+    spacing = (uint32_t) floor((double)(want.back().ts - want[0].ts) / (want.size() - 1) + 0.5);
+  }
+  CHECK(store.spacing(tier, from, to) == spacing, "%s %u..%u: spacing %u, expected %u", TIER_NAME[tier],
+        from, to, store.spacing(tier, from, to), spacing);
+  if (to < from) return;                    // read() is only asked for ordered ranges
+  const std::vector<HistAggregate> got = readAll(store, tier, from, to, rng);
+  bool match = got.size() == want.size();
+  for (size_t i = 0; match && i < got.size(); i++) match = same(got[i], want[i]);
+  CHECK(match, "%s %u..%u: read %zu rows, expected %zu", TIER_NAME[tier], from, to, got.size(), want.size());
+}
+
+static void compare(const HistoryStore& store, const Model& m, std::mt19937& rng, Stats* st) {
+  st->compares++;
+  for (HistTier tier : TIERS) {
+    const size_t held = m.end(tier) - m.first(tier);
+    CHECK(store.size(tier) == held, "%s: %zu entries, expected %zu", TIER_NAME[tier], store.size(tier), held);
+    const uint32_t oldest = held ? m.rows[tier][m.first(tier)].ts : 0;
+    CHECK(store.oldest(tier) == oldest, "%s: oldest %u, expected %u", TIER_NAME[tier], store.oldest(tier), oldest);
+
+    // Everything, row for row
+    checkRange(store, m, tier, 0, UINT32_MAX, rng);
+    if (held == 0) continue;
+
+    // Ranges on, beside and outside stored stamps
+    auto stamp = [&]() {
+      return m.rows[tier][std::uniform_int_distribution<size_t>(m.first(tier), m.end(tier) - 1)(rng)].ts;
+    };
+    const uint32_t newest = m.rows[tier].back().ts;
+    for (int k = 0; k < 24; k++) {
+      uint32_t a = stamp(), b = stamp();
+      if (a > b) std::swap(a, b);
+      const int edge = std::uniform_int_distribution<int>(0, 5)(rng);
+      if (edge == 1) a--;
+      if (edge == 2) b++;
+      if (edge == 3) a++, b--;              // may cross: an empty range
+      if (edge == 4) a = oldest - 100000, b = oldest - 1;
+      if (edge == 5) a = newest + 1, b = UINT32_MAX;
+      checkRange(store, m, tier, a, b, rng);
+      const HistTier want = m.tierFor(a);
+      CHECK(store.tierFor(a) == want, "tierFor(%u): %s, expected %s", a, TIER_NAME[store.tierFor(a)],
+            TIER_NAME[want]);
+      st->ranges++;
+    }
+  }
+}
+
+// Start a read, add `more` samples (enough to wrap the ring past the
+// cursor), then finish it. The rows after the pause must carry on from the
+// cursor or, if that was overwritten, from the oldest entry still held.
+static void wrappedRead(HistoryStore& store, Model& m, HistTier tier, const std::vector<HistSample>& more) {
+  if (m.end(tier) == m.first(tier)) return;
+  const uint32_t from = m.rows[tier][m.first(tier)].ts;
+  HistCursor cur;
+  HistAggregate buf[16];
+  const size_t before = store.read(tier, from, UINT32_MAX, cur, buf, 16);
+  const size_t next   = m.lowerBound(tier, from) + before;
+  for (const HistSample& s : more) {
+    store.add(s);
+    m.add(s);
+  }
+  std::vector<HistAggregate> got;
+  for (size_t n; (n = store.read(tier, from, UINT32_MAX, cur, buf, 16)) > 0;) got.insert(got.end(), buf, buf + n);
+  const size_t resume = std::max(next, m.first(tier));
+  const size_t want   = m.end(tier) - resume;
+  bool match = got.size() == want;
+  for (size_t i = 0; match && i < got.size(); i++) match = same(got[i], m.rows[tier][resume + i]);
+  CHECK(match, "%s read across a wrap: %zu rows after the pause, expected %zu from seq %zu",
+        TIER_NAME[tier], got.size(), want, resume);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3) Sample stream
+// ──────────────────────────────────────────────────────────────────────────────
+struct Stream {
+  std::mt19937 rng;
+  HistSample s;
+  explicit Stream(uint32_t seed) : rng(seed), s{ 1750000000u + seed * 7919u, 450, 880 } {}
+
+  int uniform(int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); }
+
+  HistSample step(uint32_t dt) {
+    s.ts += dt;
+    s.t10 = (int16_t) std::max(-400, std::min(1800, s.t10 + uniform(-3, 3)));
+    return s;
+  }
+
+  HistSample next() {
+    const int roll = uniform(0, 99999);
+    if      (roll < 1)     s.ts += (uint32_t) uniform(3600, 40 * 3600);  // outage
+    else if (roll < 600)   s.ts -= (uint32_t) uniform(1, 90);            // clock stepped back
+    else if (roll < 5000)  s.ts += 0;                                    // same second
+    else if (roll < 15000) s.ts += (uint32_t) uniform(3, 30);            // adaptive
+    else                   s.ts += 2;
+    const int spike = uniform(0, 999) == 0 ? uniform(-300, 300) : 0;
+    s.t10 = (int16_t) std::max(-400, std::min(1800, s.t10 + uniform(-3, 3) + spike));
+    s.h10 = (uint16_t) std::max(0, std::min(1000, (int) s.h10 + uniform(-5, 5)));
+    return s;
+  }
+};
+
+int main(int argc, char** argv) {
+  uint32_t seed = 1;
+  int runs = 4;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if      (strcmp(argv[i], "--seed") == 0) seed = (uint32_t) strtoul(argv[i + 1], nullptr, 10);
+    else if (strcmp(argv[i], "--runs") == 0) runs = atoi(argv[i + 1]);
+  }
+
+  Stats st;
+  for (int r = 0; r < runs && checkFailures == 0; r++) {
+    static HistoryStore store;
+    store = HistoryStore();
+    Model m;
+    Stream in(seed + (uint32_t) r);
+    std::mt19937 rng(seed * 31 + (uint32_t) r);
+
+    compare(store, m, rng, &st);                        // empty
+    while (m.end(HIST_HOUR) < HIST_HOUR_CAPACITY + 48 && checkFailures == 0) {
+      const HistSample s = in.next();
+      store.add(s);
+      m.add(s);
+      st.samples++;
+      if (st.samples % 4999 == 0) compare(store, m, rng, &st);
+      if (st.samples % 49999 == 0) {
+        // A slow reader: the raw or minute ring laps it while it waits, one
+        // entry per period (the hour ring is the same HistRing)
+        const HistTier tier = st.wrappedReads % 2 ? HIST_MINUTE : HIST_RAW;
+        std::vector<HistSample> more(capacityOf(tier) + (size_t) in.uniform(0, 100));
+        for (HistSample& x : more) x = in.step(HistoryStore::periodOf(tier));
+        wrappedRead(store, m, tier, more);
+        st.wrappedReads++;
+      }
+    }
+    compare(store, m, rng, &st);
+  }
+  printf("  %d runs from seed %u: %llu samples, %llu full comparisons, %llu ranges, "
+         "%llu reads across a wrap\n", runs, seed, (unsigned long long) st.samples,
+         (unsigned long long) st.compares, (unsigned long long) st.ranges,
+         (unsigned long long) st.wrappedReads);
+  return checkResult("history_store_check");
+}
@@ -0,0 +1,297 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// oled_check.cpp — drawReadings()' dirty-cell repaint against a full redraw
+//
+//   oled_check [--seed N] [--steps N]
+//
+// Builds app.cpp into the check itself (drawReadings() and lineStr[] are
+// file-local there) and draws into hal_host.cpp's in-memory framebuffer.
+//
+// First every glyph in the atlas, and one that isn't (the box), is drawn
+// by drawReadings() in both line colours: centred, one pixel over, and
+// hanging half off either edge. Long lines are drawn clipped at both
+// edges. Each time the framebuffer must equal the same text drawn
+// GFX-style, pixel for pixel.
+//
+// Then random steps. Each step changes the four lines the way the display step does: a digit
+// ticks, a page turns, text grows or shrinks past the screen edges, the
+// burn-in shift moves everything, or nothing changes at all. Then:
+//
+//   pixels    the framebuffer after the incremental repaint equals the
+//             same lines redrawn from a black screen, and equals them
+//             drawn GFX-style (simDrawCharGfx, one square per font pixel)
+//   SPI bytes a line that stayed put costs exactly one address window plus
+//             16 rows of pixels per run of changed cells, on-screen part
+//             only. A line that moved costs its new blit plus the old
+//             area it no longer covers, in at most four strips. An
+//             unchanged step costs nothing, and no step costs more than
+//             the full redraw.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "../app.cpp"
+#include "check.h"
+#include "hal_host.h"
+#include <random>
+#include <string>
+
+static const int LINE_Y0 = 20, LINE_PITCH = 24;        // 4 × 16 px lines + 3 × 8 px gaps, centred
+static const uint16_t LINE_COLOR[4] = { 0xF800, 0xF800, 0x001F, 0x001F };
+
+struct Cost {
+  uint64_t bytes = 0, windows = 0;
+  uint64_t pixelBytes() const { return bytes - 7 * windows; }
+};
+
+static Cost spent(const Cost& before) {
+  Cost c;
+  c.bytes   = simStats().spiBytes - before.bytes;
+  c.windows = simStats().spiWindows - before.windows;
+  return c;
+}
+
+static Cost now() {
+  Cost c;
+  c.bytes   = simStats().spiBytes;
+  c.windows = simStats().spiWindows;
+  return c;
+}
+
+static int lineX(const std::string& s, int offsetX) {
+  return (SCREEN_WIDTH - (int) s.size() * GLYPH_WIDTH) / 2 + offsetX;
+}
+
+// Pixels of [x, x + w) × [y, y + h) on the screen
+static long visible(int x, int y, int w, int h) {
+  const int x0 = std::max(x, 0), x1 = std::min(x + w, SCREEN_WIDTH);
+  const int y0 = std::max(y, 0), y1 = std::min(y + h, SCREEN_HEIGHT);
+  return x0 < x1 && y0 < y1 ? (long)(x1 - x0) * (y1 - y0) : 0;
+}
+
+// The lines as GFX would draw them on a black screen
+static void drawGfx(const std::string* lines, int offsetX, int offsetY) {
+  halDisplayFillScreen(0);
+  for (int i = 0; i < 4; i++) {
+    const int x = lineX(lines[i], offsetX), y = LINE_Y0 + i * LINE_PITCH + offsetY;
+    for (size_t c = 0; c < lines[i].size(); c++) {
+      simDrawCharGfx(x + (int) c * GLYPH_WIDTH, y, lines[i][c], LINE_COLOR[i], GLYPH_SCALE);
+    }
+  }
+}
+
+// drawReadings() from a black screen against GFX, one line set at one offset
+static void compareGlyphs(const std::string* lines, int offsetX) {
+  static uint16_t atlas[SCREEN_WIDTH * SCREEN_HEIGHT];
+  for (int i = 0; i < 4; i++) snprintf(lineStr[i], sizeof(lineStr[i]), "%s", lines[i].c_str());
+  oledDrawn = false;
+  drawReadings(offsetX, 0);
+  memcpy(atlas, simFramebuffer(), sizeof(atlas));
+  drawGfx(lines, offsetX, 0);
+  CHECK(memcmp(atlas, simFramebuffer(), sizeof(atlas)) == 0, "\"%s\" at x offset %d differs from GFX",
+        lines[0].c_str(), offsetX);
+}
+
+// Every glyph (lines of 1-4 of it, so red and blue at different x), then
+// lines wider than the screen; returns the glyphs drawn
+static size_t glyphSweep(const std::string& charset) {
+  std::string lines[4];
+  for (char c : charset) {
+    for (int i = 0; i < 4; i++) lines[i].assign(i + 1, c);
+    for (int offsetX : { 0, 1, -64, 64 }) compareGlyphs(lines, offsetX);
+  }
+  lines[0] = "0123456789";
+  lines[1] = "HUMID: 88%";
+  lines[2] = "ABCDEFGHIJKLMNO";
+  lines[3] = "PQRSTUVWXYZ:%-~";
+  for (int offsetX : { -7, 0, 13 }) compareGlyphs(lines, offsetX);
+  oledDrawn = false;
+  return charset.size();
+}
+
+// What the repaint from `was` to `lines` may cost: pixel bytes exactly, and
+// the range of address windows
+struct Expected {
+  uint64_t pixelBytes = 0, minWindows = 0, maxWindows = 0;
+};
+
+static Expected expectedCost(const std::string* was, int wasX, int wasY,
+                             const std::string* lines, int offsetX, int offsetY) {
+  Expected e;
+  for (int i = 0; i < 4; i++) {
+    const std::string& a = was[i];
+    const std::string& b = lines[i];
+    const int ax = lineX(a, wasX), ay = LINE_Y0 + i * LINE_PITCH + wasY;
+    const int bx = lineX(b, offsetX), by = LINE_Y0 + i * LINE_PITCH + offsetY;
+    if (ax == bx && ay == by) {
+      // Runs of cells whose character differs, blanks past either end
+      const size_t span = std::max(a.size(), b.size());
+      for (size_t c = 0; c < span;) {
+        auto at = [](const std::string& s, size_t k) { return k < s.size() ? s[k] : ' '; };
+        if (at(a, c) == at(b, c)) { c++; continue; }
+        size_t end = c;
+        while (end < span && at(a, end) != at(b, end)) end++;
+        const long px = visible(bx + (int) c * GLYPH_WIDTH, by, (int)(end - c) * GLYPH_WIDTH, GLYPH_HEIGHT);
+        if (px) {
+          e.pixelBytes += 2 * px;
+          e.minWindows++;
+          e.maxWindows++;
+        }
+        c = end;
+      }
+      continue;
+    }
+    // Moved: the new line, then the old area outside it
+    const int bw = (int) b.size() * GLYPH_WIDTH, aw = (int) a.size() * GLYPH_WIDTH;
+    const long blit = visible(bx, by, bw, GLYPH_HEIGHT);
+    if (blit) {
+      e.pixelBytes += 2 * blit;
+      e.minWindows++;
+      e.maxWindows++;
+    }
+    long stale = 0;
+    for (int y = ay; y < ay + GLYPH_HEIGHT; y++) {
+      for (int x = ax; x < ax + aw; x++) {
+        const bool inside = x >= bx && x < bx + bw && y >= by && y < by + GLYPH_HEIGHT;
+        stale += !inside && visible(x, y, 1, 1);
+      }
+    }
+    if (stale) {
+      e.pixelBytes += 2 * stale;
+      e.minWindows += 1;
+      e.maxWindows += 4;
+    }
+  }
+  return e;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Line generator: the app's pages, and arbitrary text from the atlas
+// ──────────────────────────────────────────────────────────────────────────────
+struct Lines {
+  std::mt19937 rng;
+  std::string charset;
+
+  explicit Lines(uint32_t seed) : rng(seed) {
+    for (const GlyphAtlasCell& g : GLYPH_ATLAS) charset += g.c;
+    charset += '~';                                     // not in the font: the box glyph
+  }
+
+  int uniform(int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); }
+
+  std::string fmt(const char* f, int a, int b = 0) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), f, a, b);
+    return buf;
+  }
+
+  void page(std::string* l) {
+    static const char* NAMES[] = { "TEMP: ", "ROOM: ", "CELLA:", "SHT3X:", "DEW: " };
+    switch (uniform(0, 3)) {
+      case 0:
+        l[0] = NAMES[uniform(0, 4)] + fmt("%dF", uniform(-40, 120));
+        l[1] = fmt("L:%d H:%d", uniform(-40, 99), uniform(0, 120));
+        l[2] = fmt("HUMID: %d%%", uniform(0, 100));
+        l[3] = fmt("L:%d H:%d", uniform(0, 99), uniform(0, 100));
+        break;
+      case 1:
+        l[0] = "TEMP: --F"; l[1] = "L:-- H:--"; l[2] = "HUMID: --%"; l[3] = "L:-- H:--";
+        break;
+      case 2:
+        l[0] = "ALERT"; l[1] = "SPROUTING"; l[2] = uniform(0, 1) ? "DAMP" : ""; l[3] = "";
+        break;
+      default:
+        for (int i = 0; i < 4; i++) {
+          l[i].clear();
+          for (int n = uniform(0, 15); n > 0; n--) l[i] += charset[uniform(0, (int) charset.size() - 1)];
+        }
+    }
+  }
+
+  // One digit (or any character) of one line
+  void tick(std::string* l) {
+    std::string& s = l[uniform(0, 3)];
+    if (s.empty()) return;
+    s[uniform(0, (int) s.size() - 1)] = charset[uniform(0, (int) charset.size() - 1)];
+  }
+
+  // A line grows or shrinks by a character: it recentres, so it moves
+  void resize(std::string* l) {
+    std::string& s = l[uniform(0, 3)];
+    if (!s.empty() && uniform(0, 1)) s.pop_back();
+    else if (s.size() < 15) s += charset[uniform(0, (int) charset.size() - 1)];
+  }
+};
+
+int main(int argc, char** argv) {
+  uint32_t seed = 1;
+  long steps = 20000;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if      (strcmp(argv[i], "--seed") == 0)  seed  = (uint32_t) strtoul(argv[i + 1], nullptr, 10);
+    else if (strcmp(argv[i], "--steps") == 0) steps = atol(argv[i + 1]);
+  }
+
+  static const int SHIFTS[4][2] = { { 1, 0 }, { 1, -1 }, { 0, -1 }, { 0, 0 } };  // appDisplayStep()'s
+  static uint16_t incremental[SCREEN_WIDTH * SCREEN_HEIGHT], full[SCREEN_WIDTH * SCREEN_HEIGHT];
+  Lines gen(seed);
+  std::string lines[4], was[4];
+  int ox = 0, oy = 0, wasX = 0, wasY = 0;
+  uint64_t incBytes = 0, fullBytes = 0, idleSteps = 0, repaints = 0;
+  const size_t glyphs = glyphSweep(gen.charset);
+
+  for (long step = 0; step < steps && checkFailures == 0; step++) {
+    const int roll = gen.uniform(0, 99);
+    if      (roll < 40) gen.tick(lines);
+    else if (roll < 55) gen.page(lines);
+    else if (roll < 65) gen.resize(lines);
+    else if (roll < 75) {
+      const int* s = SHIFTS[gen.uniform(0, 3)];
+      ox = s[0], oy = s[1];
+    } else if (roll < 80) {
+      // Wider shifts push lines off the sides; vertically they stay within
+      // drawReadings()' limit of less than the 8 px gap between lines
+      ox = gen.uniform(-20, 20), oy = gen.uniform(-3, 4);
+    }
+    // else: nothing changed
+    for (int i = 0; i < 4; i++) snprintf(lineStr[i], sizeof(lineStr[i]), "%s", lines[i].c_str());
+
+    // Incremental repaint (the first step is the initial full draw)
+    const bool first = step == 0;
+    const Cost before = now();
+    drawReadings(ox, oy);
+    const Cost inc = spent(before);
+    memcpy(incremental, simFramebuffer(), sizeof(incremental));
+
+    // The same lines from a black screen, both ways
+    drawGfx(lines, ox, oy);
+    memcpy(full, simFramebuffer(), sizeof(full));
+    CHECK(memcmp(incremental, full, sizeof(full)) == 0, "step %ld: repaint differs from GFX drawing", step);
+    oledDrawn = false;
+    const Cost beforeFull = now();
+    drawReadings(ox, oy);
+    const Cost redraw = spent(beforeFull);
+    CHECK(memcmp(simFramebuffer(), full, sizeof(full)) == 0, "step %ld: full redraw differs from GFX drawing",
+          step);
+
+    if (!first) {
+      const Expected e = expectedCost(was, wasX, wasY, lines, ox, oy);
+      CHECK(inc.pixelBytes() == e.pixelBytes, "step %ld: %llu pixel bytes, expected %llu", step,
+            (unsigned long long) inc.pixelBytes(), (unsigned long long) e.pixelBytes);
+      CHECK(inc.windows >= e.minWindows && inc.windows <= e.maxWindows,
+            "step %ld: %llu windows, expected %llu-%llu", step, (unsigned long long) inc.windows,
+            (unsigned long long) e.minWindows, (unsigned long long) e.maxWindows);
+      CHECK(inc.bytes <= redraw.bytes, "step %ld: repaint %llu bytes, full redraw %llu", step,
+            (unsigned long long) inc.bytes, (unsigned long long) redraw.bytes);
+      if (e.pixelBytes == 0) {
+        CHECK(inc.bytes == 0, "step %ld: nothing changed, %llu bytes sent", step, (unsigned long long) inc.bytes);
+        idleSteps++;
+      }
+      incBytes  += inc.bytes;
+      fullBytes += redraw.bytes;
+      repaints++;
+    }
+    for (int i = 0; i < 4; i++) was[i] = lines[i];
+    wasX = ox, wasY = oy;
+  }
+  printf("  %zu glyphs, atlas against GFX\n", glyphs);
+  printf("  %llu repaints from seed %u (%llu with nothing to send): %.0f SPI bytes each, "
+         "%.0f for a full redraw\n", (unsigned long long) repaints, seed, (unsigned long long) idleSteps,
+         repaints ? (double) incBytes / repaints : 0.0, repaints ? (double) fullBytes / repaints : 0.0);
+  return checkResult("oled_check");
+}
@@ -0,0 +1,88 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// psychro_check.cpp — psychro.h against the Magnus formula in double precision
+//
+//   psychro_check
+//
+// Sweeps psychroDerive() over every 0.1 °C / 0.1 %RH pair the sensors can
+// report (−40…125 °C × 0…100 %RH) and compares each result with psychro.h's
+// header formulas evaluated in double. The worst error of each value must
+// stay inside the bound documented there:
+//
+//   dew point          ±0.07 °C
+//   absolute humidity  ±0.2 % ±0.01 g/m³
+//   VPD                ±0.11 % of es(T) ±1 Pa
+//
+// A dew point below the table (−60 °C) must come back as PSYCHRO_DEW_NONE,
+// and only then. Along the way: the dew point never exceeds the air
+// temperature, RH above 100 % reads as 100 %, and temperatures off the
+// table clamp to its ends.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "../psychro.h"
+#include "check.h"
+#include <math.h>
+#include <algorithm>
+
+static double refSaturation(double tC) { return 611.2 * exp(17.62 * tC / (243.12 + tC)); }
+
+// Worst error seen so far, and where
+struct Worst {
+  double err = 0;
+  int t10 = 0, h10 = 0;
+
+  void add(double e, int t, int h) {
+    if (e > err) { err = e; t10 = t; h10 = h; }
+  }
+};
+
+int main() {
+  Worst dew, ah, vpd;                // dew in °C; ah and vpd as a fraction of their bound
+  uint64_t evals = 0, dewNone = 0, dewMissed = 0, dewAboveAir = 0;
+
+  for (int t10 = -400; t10 <= 1250; t10++) {
+    const double tC = t10 / 10.0, es = refSaturation(tC);
+    for (int h10 = 0; h10 <= 1000; h10++) {
+      const double e = es * h10 / 1000.0;
+      const Psychro p = psychroDerive((int16_t) t10, (uint16_t) h10);
+      evals++;
+
+      const double g  = h10 ? log(e / 611.2) : -INFINITY;
+      const double td = 243.12 * g / (17.62 - g);
+      if (p.dew10C == PSYCHRO_DEW_NONE) {
+        dewNone++;
+        if (td > -59.9) dewMissed++;
+      } else {
+        if (td >= -60.0) dew.add(fabs(p.dew10C / 10.0 - td), t10, h10);
+        if (p.dew10C > t10) dewAboveAir++;
+      }
+      const double ahRef = 2.16679 * e / (tC + 273.15);
+      ah.add(fabs(p.ah100 / 100.0 - ahRef) / (0.002 * ahRef + 0.01), t10, h10);
+      vpd.add(fabs(p.vpdPa - (es - e)) / (0.0011 * es + 1.0), t10, h10);
+    }
+  }
+  CHECK(dew.err <= 0.07, "dew point off by %.3f °C at %.1f °C / %.1f %%RH",
+        dew.err, dew.t10 / 10.0, dew.h10 / 10.0);
+  CHECK(ah.err <= 1.0, "absolute humidity at %.2f of its bound at %.1f °C / %.1f %%RH",
+        ah.err, ah.t10 / 10.0, ah.h10 / 10.0);
+  CHECK(vpd.err <= 1.0, "VPD at %.2f of its bound at %.1f °C / %.1f %%RH",
+        vpd.err, vpd.t10 / 10.0, vpd.h10 / 10.0);
+  CHECK(dewMissed == 0, "%llu dew points above −59.9 °C reported as off the table",
+        (unsigned long long) dewMissed);
+  CHECK(dewAboveAir == 0, "%llu dew points above the air temperature", (unsigned long long) dewAboveAir);
+
+  // Clamps: RH above 100 %, temperatures off the table
+  for (int t10 = -400; t10 <= 1250; t10 += 10) {
+    const Psychro full = psychroDerive((int16_t) t10, 1000), over = psychroDerive((int16_t) t10, 1200);
+    CHECK(over.dew10C == full.dew10C && over.ah100 == full.ah100 && over.vpdPa == full.vpdPa,
+          "%.1f °C: 120 %%RH differs from 100 %%RH", t10 / 10.0);
+  }
+  CHECK(psychroSaturation(-700) == PSYCHRO_ES[0], "es below the table");
+  CHECK(psychroSaturation(1400) == PSYCHRO_ES[PSYCHRO_ES_COUNT - 1], "es above the table");
+  CHECK(psychroDerive(-700, 500).dew10C == PSYCHRO_DEW_NONE, "dew point at −70 °C");
+  CHECK(psychroDewPoint(PSYCHRO_ES[PSYCHRO_ES_COUNT - 1] + 1) == PSYCHRO_T10_MAX, "dew point above the table");
+
+  printf("  %llu readings, %llu dew points below the table; worst dew point %.3f °C "
+         "(%.1f °C / %.1f %%RH), AH %.2f and VPD %.2f of their bounds\n",
+         (unsigned long long) evals, (unsigned long long) dewNone, dew.err, dew.t10 / 10.0,
+         dew.h10 / 10.0, ah.err, vpd.err);
+  return checkResult("psychro_check");
+}
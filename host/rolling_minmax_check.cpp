@@ -0,0 +1,141 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// rolling_minmax_check.cpp — RollingMinMax against a naive scan
+//
+//   rolling_minmax_check [--seed N] [--runs N]
+//
+// Feeds random sample sequences into windows of several shapes (the app's
+// 1 h / 24 h / 7 d and per-probe 24 h, and small ones that wrap their
+// deques often) and, after every sample, compares get() with a scan of
+// every sample kept so far. A sample counts while its block hasn't fully
+// left the window: block start + PERIOD > now − WINDOW (rolling_minmax.h).
+//
+// The sequences read every 2–30 s, now and then up to 30 min apart, with
+// spikes, runs of equal stamps and outages of up to twice the 7 d window.
+// During an outage the check calls expire() at random moments, as
+// publishWindows() does on failed reads, and the window must shrink to the
+// samples still in it, or to nothing.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "../rolling_minmax.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+struct Sample {
+  uint32_t ts;
+  int16_t  t10, h10;
+};
+
+template <uint32_t PERIOD, size_t BLOCKS>
+struct WindowCheck {
+  static const uint32_t WINDOW = PERIOD * BLOCKS;
+
+  RollingMinMax<PERIOD, BLOCKS> win;
+  std::vector<Sample> kept;
+  const char* name;
+  uint64_t queries = 0;
+
+  explicit WindowCheck(const char* n) : name(n) {}
+
+  bool naive(uint32_t now, MinMax16* out) const {
+    bool any = false;
+    for (size_t i = kept.size(); i-- > 0;) {        // newest first; stamps never decrease
+      const Sample& s = kept[i];
+      const int64_t start = s.ts - s.ts % PERIOD;
+      if (start + PERIOD <= (int64_t) now - WINDOW) break;
+      if (!any) {
+        *out = { s.t10, s.t10, s.h10, s.h10 };
+        any = true;
+        continue;
+      }
+      out->tMin = std::min(out->tMin, s.t10);
+      out->tMax = std::max(out->tMax, s.t10);
+      out->hMin = std::min(out->hMin, s.h10);
+      out->hMax = std::max(out->hMax, s.h10);
+    }
+    return any;
+  }
+
+  void compare(uint32_t now, const char* when) {
+    MinMax16 got = {}, want = {};
+    const bool have = win.get(&got), wanted = naive(now, &want);
+    queries++;
+    CHECK(have == wanted, "%s at %u (%s): %s, expected %s", name, now, when,
+          have ? "values" : "nothing", wanted ? "values" : "nothing");
+    if (have && wanted) {
+      CHECK(memcmp(&got, &want, sizeof(got)) == 0,
+            "%s at %u (%s): T %d..%d H %d..%d, expected T %d..%d H %d..%d", name, now, when,
+            got.tMin, got.tMax, got.hMin, got.hMax, want.tMin, want.tMax, want.hMin, want.hMax);
+    }
+  }
+
+  void add(const Sample& s) {
+    win.add(s.ts, s.t10, s.h10);
+    kept.push_back(s);
+    compare(s.ts, "add");
+  }
+
+  void expire(uint32_t now) {
+    win.expire(now);
+    compare(now, "outage");
+  }
+};
+
+template <typename... Checks>
+static void run(uint32_t seed, Checks&... checks) {
+  std::mt19937 rng(seed);
+  auto uniform = [&](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); };
+
+  uint32_t ts = 1000 + (uint32_t) uniform(0, 100000);
+  int t = 450, h = 880;
+  const uint32_t longest = 2 * 168 * 3600;
+  for (int i = 0; i < 20000; i++) {
+    const int roll = uniform(0, 999);
+    if (roll < 3) {
+      // Outage: failed reads only, each of which expires the windows
+      const uint32_t gap = (uint32_t) uniform(60, (int) longest);
+      for (int k = 0; k < 8; k++) {
+        const uint32_t at = ts + (uint32_t)((uint64_t) gap * (k + 1) / 8);
+        int unused[] = { (checks.expire(at), 0)... };
+        (void) unused;
+      }
+      ts += gap;
+    } else if (roll < 50) {
+      // Same second (several probes reporting)
+    } else if (roll < 150) {
+      ts += (uint32_t) uniform(31, 1800);       // slow adaptive reads
+    } else {
+      ts += (uint32_t) uniform(2, 30);
+    }
+    t = std::max(-400, std::min(1800, t + uniform(-3, 3) + (uniform(0, 499) == 0 ? uniform(-200, 200) : 0)));
+    h = std::max(0, std::min(1000, h + uniform(-5, 5)));
+    const Sample s = { ts, (int16_t) t, (int16_t) h };
+    int unused[] = { (checks.add(s), 0)... };
+    (void) unused;
+  }
+}
+
+int main(int argc, char** argv) {
+  uint32_t seed = 1;
+  int runs = 16;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if      (strcmp(argv[i], "--seed") == 0) seed = (uint32_t) strtoul(argv[i + 1], nullptr, 10);
+    else if (strcmp(argv[i], "--runs") == 0) runs = atoi(argv[i + 1]);
+  }
+
+  uint64_t queries = 0;
+  for (int r = 0; r < runs && checkFailures == 0; r++) {
+    WindowCheck<60, 60>    w1h("1h");
+    WindowCheck<300, 288>  w24h("24h");
+    WindowCheck<3600, 168> w7d("7d");
+    WindowCheck<1800, 48>  probe("probe 24h");
+    WindowCheck<7, 5>      tiny("7s x 5");
+    WindowCheck<1, 3>      unit("1s x 3");
+    run(seed + (uint32_t) r, w1h, w24h, w7d, probe, tiny, unit);
+    queries += w1h.queries + w24h.queries + w7d.queries + probe.queries + tiny.queries + unit.queries;
+  }
+  printf("  %d runs from seed %u: %llu window queries\n", runs, seed, (unsigned long long) queries);
+  return checkResult("rolling_minmax_check");
+}
@@ -0,0 +1,257 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// sample_log_check.cpp — SampleLog across a power cut at every byte
+//
+//   sample_log_check [--stride N]
+//
+// The log runs on an in-memory flash that loses power after a given number
+// of appended bytes. The append that crosses the limit writes only the
+// bytes before it, and every filesystem call after it fails, as the board
+// stops. A reference run records where each frame lands in the stream of
+// appended bytes. The sweep then cuts power at every byte (or every Nth,
+// with --stride) of three stretches of that stream:
+//
+//   first     the first 24 frames of an empty log
+//   rotation  4 frames either side of the first move to a new slot
+//   wrap      2 frames either side of the oldest slot being recycled
+//
+// After each cut the board reboots: begin(), then replay(). The samples
+// that come back must be a gap-free run of the samples written, unchanged,
+// ending exactly at flushedTs() as it stood before the cut. Only the
+// unflushed tail and the torn frame may be lost. Then more samples are
+// logged and the board reboots again. The old run and the new samples must
+// follow each other with nothing between them, so the torn tail was never
+// appended to.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "../sample_log.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1) Flash: files in memory, every change journaled
+// ──────────────────────────────────────────────────────────────────────────────
+typedef std::map<std::string, std::vector<uint8_t>> Files;
+
+struct FsOp {
+  bool        remove;
+  std::string path;
+  std::vector<uint8_t> data;   // an append: one frame
+  uint64_t    at;              // its offset in the stream of appended bytes
+};
+
+static Files files;
+static std::vector<FsOp> journal;
+static uint64_t streamBytes = 0;
+
+bool halFsMounted() { return true; }
+
+size_t halFsSize(const char* path) {
+  auto f = files.find(path);
+  return f == files.end() ? 0 : f->second.size();
+}
+
+size_t halFsRead(const char* path, uint32_t offset, void* buf, size_t len) {
+  auto f = files.find(path);
+  if (f == files.end() || offset >= f->second.size()) return 0;
+  const size_t n = std::min(len, f->second.size() - offset);
+  memcpy(buf, f->second.data() + offset, n);
+  return n;
+}
+
+bool halFsAppend(const char* path, const void* data, size_t len) {
+  std::vector<uint8_t>& f = files[path];
+  const uint8_t* p = (const uint8_t*) data;
+  f.insert(f.end(), p, p + len);
+  journal.push_back({ false, path, std::vector<uint8_t>(p, p + len), streamBytes });
+  streamBytes += len;
+  return true;
+}
+
+bool halFsRemove(const char* path) {
+  files.erase(path);
+  journal.push_back({ true, path, {}, streamBytes });
+  return true;
+}
+
+// The flash as a power cut after `cut` appended bytes leaves it: `base` is
+// the state before ops[from], and the append that crosses the cut writes
+// only the bytes before it. Returns the newest sample in a whole frame,
+// which flushedTs() reported before the cut.
+static uint32_t powerCut(const std::vector<FsOp>& ops, const Files& base, size_t from, uint64_t cut,
+                         uint32_t flushedTs) {
+  files = base;
+  for (size_t i = from; i < ops.size(); i++) {
+    const FsOp& op = ops[i];
+    if (op.remove) {
+      files.erase(op.path);
+      continue;
+    }
+    if (op.at >= cut) {
+      files[op.path];                  // opened, nothing written
+      break;
+    }
+    const size_t n = (size_t) std::min<uint64_t>(op.data.size(), cut - op.at);
+    std::vector<uint8_t>& f = files[op.path];
+    f.insert(f.end(), op.data.begin(), op.data.begin() + n);
+    if (n < op.data.size()) break;
+    LogFrameHeader h;
+    memcpy(&h, op.data.data(), sizeof(h));
+    flushedTs = h.lastTs;
+  }
+  return flushedTs;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2) Samples: 2 s steps with small changes (one-byte records), adaptive
+//    gaps, door openings and the odd long outage (varint records)
+// ──────────────────────────────────────────────────────────────────────────────
+static std::vector<HistSample> makeSamples(size_t n, uint32_t seed) {
+  std::mt19937 rng(seed);
+  auto uniform = [&](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); };
+  std::vector<HistSample> v;
+  v.reserve(n);
+  HistSample s = { 1750000000, 450, 880 };
+  for (size_t i = 0; i < n; i++) {
+    const int roll = uniform(0, 999);
+    if      (roll < 2)   s.ts += (uint32_t) uniform(600, 200000);
+    else if (roll < 400) s.ts += (uint32_t) uniform(3, 30);
+    else                 s.ts += 2;
+    const int jump = roll < 200 ? uniform(-40, 40) : uniform(-2, 2);
+    s.t10 = (int16_t) std::max(-400, std::min(1800, s.t10 + jump));
+    s.h10 = (uint16_t) std::max(0, std::min(1000, (int) s.h10 + uniform(-3, 3)));
+    v.push_back(s);
+  }
+  return v;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3) One boot: everything the log gives back
+// ──────────────────────────────────────────────────────────────────────────────
+static std::vector<HistSample> boot(SampleLog& log) {
+  std::vector<HistSample> out;
+  log.begin();
+  log.replay([&](const HistSample& s) { out.push_back(s); });
+  return out;
+}
+
+// Index of the sample with timestamp `ts` in `all`, or -1
+static long indexOf(const std::vector<HistSample>& all, uint32_t ts) {
+  size_t lo = 0, hi = all.size();
+  while (lo < hi) {
+    const size_t mid = (lo + hi) / 2;
+    if (all[mid].ts < ts) lo = mid + 1;
+    else                  hi = mid;
+  }
+  return lo < all.size() && all[lo].ts == ts ? (long) lo : -1;
+}
+
+// `got` must be all[first … first + got.size()), unchanged
+static bool isRun(const std::vector<HistSample>& got, const std::vector<HistSample>& all, long* first) {
+  if (got.empty()) {
+    *first = -1;
+    return true;
+  }
+  *first = indexOf(all, got.front().ts);
+  if (*first < 0 || (size_t) *first + got.size() > all.size()) return false;
+  for (size_t i = 0; i < got.size(); i++) {
+    const HistSample& a = got[i];
+    const HistSample& b = all[*first + i];
+    if (a.ts != b.ts || a.t10 != b.t10 || a.h10 != b.h10) return false;
+  }
+  return true;
+}
+
+// Boot after a power cut, check the replay, log on as the app does and
+// boot again: the first run and the new samples must follow each other
+static void checkCut(uint64_t cut, uint32_t flushedTs, const std::vector<HistSample>& all) {
+  SampleLog log;
+  const std::vector<HistSample> got = boot(log);
+  long first;
+  CHECK(isRun(got, all, &first), "cut at %llu: replay is not a run of the samples written",
+        (unsigned long long) cut);
+  const uint32_t lastTs = got.empty() ? 0 : got.back().ts;
+  CHECK(lastTs == flushedTs, "cut at %llu: replay ends at %u, flushed up to %u",
+        (unsigned long long) cut, lastTs, flushedTs);
+  if (checkFailures) return;
+
+  const size_t resume = got.empty() ? 0 : (size_t)(first + got.size());
+  const size_t end    = std::min(all.size(), resume + 600);
+  for (size_t i = resume; i < end; i++) log.append(all[i]);
+  log.flush();
+  SampleLog again;
+  const std::vector<HistSample> got2 = boot(again);
+  long first2;
+  CHECK(isRun(got2, all, &first2), "cut at %llu: after logging on, replay is not a run",
+        (unsigned long long) cut);
+  CHECK(!got2.empty() && got2.back().ts == all[end - 1].ts,
+        "cut at %llu: after logging on, replay ends at %u, expected %u", (unsigned long long) cut,
+        got2.empty() ? 0 : got2.back().ts, all[end - 1].ts);
+  CHECK(got.empty() || (!got2.empty() && first2 < (long)(first + got.size())),
+        "cut at %llu: logging on lost the samples from before the cut", (unsigned long long) cut);
+}
+
+int main(int argc, char** argv) {
+  uint64_t stride = 1;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--stride") == 0) stride = strtoull(argv[i + 1], nullptr, 10);
+  }
+  if (stride == 0) stride = 1;
+
+  // Reference run: every frame and slot erase, in order
+  const std::vector<HistSample> all = makeSamples(400000, 13);
+  {
+    SampleLog log;
+    log.begin();
+    for (const HistSample& smp : all) log.append(smp);
+    log.flush();
+  }
+  const std::vector<FsOp> ref = journal;
+  std::vector<size_t> frames;                 // journal index of each append
+  size_t firstRotation = 0, wrap = 0;
+  for (size_t i = 0; i < ref.size(); i++) {
+    if (ref[i].remove) continue;
+    const size_t f = frames.size();
+    frames.push_back(i);
+    if (f > 0 && ref[i].path != ref[frames[f - 1]].path && !firstRotation) firstRotation = f;
+    if (i > 0 && ref[i - 1].remove && ref[i - 1].at > 0 && !wrap) {
+      for (size_t k = 0; k + 1 < i && !wrap; k++) {
+        if (!ref[k].remove && ref[k].path == ref[i].path) wrap = f;
+      }
+    }
+  }
+  printf("  reference: %zu samples in %zu frames, %llu bytes; first rotation at frame %zu, "
+         "first recycled slot at frame %zu\n", all.size(), frames.size(),
+         (unsigned long long) streamBytes, firstRotation, wrap);
+  CHECK(firstRotation >= 4 && wrap >= 2 && wrap + 2 < frames.size(),
+        "the reference run never recycled a slot");
+  if (checkFailures) return checkResult("sample_log_check");
+
+  struct Stretch { const char* name; size_t from, to; };
+  const Stretch stretches[] = {
+    { "first",    0,                 24 },
+    { "rotation", firstRotation - 4, firstRotation + 4 },
+    { "wrap",     wrap - 2,          wrap + 2 },
+  };
+  for (const Stretch& st : stretches) {
+    if (checkFailures) break;
+    // The flash just before the stretch, and what it had flushed
+    const size_t from = st.from == 0 ? 0 : frames[st.from - 1] + 1;
+    const uint32_t flushedBefore = powerCut(ref, Files(), 0, ref[from].at, 0);
+    const Files base = files;
+    const uint64_t lo = ref[frames[st.from]].at, hi = ref[frames[st.to]].at;
+    uint64_t cuts = 0;
+    for (uint64_t cut = lo; cut <= hi && checkFailures == 0; cut += stride, cuts++) {
+      journal.clear();
+      const uint32_t flushedTs = powerCut(ref, base, from, cut, flushedBefore);
+      checkCut(cut, flushedTs, all);
+    }
+    printf("  %-8s %llu power cuts over bytes %llu…%llu\n", st.name, (unsigned long long) cuts,
+           (unsigned long long) lo, (unsigned long long) hi);
+  }
+  return checkResult("sample_log_check");
+}
@@ -0,0 +1,327 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// sensor_scheduler_check.cpp — SensorScheduler driven the way the sensor step does
+//
+//   sensor_scheduler_check [--seed N] [--hours N]
+//
+// Runs the scheduler over a virtual millisecond clock like appSensorStep():
+// start next() when no read is in flight, hold it for the probe's read time
+// (6 ms DHT22, 16 ms SHT3x), sleep untilNext() otherwise. Three probe sets:
+// the app's 8 (DHT22 and SHT3x alternating), 10 with uneven minimum
+// intervals, some above the 2 s cadence, and a single probe.
+//
+// Each set runs a scripted sequence — boot stagger, period grow, two
+// shrinks, a short and a long stall — and then --hours of random period
+// changes and stalls. halMillis() is offset so that it wraps during both.
+// The check keeps its own due time per probe and, at every read start,
+// compares it with the one started() reports (now − lateness):
+//
+//   steady     due times advance by whole periods, whatever the lateness;
+//              a probe a full period behind restarts one period after its
+//              late start (no catch-up burst); none comes round sooner
+//              than its minimum interval
+//   lateness   never early, and at most every probe's read time (SLACK)
+//              late unless the read fell due during a stall
+//   grow       every pending read moves out by the difference
+//   shrink     the reads go longest-waiting probe first, none sooner than
+//              one new period after its last read, all within the longest
+//              shrunk period plus the shortest period
+//   stalls     every probe is read within one period + SLACK after one
+//
+// and next() must return a probe exactly when untilNext() says 0. The
+// comparisons themselves are also checked on their own, right at the wrap.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "../sensor_scheduler.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+
+static const size_t   MAX_PROBES  = 10;
+static const uint32_t DHT_READ_MS = 6;
+static const uint32_t SHT_READ_MS = 16;
+static const uint64_t T0          = 1000000;   // virtual start: begin()'s last starts lie before it
+static const uint32_t PERIODS[]   = { 2000, 3000, 4500, 8000, 16000, 30000, 300000 };
+
+struct ProbeSet {
+  const char* name;
+  size_t      count;
+  uint32_t    minIntervalMs[MAX_PROBES];
+};
+
+static const ProbeSet SETS[] = {
+  { "app",     8, { 2000, 100, 2000, 100, 2000, 100, 2000, 100 } },
+  { "uneven", 10, { 2000, 100, 2500, 100, 3000, 5000, 100, 2000, 4000, 250 } },
+  { "single",  1, { 2000 } },
+};
+
+struct Stats {
+  uint64_t starts = 0, resyncs = 0, grows = 0, shrinks = 0, stalls = 0;
+  uint32_t worstLateMs = 0;     // outside stalls
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1) The driver, the due-time model and the per-start checks
+// ──────────────────────────────────────────────────────────────────────────────
+struct Drive {
+  const ProbeSet& set;
+  Stats& st;
+  SensorScheduler<MAX_PROBES> sched;
+  uint32_t base;                          // halMillis() at virtual t = 0
+  uint64_t t = T0;                        // virtual ms, never wraps
+  uint32_t readMs[MAX_PROBES];
+  uint32_t slack = 0;
+  uint32_t common = 0;
+  int      active = -1;
+  uint64_t busyUntil = 0;
+  uint64_t stallEnd = 0;                  // end of the last stall
+
+  bool     begun[MAX_PROBES] = {};
+  uint64_t lastStart[MAX_PROBES] = {};    // as the scheduler sees it (begin() makes one up)
+  uint64_t due[MAX_PROBES] = {};          // the model's; 0 = unknown after a shrink
+  uint64_t dueBy[MAX_PROBES] = {};        // while unknown, the latest it may be
+  uint64_t deadline[MAX_PROBES] = {};     // must start by then (0 = none set)
+  uint32_t shrinkRank[MAX_PROBES] = {};   // place in the last shrink's order (0 = not in it)
+  uint32_t shrinkNext = 0;                // rank that must start next
+  size_t   bootOrder[MAX_PROBES];         // probes in the order of their first read
+  size_t   booted = 0;
+
+  Drive(const ProbeSet& s, Stats& stats, uint32_t nowAtT0) : set(s), st(stats) {
+    base = (uint32_t)(nowAtT0 - T0);
+    for (size_t i = 0; i < set.count; i++) {
+      readMs[i] = set.minIntervalMs[i] >= 2000 ? DHT_READ_MS : SHT_READ_MS;
+      slack += readMs[i];
+    }
+  }
+
+  uint32_t now() const { return (uint32_t)(base + t); }
+
+  void begin(uint32_t periodMs, uint32_t warmupMs) {
+    common = periodMs;
+    sched.begin(set.count, periodMs, set.minIntervalMs, now() + warmupMs);
+    CHECK(sched.count() == set.count, "%s: count() %zu", set.name, sched.count());
+    uint32_t spread = UINT32_MAX;
+    for (size_t i = 0; i < set.count; i++) {
+      CHECK(sched.periodMs(i) == std::max(periodMs, set.minIntervalMs[i]),
+            "%s: probe %zu period %u", set.name, i, sched.periodMs(i));
+      spread = std::min(spread, sched.periodMs(i));
+    }
+    for (size_t i = 0; i < set.count; i++) {
+      due[i]       = t + warmupMs + (uint64_t) spread * i / set.count;
+      lastStart[i] = due[i] - sched.periodMs(i);
+      deadline[i]  = due[i] + slack;
+    }
+  }
+
+  void start(size_t p) {
+    const uint32_t late   = sched.started(p, now());
+    const uint32_t period = sched.periodMs(p);
+    const uint64_t dueAt  = t - late;
+    st.starts++;
+
+    CHECK(late < 0x80000000u, "%s: probe %zu started %d ms early", set.name, p, -(int32_t) late);
+    if (due[p]) {
+      CHECK(dueAt == due[p], "%s: probe %zu was due at %llu, the model says %llu", set.name, p,
+            (unsigned long long) dueAt, (unsigned long long) due[p]);
+    } else {
+      CHECK(dueAt >= lastStart[p] + period && dueAt <= dueBy[p],
+            "%s: probe %zu due %llu ms after its last read, %lld past its latest, period %u",
+            set.name, p, (unsigned long long)(dueAt - lastStart[p]),
+            (long long)(dueAt - dueBy[p]), period);
+    }
+    if (dueAt >= stallEnd) {
+      CHECK(late <= slack, "%s: probe %zu started %u ms late", set.name, p, late);
+      st.worstLateMs = std::max(st.worstLateMs, late);
+    }
+    if (begun[p]) {
+      CHECK(t - lastStart[p] >= set.minIntervalMs[p], "%s: probe %zu read %llu ms after the last, minimum %u",
+            set.name, p, (unsigned long long)(t - lastStart[p]), set.minIntervalMs[p]);
+    } else {
+      bootOrder[booted++] = p;
+    }
+    if (deadline[p]) {
+      CHECK(t <= deadline[p], "%s: probe %zu started %llu ms past its deadline",
+            set.name, p, (unsigned long long)(t - deadline[p]));
+      deadline[p] = 0;
+    }
+    if (shrinkRank[p]) {
+      CHECK(shrinkRank[p] == shrinkNext, "%s: probe %zu went %u-th after a shrink, expected %u-th",
+            set.name, p, shrinkRank[p], shrinkNext);
+      shrinkRank[p] = 0;
+      shrinkNext++;
+    }
+
+    // Next due: a whole period on, unless a full period behind
+    if (late >= period) st.resyncs++;
+    due[p] = std::max(late >= period ? t + period : dueAt + period, t + set.minIntervalMs[p]);
+    begun[p]     = true;
+    lastStart[p] = t;
+  }
+
+  // Sensor steps until virtual time `until`
+  void run(uint64_t until) {
+    while (t < until) {
+      if (active >= 0 && t >= busyUntil) active = -1;
+      const uint32_t wait = sched.untilNext(now());
+      if (active < 0) {
+        const int p = sched.next(now());
+        CHECK((p >= 0) == (wait == 0), "%s: next() %d but untilNext() %u", set.name, p, wait);
+        if (p >= 0) {
+          start((size_t) p);
+          active = p;
+          busyUntil = t + readMs[p];
+        }
+      }
+      for (size_t i = 0; i < set.count; i++) {
+        if (deadline[i] && t > deadline[i]) {
+          CHECK(false, "%s: probe %zu not read by its deadline", set.name, i);
+          deadline[i] = 0;
+        }
+      }
+      t = active >= 0 ? busyUntil : t + std::max<uint32_t>(std::min(wait, common), 1);
+    }
+  }
+
+  // The read in flight finishes first: the app calls setPeriod() from takeReading()
+  void setPeriod(uint32_t periodMs) {
+    if (active >= 0) { t = std::max(t, busyUntil); active = -1; }
+    uint32_t oldPeriod[MAX_PROBES];
+    for (size_t i = 0; i < set.count; i++) oldPeriod[i] = sched.periodMs(i);
+    common = periodMs;
+    sched.setPeriod(periodMs, now());
+
+    size_t order[MAX_PROBES], n = 0;
+    bool grew = false;
+    for (size_t i = 0; i < set.count; i++) {
+      const uint32_t p = sched.periodMs(i);
+      CHECK(p == std::max(periodMs, set.minIntervalMs[i]), "%s: probe %zu period %u after setPeriod(%u)",
+            set.name, i, p, periodMs);
+      shrinkRank[i] = 0;
+      if (p >= oldPeriod[i]) {
+        if (due[i]) due[i]   += p - oldPeriod[i];
+        else        dueBy[i] += p - oldPeriod[i];
+        grew |= p > oldPeriod[i];
+      } else {
+        size_t at = n++;
+        for (; at > 0 && lastStart[order[at - 1]] > lastStart[i]; at--) order[at] = order[at - 1];
+        order[at] = i;
+        due[i] = 0;
+      }
+      deadline[i] = t + 2 * (uint64_t) p + slack;
+    }
+    // The shrunk reads wait, together, at most the longest of their periods,
+    // then spread across the shortest period of all
+    uint32_t spread = UINT32_MAX, longest = 0;
+    for (size_t i = 0; i < set.count; i++) spread = std::min(spread, sched.periodMs(i));
+    for (size_t r = 0; r < n; r++) longest = std::max(longest, sched.periodMs(order[r]));
+    for (size_t r = 0; r < n; r++) {
+      shrinkRank[order[r]] = (uint32_t) r + 1;
+      dueBy[order[r]]      = t + longest + spread;
+      deadline[order[r]]   = dueBy[order[r]] + slack;
+    }
+    shrinkNext = 1;
+    if (n)    st.shrinks++;
+    if (grew) st.grows++;
+  }
+
+  // Nothing serviced for `ms` (a blocked task, a long flash write)
+  void stall(uint32_t ms) {
+    t += ms;
+    stallEnd = t;
+    st.stalls++;
+    for (size_t i = 0; i < set.count; i++) {
+      deadline[i] = std::max(deadline[i], t + sched.periodMs(i) + slack);
+    }
+  }
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2) Scripted: boot stagger, grow, shrinks, stalls — halMillis() wraps at 30 s
+// ──────────────────────────────────────────────────────────────────────────────
+static void scripted(const ProbeSet& set, Stats& st) {
+  Drive d(set, st, UINT32_MAX - 30000);
+  d.begin(2000, 1500);
+
+  // The first round goes out in index order (begin()'s stagger; the times are in the model)
+  d.run(T0 + 1500 + 2000 + d.slack + 1);
+  CHECK(d.booted == set.count, "%s: %zu of %zu probes read in the first round", set.name, d.booted, set.count);
+  for (size_t r = 0; r < d.booted; r++) {
+    CHECK(d.bootOrder[r] == r, "%s: probe %zu read %zu-th at boot", set.name, d.bootOrder[r], r);
+  }
+
+  d.run(T0 + 60000);
+  d.setPeriod(30000);  d.run(T0 + 200000);
+  d.setPeriod(8000);   d.run(T0 + 260000);
+  d.setPeriod(2000);   d.run(T0 + 300000);
+  d.stall(12000);      d.run(T0 + 400000);
+  d.stall(95000);      d.run(T0 + 500000);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3) Random: period changes and stalls for `hours`, wrapping somewhere inside
+// ──────────────────────────────────────────────────────────────────────────────
+static void randomized(const ProbeSet& set, Stats& st, std::mt19937& rng, int hours) {
+  const uint64_t span = (uint64_t) hours * 3600000;
+  Drive d(set, st, UINT32_MAX - (uint32_t)(rng() % span));
+  d.begin(PERIODS[rng() % 3], (uint32_t)(rng() % 5000));
+  while (d.t < T0 + span) {
+    switch (rng() % 4) {
+      case 0: d.setPeriod(PERIODS[rng() % (sizeof(PERIODS) / sizeof(PERIODS[0]))]); break;
+      case 1: d.stall(rng() % 4 ? 100 + rng() % 5000 : 5000 + rng() % 600000);     break;
+      default: break;
+    }
+    d.run(d.t + 1000 + rng() % 600000);
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 4) Wrap-safe comparisons, on their own
+// ──────────────────────────────────────────────────────────────────────────────
+static void wrapEdges() {
+  const uint32_t minIntervalMs[2] = { 100, 100 };
+  SensorScheduler<2> s;
+  s.begin(2, 2000, minIntervalMs, UINT32_MAX - 499);   // due at 2^32 − 500 and 2^32 + 500
+  CHECK(s.next(UINT32_MAX - 1000) == -1, "next() before the wrap");
+  CHECK(s.untilNext(UINT32_MAX - 1000) == 501, "untilNext() %u before the wrap",
+        s.untilNext(UINT32_MAX - 1000));
+  CHECK(s.next(UINT32_MAX) == 0, "next() just before the wrap");
+  CHECK(s.next(600) == 0, "next() %d after the wrap, want the most overdue", s.next(600));
+  CHECK(s.started(0, 600) == 1100, "lateness across the wrap");
+  CHECK(s.untilNext(600) == 0, "probe 1 still due");
+  CHECK(s.started(1, 610) == 110, "lateness after the wrap");
+  // Probe 0 started 1100 ms late; its next read keeps the phase, not the late start
+  CHECK(s.untilNext(610) == 890, "untilNext() %u after the wrap", s.untilNext(610));
+  CHECK(s.next(1499) == -1 && s.next(1500) == 0, "phase lost across the wrap");
+
+  // The minimum interval and the resync, across the wrap
+  const uint32_t dhtMs = 2000;
+  SensorScheduler<1> d;
+  d.begin(1, 2000, &dhtMs, UINT32_MAX - 99);           // due at 2^32 − 100
+  CHECK(d.started(0, 1500) == 1600, "DHT lateness across the wrap");
+  CHECK(d.next(3499) == -1 && d.next(3500) == 0, "minimum interval lost across the wrap");
+  CHECK(d.started(0, 9000) == 5500, "DHT lateness after a stall");
+  CHECK(d.untilNext(9000) == 2000, "resync after a stall: untilNext() %u", d.untilNext(9000));
+}
+
+int main(int argc, char** argv) {
+  uint32_t seed = 1;
+  int hours = 336;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if      (strcmp(argv[i], "--seed") == 0)  seed = (uint32_t) strtoul(argv[i + 1], nullptr, 10);
+    else if (strcmp(argv[i], "--hours") == 0) hours = atoi(argv[i + 1]);
+  }
+  if (hours < 1) hours = 1;
+
+  std::mt19937 rng(seed);
+  for (const ProbeSet& set : SETS) {
+    Stats st;
+    scripted(set, st);
+    randomized(set, st, rng, hours);
+    printf("  %-6s %2zu probes: %llu reads, %llu grows, %llu shrinks, %llu stalls (%llu resyncs), "
+           "worst lateness %u ms\n", set.name, set.count, (unsigned long long) st.starts,
+           (unsigned long long) st.grows, (unsigned long long) st.shrinks,
+           (unsigned long long) st.stalls, (unsigned long long) st.resyncs, st.worstLateMs);
+  }
+  wrapEdges();
+  return checkResult("sensor_scheduler_check");
+}
@@ -0,0 +1,114 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// seqlock_check.cpp — Seqlock<SensorSnapshot> under a writer and readers
+//
+//   seqlock_check [--seconds S] [--readers N] [--min-new N]
+//
+// One thread stores snapshots back to back while N readers (default 3)
+// load them, for S seconds (default 1). Every 32-bit word of store i is
+// derived from i, so a reader can tell a torn copy: a word from another
+// store, such as the temperature of one sample next to the humidity of
+// the previous one. Each reader also checks that the store number never
+// goes backwards and that version() is never behind the snapshot it just
+// read. The writer never pauses and the readers yield after a few loads, so
+// on a single CPU (as for two tasks sharing an ESP32 core) a timeslice that
+// ends mid-store hands a reader a half-written payload. With the retry
+// taken out of load(), thousands of torn copies show up per second. The
+// run fails unless the readers saw at least --min-new (default 10) stores,
+// as a check that the threads interleaved at all.
+// ctest runs it as built and again built with -fsanitize=thread
+// (seqlock_check_tsan), which reports any plain access the atomics miss.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "../app.h"
+#include "../seqlock.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+static const size_t WORDS = sizeof(SensorSnapshot) / sizeof(uint32_t);
+static_assert(sizeof(SensorSnapshot) % sizeof(uint32_t) == 0, "checked word by word");
+
+// Word k of store i; word 0 is i itself
+static uint32_t wordOf(uint32_t i, size_t k) { return k == 0 ? i : i * 2654435761u + (uint32_t) k; }
+
+static SensorSnapshot make(uint32_t i) {
+  uint32_t words[WORDS];
+  for (size_t k = 0; k < WORDS; k++) words[k] = wordOf(i, k);
+  SensorSnapshot s;
+  memcpy(&s, words, sizeof(s));
+  return s;
+}
+
+struct ReaderResult {
+  uint64_t loads = 0, changes = 0, torn = 0, backwards = 0, staleVersion = 0;
+};
+
+int main(int argc, char** argv) {
+  double seconds = 1;
+  int readers = 3;
+  uint64_t minNew = 10;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if      (strcmp(argv[i], "--seconds") == 0) seconds = atof(argv[i + 1]);
+    else if (strcmp(argv[i], "--readers") == 0) readers = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "--min-new") == 0) minNew  = strtoull(argv[i + 1], nullptr, 10);
+  }
+
+  Seqlock<SensorSnapshot> lock;
+  lock.store(make(0));
+  std::atomic<bool> stop{false};
+  std::vector<ReaderResult> results(readers);
+  std::vector<std::thread> threads;
+
+  for (int r = 0; r < readers; r++) {
+    threads.emplace_back([&, r] {
+      ReaderResult& res = results[r];
+      uint32_t last = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        const SensorSnapshot s = lock.load();
+        const uint32_t version = lock.version();
+        uint32_t words[WORDS];
+        memcpy(words, &s, sizeof(s));
+        const uint32_t i = words[0];
+        for (size_t k = 1; k < WORDS; k++) {
+          if (words[k] != wordOf(i, k)) {
+            res.torn++;
+            break;
+          }
+        }
+        if (i < last) res.backwards++;
+        if (i != last) res.changes++;
+        if (version < i + 1) res.staleVersion++;    // store i is the (i+1)th
+        last = i;
+        if (++res.loads % 4 == 0) std::this_thread::yield();
+      }
+    });
+  }
+
+  uint32_t stores = 0;
+  const auto until = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+  while (std::chrono::steady_clock::now() < until) {
+    for (int burst = 0; burst < 256; burst++) lock.store(make(++stores));
+  }
+  stop = true;
+  for (std::thread& t : threads) t.join();
+
+  ReaderResult total;
+  for (const ReaderResult& r : results) {
+    total.loads        += r.loads;
+    total.changes      += r.changes;
+    total.torn         += r.torn;
+    total.backwards    += r.backwards;
+    total.staleVersion += r.staleVersion;
+  }
+  printf("  %u stores, %d readers: %llu loads, %llu saw a new store\n", stores, readers,
+         (unsigned long long) total.loads, (unsigned long long) total.changes);
+  CHECK(total.torn == 0, "%llu torn snapshots", (unsigned long long) total.torn);
+  CHECK(total.backwards == 0, "%llu loads went back to an older store", (unsigned long long) total.backwards);
+  CHECK(total.staleVersion == 0, "%llu loads ahead of version()", (unsigned long long) total.staleVersion);
+  CHECK(total.changes >= minNew, "readers saw only %llu stores; the threads never interleaved",
+        (unsigned long long) total.changes);
+  return checkResult("seqlock_check");
+}
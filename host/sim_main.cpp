@@ -0,0 +1,311 @@
+// ──────────────────────────────────────────────────────────────────────────────
+// sim_main.cpp — run the firmware's application logic on Linux
+//
+//   potato_sim [--csv FILE] [--speed N | --fast] [--duration T] [--port P]
+//              [--ntp-delay T] [--epoch UNIX] [--fail-rate P] [--ppm FILE]
+//              [--flash-dir DIR [--power-cut-after BYTES]]
+//              [--sensors N [--max-jitter MS]] [--max-period T]
+//              [--uplink URL [--unit ID]]
+//              [--webhook URL] [--get TARGET]...
+//
+// The FreeRTOS tasks of the ESP32 build become one cooperative loop over a
+// virtual clock: the sensor, uplink and alert steps run when they asked to,
+// the display and alert steps also when notified of a sample, and HTTP is
+// served while the loop waits for the next deadline. An uplink or webhook
+// POST blocks the loop for its real duration while virtual time stands still. Durations take
+// s/m/h/d suffixes.
+//
+// On exit (end of trace, --duration, or Ctrl-C) it flushes the sample log,
+// prints per-step timing, sensor/SPI/HTTP/flash counters, each probe's read
+// spacing, and optionally dumps the OLED framebuffer and the raw HTTP
+// responses to --get requests (to stdout, in order). --power-cut-after stops
+// it mid-write instead, with no flush, so the next run with the same
+// --flash-dir boots from a torn log. --max-jitter turns the probe report into
+// a check: the exit status is 1 if any probe's reads drifted further than
+// that from the period the scheduler had for it at each read.
+// ──────────────────────────────────────────────────────────────────────────────
+#include "hal_host.h"
+#include "../app.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <type_traits>
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int) { stopRequested = 1; }
+
+static uint64_t wallMicros() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1) Per-step profile (wall time spent inside each app*Step call)
+// ──────────────────────────────────────────────────────────────────────────────
+struct StepProfile {
+  const char* name;
+  uint64_t calls = 0;
+  uint64_t totalNs = 0;
+  uint64_t maxNs = 0;
+};
+
+static uint64_t wallNanos() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+template <typename F>
+static auto profiled(StepProfile& p, F step) -> decltype(step()) {
+  const uint64_t t0 = wallNanos();
+  auto guard = [&] {
+    const uint64_t dt = wallNanos() - t0;
+    p.calls++;
+    p.totalNs += dt;
+    p.maxNs = std::max(p.maxNs, dt);
+  };
+  if constexpr (std::is_void<decltype(step())>::value) {
+    step();
+    guard();
+  } else {
+    auto r = step();
+    guard();
+    return r;
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2) Command line
+// ──────────────────────────────────────────────────────────────────────────────
+static bool parseDuration(const char* s, uint64_t* seconds) {
+  char* end;
+  double v = strtod(s, &end);
+  if (end == s || v < 0) return false;
+  switch (*end) {
+    case '\0': case 's': break;
+    case 'm': v *= 60;    break;
+    case 'h': v *= 3600;  break;
+    case 'd': v *= 86400; break;
+    default:  return false;
+  }
+  *seconds = (uint64_t) v;
+  return true;
+}
+
+static void usage() {
+  fprintf(stderr,
+    "usage: potato_sim [options]\n"
+    "  --csv FILE       replay readings from \"seconds,temp_c,humidity\" rows\n"
+    "                   (default: synthetic day/night cycle)\n"
+    "  --speed N        virtual seconds per real second (default 1)\n"
+    "  --fast           run the virtual clock as fast as possible\n"
+    "  --duration T     stop after T virtual time (default: end of CSV, else never)\n"
+    "  --port P         HTTP port (default 8080, 0 = no listener)\n"
+    "  --ntp-delay T    clock reads uptime until T after boot (default 0)\n"
+    "  --epoch UNIX     wall clock at boot (default: first CSV timestamp or now)\n"
+    "  --fail-rate P    fraction of sensor frames with a bad checksum (default 0)\n"
+    "  --sensors N      simulated probes, 1-8: DHT22, then SHT3x/DHT22 alternating\n"
+    "  --max-jitter MS  exit 1 if a probe's read spacing strays further than MS\n"
+    "                   from the scheduled period\n"
+    "  --max-period T   slowest read cadence while readings hold still\n"
+    "                   (default 30s; 2s = fixed)\n"
+    "  --ppm FILE       write the OLED framebuffer to FILE on exit\n"
+    "  --flash-dir DIR  keep the sample log in DIR across runs (default: no flash)\n"
+    "  --power-cut-after BYTES\n"
+    "                   lose power once BYTES have been appended to flash\n"
+    "  --uplink URL     push batches to a collector, e.g. tools/collector.py at\n"
+    "                   http://127.0.0.1:8086/ingest (default: no uplink)\n"
+    "  --unit ID        X-Potato-Unit sent with each batch (default sim)\n"
+    "  --webhook URL    POST alert transitions there as JSON (default: none)\n"
+    "  --get TARGET     on exit, request TARGET (\"/path?query\") and write the raw\n"
+    "                   HTTP response to stdout; repeatable\n");
+}
+
+int main(int argc, char** argv) {
+  SimConfig cfg;
+  double   speed    = 1.0;       // 0 → flat out
+  uint64_t duration = 0;         // virtual seconds; 0 → unbounded
+  const char* ppmPath = nullptr;
+  double   maxJitterMs = -1;     // < 0 → report only
+  const char* gets[128];
+  size_t   getCount = 0;
+
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+    uint64_t secs;
+    if      (!strcmp(a, "--fast"))                { speed = 0; continue; }
+    else if (!v)                                  { usage(); return 2; }
+    else if (!strcmp(a, "--csv"))                 cfg.csvPath = v;
+    else if (!strcmp(a, "--speed"))               speed = atof(v);
+    else if (!strcmp(a, "--duration") && parseDuration(v, &secs))  duration = secs;
+    else if (!strcmp(a, "--port"))                cfg.port = atoi(v);
+    else if (!strcmp(a, "--ntp-delay") && parseDuration(v, &secs)) cfg.ntpDelayS = (uint32_t) secs;
+    else if (!strcmp(a, "--epoch"))               cfg.epoch = (time_t) strtoll(v, nullptr, 10);
+    else if (!strcmp(a, "--fail-rate"))           cfg.failRate = atof(v);
+    else if (!strcmp(a, "--ppm"))                 ppmPath = v;
+    else if (!strcmp(a, "--flash-dir"))           cfg.flashDir = v;
+    else if (!strcmp(a, "--power-cut-after"))     cfg.powerCutAfter = strtoull(v, nullptr, 10);
+    else if (!strcmp(a, "--sensors"))             cfg.sensors = (size_t) atoi(v);
+    else if (!strcmp(a, "--max-jitter"))          maxJitterMs = atof(v);
+    else if (!strcmp(a, "--max-period") && parseDuration(v, &secs)) cfg.maxPeriodMs = (uint32_t)(secs * 1000);
+    else if (!strcmp(a, "--uplink"))              cfg.uplinkUrl = v;
+    else if (!strcmp(a, "--unit"))                cfg.unitId = v;
+    else if (!strcmp(a, "--webhook"))             cfg.webhookUrl = v;
+    else if (!strcmp(a, "--get") && getCount < 128) gets[getCount++] = v;
+    else                                          { usage(); return 2; }
+    i++;
+  }
+  if (speed < 0) { usage(); return 2; }
+
+  if (!simInit(cfg)) return 1;
+  signal(SIGINT,  onSignal);
+  signal(SIGTERM, onSignal);
+  if (cfg.port > 0) fprintf(stderr, "sim: dashboard at http://localhost:%d/\n", cfg.port);
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // 3) Main loop. Same cadence as the ESP32 tasks: sensor and uplink sleep
+  //    for what their steps return, display waits for a notification or 1 s.
+  // ────────────────────────────────────────────────────────────────────────────
+  StepProfile sensorProf  { "sensor"  };
+  StepProfile displayProf { "display" };
+  StepProfile webProf     { "web"     };
+  StepProfile uplinkProf  { "uplink"  };
+  StepProfile alertProf   { "alert"   };
+
+  appSetup();
+
+  const uint64_t endUs = duration ? duration * 1000000 : UINT64_MAX;
+  const uint64_t wallStart = wallMicros();
+  uint64_t nextSensor = 0, nextDisplay = 1000000;
+  uint64_t nextUplink = cfg.uplinkUrl ? 0 : UINT64_MAX;
+  uint64_t nextAlert  = cfg.webhookUrl ? 0 : UINT64_MAX;
+  uint32_t iterations = 0;
+
+  while (!stopRequested && !simTraceDone() && !simPowerLost()) {
+    const uint64_t now = simMicros();
+    if (now >= endUs) break;
+
+    if (now >= nextSensor) {
+      const uint32_t ms = profiled(sensorProf, [] { return appSensorStep(); });
+      nextSensor = now + (uint64_t) std::max<uint32_t>(ms, 1) * 1000;
+    }
+    if (simTakeDisplayNotify() || now >= nextDisplay) {
+      profiled(displayProf, [] { appDisplayStep(); });
+      nextDisplay = now + 1000000;
+    }
+    profiled(webProf, [] { appWebStep(); });
+    if (now >= nextUplink) {
+      const uint32_t ms = profiled(uplinkProf, [] { return appUplinkStep(); });
+      nextUplink = now + (uint64_t) std::max<uint32_t>(ms, 1) * 1000;
+    }
+    if ((simTakeAlertNotify() && cfg.webhookUrl) || now >= nextAlert) {
+      const uint32_t ms = profiled(alertProf, [] { return appAlertStep(); });
+      nextAlert = now + (uint64_t) std::max<uint32_t>(ms, 1) * 1000;
+    }
+
+    const uint64_t next = std::min({ nextSensor, nextDisplay, nextUplink, nextAlert, endUs });
+    if (speed == 0) {
+      // Flat out: jump straight to the next deadline, but still answer HTTP
+      if ((++iterations & 1023) == 0) simHttpPoll(0);
+      simSetMicros(next);
+      continue;
+    }
+
+    // Paced: sleep in HTTP poll for the real-time equivalent of the gap; a
+    // request ends the wait early and the clock advances by what elapsed
+    const uint64_t w0 = wallMicros();
+    const bool served = simHttpPoll((uint64_t)((next - now) / speed));
+    if (served) {
+      simSetMicros(std::min(next, now + (uint64_t)((wallMicros() - w0) * speed)));
+      profiled(webProf, [] { appWebStep(); });
+    } else {
+      simSetMicros(next);
+    }
+  }
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // 4) Report
+  // ────────────────────────────────────────────────────────────────────────────
+  if (simPowerLost()) fprintf(stderr, "sim: power cut after %llu flash bytes\n",
+                              (unsigned long long) cfg.powerCutAfter);
+  else                appFlushLog();
+
+  const double virtSec = simMicros() / 1e6;
+  const double wallSec = (wallMicros() - wallStart) / 1e6;
+  const SimStats& st = simStats();
+
+  fprintf(stderr, "\nsim: %.0f s virtual in %.2f s wall (%.0f×)\n",
+          virtSec, wallSec, wallSec > 0 ? virtSec / wallSec : 0.0);
+  fprintf(stderr, "  sensors   %llu reads, %llu failed\n",
+          (unsigned long long) st.sensorReads, (unsigned long long) st.sensorFailures);
+  fprintf(stderr, "  history   %zu raw / %zu 1-min / %zu 1-h entries held\n",
+          history.size(HIST_RAW), history.size(HIST_MINUTE), history.size(HIST_HOUR));
+  fprintf(stderr, "  display   %llu draw calls, %llu SPI bytes in %llu windows (%.1f B, %.2f windows per sample)\n",
+          (unsigned long long) st.displayCalls, (unsigned long long) st.spiBytes,
+          (unsigned long long) st.spiWindows,
+          st.sensorReads ? (double) st.spiBytes / st.sensorReads : 0.0,
+          st.sensorReads ? (double) st.spiWindows / st.sensorReads : 0.0);
+  fprintf(stderr, "  http      %llu requests, %llu SSE bytes\n",
+          (unsigned long long) st.httpRequests, (unsigned long long) st.streamBytes);
+  fprintf(stderr, "  flash     %llu appends, %llu bytes\n",
+          (unsigned long long) st.flashWrites, (unsigned long long) st.flashBytes);
+  HalCpuInfo cpu;
+  halCpuInfo(&cpu);
+  fprintf(stderr, "  cpu       %.1f%% idle (blocked waiting for HTTP or the next deadline)\n",
+          cpu.sinceUs ? 100.0 * cpu.idleUs[0] / cpu.sinceUs : 0.0);
+  if (cfg.uplinkUrl) {
+    fprintf(stderr, "  uplink    %llu POSTs (%lu accepted), %llu bytes, collector has up to %lu\n",
+            (unsigned long long) st.uplinkPosts, (unsigned long) metrics.uplinkBatches.value(),
+            (unsigned long long) st.uplinkBytes, (unsigned long) metrics.uplinkAckedTs.value());
+  }
+  if (cfg.webhookUrl) {
+    fprintf(stderr, "  alerts    %llu webhook POSTs (%lu accepted), %lu transitions dropped\n",
+            (unsigned long long) st.webhookPosts, (unsigned long) metrics.alertDeliveries.value(),
+            (unsigned long) metrics.alertsDropped.value());
+  }
+  fprintf(stderr, "  %-8s %12s %12s %10s %10s\n", "step", "calls", "total ms", "avg ns", "max ns");
+  for (const StepProfile* p : { &sensorProf, &displayProf, &webProf, &uplinkProf, &alertProf }) {
+    fprintf(stderr, "  %-8s %12llu %12.1f %10.0f %10llu\n", p->name,
+            (unsigned long long) p->calls, p->totalNs / 1e6,
+            p->calls ? (double) p->totalNs / p->calls : 0.0,
+            (unsigned long long) p->maxNs);
+  }
+
+  // — Probe read spacing against the period the scheduler had at each read
+  //   (hal_host.cpp). A start can be late (another probe's read in flight),
+  //   never early, so jitter is the worst deviation either way from that
+  //   period; across an adaptive cadence change, only how early a read came.
+  bool jitterOk = true;
+  fprintf(stderr, "  %-8s %6s %10s %8s %12s %12s %10s\n",
+          "probe", "kind", "reads", "failed", "min gap ms", "max gap ms", "jitter ms");
+  for (size_t i = 0; i < halSensorCount(); i++) {
+    const SimProbeStats& ps = st.probes[i];
+    const double lo = ps.minGapUs / 1000.0, hi = ps.maxGapUs / 1000.0;
+    const double jitter = ps.maxJitterUs / 1000.0;
+    fprintf(stderr, "  %-8s %6s %10llu %8llu %12.1f %12.1f %10.1f\n", halSensorInfo(i).name,
+            halSensorInfo(i).kind == SENSOR_SHT3X ? "sht3x" : "dht22",
+            (unsigned long long) ps.reads, (unsigned long long) ps.failures, lo, hi, jitter);
+    if (maxJitterMs >= 0 && jitter > maxJitterMs) jitterOk = false;
+  }
+  if (!jitterOk) fprintf(stderr, "sim: probe jitter above %.1f ms\n", maxJitterMs);
+
+  if (ppmPath) {
+    if (!simWritePpm(ppmPath)) {
+      fprintf(stderr, "sim: cannot write %s\n", ppmPath);
+      return 1;
+    }
+    fprintf(stderr, "sim: framebuffer written to %s\n", ppmPath);
+  }
+  for (size_t i = 0; i < getCount; i++) {
+    std::string response;
+    simHttpRequest(gets[i], nullptr, &response);
+    fwrite(response.data(), 1, response.size(), stdout);
+  }
+  return jitterOk ? 0 : 1;
+}
@@ -0,0 +1,692 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// http_server.h — non-blocking HTTP/1.1 server with a fixed connection pool
+//
+// Plain BSD sockets, so the same code runs on lwIP on the ESP32 and on Linux
+// in the host simulation. One task drives it: pollSet() lists the sockets to
+// wait on, the caller poll()s them (with its own timeout), and process()
+// accepts, reads request heads and writes responses only as far as each
+// socket allows. A phone on bad Wi-Fi holds its own slot, not the server.
+//
+//   pool        HTTP_POOL_SIZE connections, each with fixed request and
+//               response buffers inside the server object (≈27 KB in all).
+//               When every slot is taken, a keep-alive connection that has
+//               been idle for HTTP_EVICT_IDLE_MS makes room; if there is
+//               none, the newcomer gets a canned 503 and is closed.
+//   keep-alive  HTTP/1.1 connections (and 1.0 ones that ask) stay open for
+//               further requests, pipelined ones included, until they sit
+//               idle for HTTP_IDLE_TIMEOUT_MS.
+//   timeouts    a request head must be complete HTTP_HEAD_TIMEOUT_MS after
+//               its first byte, and a response may go HTTP_WRITE_TIMEOUT_MS
+//               without progress; either closes the connection.
+//
+// Handlers run one at a time, as under WebServer, through the calls below
+// (hal.h section 5 maps onto them):
+//
+//   send()        headers and body are copied into the slot's buffer and sent
+//                 from there, so the caller may reuse its buffer at once
+//   sendStatic()  the body is sent from where it is; it must outlive the
+//                 request (the page in flash)
+//   chunk()       chunks collect in the slot's buffer. A response that
+//                 outgrows it is written synchronously from then on, each
+//                 wait bounded by HTTP_WRITE_TIMEOUT_MS: the streaming routes
+//                 (/history, /metrics, /export) hold the server while they
+//                 run, as they always did.
+//
+// Only the request head is read. A request that announces a body is answered
+// and its connection closed.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/poll.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "hal.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0                  // lwIP raises no SIGPIPE anyway
+#endif
+
+static const int      HTTP_POOL_SIZE        = 6;
+static const int      HTTP_POLL_FDS         = HTTP_POOL_SIZE + 1;   // + the listener
+static const size_t   HTTP_REQUEST_BYTES    = 1536;   // a request head, plus pipelined bytes
+static const size_t   HTTP_RESPONSE_BYTES   = 2816;   // status, headers and a copied body
+static const int      HTTP_MAX_ROUTES       = 16;
+static const int      HTTP_MAX_HEADERS      = 24;
+static const uint32_t HTTP_HEAD_TIMEOUT_MS  = 5000;
+static const uint32_t HTTP_IDLE_TIMEOUT_MS  = 5000;
+static const uint32_t HTTP_WRITE_TIMEOUT_MS = 5000;
+static const uint32_t HTTP_EVICT_IDLE_MS    = 1000;
+
+class HttpServer {
+public:
+  // In-memory requests (handleInMemory) hand their response bytes here
+  typedef void (*Sink)(void* ctx, const void* data, size_t len);
+
+  HttpServer() {
+    for (int& fd : streams_) fd = -1;
+  }
+
+  // Listen on `port`. On failure errno says why.
+  bool begin(uint16_t port) {
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd_ < 0) return false;
+    int one = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr = {};
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(listenFd_, (sockaddr*) &addr, sizeof(addr)) < 0 || listen(listenFd_, 16) < 0) {
+      const int err = errno;
+      close(listenFd_);
+      listenFd_ = -1;
+      errno = err;
+      return false;
+    }
+    setNonBlocking(listenFd_);
+    return true;
+  }
+
+  void on(const char* path, HalHttpHandler handler) {
+    if (routeCount_ < HTTP_MAX_ROUTES) routes_[routeCount_++] = { path, handler };
+  }
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Event loop: wait on pollSet()'s sockets, then process() what poll() found
+  // ────────────────────────────────────────────────────────────────────────────
+  // `fds` must hold HTTP_POLL_FDS entries; returns how many were filled
+  int pollSet(pollfd* fds) const {
+    int n = 0;
+    if (listenFd_ >= 0) fds[n++] = { listenFd_, POLLIN, 0 };
+    for (const Conn& c : pool_) {
+      if (c.fd >= 0) fds[n++] = { c.fd, (short)(c.state == WRITING ? POLLOUT : POLLIN), 0 };
+    }
+    return n;
+  }
+
+  // µs until the first connection times out; cap the poll() wait with it
+  uint32_t untilTimeoutUs() const {
+    const uint32_t now = halPerfMicros();
+    uint32_t wait = UINT32_MAX;
+    for (const Conn& c : pool_) {
+      if (c.fd < 0) continue;
+      const uint32_t spent = now - c.sinceUs, limit = timeoutUs(c);
+      const uint32_t left  = spent >= limit ? 0 : limit - spent;
+      if (left < wait) wait = left;
+    }
+    return wait;
+  }
+
+  // Accept, read and write whatever poll() reported ready, then close the
+  // connections that timed out. Returns the number of requests handled.
+  int process(const pollfd* fds, int n) {
+    handled_ = 0;
+    for (int i = 0; i < n; i++) {
+      if (!fds[i].revents) continue;
+      if (fds[i].fd == listenFd_) {
+        acceptAll();
+        continue;
+      }
+      Conn* c = find(fds[i].fd);
+      if (!c) continue;
+      if (c->state == WRITING) {
+        if (flush(*c) && finish(*c)) serve(*c);
+      } else {
+        receive(*c);
+      }
+    }
+    expire();
+    return handled_;
+  }
+
+  // Run the handler for `target` as if it had arrived over a socket, handing
+  // the response to `sink` (benchmarks and tests)
+  void handleInMemory(const char* target, const char* ifNoneMatch, Sink sink, void* ctx) {
+    snprintf(memTarget_, sizeof(memTarget_), "%s", target);
+    char* q = strchr(memTarget_, '?');
+    query_ = "";
+    if (q) {
+      *q = '\0';
+      query_ = q + 1;
+    }
+    headerCount_ = 0;
+    if (ifNoneMatch) headers_[headerCount_++] = { "If-None-Match", ifNoneMatch };
+    sink_    = sink;
+    sinkCtx_ = ctx;
+    dispatch(memTarget_);
+    sink_ = nullptr;
+  }
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Inside a handler: the request being handled
+  // ────────────────────────────────────────────────────────────────────────────
+  // Query argument → `out` (URL-decoded, NUL-terminated, truncated to cap)
+  bool arg(const char* name, char* out, size_t cap) const {
+    const size_t nameLen = strlen(name);
+    for (const char* p = query_; *p; ) {
+      const char* end = strchr(p, '&');
+      if (!end) end = p + strlen(p);
+      if (strncmp(p, name, nameLen) == 0 && (p + nameLen == end || p[nameLen] == '=')) {
+        size_t n = 0;
+        const char* v = p + nameLen < end ? p + nameLen + 1 : end;
+        for (; v < end && n + 1 < cap; v++) {
+          if (*v == '+') out[n++] = ' ';
+          else if (*v == '%' && v + 2 < end && hexValue(v[1]) >= 0 && hexValue(v[2]) >= 0) {
+            out[n++] = (char)(hexValue(v[1]) * 16 + hexValue(v[2]));
+            v += 2;
+          }
+          else out[n++] = *v;
+        }
+        if (cap > 0) out[n] = '\0';
+        return true;
+      }
+      p = *end ? end + 1 : end;
+    }
+    return false;
+  }
+
+  bool headerIs(const char* name, const char* value) const {
+    for (int i = 0; i < headerCount_; i++) {
+      if (strcasecmp(headers_[i].name, name) == 0) return strcmp(headers_[i].value, value) == 0;
+    }
+    return false;
+  }
+
+  void sendHeader(const char* name, const char* value) {
+    const int n = snprintf(respHeaders_ + respHeadersLen_, sizeof(respHeaders_) - respHeadersLen_,
+                           "%s: %s\r\n", name, value);
+    if (n > 0 && respHeadersLen_ + n < sizeof(respHeaders_)) respHeadersLen_ += n;
+  }
+
+  void send(int code, const char* contentType, const void* body, size_t len) {
+    if (body == nullptr) {
+      sendStatus(code, nullptr, 0);
+      return;
+    }
+    sendStatus(code, contentType, (long) len);
+    emit(body, len);
+  }
+
+  void sendStatic(int code, const char* contentType, const void* body, size_t len) {
+    sendStatus(code, contentType, (long) len);
+    if (sink_) {
+      emit(body, len);
+      return;
+    }
+    cur_->body    = (const uint8_t*) body;
+    cur_->bodyLen = len;
+  }
+
+  void beginChunked(int code, const char* contentType) {
+    sendStatus(code, contentType, -1);
+    chunked_ = true;
+  }
+
+  void chunk(const void* data, size_t len) {
+    if (!chunked_ || len == 0) return;
+    char size[16];
+    const int n = snprintf(size, sizeof(size), "%zx\r\n", len);
+    emit(size, n);
+    emit(data, len);
+    emit("\r\n", 2);
+  }
+
+  void endChunked() {
+    if (!chunked_) return;
+    emit("0\r\n\r\n", 5);
+    chunked_ = false;
+  }
+
+  // Hand the connection over as a raw stream (SSE): it leaves the pool, and
+  // the stream calls below own it. -1 if every stream slot is taken.
+  int detach() {
+    if (!cur_) return -1;                      // in-memory request: nothing to keep
+    for (int i = 0; i < HAL_MAX_STREAMS; i++) {
+      if (streams_[i] < 0) {
+        streams_[i] = cur_->fd;
+        reset(*cur_);
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Detached streams. Writes never block: a peer that stops reading fails
+  // the write instead of stalling the caller.
+  // ────────────────────────────────────────────────────────────────────────────
+  bool streamWrite(int id, const void* data, size_t len) {
+    if (id < 0 || id >= HAL_MAX_STREAMS || streams_[id] < 0) return false;
+    return ::send(streams_[id], data, len, MSG_DONTWAIT | MSG_NOSIGNAL) == (ssize_t) len;
+  }
+
+  bool streamOpen(int id) const {
+    if (id < 0 || id >= HAL_MAX_STREAMS || streams_[id] < 0) return false;
+    char c;
+    const ssize_t n = recv(streams_[id], &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n > 0 || (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+  }
+
+  void streamClose(int id) {
+    if (id < 0 || id >= HAL_MAX_STREAMS || streams_[id] < 0) return;
+    close(streams_[id]);
+    streams_[id] = -1;
+  }
+
+  void info(HalHttpInfo* out) const {
+    out->open = 0;
+    for (const Conn& c : pool_) out->open += c.fd >= 0;
+    out->slots    = HTTP_POOL_SIZE;
+    out->accepted = stats_.accepted;
+    out->rejected = stats_.rejected;
+    out->timedOut = stats_.timedOut;
+    out->evicted  = stats_.evicted;
+    out->requests = stats_.requests;
+    out->reused   = stats_.reused;
+  }
+
+private:
+  enum State : uint8_t { READING, WRITING };
+
+  struct Conn {
+    int            fd        = -1;
+    State          state     = READING;
+    bool           keepAlive = false;
+    bool           failed    = false;     // a synchronous write gave up
+    uint32_t       sinceUs   = 0;         // idle since / head started / last write progress
+    uint32_t       requests  = 0;
+    size_t         inLen     = 0;
+    size_t         outLen    = 0, outSent = 0;
+    const uint8_t* body      = nullptr;   // sendStatic(): sent after out[]
+    size_t         bodyLen   = 0, bodySent = 0;
+    char           in[HTTP_REQUEST_BYTES];
+    char           out[HTTP_RESPONSE_BYTES];
+  };
+
+  struct Route  { const char* path; HalHttpHandler handler; };
+  struct Header { const char* name; const char* value; };
+
+  static void setNonBlocking(int fd) { fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK); }
+
+  static bool wouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR; }
+
+  static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+  }
+
+  // Comma-separated header value contains `token` (case-insensitive)
+  static bool hasToken(const char* list, const char* token) {
+    const size_t len = strlen(token);
+    for (const char* p = list; *p; ) {
+      while (*p == ' ' || *p == ',') p++;
+      if (strncasecmp(p, token, len) == 0 && (p[len] == '\0' || p[len] == ',' || p[len] == ' ')) return true;
+      while (*p && *p != ',') p++;
+    }
+    return false;
+  }
+
+  static const char* reasonPhrase(int code) {
+    switch (code) {
+      case 200: return "OK";
+      case 304: return "Not Modified";
+      case 400: return "Bad Request";
+      case 404: return "Not Found";
+      case 431: return "Request Header Fields Too Large";
+      case 503: return "Service Unavailable";
+    }
+    return "";
+  }
+
+  static uint32_t timeoutUs(const Conn& c) {
+    if (c.state == WRITING) return HTTP_WRITE_TIMEOUT_MS * 1000;
+    return (c.inLen > 0 ? HTTP_HEAD_TIMEOUT_MS : HTTP_IDLE_TIMEOUT_MS) * 1000;
+  }
+
+  Conn* find(int fd) {
+    for (Conn& c : pool_) if (c.fd == fd) return &c;
+    return nullptr;
+  }
+
+  void reset(Conn& c) {
+    c.fd       = -1;
+    c.state    = READING;
+    c.requests = 0;
+    c.inLen    = 0;
+    c.outLen   = c.outSent = 0;
+    c.body     = nullptr;
+    c.bodyLen  = c.bodySent = 0;
+  }
+
+  void closeConn(Conn& c) {
+    shutdown(c.fd, SHUT_WR);
+    close(c.fd);
+    reset(c);
+  }
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Connections
+  // ────────────────────────────────────────────────────────────────────────────
+  void acceptAll() {
+    for (;;) {
+      const int fd = accept(listenFd_, nullptr, nullptr);
+      if (fd < 0) return;
+      Conn* c = freeSlot();
+      if (!c) {
+        reject(fd);
+        continue;
+      }
+      setNonBlocking(fd);
+      int one = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      stats_.accepted++;
+      c->fd        = fd;
+      c->keepAlive = false;
+      c->sinceUs   = halPerfMicros();
+      receive(*c);                            // the request is often already here
+    }
+  }
+
+  // A free slot, or the longest-idle keep-alive connection's if it has been
+  // quiet long enough; nullptr when all are busy
+  Conn* freeSlot() {
+    const uint32_t now = halPerfMicros();
+    Conn* idle = nullptr;
+    for (Conn& c : pool_) {
+      if (c.fd < 0) return &c;
+      if (c.state != READING || c.inLen > 0 || now - c.sinceUs < HTTP_EVICT_IDLE_MS * 1000) continue;
+      if (!idle || (int32_t)(c.sinceUs - idle->sinceUs) < 0) idle = &c;
+    }
+    if (!idle) return nullptr;
+    stats_.evicted++;
+    closeConn(*idle);
+    return idle;
+  }
+
+  void reject(int fd) {
+    static const char busy[] = "HTTP/1.1 503 Service Unavailable\r\n"
+                               "Content-Type: text/plain\r\n"
+                               "Content-Length: 12\r\n"
+                               "Retry-After: 1\r\n"
+                               "Connection: close\r\n"
+                               "\r\n"
+                               "Server busy\n";
+    // Read what already arrived: closing on unread data sends a reset, which
+    // can overtake the 503
+    char drain[256];
+    (void) recv(fd, drain, sizeof(drain), MSG_DONTWAIT);
+    (void) ::send(fd, busy, sizeof(busy) - 1, MSG_DONTWAIT | MSG_NOSIGNAL);
+    shutdown(fd, SHUT_WR);
+    close(fd);
+    stats_.rejected++;
+  }
+
+  void receive(Conn& c) {
+    const ssize_t n = recv(c.fd, c.in + c.inLen, HTTP_REQUEST_BYTES - 1 - c.inLen, 0);
+    if (n < 0 && wouldBlock()) return;
+    if (n <= 0) {
+      closeConn(c);
+      return;
+    }
+    if (c.inLen == 0) c.sinceUs = halPerfMicros();   // the head timeout runs from its first byte
+    c.inLen += n;
+    serve(c);
+  }
+
+  // Answer every complete request in the buffer, for as long as the socket
+  // takes the responses
+  void serve(Conn& c) {
+    while (c.fd >= 0 && c.state == READING && c.inLen > 0) {
+      c.in[c.inLen] = '\0';
+      char* headEnd = strstr(c.in, "\r\n\r\n");
+      if (!headEnd) {
+        if (c.inLen >= HTTP_REQUEST_BYTES - 1) {
+          static const char tooLarge[] = "Request head too large\n";
+          c.inLen = 0;
+          respondError(c, 431, tooLarge, sizeof(tooLarge) - 1);
+          if (flush(c)) finish(c);
+        }
+        return;
+      }
+      const size_t headLen = headEnd + 4 - c.in;
+      handle(c, headEnd);
+      if (c.fd < 0) return;                    // detached, or a write failed
+      memmove(c.in, c.in + headLen, c.inLen - headLen);
+      c.inLen -= headLen;
+      if (!flush(c) || !finish(c)) return;
+    }
+  }
+
+  // Parse the head in place (its strings live until the next request) and run
+  // the route's handler; the response is left in the slot for flush()
+  void handle(Conn& c, char* headEnd) {
+    headEnd[2] = '\0';                         // every line keeps its CRLF
+    char* eol = strstr(c.in, "\r\n");
+    *eol = '\0';
+
+    // "GET /path?query HTTP/1.1"
+    char* target  = strchr(c.in, ' ');
+    char* version = target ? strchr(target + 1, ' ') : nullptr;
+    if (!version) {
+      static const char bad[] = "Bad request\n";
+      respondError(c, 400, bad, sizeof(bad) - 1);
+      return;
+    }
+    *target++  = '\0';
+    *version++ = '\0';
+    char* q = strchr(target, '?');
+    query_ = "";
+    if (q) {
+      *q = '\0';
+      query_ = q + 1;
+    }
+
+    c.keepAlive = strcmp(version, "HTTP/1.1") == 0;
+    bool hasBody = false;
+    headerCount_ = 0;
+    for (char* line = eol + 2; *line; line = eol + 2) {
+      eol = strstr(line, "\r\n");
+      *eol = '\0';
+      char* colon = strchr(line, ':');
+      if (!colon) continue;
+      *colon = '\0';
+      char* v = colon + 1;
+      while (*v == ' ' || *v == '\t') v++;
+      if (headerCount_ < HTTP_MAX_HEADERS) headers_[headerCount_++] = { line, v };
+
+      if (strcasecmp(line, "Connection") == 0) {
+        if (hasToken(v, "close"))      c.keepAlive = false;
+        if (hasToken(v, "keep-alive")) c.keepAlive = true;
+      } else if (strcasecmp(line, "Transfer-Encoding") == 0 ||
+                 (strcasecmp(line, "Content-Length") == 0 && atol(v) > 0)) {
+        hasBody = true;
+      }
+    }
+    if (hasBody) c.keepAlive = false;          // the body is never read
+
+    handled_++;
+    if (++c.requests > 1) stats_.reused++;
+    run(c, target);
+  }
+
+  // Queue an error response; the connection closes once it is out
+  void respondError(Conn& c, int code, const char* text, size_t len) {
+    c.keepAlive = false;
+    cur_ = &c;
+    respHeadersLen_ = 0;
+    send(code, "text/plain", text, len);
+    cur_ = nullptr;
+    c.state   = WRITING;
+    c.sinceUs = halPerfMicros();
+  }
+
+  void run(Conn& c, const char* path) {
+    c.failed = false;
+    cur_ = &c;
+    dispatch(path);
+    cur_ = nullptr;
+    if (c.fd < 0) return;                      // detached
+    if (c.failed) {
+      closeConn(c);
+      return;
+    }
+    c.state   = WRITING;
+    c.sinceUs = halPerfMicros();
+  }
+
+  void dispatch(const char* path) {
+    chunked_        = false;
+    respHeadersLen_ = 0;
+    stats_.requests++;
+    for (int i = 0; i < routeCount_; i++) {
+      if (strcmp(routes_[i].path, path) == 0) {
+        routes_[i].handler();
+        return;
+      }
+    }
+    static const char notFound[] = "Not found\n";
+    send(404, "text/plain", notFound, sizeof(notFound) - 1);
+  }
+
+  // Send what the socket takes now. True once the whole response is out;
+  // false while it is still pending, or if the connection was closed.
+  bool flush(Conn& c) {
+    while (c.outSent < c.outLen) {
+      if (!sendSome(c, c.out + c.outSent, c.outLen - c.outSent, &c.outSent)) return false;
+    }
+    while (c.bodySent < c.bodyLen) {
+      if (!sendSome(c, c.body + c.bodySent, c.bodyLen - c.bodySent, &c.bodySent)) return false;
+    }
+    return true;
+  }
+
+  bool sendSome(Conn& c, const void* data, size_t len, size_t* sent) {
+    const ssize_t n = ::send(c.fd, data, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (n > 0) {
+      *sent += n;
+      c.sinceUs = halPerfMicros();
+      return true;
+    }
+    if (n < 0 && wouldBlock()) return false;
+    closeConn(c);
+    return false;
+  }
+
+  // Response sent: keep the connection for the next request, or close it.
+  // False if it was closed.
+  bool finish(Conn& c) {
+    if (!c.keepAlive) {
+      closeConn(c);
+      return false;
+    }
+    c.state   = READING;
+    c.outLen  = c.outSent = 0;
+    c.body    = nullptr;
+    c.bodyLen = c.bodySent = 0;
+    c.sinceUs = halPerfMicros();
+    return true;
+  }
+
+  void expire() {
+    const uint32_t now = halPerfMicros();
+    for (Conn& c : pool_) {
+      if (c.fd < 0 || now - c.sinceUs < timeoutUs(c)) continue;
+      // An idle keep-alive connection running out is routine; anything else
+      // is a client that stalled
+      if (c.state == WRITING || c.inLen > 0 || c.requests == 0) stats_.timedOut++;
+      closeConn(c);
+    }
+  }
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Response output
+  // ────────────────────────────────────────────────────────────────────────────
+  // Status line + headers. `length` < 0 means chunked.
+  void sendStatus(int code, const char* contentType, long length) {
+    char h[sizeof(respHeaders_) + 256];
+    int n = snprintf(h, sizeof(h), "HTTP/1.1 %d %s\r\n", code, reasonPhrase(code));
+    if (contentType) n += snprintf(h + n, sizeof(h) - n, "Content-Type: %s\r\n", contentType);
+    if (length >= 0) n += snprintf(h + n, sizeof(h) - n, "Content-Length: %ld\r\n", length);
+    else             n += snprintf(h + n, sizeof(h) - n, "Transfer-Encoding: chunked\r\n");
+    const bool keepAlive = cur_ && cur_->keepAlive;
+    n += snprintf(h + n, sizeof(h) - n, "%.*s%s\r\n", (int) respHeadersLen_, respHeaders_,
+                  keepAlive ? "Connection: keep-alive\r\nKeep-Alive: timeout=5\r\n"
+                            : "Connection: close\r\n");
+    respHeadersLen_ = 0;
+    emit(h, n < (int) sizeof(h) ? (size_t) n : sizeof(h) - 1);
+  }
+
+  // Into the slot's buffer; when it fills up, out to the socket synchronously
+  void emit(const void* data, size_t len) {
+    if (sink_) {
+      sink_(sinkCtx_, data, len);
+      return;
+    }
+    Conn& c = *cur_;
+    if (c.failed || len == 0) return;
+    if (c.outLen + len > HTTP_RESPONSE_BYTES) {
+      if (!writeAll(c.fd, c.out, c.outLen)) {
+        c.failed = true;
+        return;
+      }
+      c.outLen = 0;
+      if (len > HTTP_RESPONSE_BYTES) {
+        if (!writeAll(c.fd, data, len)) c.failed = true;
+        return;
+      }
+    }
+    memcpy(c.out + c.outLen, data, len);
+    c.outLen += len;
+  }
+
+  static bool writeAll(int fd, const void* data, size_t len) {
+    const char* p = (const char*) data;
+    while (len > 0) {
+      const ssize_t n = ::send(fd, p, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+      if (n > 0) {
+        p   += n;
+        len -= n;
+        continue;
+      }
+      if (n < 0 && !wouldBlock()) return false;
+      pollfd pfd = { fd, POLLOUT, 0 };
+      if (poll(&pfd, 1, HTTP_WRITE_TIMEOUT_MS) <= 0) return false;
+    }
+    return true;
+  }
+
+  int       listenFd_ = -1;
+  Route     routes_[HTTP_MAX_ROUTES];
+  int       routeCount_ = 0;
+  Conn      pool_[HTTP_POOL_SIZE];
+  int       streams_[HAL_MAX_STREAMS];
+
+  // The request being handled
+  Conn*       cur_ = nullptr;               // nullptr for an in-memory request
+  Sink        sink_ = nullptr;
+  void*       sinkCtx_ = nullptr;
+  const char* query_ = "";
+  Header      headers_[HTTP_MAX_HEADERS];
+  int         headerCount_ = 0;
+  char        respHeaders_[512];            // queued by sendHeader()
+  size_t      respHeadersLen_ = 0;
+  bool        chunked_ = false;
+  char        memTarget_[512];
+  int         handled_ = 0;
+
+  struct {
+    uint32_t accepted = 0, rejected = 0, timedOut = 0, evicted = 0, requests = 0, reused = 0;
+  } stats_;
+};
@@ -0,0 +1,319 @@
+#pragma once
+// Generated by tools/embed_page.py from web/index.html — do not edit.
+// 19645 bytes of HTML, 4930 bytes gzipped.
+#include <stdint.h>
+#include <stddef.h>
+
+static const char     INDEX_HTML_ETAG[]  = "\"c05f1bc7c933ac06\"";
+static const size_t   INDEX_HTML_GZ_LEN  = 4930;
+static const uint8_t  INDEX_HTML_GZ[]    = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xdd, 0x5c, 0xeb, 0x72, 0xdb, 0x38,
+  0x96, 0xfe, 0x9f, 0xa7, 0x40, 0x2b, 0x95, 0x26, 0x95, 0x16, 0xa9, 0xbb, 0xec, 0xc8, 0x92, 0xbb,
+  0x13, 0xc7, 0xd9, 0xce, 0x54, 0x6e, 0x3b, 0xf6, 0x6c, 0xef, 0x56, 0x2a, 0x35, 0x45, 0x91, 0x90,
+  0x84, 0x09, 0x45, 0x72, 0x09, 0xc8, 0xb2, 0xa6, 0x27, 0x55, 0xf3, 0x6b, 0x1e, 0x60, 0xff, 0xec,
+  0x9f, 0xdd, 0x77, 0xe8, 0x67, 0xe8, 0x7d, 0x93, 0x7e, 0x92, 0x3d, 0x07, 0x20, 0x25, 0x5e, 0x40,
+  0x4a, 0x4e, 0x9c, 0xae, 0xda, 0x75, 0x25, 0x31, 0x45, 0x00, 0x07, 0x07, 0x07, 0xdf, 0xb9, 0x02,
+  0xca, 0xe4, 0x9b, 0xe7, 0x6f, 0x2f, 0xae, 0xff, 0xed, 0xdd, 0x25, 0x59, 0x8a, 0x95, 0x7f, 0xfe,
+  0x60, 0x82, 0xbf, 0x88, 0xef, 0x04, 0x8b, 0x69, 0x83, 0x06, 0x0d, 0x7c, 0x41, 0x1d, 0xef, 0xfc,
+  0x01, 0x81, 0x9f, 0xc9, 0x8a, 0x0a, 0x87, 0xb8, 0x4b, 0x27, 0xe6, 0x54, 0x4c, 0x1b, 0x7f, 0xba,
+  0x7e, 0x61, 0x9d, 0x36, 0xb2, 0x4d, 0x81, 0xb3, 0xa2, 0xd3, 0xc6, 0x0d, 0xa3, 0x9b, 0x28, 0x8c,
+  0x45, 0x83, 0xb8, 0x61, 0x20, 0x68, 0x00, 0x5d, 0x37, 0xcc, 0x13, 0xcb, 0xa9, 0x47, 0x6f, 0x98,
+  0x4b, 0x2d, 0xf9, 0xa1, 0x45, 0x58, 0xc0, 0x04, 0x73, 0x7c, 0x8b, 0xbb, 0x8e, 0x4f, 0xa7, 0x5d,
+  0xbb, 0x93, 0x92, 0x12, 0x4c, 0xf8, 0xf4, 0xfc, 0x5d, 0x28, 0x1c, 0x11, 0x92, 0x2b, 0x1a, 0xf0,
+  0x30, 0x9e, 0xb4, 0xd5, 0x4b, 0xd5, 0x81, 0x8b, 0x6d, 0xfa, 0x8c, 0x3f, 0x3f, 0xb0, 0x15, 0x4e,
+  0x47, 0xd6, 0xb1, 0x6f, 0x1a, 0x4b, 0x21, 0x22, 0x3e, 0x6e, 0xb7, 0xe7, 0x30, 0x35, 0xb7, 0x17,
+  0x61, 0xb8, 0xf0, 0xa9, 0x13, 0x31, 0x6e, 0xbb, 0xe1, 0xaa, 0xed, 0x72, 0xde, 0xfb, 0x7e, 0xee,
+  0xac, 0x98, 0xbf, 0x9d, 0xbe, 0x04, 0xd6, 0xe2, 0xf1, 0x66, 0xb1, 0x14, 0x3f, 0x0c, 0x3a, 0x9d,
+  0xb3, 0x21, 0xfc, 0x1d, 0xc1, 0xdf, 0x93, 0x4e, 0xe7, 0x5b, 0x8f, 0xf1, 0xc8, 0x77, 0xb6, 0x53,
+  0xbe, 0x71, 0x22, 0xa3, 0x79, 0xb6, 0x9b, 0x68, 0xf7, 0xf0, 0x98, 0xfc, 0xbc, 0x7b, 0xc6, 0x9f,
+  0x95, 0x13, 0x2f, 0x58, 0x30, 0x26, 0x9d, 0xb3, 0xdc, 0xeb, 0xc8, 0xf1, 0x3c, 0x16, 0x2c, 0x4a,
+  0xef, 0x67, 0xe1, 0xad, 0xc5, 0xd9, 0x5f, 0x65, 0xd3, 0x2c, 0x8c, 0x3d, 0x1a, 0x5b, 0xf0, 0x6a,
+  0xdf, 0xe7, 0x53, 0x79, 0xc6, 0x59, 0xe8, 0x6d, 0x0b, 0x93, 0xe2, 0x0a, 0x2d, 0xb5, 0x98, 0x31,
+  0x31, 0xe4, 0x72, 0x8c, 0x16, 0xe1, 0x4e, 0xc0, 0x2d, 0x4e, 0x63, 0x36, 0x2f, 0xcc, 0xe9, 0xb8,
+  0x1f, 0x17, 0x71, 0xb8, 0x0e, 0xbc, 0x31, 0xf1, 0x59, 0x40, 0x9d, 0xd8, 0x5a, 0xc4, 0x8e, 0xc7,
+  0x60, 0x7b, 0xcc, 0x6e, 0x7f, 0xe8, 0xd1, 0x45, 0x8b, 0x3c, 0x9c, 0xcf, 0xbd, 0x11, 0x3d, 0x25,
+  0x9d, 0x47, 0xf0, 0x4c, 0x4f, 0xe7, 0x83, 0xb9, 0x47, 0xba, 0x9d, 0xce, 0xa3, 0x66, 0x9e, 0xd4,
+  0x8a, 0x05, 0xd6, 0x92, 0x32, 0x90, 0xdc, 0x18, 0x9b, 0x6f, 0x96, 0xf9, 0xe6, 0x44, 0x7a, 0x63,
+  0x32, 0xf7, 0xe9, 0x6d, 0xbe, 0xc9, 0xf1, 0xd9, 0x22, 0xb0, 0x98, 0xa0, 0x2b, 0x3e, 0x26, 0x2e,
+  0x45, 0x96, 0xf3, 0x1d, 0xfe, 0xb2, 0xe6, 0x82, 0xcd, 0xb7, 0x56, 0x02, 0x1c, 0x7d, 0xa7, 0x9d,
+  0x58, 0xbb, 0xc3, 0xa8, 0x5e, 0x6a, 0x36, 0xd2, 0x71, 0x60, 0xb5, 0x71, 0x69, 0xc3, 0x6e, 0x15,
+  0x0c, 0xc7, 0x04, 0x36, 0x3c, 0x2a, 0xb0, 0x99, 0xb4, 0xe0, 0xd2, 0xeb, 0xc9, 0xa3, 0x6a, 0x94,
+  0x68, 0xcb, 0x7d, 0x81, 0xed, 0xa5, 0x40, 0xbb, 0x57, 0x24, 0x2d, 0x1b, 0x37, 0x89, 0xf0, 0x10,
+  0x6f, 0xb9, 0x56, 0x37, 0xf4, 0xc3, 0x78, 0x4c, 0x1e, 0x5e, 0x9c, 0x9e, 0x8e, 0x3a, 0xcf, 0xcf,
+  0x34, 0x18, 0x03, 0xa0, 0x08, 0x11, 0xae, 0xc6, 0x64, 0x50, 0xe2, 0xfa, 0xab, 0xcb, 0x7d, 0xe1,
+  0x44, 0x63, 0xd2, 0x2b, 0xcd, 0x8b, 0xd3, 0x59, 0x9b, 0x18, 0x1b, 0xf1, 0xdf, 0x7a, 0x89, 0x45,
+  0x52, 0xab, 0x2d, 0x06, 0x13, 0x15, 0xc4, 0x96, 0x0a, 0x7d, 0x58, 0x9a, 0x60, 0x87, 0xb5, 0x61,
+  0xf5, 0x9a, 0x59, 0x80, 0xa0, 0xb6, 0x66, 0x7e, 0xe8, 0x7e, 0xd4, 0xb0, 0xc7, 0x97, 0x31, 0x0b,
+  0x3e, 0xe6, 0x14, 0x51, 0xc7, 0xdd, 0x86, 0x3a, 0x62, 0x09, 0xda, 0xe8, 0x3a, 0xb1, 0x57, 0x60,
+  0x2f, 0xab, 0x3f, 0xf1, 0x62, 0xe6, 0x98, 0xbd, 0xe1, 0xb0, 0x45, 0xf6, 0xff, 0x74, 0xec, 0x27,
+  0xcd, 0xb2, 0xc6, 0x79, 0x71, 0x18, 0x59, 0x73, 0xe6, 0xa3, 0xa9, 0x21, 0x33, 0x7f, 0x1d, 0x9b,
+  0x5d, 0x58, 0x43, 0xb1, 0xa3, 0x32, 0x01, 0xa8, 0x8d, 0x6b, 0xd8, 0x9f, 0x7e, 0x09, 0x34, 0x3b,
+  0xc0, 0x9f, 0x94, 0x04, 0x20, 0x4d, 0xc9, 0xd2, 0xf1, 0xc2, 0x0d, 0x2c, 0x4e, 0x6e, 0x8e, 0x44,
+  0x86, 0x62, 0xb1, 0x03, 0x6c, 0xa9, 0x3f, 0x76, 0x57, 0x3b, 0x27, 0xc8, 0x14, 0xfa, 0xf2, 0xd0,
+  0x67, 0x5e, 0xc5, 0xa2, 0x7a, 0xcd, 0x7a, 0x89, 0x81, 0xd9, 0x8f, 0x99, 0xcb, 0xad, 0x2a, 0x45,
+  0xdb, 0x6d, 0xd0, 0x22, 0x66, 0x5e, 0x01, 0x4e, 0xf0, 0xc6, 0x02, 0x48, 0x42, 0xbb, 0xa0, 0x40,
+  0xc0, 0x5f, 0xaf, 0x02, 0x58, 0x7e, 0x77, 0x1e, 0xe3, 0x5f, 0x0d, 0xf4, 0x4e, 0x4b, 0xab, 0x2f,
+  0xe8, 0x44, 0x1e, 0x9b, 0xd5, 0xec, 0x82, 0x7d, 0x74, 0x05, 0x03, 0x04, 0x2e, 0x7b, 0xd5, 0xba,
+  0x3b, 0xf8, 0x4c, 0xdd, 0xed, 0xb9, 0x7d, 0x3a, 0xec, 0xd4, 0xf3, 0x39, 0x3c, 0x92, 0xcf, 0x38,
+  0xdc, 0x54, 0xc9, 0xb3, 0xac, 0xe4, 0x25, 0x1d, 0xe6, 0x91, 0x03, 0xde, 0x76, 0x46, 0xc5, 0x86,
+  0xd2, 0xe0, 0x8e, 0x06, 0xa1, 0xc0, 0x71, 0x77, 0x74, 0x24, 0xc7, 0xbe, 0x33, 0xa3, 0x7e, 0xb5,
+  0x50, 0x7b, 0x83, 0x5a, 0xa1, 0x0e, 0xab, 0x84, 0x7a, 0x3a, 0x7b, 0xe2, 0xce, 0x86, 0x47, 0x71,
+  0x70, 0xe3, 0xf8, 0x6b, 0xfa, 0xd9, 0x1c, 0x1c, 0xbd, 0xad, 0x5a, 0x6f, 0xb3, 0x8e, 0x63, 0x90,
+  0xa5, 0x62, 0x81, 0xff, 0xae, 0x9a, 0x50, 0xbb, 0xa1, 0x75, 0xbc, 0x2e, 0xd7, 0x2b, 0xe6, 0x31,
+  0x51, 0x0c, 0x2e, 0x04, 0xbd, 0x15, 0x96, 0x24, 0x5a, 0x8b, 0x0f, 0x11, 0x02, 0x37, 0xfd, 0x83,
+  0x6a, 0x97, 0x4e, 0x86, 0x6b, 0xa4, 0xb1, 0x23, 0xd6, 0x31, 0xfd, 0x5d, 0xe6, 0x3b, 0x80, 0x85,
+  0x27, 0xa3, 0x5a, 0x2c, 0x9c, 0x14, 0xb1, 0x20, 0x5d, 0xcc, 0xce, 0x1b, 0x1d, 0x08, 0x0d, 0x12,
+  0xb9, 0x6a, 0x79, 0x48, 0x41, 0x35, 0x78, 0xfa, 0xa4, 0x73, 0xd9, 0xab, 0x27, 0x94, 0x91, 0x59,
+  0x2d, 0xad, 0x17, 0x2f, 0x46, 0xcf, 0x46, 0xcf, 0x0e, 0xf8, 0x37, 0x16, 0x80, 0xa7, 0xb0, 0x22,
+  0xe6, 0x7e, 0xac, 0xb6, 0xd4, 0x47, 0x58, 0x96, 0xca, 0xe8, 0xe0, 0xb4, 0xc2, 0x42, 0x6b, 0xf7,
+  0xad, 0x8a, 0xaf, 0xd9, 0x1a, 0x8c, 0x4e, 0xa0, 0xd9, 0x36, 0x74, 0xf3, 0xe0, 0x9e, 0x99, 0x38,
+  0xab, 0xda, 0xd1, 0xee, 0x3d, 0xd9, 0x97, 0xa2, 0xc7, 0x0f, 0xc2, 0x80, 0x1e, 0x72, 0xa0, 0x0f,
+  0xbd, 0xa1, 0xe7, 0xd1, 0xd3, 0x5a, 0xdf, 0xde, 0x1d, 0x55, 0xfa, 0x76, 0xe0, 0x5c, 0xc3, 0x3e,
+  0x20, 0x99, 0x23, 0x87, 0x51, 0xc8, 0x8a, 0x3a, 0x5d, 0x2f, 0x3e, 0xdb, 0x01, 0x17, 0x77, 0x53,
+  0x05, 0x96, 0xf9, 0xbc, 0x26, 0x3d, 0xd0, 0x86, 0x9f, 0xc9, 0x42, 0xaa, 0x22, 0xd4, 0x2c, 0x3b,
+  0x02, 0x74, 0xcf, 0xab, 0x42, 0x97, 0x26, 0x42, 0xd3, 0x86, 0xdb, 0xb9, 0xc0, 0xaf, 0xd2, 0xf3,
+  0x4b, 0x5c, 0xe5, 0x4d, 0x7a, 0x96, 0x93, 0x28, 0x0e, 0x67, 0x25, 0x43, 0x5c, 0x39, 0x5d, 0x35,
+  0x56, 0xf3, 0x02, 0xf0, 0x9d, 0x88, 0x03, 0xd6, 0xd2, 0xa7, 0x6a, 0x30, 0x96, 0x36, 0xbb, 0xda,
+  0x99, 0x94, 0x78, 0x16, 0xcb, 0x6a, 0xbb, 0xd5, 0xed, 0xdf, 0x1f, 0xca, 0xb3, 0x86, 0x37, 0xc6,
+  0xf1, 0x35, 0xf0, 0x1c, 0x1d, 0x90, 0xb3, 0xf0, 0x6a, 0xac, 0x7a, 0x1d, 0xf1, 0x51, 0x85, 0xb0,
+  0xe5, 0x56, 0x64, 0x34, 0x8c, 0x7a, 0xf3, 0xee, 0x7c, 0x74, 0x40, 0x6e, 0xe3, 0x39, 0x8b, 0xb9,
+  0xb0, 0xdc, 0x25, 0xf3, 0xbd, 0x56, 0x86, 0xb7, 0xec, 0xfb, 0x1a, 0x3e, 0x7d, 0x3a, 0x17, 0xc7,
+  0x06, 0x08, 0x5a, 0x19, 0xd8, 0x73, 0x87, 0x81, 0xa7, 0x58, 0x1c, 0x6d, 0xa7, 0xf7, 0x34, 0x7c,
+  0x07, 0x18, 0x5c, 0x47, 0x1e, 0x84, 0x01, 0xde, 0x17, 0x38, 0x48, 0x4d, 0x8e, 0x56, 0x67, 0x22,
+  0xef, 0x10, 0x64, 0xb5, 0x1f, 0x93, 0xab, 0x55, 0x18, 0x02, 0x38, 0x45, 0xec, 0x04, 0x9c, 0x61,
+  0x14, 0xcd, 0x81, 0x7a, 0x4c, 0x94, 0x6b, 0x72, 0x97, 0x4e, 0xb0, 0x00, 0x29, 0x3c, 0x6e, 0x57,
+  0x38, 0xe3, 0x56, 0x6d, 0x9c, 0xb6, 0x27, 0x3a, 0x86, 0x88, 0xc6, 0x87, 0xfc, 0xa3, 0xcf, 0x09,
+  0x75, 0xb2, 0x3a, 0xa6, 0x67, 0xea, 0x32, 0x80, 0x89, 0x5d, 0x10, 0x5a, 0x4c, 0x79, 0x04, 0x2c,
+  0xa1, 0xe5, 0xf3, 0x28, 0x07, 0x69, 0x65, 0x59, 0xf9, 0x61, 0x45, 0x3d, 0xe6, 0x10, 0x33, 0x9b,
+  0xfd, 0x8f, 0xc0, 0x65, 0x35, 0x0b, 0x6c, 0xd4, 0xe5, 0x81, 0x79, 0xa5, 0xc0, 0x54, 0x2b, 0x1f,
+  0xcd, 0xe7, 0x79, 0xcc, 0xf1, 0x79, 0x54, 0xc2, 0xb4, 0x73, 0xa5, 0xe5, 0x64, 0xb7, 0x8e, 0x6c,
+  0x6d, 0xe8, 0x79, 0x1f, 0x34, 0x35, 0x24, 0x6b, 0x0b, 0x1d, 0x87, 0x65, 0x50, 0x9d, 0x85, 0x15,
+  0x88, 0xf7, 0xef, 0x44, 0x5c, 0x5b, 0x93, 0x29, 0xe6, 0x76, 0xa7, 0x77, 0xa1, 0x58, 0x5d, 0xb3,
+  0xc8, 0xba, 0x93, 0xb2, 0xd2, 0xe5, 0x5c, 0x58, 0xaf, 0x46, 0xf4, 0x1a, 0x4c, 0x6b, 0xa0, 0x3a,
+  0x40, 0x2f, 0x58, 0x84, 0xaa, 0xa6, 0x2e, 0x58, 0x2a, 0x91, 0x11, 0xac, 0x39, 0x48, 0x8f, 0x26,
+  0x9f, 0xca, 0x4c, 0xe6, 0x92, 0x07, 0x55, 0x2f, 0x11, 0x4e, 0x2c, 0xca, 0x1d, 0x0f, 0x54, 0xfe,
+  0xf2, 0x81, 0x84, 0xe5, 0x08, 0xe1, 0xb8, 0xcb, 0x95, 0x8c, 0x18, 0xe7, 0xec, 0x96, 0x7a, 0x77,
+  0x80, 0x5e, 0x8d, 0x76, 0x54, 0xfa, 0xef, 0x22, 0x87, 0xae, 0xe3, 0xbb, 0xa6, 0x64, 0x93, 0x58,
+  0x64, 0x30, 0x2c, 0xd5, 0x5d, 0x0e, 0x44, 0xbd, 0xbb, 0xe2, 0x91, 0xc7, 0x62, 0x85, 0x54, 0xe9,
+  0xf3, 0x21, 0x37, 0x2b, 0xf7, 0x2b, 0x45, 0xc8, 0x55, 0x52, 0xfc, 0x52, 0xe4, 0xf6, 0x47, 0xd1,
+  0x17, 0xb0, 0x29, 0x8d, 0x40, 0x77, 0xa8, 0x23, 0x51, 0x5b, 0xa2, 0x38, 0xce, 0xc9, 0x7c, 0xb9,
+  0x0e, 0x75, 0xea, 0x75, 0xa8, 0x73, 0xa7, 0x29, 0x8f, 0x35, 0xe2, 0x52, 0x31, 0xf6, 0x95, 0x33,
+  0xbd, 0x1e, 0x17, 0xe2, 0xf8, 0x72, 0x15, 0xe1, 0x60, 0x39, 0x2a, 0xbb, 0x57, 0xb9, 0xec, 0xf1,
+  0x1e, 0xa1, 0xf8, 0xc5, 0x8e, 0xa7, 0xb2, 0x10, 0x51, 0x81, 0xa5, 0xfe, 0xf0, 0xb3, 0xe5, 0x70,
+  0x28, 0xa0, 0xf9, 0x22, 0x6f, 0xb7, 0x93, 0x65, 0x39, 0x71, 0xbb, 0x27, 0x8f, 0x37, 0x1a, 0x7c,
+  0x45, 0x8f, 0xd7, 0x3b, 0xfd, 0x2c, 0xb1, 0x1e, 0xc1, 0x81, 0xac, 0xcf, 0xd5, 0x07, 0x61, 0x45,
+  0x5e, 0xbe, 0xd8, 0x71, 0xf5, 0x4f, 0x86, 0x9a, 0x18, 0xeb, 0x0e, 0xb2, 0x1e, 0x8e, 0xee, 0x3b,
+  0x00, 0x28, 0x87, 0x14, 0x45, 0xf3, 0xd6, 0x1d, 0x7e, 0xcd, 0xfd, 0x1d, 0xfc, 0x2e, 0x5b, 0xd7,
+  0x3d, 0xfd, 0x1a, 0xf6, 0xb2, 0x27, 0x43, 0x0a, 0xfc, 0xa7, 0x9f, 0x3e, 0x1d, 0x3d, 0xc9, 0xc1,
+  0x70, 0x25, 0x0d, 0x52, 0x92, 0x59, 0xee, 0x86, 0x3d, 0x48, 0x04, 0x5e, 0xb0, 0x5b, 0x95, 0x8e,
+  0xd0, 0x78, 0x4b, 0x04, 0xe6, 0x10, 0xd1, 0x12, 0x4c, 0x00, 0x27, 0x2c, 0x20, 0x78, 0x48, 0x1c,
+  0x3b, 0x4c, 0x54, 0xa5, 0x04, 0xcb, 0x7d, 0xdd, 0x0f, 0xf1, 0xea, 0x04, 0xde, 0x67, 0xc7, 0x5f,
+  0x47, 0x47, 0x54, 0xc9, 0xca, 0x0f, 0xbb, 0x54, 0xf5, 0x34, 0x69, 0x27, 0x67, 0xdf, 0x93, 0xb6,
+  0x3a, 0x96, 0x9f, 0x20, 0x03, 0xc9, 0xb1, 0xb8, 0xc7, 0x6e, 0x88, 0x0b, 0x29, 0x24, 0x9f, 0x36,
+  0x76, 0x46, 0xbe, 0xb1, 0x3f, 0x26, 0x9f, 0x2c, 0xbb, 0x69, 0xb3, 0x52, 0x91, 0x4c, 0x9b, 0x3a,
+  0x56, 0xbf, 0x59, 0xa4, 0x1d, 0x32, 0xee, 0xba, 0x41, 0xf0, 0x3c, 0xff, 0x59, 0x78, 0x3b, 0x6d,
+  0x74, 0x48, 0x07, 0x9d, 0x30, 0xfe, 0x6d, 0x90, 0xdb, 0x95, 0x1f, 0x20, 0x29, 0x21, 0xa2, 0x71,
+  0xbb, 0xbd, 0xd9, 0x6c, 0xec, 0x4d, 0xdf, 0x0e, 0xe3, 0x45, 0xbb, 0xd7, 0xe9, 0x74, 0xda, 0x40,
+  0xab, 0x40, 0x5e, 0x4e, 0xf1, 0x8d, 0x65, 0x91, 0xe4, 0x60, 0x5f, 0x4a, 0xce, 0xb2, 0x34, 0x9d,
+  0xa8, 0xef, 0xb3, 0x88, 0x43, 0x32, 0x09, 0x53, 0x0e, 0x61, 0x26, 0x77, 0x0b, 0xbf, 0x87, 0x0d,
+  0x12, 0xc3, 0xe7, 0xde, 0x29, 0xfc, 0x86, 0xcf, 0x7d, 0xf8, 0x3c, 0x67, 0xbe, 0x3f, 0x6d, 0x3c,
+  0x7c, 0x3e, 0x78, 0x3a, 0x3c, 0x19, 0x34, 0x08, 0x17, 0x71, 0xf8, 0x91, 0xc2, 0x8b, 0x67, 0xa7,
+  0x4f, 0x86, 0xa3, 0xa7, 0xe9, 0x0b, 0xb5, 0x7d, 0x30, 0xb2, 0xd1, 0x2e, 0xcf, 0x55, 0xcb, 0x21,
+  0xdd, 0x02, 0x6e, 0x4c, 0x9f, 0x09, 0xe1, 0x53, 0x02, 0x69, 0xa5, 0xe0, 0xcd, 0xc3, 0x0c, 0x0f,
+  0x12, 0x86, 0x07, 0x09, 0xc3, 0x7d, 0xc5, 0x6f, 0x6f, 0xc7, 0xee, 0xe9, 0xb3, 0x93, 0x3e, 0xac,
+  0xa6, 0x7d, 0x80, 0xce, 0x28, 0xa5, 0xd3, 0x49, 0x16, 0x9e, 0xac, 0xfb, 0xae, 0x74, 0x90, 0x0f,
+  0xa4, 0x33, 0x1a, 0xe6, 0xe8, 0xdc, 0x99, 0x9f, 0xe1, 0xa9, 0xa2, 0x73, 0xd2, 0xb9, 0xf3, 0xba,
+  0xf4, 0x42, 0xbe, 0x58, 0x0b, 0x4a, 0xe6, 0x8e, 0x4b, 0xf5, 0x32, 0x75, 0x59, 0xec, 0xfa, 0xc9,
+  0x12, 0x7a, 0x09, 0x06, 0x70, 0xea, 0xec, 0x94, 0xa3, 0xe1, 0xa0, 0xdf, 0xeb, 0x6a, 0x59, 0xcf,
+  0x0c, 0x4f, 0x39, 0xbf, 0xcb, 0xf0, 0x08, 0x4c, 0x21, 0xf1, 0xa6, 0x8d, 0xd7, 0x64, 0x30, 0x22,
+  0xa3, 0x0e, 0xf9, 0x67, 0x48, 0x9d, 0xc9, 0x68, 0x48, 0x86, 0x03, 0x82, 0x1b, 0xb3, 0x83, 0x5a,
+  0x42, 0xa2, 0x04, 0xb5, 0x64, 0x0a, 0x8c, 0x3e, 0x76, 0x8d, 0x78, 0x7a, 0xe0, 0x3a, 0xd1, 0xb4,
+  0x21, 0xb3, 0xa3, 0xe3, 0x05, 0x75, 0xb5, 0x42, 0x33, 0xb6, 0x04, 0xdb, 0xe4, 0xa3, 0x7d, 0x3a,
+  0x02, 0x82, 0xc9, 0x96, 0xa3, 0xdc, 0x70, 0xab, 0x06, 0x6a, 0xab, 0x46, 0xbb, 0x85, 0x5f, 0x9e,
+  0x5e, 0x0c, 0x9e, 0x80, 0x82, 0x84, 0x91, 0xe3, 0x32, 0x01, 0x4d, 0x1d, 0xfb, 0xa4, 0xc8, 0xcf,
+  0x04, 0x55, 0x38, 0xff, 0x2a, 0x77, 0x23, 0x67, 0x6f, 0x56, 0xda, 0xcb, 0xee, 0x79, 0xd9, 0x16,
+  0x67, 0xad, 0x51, 0xd6, 0xb3, 0x14, 0x8d, 0x4e, 0xa6, 0x5b, 0x29, 0x42, 0xd5, 0x59, 0x90, 0x52,
+  0xff, 0xd4, 0xe9, 0x6a, 0x3a, 0x2b, 0xab, 0xd7, 0x3b, 0xff, 0x31, 0x39, 0x8b, 0x01, 0x56, 0x7b,
+  0x15, 0xbd, 0xca, 0x64, 0xe3, 0x70, 0x53, 0x41, 0x52, 0x19, 0xcb, 0xc8, 0x09, 0x0a, 0x23, 0xa4,
+  0x83, 0x6e, 0x9c, 0xff, 0x08, 0xbb, 0x04, 0xd2, 0x83, 0xf6, 0xbb, 0x0d, 0x97, 0x0e, 0xbd, 0x41,
+  0x18, 0xc0, 0x6e, 0x77, 0x78, 0x84, 0xbb, 0xde, 0x38, 0xb7, 0xac, 0x47, 0x75, 0x04, 0x27, 0x6d,
+  0xe0, 0xfe, 0xeb, 0xaf, 0xeb, 0x55, 0xb8, 0xb9, 0xaf, 0x65, 0xf9, 0xc8, 0xc3, 0xfd, 0xac, 0xaa,
+  0x78, 0x8e, 0x59, 0xb7, 0x36, 0xcd, 0x30, 0x15, 0x45, 0xe5, 0x0f, 0xeb, 0x14, 0xb3, 0x65, 0xc2,
+  0x92, 0xe1, 0x6a, 0xa6, 0xf4, 0x4d, 0x15, 0xaf, 0xef, 0x07, 0xd8, 0xd7, 0xfb, 0xb3, 0xc1, 0xff,
+  0x33, 0xd8, 0xc6, 0xf4, 0x72, 0x87, 0xeb, 0x5f, 0x7f, 0xf9, 0x7f, 0x01, 0x6c, 0xb9, 0xa6, 0x04,
+  0xd4, 0xf7, 0xb2, 0x24, 0xcd, 0x81, 0xf9, 0x67, 0x01, 0xbb, 0x74, 0x78, 0x9c, 0xc7, 0x76, 0x8e,
+  0xbc, 0x62, 0xfd, 0x1e, 0xf0, 0xad, 0x79, 0xf5, 0xa0, 0xe4, 0xd5, 0x7e, 0x5a, 0x32, 0x77, 0x89,
+  0xe5, 0xba, 0x36, 0x84, 0xd8, 0x44, 0x9d, 0x60, 0x12, 0xf0, 0x12, 0x04, 0x21, 0xd6, 0x86, 0x2d,
+  0x21, 0xb0, 0x9f, 0x9c, 0xf0, 0x25, 0x3c, 0x15, 0x3d, 0x5e, 0xce, 0xb7, 0x64, 0xcf, 0x3e, 0xd5,
+  0xea, 0xf2, 0xaf, 0x34, 0x2c, 0x27, 0x07, 0xcc, 0x9e, 0x23, 0x1c, 0x4b, 0x75, 0x9e, 0x36, 0xba,
+  0x80, 0xc7, 0x2e, 0x01, 0x70, 0xab, 0xc6, 0x23, 0x47, 0xf5, 0x06, 0xcb, 0x46, 0xca, 0x89, 0x3a,
+  0x70, 0x6d, 0x9c, 0xf7, 0x06, 0x77, 0x26, 0x73, 0x02, 0x6e, 0xf1, 0x84, 0x78, 0x77, 0x1c, 0x25,
+  0x42, 0xcf, 0x01, 0xb3, 0x74, 0x8d, 0xbf, 0xf4, 0x43, 0x93, 0x9d, 0x28, 0x4b, 0x3f, 0x63, 0x38,
+  0x64, 0x9e, 0xb3, 0xbb, 0x05, 0x12, 0x42, 0xe2, 0x24, 0xb7, 0x81, 0x3b, 0x2b, 0x9a, 0x6e, 0x4b,
+  0x49, 0xfe, 0xae, 0x13, 0xdc, 0x38, 0x3c, 0x5d, 0xb8, 0x3c, 0xef, 0x4d, 0x14, 0x41, 0x3e, 0x9e,
+  0x4f, 0xda, 0xaa, 0x87, 0x6e, 0xea, 0xb7, 0x01, 0xc5, 0xad, 0x25, 0x30, 0x3f, 0x91, 0x67, 0x66,
+  0x67, 0x10, 0xdb, 0x78, 0x1e, 0x0d, 0x60, 0x36, 0x08, 0xba, 0x1c, 0xc2, 0x21, 0x1f, 0xc2, 0x80,
+  0x5b, 0x86, 0x19, 0xe5, 0xb9, 0x85, 0x33, 0xc3, 0xc0, 0x2e, 0xc9, 0x53, 0xe4, 0xa1, 0x9b, 0x9a,
+  0x3b, 0x7d, 0x56, 0xd4, 0x34, 0x32, 0x14, 0xfb, 0x9b, 0xcc, 0xe5, 0xb6, 0xf8, 0x1c, 0xda, 0xcf,
+  0xdf, 0x21, 0x8d, 0x49, 0x1b, 0x9e, 0xf0, 0x13, 0x4a, 0x69, 0xf7, 0x61, 0x1f, 0x44, 0x24, 0x2f,
+  0x00, 0xa3, 0x6d, 0x65, 0x0f, 0x93, 0x17, 0x57, 0x10, 0x1e, 0xad, 0xb9, 0xfa, 0xd8, 0x06, 0x82,
+  0x1a, 0x5d, 0xa9, 0x60, 0x61, 0x22, 0x64, 0x1a, 0x07, 0xed, 0xfb, 0x74, 0x2e, 0x33, 0x08, 0x57,
+  0x5c, 0x14, 0x65, 0x46, 0x05, 0xb2, 0xa7, 0x86, 0x4a, 0x14, 0xb9, 0x37, 0xe5, 0xe9, 0x5e, 0x41,
+  0x33, 0x49, 0x9a, 0xc7, 0xe4, 0x0d, 0x85, 0x3d, 0xaf, 0x53, 0xe0, 0xcc, 0xc7, 0x2c, 0xa0, 0x26,
+  0xdc, 0x8d, 0x59, 0x24, 0xf6, 0xfd, 0xda, 0xed, 0xbd, 0xf2, 0x26, 0xc8, 0x31, 0xe3, 0xd0, 0x97,
+  0x67, 0xa1, 0xa0, 0x5a, 0xa4, 0x4d, 0x50, 0x35, 0xe0, 0x17, 0x40, 0xbd, 0x45, 0x42, 0x85, 0x33,
+  0xbc, 0xfc, 0x1d, 0x78, 0x4e, 0x0c, 0xd0, 0xde, 0x36, 0x77, 0xa4, 0x7c, 0x2a, 0x00, 0x00, 0x3e,
+  0x38, 0x40, 0xea, 0xfd, 0xa4, 0x48, 0x4d, 0x89, 0x01, 0xda, 0x66, 0x9c, 0xe5, 0xfa, 0xe0, 0x42,
+  0x9f, 0x83, 0x4e, 0x40, 0x6b, 0xb0, 0xf6, 0xfd, 0x7d, 0xa3, 0x17, 0xba, 0x6b, 0x3c, 0x79, 0xb0,
+  0xff, 0x7d, 0x4d, 0xe3, 0xed, 0x95, 0x24, 0x15, 0xc6, 0x4f, 0x7d, 0xdf, 0x34, 0x1e, 0xea, 0xae,
+  0x4b, 0x18, 0x4d, 0x7b, 0x1e, 0xc6, 0x97, 0x8e, 0xbb, 0x34, 0x67, 0x22, 0x20, 0xd3, 0xf3, 0x62,
+  0x9e, 0x2f, 0x02, 0x1b, 0x52, 0xf5, 0xcb, 0x1b, 0xa0, 0xf9, 0x8a, 0x71, 0x41, 0x21, 0x3c, 0x35,
+  0x0d, 0xd7, 0x07, 0x1a, 0x46, 0x8b, 0x98, 0xcd, 0xf2, 0x08, 0xfc, 0x29, 0x2d, 0x01, 0xc9, 0xa0,
+  0x0e, 0x73, 0x2a, 0x92, 0x5b, 0x1b, 0x9a, 0x3a, 0xf0, 0x17, 0xb0, 0x0e, 0x6c, 0x68, 0xf1, 0x3d,
+  0xb3, 0x25, 0x56, 0x90, 0x73, 0x5b, 0x84, 0x0b, 0xd0, 0x2f, 0xd3, 0x50, 0xf6, 0x0a, 0xb8, 0x87,
+  0x51, 0x53, 0xc9, 0x5a, 0x53, 0x73, 0x40, 0xc2, 0xe6, 0x90, 0x02, 0x27, 0x52, 0x6e, 0x26, 0xa0,
+  0x51, 0x19, 0x00, 0xbe, 0xd9, 0x37, 0x69, 0x0a, 0xd6, 0x54, 0xb8, 0xcb, 0x6b, 0x34, 0x08, 0x66,
+  0xa1, 0xf5, 0x53, 0xf6, 0x52, 0x29, 0x3c, 0x67, 0x11, 0x24, 0x07, 0xc8, 0xef, 0x18, 0x88, 0xb1,
+  0x04, 0x88, 0xfa, 0xd2, 0x00, 0x48, 0x65, 0x13, 0x80, 0x4d, 0x8a, 0x7c, 0x79, 0xc6, 0xbf, 0x33,
+  0x4d, 0xe6, 0xab, 0xeb, 0xeb, 0x67, 0x4d, 0x02, 0x69, 0x89, 0x33, 0x0b, 0xd7, 0x82, 0x40, 0xc2,
+  0x95, 0xa5, 0x26, 0xaf, 0xcd, 0x28, 0x53, 0xc3, 0x6e, 0xa9, 0x9f, 0x14, 0xcd, 0x5b, 0x84, 0x43,
+  0x7f, 0x55, 0x19, 0x22, 0x01, 0xc2, 0x9f, 0x44, 0x80, 0x1e, 0x45, 0x38, 0x76, 0x36, 0x60, 0x42,
+  0x38, 0x88, 0x7c, 0xfb, 0x60, 0x7f, 0x42, 0x1e, 0x80, 0xc6, 0x48, 0xe3, 0x76, 0xa1, 0x4c, 0xdf,
+  0x74, 0xbf, 0x4d, 0x0b, 0x2a, 0x2e, 0x7d, 0x8a, 0x8f, 0xcf, 0xb6, 0x2f, 0x3d, 0xd3, 0x90, 0xdd,
+  0xb2, 0x5f, 0x1b, 0x98, 0xaf, 0x03, 0x55, 0x16, 0x94, 0x2d, 0x0a, 0x0b, 0x66, 0xb1, 0x90, 0x84,
+  0x72, 0x2e, 0xc0, 0xe5, 0x1b, 0xd8, 0x15, 0x43, 0x1a, 0x79, 0xa3, 0x49, 0x62, 0x0a, 0xc6, 0x3a,
+  0x28, 0x20, 0xaa, 0x78, 0x8e, 0x8f, 0x5c, 0x06, 0x12, 0x68, 0x01, 0xdd, 0x10, 0xd8, 0x17, 0x6a,
+  0x36, 0x5b, 0xe0, 0x64, 0xbd, 0x40, 0x66, 0x8e, 0x99, 0xd7, 0xd0, 0xab, 0x69, 0x03, 0x0a, 0x7f,
+  0x0c, 0xd7, 0x31, 0xcf, 0x5c, 0x14, 0x2e, 0xec, 0x54, 0x32, 0xeb, 0x6b, 0xc8, 0xdf, 0x6c, 0xf0,
+  0xd3, 0xe6, 0x08, 0xfa, 0xc8, 0x0f, 0x32, 0x87, 0x35, 0x91, 0x0c, 0xb1, 0x76, 0x13, 0x34, 0x41,
+  0xb7, 0xbb, 0x9d, 0x4e, 0xa7, 0xd9, 0x24, 0xdf, 0x11, 0x83, 0x1b, 0xda, 0x4b, 0x0e, 0x3b, 0x69,
+  0x64, 0xf1, 0x51, 0xba, 0x2b, 0x81, 0x2b, 0x91, 0x9b, 0x87, 0xa2, 0x56, 0xd3, 0xb3, 0xc0, 0x1c,
+  0x76, 0xd2, 0xf9, 0x91, 0x99, 0xee, 0xa8, 0x95, 0xdd, 0x13, 0x80, 0x38, 0x7e, 0x9b, 0xe1, 0x27,
+  0xcc, 0xc1, 0x8b, 0x48, 0x96, 0x73, 0x99, 0x46, 0x5b, 0x76, 0xff, 0x3e, 0x71, 0xa0, 0x06, 0x70,
+  0x99, 0xdf, 0x12, 0xe0, 0xfa, 0x5b, 0x35, 0xab, 0x6c, 0x54, 0x8f, 0xcd, 0x12, 0xb2, 0x6d, 0xc0,
+  0x49, 0x60, 0x26, 0x57, 0x0d, 0x28, 0xaa, 0x7e, 0xfa, 0x6c, 0xff, 0x85, 0x87, 0x81, 0xd9, 0xac,
+  0x1a, 0x82, 0xad, 0xd8, 0xdd, 0x03, 0x90, 0xa9, 0x95, 0xe3, 0x1b, 0x5d, 0x77, 0xd7, 0x41, 0x86,
+  0x69, 0x1c, 0x83, 0x99, 0x84, 0x01, 0x28, 0x90, 0xd0, 0xa7, 0xb6, 0x7c, 0x61, 0x1a, 0x97, 0xf2,
+  0xbd, 0x5c, 0x14, 0x1a, 0x57, 0xb9, 0x88, 0x31, 0x68, 0xb2, 0x6c, 0x6e, 0x36, 0xeb, 0xe5, 0xbe,
+  0x9f, 0x5c, 0xe8, 0xe5, 0xee, 0x45, 0x30, 0x67, 0xa2, 0x60, 0xb6, 0x52, 0xbf, 0x77, 0xa8, 0x3d,
+  0x7f, 0x74, 0x60, 0x3c, 0xf9, 0xdb, 0xdf, 0x8a, 0x87, 0x57, 0x6a, 0x14, 0xa2, 0xae, 0x62, 0x37,
+  0x5a, 0x60, 0xf5, 0x75, 0x8d, 0x3f, 0xd2, 0xf2, 0x9d, 0xa0, 0x6c, 0x2f, 0x59, 0x4e, 0x41, 0x56,
+  0xc8, 0x63, 0x64, 0xaa, 0xba, 0xa3, 0xaa, 0xdc, 0x42, 0xcf, 0xa5, 0xae, 0xa7, 0xe2, 0xcf, 0x15,
+  0xb7, 0x05, 0x26, 0x40, 0x71, 0x2f, 0xf0, 0xbc, 0xf6, 0x56, 0x98, 0x46, 0x2f, 0xa7, 0xb1, 0x72,
+  0x94, 0xb8, 0xb5, 0xe5, 0x57, 0x93, 0x4c, 0x20, 0xd8, 0x42, 0xaa, 0x9a, 0x0e, 0x58, 0x6c, 0x47,
+  0xcf, 0xd4, 0x95, 0x97, 0x94, 0x76, 0x5f, 0xbd, 0x31, 0x74, 0x0c, 0x44, 0x8e, 0x07, 0x5d, 0xfb,
+  0x80, 0x60, 0x99, 0x4c, 0x4c, 0x33, 0x40, 0x06, 0x1c, 0x83, 0x59, 0x06, 0x4d, 0x12, 0xf6, 0x3c,
+  0x0e, 0x57, 0x4d, 0xdd, 0x70, 0xc9, 0x3d, 0x47, 0x30, 0x20, 0xa1, 0xef, 0x88, 0x09, 0x1f, 0x76,
+  0x03, 0x40, 0xf1, 0x24, 0xd1, 0xc7, 0xc4, 0x44, 0x85, 0xec, 0xc1, 0x03, 0xf4, 0xca, 0x9a, 0xd6,
+  0xc4, 0x20, 0x62, 0xf4, 0x85, 0x85, 0x28, 0x69, 0x13, 0x91, 0x57, 0xca, 0x01, 0x36, 0xe0, 0x3b,
+  0xc0, 0x72, 0x12, 0x06, 0x24, 0xc1, 0xcc, 0x12, 0xb9, 0xec, 0x31, 0xf9, 0xf5, 0x97, 0x17, 0xf2,
+  0x36, 0x54, 0x8b, 0x3c, 0x52, 0xb7, 0xb7, 0x72, 0xc4, 0xde, 0xbf, 0x17, 0xd9, 0xbb, 0xa9, 0x2d,
+  0x62, 0x24, 0x57, 0x9b, 0x00, 0x87, 0xc6, 0xaf, 0xbf, 0xe0, 0xbf, 0x38, 0xd8, 0xf8, 0xd0, 0x22,
+  0xd0, 0x33, 0x0d, 0x30, 0xb1, 0x9b, 0xba, 0xf5, 0x8a, 0x1d, 0x1e, 0xe1, 0x3f, 0x92, 0xb4, 0xf1,
+  0xe1, 0x43, 0x59, 0x09, 0x52, 0xb7, 0x66, 0xbe, 0x8f, 0x04, 0xb0, 0x29, 0xef, 0x29, 0xb5, 0xc8,
+  0x3a, 0x60, 0xc0, 0x12, 0x67, 0x1e, 0xfd, 0x50, 0xe1, 0x76, 0x53, 0x7b, 0xfa, 0x0d, 0x0c, 0xb3,
+  0x21, 0xbc, 0x58, 0x80, 0x41, 0x48, 0x4c, 0xd9, 0x99, 0xb6, 0xb3, 0x0c, 0x25, 0xc2, 0xac, 0xa5,
+  0xb1, 0x6d, 0x1b, 0x07, 0xaf, 0x9c, 0xc8, 0x8c, 0xa4, 0xcc, 0xdf, 0x77, 0x3f, 0x34, 0xc1, 0x96,
+  0x2e, 0x59, 0x76, 0xe3, 0xf4, 0xbd, 0xce, 0x2a, 0x19, 0x82, 0xd1, 0x16, 0x4e, 0x34, 0x21, 0x5d,
+  0x50, 0x3d, 0x7c, 0xb2, 0xa6, 0xa4, 0x63, 0x0f, 0x31, 0x04, 0x26, 0xdf, 0x25, 0x8f, 0x9f, 0xb4,
+  0xc3, 0x15, 0x08, 0xb6, 0x30, 0xfb, 0x0d, 0xce, 0x74, 0x8a, 0x08, 0x90, 0xe4, 0x6e, 0x70, 0xf3,
+  0x53, 0xca, 0x4d, 0x44, 0x00, 0x5e, 0x77, 0xe8, 0x77, 0x2a, 0xd8, 0x90, 0xb0, 0x96, 0x05, 0xc9,
+  0x2b, 0x3c, 0x49, 0x00, 0x7a, 0x52, 0xac, 0xd5, 0x9d, 0x11, 0x2d, 0x3f, 0x25, 0x8a, 0xd8, 0xb5,
+  0x87, 0xd5, 0x1d, 0x67, 0x74, 0xc1, 0x82, 0x77, 0x20, 0x1a, 0xb3, 0x62, 0x6a, 0x14, 0xd5, 0x6e,
+  0x4b, 0xa3, 0x16, 0x61, 0x72, 0xfb, 0x18, 0xf9, 0x7e, 0x37, 0xcf, 0x75, 0x68, 0xde, 0x9a, 0xd1,
+  0xfb, 0xce, 0x07, 0x90, 0xf4, 0xd6, 0x54, 0xd2, 0x24, 0x63, 0xd9, 0xbc, 0x82, 0xcc, 0x44, 0xd7,
+  0x7c, 0x70, 0x99, 0x66, 0x4d, 0x0f, 0xac, 0x87, 0x1e, 0x29, 0x06, 0x34, 0x13, 0x4f, 0xf1, 0x54,
+  0x07, 0xba, 0x22, 0xf6, 0xea, 0x89, 0x5e, 0xa3, 0x51, 0xc9, 0x38, 0xca, 0x25, 0x43, 0xe7, 0xb2,
+  0x47, 0xae, 0x8c, 0xb8, 0x94, 0x7e, 0xc0, 0xf2, 0x3b, 0xb0, 0xc6, 0x4d, 0x8b, 0x74, 0x07, 0xcd,
+  0xbb, 0x51, 0xc5, 0xfd, 0x3e, 0x48, 0x15, 0xd1, 0xd0, 0xeb, 0x69, 0x28, 0x7f, 0xd2, 0x98, 0x87,
+  0x2b, 0x3c, 0xa5, 0x92, 0x19, 0x21, 0x46, 0x61, 0x82, 0xad, 0xd0, 0x3c, 0x84, 0x01, 0xc4, 0x5f,
+  0x99, 0x50, 0xcc, 0xc5, 0x2b, 0xbc, 0x84, 0x71, 0x50, 0x29, 0xc7, 0x2f, 0x05, 0x31, 0xca, 0x22,
+  0x21, 0xc4, 0x47, 0x9d, 0xe4, 0x47, 0xaf, 0x7c, 0x0a, 0xd1, 0x61, 0x24, 0x5d, 0xbc, 0xb4, 0x5e,
+  0x00, 0xeb, 0xd1, 0xa0, 0xd3, 0x01, 0xde, 0x7f, 0x26, 0x2b, 0xb0, 0xac, 0xcb, 0x31, 0x44, 0x11,
+  0xcb, 0x30, 0x16, 0x60, 0x26, 0x3c, 0x3c, 0xcd, 0x37, 0x02, 0x08, 0xb9, 0x62, 0xe6, 0x1a, 0xe4,
+  0x13, 0x2c, 0xee, 0x67, 0xb2, 0x84, 0xe8, 0x05, 0xde, 0xf6, 0x2c, 0x8f, 0x2d, 0x18, 0xf6, 0x02,
+  0xd5, 0x5d, 0x0b, 0x9a, 0x79, 0x45, 0x3e, 0x69, 0x8c, 0x76, 0x66, 0xd7, 0x8d, 0xe4, 0xd6, 0xa3,
+  0x51, 0xee, 0x96, 0xdd, 0x71, 0x25, 0x54, 0x3d, 0x29, 0xb9, 0x2b, 0xbb, 0xc0, 0x2a, 0x59, 0xfe,
+  0x63, 0x15, 0x08, 0x81, 0x55, 0x7f, 0x15, 0xa2, 0x35, 0xbd, 0x12, 0x31, 0x78, 0x6a, 0xf3, 0x3d,
+  0x58, 0x43, 0x5c, 0x31, 0x00, 0x18, 0xec, 0xb3, 0xda, 0x9c, 0x41, 0xf3, 0xc0, 0xdc, 0xca, 0x40,
+  0x1e, 0x37, 0x39, 0x78, 0x91, 0xc3, 0x53, 0xa3, 0x8b, 0xd0, 0x4e, 0xff, 0x29, 0x1f, 0x8a, 0xef,
+  0xb7, 0x3c, 0xa6, 0x78, 0x78, 0x0a, 0x0e, 0xe7, 0xc9, 0x93, 0x27, 0xd2, 0x2f, 0xb4, 0x89, 0xd5,
+  0x05, 0xb7, 0x80, 0x47, 0xad, 0x4e, 0x1a, 0x8b, 0xcb, 0xfc, 0x3d, 0x08, 0x11, 0x16, 0x78, 0xa6,
+  0xc9, 0xc9, 0x96, 0x8a, 0x72, 0xf8, 0x81, 0x15, 0x9d, 0x7f, 0xc1, 0x52, 0x94, 0xc9, 0x80, 0x83,
+  0xe4, 0x52, 0x28, 0x62, 0xb8, 0x18, 0x8c, 0x54, 0x05, 0xd8, 0xcc, 0x6b, 0x4a, 0xf9, 0x5c, 0xa8,
+  0xbb, 0x56, 0x64, 0x5a, 0x42, 0xb6, 0xa9, 0x8a, 0x5f, 0x93, 0xa9, 0xe2, 0x17, 0x22, 0x96, 0xe4,
+  0x05, 0xe8, 0xc4, 0xb7, 0xdf, 0xca, 0xc9, 0x94, 0xaa, 0x3c, 0x82, 0xc0, 0xfa, 0x7b, 0x62, 0x58,
+  0x96, 0x91, 0xe8, 0x11, 0xa0, 0x2a, 0xa3, 0x5f, 0x72, 0x54, 0xaa, 0x62, 0x55, 0x52, 0xba, 0x70,
+  0x7c, 0x9f, 0x7a, 0x64, 0x03, 0xf1, 0x9d, 0xcc, 0x24, 0x36, 0x94, 0x00, 0xc3, 0x32, 0xd2, 0xfe,
+  0xc3, 0xd5, 0xdb, 0x37, 0x44, 0xc2, 0xa1, 0xad, 0xaa, 0x19, 0x16, 0xe6, 0x7e, 0x65, 0x91, 0x94,
+  0xb2, 0x2a, 0x4f, 0x26, 0x5b, 0x79, 0x71, 0x64, 0x52, 0x5d, 0x6c, 0x3e, 0x2b, 0xaa, 0xee, 0x85,
+  0xaa, 0xe9, 0xed, 0xa4, 0x7f, 0x94, 0x2c, 0x0d, 0x4d, 0x25, 0xd0, 0x28, 0x88, 0x37, 0x2b, 0x11,
+  0x9c, 0x39, 0xeb, 0xf5, 0x65, 0xc8, 0x0c, 0xce, 0xfe, 0xec, 0x6e, 0xb3, 0xa5, 0xd1, 0x40, 0x61,
+  0x2a, 0xf8, 0x29, 0xcf, 0x96, 0xf6, 0x6d, 0x62, 0xf3, 0x77, 0xb8, 0x67, 0x65, 0xb3, 0xf5, 0x9a,
+  0x05, 0xed, 0xd7, 0x8e, 0x3a, 0xf9, 0x97, 0xc5, 0xab, 0x24, 0x4b, 0xda, 0x65, 0x89, 0x22, 0x8c,
+  0x2c, 0x1f, 0xb6, 0xc7, 0x27, 0x73, 0x46, 0x7d, 0x8f, 0x13, 0x27, 0x56, 0x26, 0x4d, 0x56, 0x24,
+  0x54, 0xaf, 0x66, 0x45, 0x50, 0xab, 0xd8, 0x50, 0x7d, 0x38, 0xe2, 0x27, 0xfb, 0xf9, 0x7d, 0x3e,
+  0x21, 0x83, 0x88, 0x04, 0xd0, 0x56, 0xde, 0x9f, 0x3d, 0xe8, 0x8d, 0xb4, 0x56, 0x0c, 0xd6, 0x4a,
+  0xdd, 0x7d, 0x93, 0xf2, 0xfc, 0x33, 0xbc, 0x81, 0x17, 0x28, 0xcb, 0x66, 0xfd, 0x50, 0x2c, 0x9d,
+  0x27, 0x63, 0x93, 0xa1, 0xf8, 0xa6, 0x75, 0x60, 0x68, 0xf6, 0xe8, 0x05, 0x47, 0x6f, 0x50, 0xae,
+  0xc9, 0xa4, 0x52, 0x0f, 0x0e, 0x8f, 0x4c, 0x26, 0x56, 0x23, 0xd5, 0x9c, 0x9a, 0x91, 0x0a, 0xcb,
+  0xb2, 0x8e, 0xc6, 0x95, 0xe4, 0x14, 0xf4, 0x39, 0x0a, 0xe6, 0xfd, 0x07, 0x8d, 0xcf, 0xf9, 0xed,
+  0xef, 0xff, 0x95, 0x2d, 0x48, 0xfd, 0xf6, 0xf7, 0xff, 0xc6, 0xcb, 0x6d, 0x01, 0xe8, 0x92, 0x20,
+  0x7f, 0x7a, 0xf3, 0xf2, 0x5f, 0x95, 0x1b, 0x12, 0x90, 0xfb, 0x63, 0x86, 0x0c, 0x2d, 0x1e, 0x97,
+  0x09, 0xff, 0x1f, 0xae, 0xa4, 0xd1, 0xb3, 0x8b, 0xf4, 0x9e, 0x51, 0x80, 0x01, 0x25, 0x6f, 0xae,
+  0xdf, 0x11, 0xbe, 0x0d, 0xdc, 0xac, 0xe7, 0x4a, 0xcd, 0x58, 0x42, 0x06, 0x4b, 0x8d, 0xf0, 0x76,
+  0x16, 0x86, 0x82, 0x30, 0xd8, 0x6e, 0xd0, 0x1c, 0xbb, 0xe4, 0xcf, 0xe4, 0x1a, 0x50, 0xf9, 0xfe,
+  0x9c, 0x5e, 0xcc, 0xcf, 0xbb, 0xb6, 0x9f, 0xab, 0x0b, 0x38, 0x45, 0xf8, 0x67, 0xcb, 0x72, 0xc6,
+  0x21, 0x23, 0x86, 0x3f, 0x46, 0xbe, 0x52, 0x87, 0x56, 0xaa, 0xcc, 0x0e, 0xe8, 0x04, 0x01, 0x40,
+  0xcf, 0x05, 0x56, 0x84, 0x70, 0x29, 0xa6, 0x72, 0xd0, 0x01, 0x3c, 0x6e, 0xb1, 0x8e, 0xb6, 0xc5,
+  0x9b, 0xf1, 0x4d, 0xa3, 0x1c, 0x01, 0xe8, 0xbc, 0xf2, 0x27, 0x8d, 0x16, 0x08, 0xfe, 0x9a, 0x27,
+  0x66, 0x27, 0x3f, 0xb5, 0x72, 0x35, 0x67, 0x44, 0x97, 0x44, 0x0a, 0xa9, 0xcd, 0x7b, 0xd7, 0x04,
+  0x34, 0x9a, 0x47, 0x9a, 0x89, 0x3b, 0xc9, 0x49, 0x27, 0x23, 0x51, 0x74, 0x7e, 0x95, 0x3e, 0xee,
+  0x1d, 0x8d, 0x2d, 0x59, 0x38, 0x56, 0xc7, 0x0d, 0xa6, 0xb4, 0x07, 0xa0, 0x16, 0x6d, 0x04, 0x78,
+  0xf3, 0x4c, 0x82, 0x67, 0xc6, 0x16, 0x04, 0x02, 0x8f, 0x19, 0x05, 0x10, 0x3b, 0x33, 0x88, 0x43,
+  0x77, 0xd6, 0x23, 0x0e, 0xc1, 0xb6, 0xaf, 0xa8, 0x13, 0x54, 0xd9, 0xf4, 0x44, 0x0f, 0x12, 0x15,
+  0xd0, 0xa7, 0xdb, 0xaa, 0xa0, 0x5d, 0x53, 0x50, 0x52, 0x85, 0xed, 0xa2, 0xa2, 0xc9, 0x61, 0x76,
+  0x52, 0x3a, 0x9f, 0x26, 0xe5, 0xf2, 0x34, 0xdd, 0x01, 0x8c, 0xf6, 0xce, 0xca, 0xa1, 0x59, 0x66,
+  0x48, 0x5d, 0x4c, 0x36, 0x5f, 0xa1, 0xd9, 0x37, 0x6f, 0x52, 0xbf, 0x0c, 0x51, 0xba, 0x79, 0x93,
+  0x73, 0xa7, 0xb5, 0xae, 0x34, 0xef, 0x43, 0xcb, 0xfe, 0x73, 0x3f, 0x91, 0xbc, 0x03, 0x34, 0x4d,
+  0x96, 0x22, 0x9e, 0x85, 0x1e, 0xa4, 0xa3, 0x10, 0xde, 0x17, 0xbe, 0x1e, 0xb6, 0x64, 0x20, 0x1f,
+  0x13, 0xfb, 0xda, 0xb8, 0x49, 0xe9, 0x12, 0xcf, 0x0b, 0x6b, 0x6e, 0x4a, 0x72, 0xb6, 0x07, 0x06,
+  0x59, 0xd0, 0x3f, 0x86, 0x1b, 0xd3, 0x2a, 0x7e, 0xe9, 0x3d, 0xed, 0xbf, 0x4b, 0x42, 0x78, 0x9a,
+  0x84, 0x94, 0x95, 0x58, 0x31, 0x18, 0xab, 0xaa, 0x6d, 0x3a, 0xf5, 0x7b, 0xf6, 0x01, 0x97, 0x2f,
+  0x3f, 0x83, 0xc1, 0x00, 0x0b, 0x85, 0xf3, 0x68, 0x62, 0xeb, 0x84, 0x67, 0x18, 0x63, 0xbb, 0xd4,
+  0xf7, 0x33, 0xdb, 0x32, 0x6c, 0x22, 0xd1, 0x64, 0xf4, 0x05, 0xb4, 0xe9, 0x86, 0xef, 0xc6, 0x81,
+  0x30, 0x0a, 0xce, 0x98, 0xdb, 0xf8, 0x9f, 0xac, 0xd4, 0x0d, 0xe9, 0x16, 0x87, 0xc0, 0x76, 0x9a,
+  0xbc, 0x90, 0xab, 0x97, 0x9d, 0x45, 0x9e, 0x48, 0x4f, 0x4f, 0x24, 0x93, 0xc6, 0x3f, 0xaa, 0x27,
+  0xd0, 0xaf, 0xe6, 0x42, 0xb9, 0x1d, 0xc9, 0x82, 0x34, 0x5e, 0x6d, 0xa9, 0xb4, 0x99, 0xf6, 0x4a,
+  0x87, 0x96, 0x9f, 0x62, 0x50, 0x96, 0x0d, 0x97, 0x47, 0x30, 0x0a, 0x91, 0xe1, 0x47, 0xcc, 0x82,
+  0xe4, 0xaf, 0xf1, 0xbe, 0x09, 0x27, 0xfc, 0x9f, 0xff, 0xc4, 0x09, 0xb9, 0xfc, 0xa2, 0x16, 0x88,
+  0x83, 0x1f, 0x98, 0x44, 0x96, 0xce, 0xdf, 0xe0, 0x79, 0xd8, 0x34, 0x33, 0x08, 0xf0, 0x87, 0x99,
+  0x8a, 0x91, 0x7c, 0xdb, 0x0b, 0x27, 0x31, 0x8c, 0x9a, 0x3a, 0x77, 0xce, 0xec, 0xbc, 0xc0, 0xd2,
+  0x5d, 0x26, 0x3e, 0xbc, 0xbc, 0x7a, 0xd7, 0xef, 0x11, 0x73, 0x0e, 0xb1, 0x24, 0x7e, 0x81, 0x82,
+  0xc8, 0xfb, 0x47, 0x18, 0x52, 0x92, 0x36, 0xc5, 0x23, 0x07, 0x8e, 0xe9, 0xd6, 0x3a, 0x70, 0x6e,
+  0x60, 0x32, 0x54, 0x96, 0x66, 0x45, 0x39, 0x35, 0x13, 0x43, 0x16, 0x8d, 0x4d, 0x5a, 0x02, 0xcd,
+  0x44, 0xa2, 0xc6, 0x57, 0x28, 0x6d, 0x96, 0x62, 0xd9, 0x7b, 0xa9, 0x70, 0x66, 0x98, 0x3e, 0x54,
+  0xe7, 0x44, 0xa3, 0x1e, 0xfa, 0x3e, 0xa1, 0xf2, 0x0a, 0x68, 0x3f, 0xf5, 0xf5, 0x67, 0x90, 0xc6,
+  0xfa, 0x5b, 0xb2, 0xe6, 0xe0, 0xb6, 0xc0, 0x16, 0xa2, 0xf5, 0x96, 0x92, 0xc5, 0xdb, 0x59, 0xd4,
+  0x59, 0xa9, 0x74, 0x76, 0x8e, 0xcd, 0xb9, 0x03, 0xa6, 0x08, 0x48, 0x5d, 0x43, 0xfc, 0x11, 0x97,
+  0x4e, 0x98, 0xf6, 0x09, 0x0d, 0xe6, 0xcc, 0xef, 0xd4, 0x39, 0x97, 0xb6, 0xac, 0xbf, 0xa3, 0xa1,
+  0xb7, 0xb9, 0xd9, 0x29, 0x38, 0x15, 0xf2, 0x3f, 0xf2, 0x81, 0xcc, 0xc3, 0x2c, 0x6c, 0x68, 0x8b,
+  0xf4, 0x31, 0xde, 0xd0, 0xd4, 0xb5, 0xb3, 0x9b, 0x5e, 0x29, 0x12, 0x58, 0x1c, 0x48, 0x0d, 0x16,
+  0x8f, 0xd0, 0x52, 0x27, 0x2b, 0x0a, 0x74, 0xd1, 0x9a, 0x2f, 0x29, 0x57, 0x35, 0x40, 0xf4, 0xd6,
+  0x49, 0xfe, 0xa0, 0x4e, 0x82, 0xaf, 0x80, 0x15, 0xf0, 0x90, 0x57, 0x28, 0x28, 0x79, 0xf6, 0xb5,
+  0x4f, 0x2b, 0x70, 0x65, 0x49, 0x8d, 0x58, 0xb6, 0x5c, 0x41, 0x2e, 0xee, 0x52, 0xbd, 0x8b, 0x4b,
+  0x30, 0xac, 0xc2, 0x81, 0x4c, 0x6f, 0x80, 0xa3, 0x6a, 0x2a, 0x2a, 0xba, 0x7a, 0x6b, 0x87, 0x01,
+  0x44, 0x7e, 0xdc, 0x59, 0xa0, 0xe6, 0x51, 0x2d, 0xba, 0x50, 0x85, 0xec, 0x08, 0xff, 0x43, 0x2a,
+  0x93, 0xca, 0x93, 0xb5, 0x66, 0x15, 0xa5, 0x04, 0x69, 0x95, 0x67, 0x75, 0x98, 0x42, 0xbd, 0x7d,
+  0xf3, 0xe6, 0xf2, 0xe2, 0xfa, 0xe5, 0x9b, 0x7f, 0x92, 0x4e, 0x5d, 0x9d, 0x07, 0xcd, 0xd0, 0xf0,
+  0x83, 0x28, 0x24, 0x40, 0x44, 0xbc, 0x95, 0xb2, 0xd9, 0xd5, 0x4a, 0xcf, 0xb4, 0x74, 0x5e, 0xbd,
+  0xbd, 0xba, 0x7c, 0x9e, 0xd0, 0x80, 0x7c, 0x70, 0x43, 0x63, 0x9a, 0xa2, 0x8b, 0x00, 0x9f, 0x0b,
+  0x9b, 0xf0, 0xf5, 0x0c, 0x8f, 0x4f, 0x21, 0xa6, 0x20, 0x3e, 0x5b, 0xa1, 0x93, 0xfd, 0xed, 0x1f,
+  0xff, 0x21, 0xa1, 0xa0, 0x3d, 0x81, 0x4b, 0x56, 0x81, 0x7b, 0xb3, 0xc5, 0x63, 0x66, 0x55, 0xea,
+  0xc9, 0x48, 0xd2, 0x56, 0x73, 0x36, 0x0b, 0x68, 0x2c, 0xd8, 0xa3, 0x0c, 0x3a, 0x08, 0xf5, 0x79,
+  0xf1, 0xfa, 0x78, 0xd5, 0xd8, 0x7d, 0x4c, 0x58, 0xc6, 0x1b, 0xae, 0xf7, 0xa5, 0xfa, 0x9f, 0xbc,
+  0xf0, 0x2c, 0xd7, 0x57, 0x56, 0x2b, 0xc2, 0x3d, 0xf3, 0x43, 0xc7, 0xe3, 0x0f, 0xea, 0x8f, 0x03,
+  0x4b, 0x80, 0x97, 0x3d, 0x5a, 0x44, 0x06, 0xd8, 0x49, 0xbf, 0x49, 0x3b, 0x3d, 0x69, 0x9e, 0xb4,
+  0xd5, 0xf9, 0xf8, 0xa4, 0xad, 0xfe, 0xb3, 0xb2, 0xff, 0x05, 0x89, 0xc4, 0xf6, 0x2c, 0xbd, 0x4c,
+  0x00, 0x00,
+};
@@ -0,0 +1,161 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// lttb.h — Largest-Triangle-Three-Buckets downsampling in one streaming pass
+//
+// LTTB (Steinarsson, 2013) keeps the first and the last of n points and one
+// point per bucket in between. The n − 2 middle points are cut into
+// threshold − 2 buckets of consecutive points (bucket k starts at index
+// k·(n − 2) / (threshold − 2) + 1). From each bucket it keeps the point that
+// spans the largest triangle with the point kept from the previous bucket
+// and the mean of the next bucket. Peaks and dips survive; a flat stretch
+// costs one point per bucket like anything else.
+//
+// LttbStream takes the points in order, with n known up front, and hands
+// each kept point to `emit` as soon as it is decided. A bucket is judged
+// once the next one is complete, so no more than two buckets are ever held;
+// begin() refuses an (n, threshold) whose buckets would not fit in CAP.
+//
+// Several series sharing x (temperature and humidity, say) go through one
+// pass as CH channels: the points are buffered once and every channel picks
+// its own. Areas are compared exactly in 64-bit integers, with the next
+// bucket's mean kept as sum / count and multiplied through, so every
+// platform picks the same points and ties go to the earliest, as in the
+// reference.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+
+template <size_t CAP, size_t CH>
+class LttbStream {
+public:
+  struct Point {
+    uint32_t x;                      // non-decreasing (a timestamp)
+    int16_t  y[CH];
+  };
+
+  // Expect n points and keep at most `threshold` of them (all of them when
+  // threshold ≥ n or < 3). False if two buckets would not fit in CAP.
+  bool begin(size_t n, size_t threshold) {
+    n_       = n;
+    seen_    = 0;
+    head_    = size_ = 0;
+    bucket_  = 0;
+    buckets_ = threshold >= 3 && threshold < n ? threshold - 2 : 0;
+    if (buckets_ == 0) return true;
+    const size_t widest = (n - 2 + buckets_ - 1) / buckets_;
+    judgeAt_ = start(2);
+    return 2 * widest <= CAP;
+  }
+
+  // Feed the next point. emit(channel, point) is called for each kept point,
+  // channel by channel, in order.
+  template <typename Emit>
+  void add(const Point& p, Emit&& emit) {
+    if (seen_ >= n_) return;
+    const size_t i = seen_++;
+    if (i == 0) x0_ = p.x;
+    if (buckets_ == 0 || i == 0) {
+      keep(p, emit);
+      return;
+    }
+
+    // p opens the bucket after next: judge the oldest one by the mean of the
+    // one after it
+    if (i == judgeAt_) {
+      const size_t cand = start(bucket_ + 1) - start(bucket_);
+      judge(cand, size_ - cand, nullptr, emit);
+      bucket_++;
+      judgeAt_ = start(bucket_ + 2);
+    }
+    if (i == n_ - 1) {
+      // The last point is the final bucket's "next mean" by itself
+      if (size_ > 0) judge(size_, 0, &p, emit);
+      keep(p, emit);
+      return;
+    }
+    ring_[(head_ + size_++) % CAP] = p;
+  }
+
+  // Close a stream that ended before n points (its source shrank while it
+  // was read): judge what is buffered and keep the newest point as the last.
+  template <typename Emit>
+  void finish(Emit&& emit) {
+    if (seen_ >= n_ || seen_ < 2 || buckets_ == 0) return;
+    const Point last = ring_[(head_ + --size_) % CAP];
+    while (size_ > 0) {
+      const size_t width = start(bucket_ + 1) - start(bucket_);
+      const size_t cand  = width < size_ ? width : size_;
+      const size_t rest  = size_ - cand;
+      const size_t next  = start(bucket_ + 2) - start(bucket_ + 1);
+      judge(cand, rest < next ? rest : next, rest ? nullptr : &last, emit);
+      bucket_++;
+    }
+    keep(last, emit);
+  }
+
+private:
+  // First input index of bucket k; bucket `buckets_` is the last point alone
+  size_t start(size_t k) const { return (size_t)((uint64_t) k * (n_ - 2) / buckets_) + 1; }
+
+  template <typename Emit>
+  void keep(const Point& p, Emit& emit) {
+    for (size_t c = 0; c < CH; c++) {
+      prev_[c] = p;
+      emit(c, p);
+    }
+  }
+
+  // Pick, per channel, the best of the `cand` oldest buffered points against
+  // the mean of the `next` points after them (or against `*alone`), then
+  // drop the candidates
+  template <typename Emit>
+  void judge(size_t cand, size_t next, const Point* alone, Emit& emit) {
+    int64_t cnt = 1, sx, sy[CH];
+    if (alone) {
+      sx = (int64_t)(alone->x - x0_);
+      for (size_t c = 0; c < CH; c++) sy[c] = alone->y[c];
+    } else {
+      cnt = (int64_t) next;
+      sx  = 0;
+      for (size_t c = 0; c < CH; c++) sy[c] = 0;
+      for (size_t j = cand; j < cand + next; j++) {
+        const Point& q = ring_[(head_ + j) % CAP];
+        sx += (int64_t)(q.x - x0_);
+        for (size_t c = 0; c < CH; c++) sy[c] += q.y[c];
+      }
+    }
+
+    for (size_t c = 0; c < CH; c++) {
+      // 2 · area · cnt = |(ax·cnt − Σx)(py − ay) − (ax − px)(Σy − ay·cnt)|
+      const int64_t ax = (int64_t)(prev_[c].x - x0_), ay = prev_[c].y[c];
+      const int64_t u  = ax * cnt - sx;
+      const int64_t v  = sy[c] - ay * cnt;
+      int64_t best = -1;
+      size_t  at   = 0;
+      for (size_t j = 0; j < cand; j++) {
+        const Point& q = ring_[(head_ + j) % CAP];
+        int64_t area = u * (q.y[c] - ay) - (ax - (int64_t)(q.x - x0_)) * v;
+        if (area < 0) area = -area;
+        if (area > best) {
+          best = area;
+          at   = j;
+        }
+      }
+      prev_[c] = ring_[(head_ + at) % CAP];
+      emit(c, prev_[c]);
+    }
+    head_  = (head_ + cand) % CAP;
+    size_ -= cand;
+  }
+
+  Point    ring_[CAP];
+  Point    prev_[CH];                // last point kept, per channel
+  uint32_t x0_      = 0;             // x of the first point; areas use x − x0
+  size_t   n_       = 0;
+  size_t   seen_    = 0;
+  size_t   buckets_ = 0;             // threshold − 2; 0 = keep everything
+  size_t   bucket_  = 0;             // oldest bucket not yet judged
+  size_t   judgeAt_ = 0;             // input index that completes bucket_ + 1
+  size_t   head_    = 0;
+  size_t   size_    = 0;
+};
@@ -1,673 +1,672 @@
-#include <Arduino.h>
-#include <SPI.h>
-#include <WiFi.h>
-#include <WebServer.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_SSD1351.h>
-#include <Adafruit_Sensor.h>
-#include <DHT.h>
-#include <DHT_U.h>
-#include <ArduinoJson.h>    // For JSON serialization
-#include <time.h>           // Needed for NTP/time functions
-
-// ──────────────────────────────────────────────────────────────────────────────
-// USER CONFIGURATION: Change these to match your Wi-Fi SSID/password.
-// ──────────────────────────────────────────────────────────────────────────────
-const char* ssid     = "ssid";
-const char* password = "password";
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 1) Pin Definitions (ESP32 DevKit ↔ Waveshare 1.5" SSD1351)
-// ──────────────────────────────────────────────────────────────────────────────
-static const uint8_t OLED_MOSI = 23;  // VSPI MOSI
-static const uint8_t OLED_SCLK = 18;  // VSPI SCLK
-static const uint8_t OLED_DC   = 16;  // Data/Command pin
-static const uint8_t OLED_RST  = 17;  // Reset pin
-static const uint8_t OLED_CS   = 5;   // Chip Select pin
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 2) Display Resolution
-// ──────────────────────────────────────────────────────────────────────────────
-static const int SCREEN_WIDTH  = 128;
-static const int SCREEN_HEIGHT = 128;
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 3) Color Definitions (16-bit 5-6-5 RGB)
-// ──────────────────────────────────────────────────────────────────────────────
-static const uint16_t COLOR_BLACK = 0x0000;
-static const uint16_t COLOR_RED   = 0xF800;
-static const uint16_t COLOR_BLUE  = 0x001F;
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 4) Instantiate Adafruit_SSD1351
-// ──────────────────────────────────────────────────────────────────────────────
-Adafruit_SSD1351 oled(SCREEN_WIDTH, SCREEN_HEIGHT, &SPI, OLED_CS, OLED_DC, OLED_RST);
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 5) DHT22 on GPIO 22
-// ──────────────────────────────────────────────────────────────────────────────
-#define DHTPIN   22
-#define DHTTYPE  DHT22
-DHT_Unified dht(DHTPIN, DHTTYPE);
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 6) Text metrics (textSize = 2 ⇒ each char = 12×16 px)
-// ──────────────────────────────────────────────────────────────────────────────
-static const int TEXT_SIZE   = 2;
-static const int CHAR_WIDTH  = 12;
-static const int CHAR_HEIGHT = 16;
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 7) Four lines of text for the OLED. Must be declared before using snprintf().
-// ──────────────────────────────────────────────────────────────────────────────
-char lineStr[4][16];  // lineStr[0] = “TEMP: XXF”, lineStr[1] = “L:XX H:YY”, etc.
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 8) Globals for sensor values + min/max tracking + last update timestamp
-// ──────────────────────────────────────────────────────────────────────────────
-float tMin =  1e6, tMax = -1e6;
-float hMin =  1e6, hMax = -1e6;
-float currentTempF = NAN, currentHum = NAN;
-uint32_t lastReadTime   = 0;    // millis() of last DHT read
-uint32_t lastUpdateTime = 0;    // UNIX timestamp from NTP
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 9) Globals for burn-in phase tracking
-// ──────────────────────────────────────────────────────────────────────────────
-int lastPhase = -1;
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 10) WebServer on port 80
-// ──────────────────────────────────────────────────────────────────────────────
-WebServer server(80);
-
-// ──────────────────────────────────────────────────────────────────────────────
-// Forward declarations
-// ──────────────────────────────────────────────────────────────────────────────
-void handleRoot();
-void handleSensorData();
-void drawReadings(int16_t offsetX, int16_t offsetY);
-String getHtmlPage();
-
-void setup() {
-  // — Serial for debugging
-  Serial.begin(115200);
-  delay(200);
-
-  // — Initialize DHT22
-  dht.begin();
-
-  // — Initialize SPI for the OLED (SSD1351 uses VSPI MOSI/SCLK; MISO isn’t used)
-  SPI.begin(
-    OLED_SCLK,   // SCLK = GPIO 18
-    /* MISO */ -1,
-    OLED_MOSI,   // MOSI = GPIO 23
-    OLED_CS      // CS   = GPIO  5
-  );
-
-  // — Hardware reset pulse on the OLED’s RST pin
-  pinMode(OLED_RST, OUTPUT);
-  digitalWrite(OLED_RST, LOW);
-  delay(10);
-  digitalWrite(OLED_RST, HIGH);
-  delay(10);
-
-  // — Initialize the SSD1351 display (8 MHz SPI, 16-bit color)
-  oled.begin();
-
-  // ──────────────── Rotate 90° clockwise ────────────────
-  oled.setRotation(3);
-  // ────────────────────────────────────────────────────────
-
-  // — Draw initial placeholders (“--F” etc.) so you see them only briefly
-  snprintf(lineStr[0], sizeof(lineStr[0]), "TEMP: --F");
-  snprintf(lineStr[1], sizeof(lineStr[1]), "L:-- H:--");
-  snprintf(lineStr[2], sizeof(lineStr[2]), "HUMID: --%%");
-  snprintf(lineStr[3], sizeof(lineStr[3]), "L:-- H:--");
-  drawReadings(0, 0);
-  lastPhase = (int)((millis() / 60000UL) % 4);
-
-  // — Connect to Wi-Fi
-  Serial.printf("Connecting to Wi-Fi SSID \"%s\" …\n", ssid);
-  WiFi.begin(ssid, password);
-  while (WiFi.status() != WL_CONNECTED) {
-    delay(250);
-    Serial.print(".");
-  }
-  Serial.println();
-  Serial.print("Wi-Fi connected. IP = ");
-  Serial.println(WiFi.localIP());
-
-  // ────────────────────────────────────────────────────────────────────────────
-  // Set up NTP time synchronization (UTC, no DST).
-  configTime(0, 0, "pool.ntp.org", "time.nist.gov");
-
-  Serial.print("Waiting for NTP time sync");
-  time_t now;
-  while ((now = time(nullptr)) < 100000) {
-    // time(nullptr) will be < 100000 until NTP replies. (Zero on boot.)
-    delay(500);
-    Serial.print(".");
-  }
-  Serial.println();
-  Serial.printf("NTP synced, current UNIX time = %lu\n", now);
-
-  // ────────────────────────────────────────────────────────────────────────────
-  // Set up HTTP handlers
-  server.on("/",            handleRoot);
-  server.on("/sensor-data", handleSensorData);
-  server.begin();
-  Serial.println("HTTP server started");
-}
-
-void loop() {
-  // — Handle any pending HTTP requests
-  server.handleClient();
-
-  // — Read DHT22 every 2 seconds
-  if (millis() - lastReadTime >= 2000UL) {
-    lastReadTime = millis();
-
-    sensors_event_t event;
-    // a) Read temperature in °C → convert to °F
-    dht.temperature().getEvent(&event);
-    if (!isnan(event.temperature)) {
-      currentTempF = event.temperature * 9.0 / 5.0 + 32.0;
-      tMin = min(tMin, currentTempF);
-      tMax = max(tMax, currentTempF);
-    } else {
-      Serial.println(F("Error reading temperature!"));
-    }
-
-    // b) Read humidity
-    dht.humidity().getEvent(&event);
-    if (!isnan(event.relative_humidity)) {
-      currentHum = event.relative_humidity;
-      hMin = min(hMin, currentHum);
-      hMax = max(hMax, currentHum);
-    } else {
-      Serial.println(F("Error reading humidity!"));
-    }
-
-    // c) Update lineStr[] so the OLED shows real data instead of “--F”
-    {
-      // “TEMP: XXF”
-      int tf = (int)round(currentTempF);
-      snprintf(lineStr[0], sizeof(lineStr[0]), "TEMP: %dF", tf);
-
-      // “L:XX H:YY”
-      int tmin_i = (int)round(tMin);
-      int tmax_i = (int)round(tMax);
-      snprintf(lineStr[1], sizeof(lineStr[1]), "L:%d H:%d", tmin_i, tmax_i);
-
-      // “HUMID: ZZ%”
-      int h_i = (int)round(currentHum);
-      snprintf(lineStr[2], sizeof(lineStr[2]), "HUMID: %d%%", h_i);
-
-      // “L:AA H:BB”
-      int hmin_i = (int)round(hMin);
-      int hmax_i = (int)round(hMax);
-      snprintf(lineStr[3], sizeof(lineStr[3]), "L:%d H:%d", hmin_i, hmax_i);
-    }
-
-    // d) Record “lastUpdateTime” from NTP
-    lastUpdateTime = (uint32_t) time(nullptr);
-  }
-
-  // — Jiggle the OLED contents once per minute to prevent burn-in
-  {
-    int phase = (int)((millis() / 60000UL) % 4);
-    if (phase != lastPhase) {
-      lastPhase = phase;
-      int16_t offsetX = 0, offsetY = 0;
-      switch (phase) {
-        case 0: offsetX =  1; offsetY =  0; break; // shift right 1px
-        case 1: offsetX =  1; offsetY = -1; break; // shift up    1px
-        case 2: offsetX =  0; offsetY = -1; break; // shift left  1px
-        case 3: offsetX =  0; offsetY =  0; break; // shift down  1px
-      }
-      drawReadings(offsetX, offsetY);
-    }
-  }
-  // No extra delay—server.handleClient() and DHT logic are nonblocking.
-}
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 1) handleRoot() → serve the updated HTML page
-// ──────────────────────────────────────────────────────────────────────────────
-void handleRoot() {
-  String html = getHtmlPage();
-  server.send(200, "text/html", html);
-}
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 2) handleSensorData() → return JSON fields for the webpage’s fetch()
-// ──────────────────────────────────────────────────────────────────────────────
-void handleSensorData() {
-  StaticJsonDocument<256> doc;
-  doc["temperature"]  = isnan(currentTempF) ? -999.0 : currentTempF;
-  doc["humidity"]     = isnan(currentHum)     ? -1.0   : currentHum;
-  doc["temp_low"]     = isnan(tMin)           ? -999.0 : tMin;
-  doc["temp_high"]    = isnan(tMax)           ? -999.0 : tMax;
-  doc["hum_low"]      = isnan(hMin)           ? -1.0   : hMin;
-  doc["hum_high"]     = isnan(hMax)           ? -1.0   : hMax;
-  doc["last_updated"] = lastUpdateTime;
-  String payload;
-  serializeJson(doc, payload);
-  server.send(200, "application/json", payload);
-}
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 3) drawReadings(offsetX, offsetY) → clear + print the four lines from lineStr[]
-// ──────────────────────────────────────────────────────────────────────────────
-void drawReadings(int16_t offsetX, int16_t offsetY) {
-  oled.fillScreen(COLOR_BLACK);
-
-  // Compute pixel-width of each line
-  int widths[4];
-  for (int i = 0; i < 4; i++) {
-    widths[i] = strlen(lineStr[i]) * CHAR_WIDTH;
-  }
-
-  // Total height: 4 lines × 16px + 3 gaps × 8px = 88px
-  const int totalBlockH = 4 * CHAR_HEIGHT + 3 * 8;
-  const int yStart = (SCREEN_HEIGHT - totalBlockH) / 2; // = 20px
-
-  oled.setTextSize(TEXT_SIZE);
-
-  // Line 0: “TEMP: XXF” in RED
-  oled.setTextColor(COLOR_RED);
-  int16_t x0 = (SCREEN_WIDTH - widths[0]) / 2 + offsetX;
-  int16_t y0 = yStart + 0 * (CHAR_HEIGHT + 8) + offsetY;
-  oled.setCursor(x0, y0);
-  oled.print(lineStr[0]);
-
-  // Line 1: “L:XX H:YY” in RED
-  int16_t x1 = (SCREEN_WIDTH - widths[1]) / 2 + offsetX;
-  int16_t y1 = yStart + 1 * (CHAR_HEIGHT + 8) + offsetY;
-  oled.setCursor(x1, y1);
-  oled.print(lineStr[1]);
-
-  // Line 2: “HUMID: ZZ%” in BLUE
-  oled.setTextColor(COLOR_BLUE);
-  int16_t x2 = (SCREEN_WIDTH - widths[2]) / 2 + offsetX;
-  int16_t y2 = yStart + 2 * (CHAR_HEIGHT + 8) + offsetY;
-  oled.setCursor(x2, y2);
-  oled.print(lineStr[2]);
-
-  // Line 3: “L:AA H:BB” in BLUE
-  int16_t x3 = (SCREEN_WIDTH - widths[3]) / 2 + offsetX;
-  int16_t y3 = yStart + 3 * (CHAR_HEIGHT + 8) + offsetY;
-  oled.setCursor(x3, y3);
-  oled.print(lineStr[3]);
-}
-
-// ──────────────────────────────────────────────────────────────────────────────
-// 4) getHtmlPage() → return your new, mobile-friendly HTML/CSS/JS (with real fetch)
-// ──────────────────────────────────────────────────────────────────────────────
-String getHtmlPage() {
-  // We embed your updated HTML exactly (with revised script to call fetch on /sensor-data).
-  return R"rawliteral(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Potato Sensor</title>
-    <style>
-        @import url('https://fonts.googleapis.com/css2?family=Inter:wght@400;500;600;700&display=swap');
-        
-        * {
-            margin: 0;
-            padding: 0;
-            box-sizing: border-box;
-        }
-        
-        body {
-            font-family: 'Inter', sans-serif;
-            background: linear-gradient(135deg, #ffd6e8 0%, #e8f4fd 100%);
-            min-height: 100vh;
-            display: flex;
-            align-items: center;
-            justify-content: center;
-            padding: 15px;
-        }
-        
-        .container {
-            max-width: 700px;
-            width: 100%;
-        }
-        
-        .header {
-            font-size: 72px;
-            font-weight: 600;
-            color: #C8860D;
-            margin-bottom: 40px;
-            display: flex;
-            align-items: center;
-            justify-content: center;
-            gap: 20px;
-            flex-wrap: wrap;
-        }
-        
-        .potato-icon {
-            width: 150px;
-            height: 150px;
-            display: inline-block;
-            flex-shrink: 0;
-        }
-        
-        .weather-card {
-            background: rgba(255, 255, 255, 0.9);
-            backdrop-filter: blur(10px);
-            border-radius: 32px;
-            padding: 70px;
-            box-shadow: 0 20px 40px rgba(0, 0, 0, 0.1);
-            border: 1px solid rgba(255, 255, 255, 0.2);
-        }
-        
-        .metrics-container {
-            display: grid;
-            grid-template-columns: 1fr 1fr;
-            gap: 80px;
-            margin-bottom: 20px;
-        }
-        
-        .metric-section h2 {
-            font-size: 42px;
-            font-weight: 600;
-            color: #2c3e50;
-            margin-bottom: 25px;
-        }
-        
-        .metric-row {
-            display: flex;
-            justify-content: space-between;
-            align-items: center;
-            margin-bottom: 16px;
-        }
-        
-        .metric-label {
-            font-size: 24px;
-            font-weight: 500;
-            color: #8b9cb5;
-        }
-        
-        .metric-value {
-            font-size: 24px;
-            font-weight: 600;
-            color: #2c3e50;
-        }
-        
-        .current-values {
-            display: grid;
-            grid-template-columns: 1fr 1fr;
-            gap: 80px;
-            align-items: center;
-        }
-        
-        .current-humidity {
-            text-align: center;
-            margin-top: 30px;
-        }
-        
-        .current-temperature {
-            text-align: center;
-            margin-top: 30px;
-        }
-        
-        .current-value {
-            font-size: 96px;
-            font-weight: 700;
-            line-height: 1;
-        }
-        
-        .humidity-value {
-            color: #4A90E2;
-        }
-        
-        .temperature-value {
-            color: #FF6B6B;
-        }
-        
-        .last-updated {
-            text-align: center;
-            margin-top: 20px;
-            font-size: 14px;
-            color: #8b9cb5;
-        }
-        
-        /* Smooth transitions for value changes */
-        .current-value, .metric-value {
-            transition: all 0.3s ease;
-        }
-        
-        /* Enhanced responsive design */
-        @media (max-width: 768px) {
-            .weather-card {
-                padding: 40px 25px;
-            }
-            
-            .metrics-container {
-                gap: 50px;
-            }
-            
-            .current-values {
-                gap: 50px;
-            }
-            
-            .current-value {
-                font-size: 72px;
-            }
-            
-            .metric-section h2 {
-                font-size: 32px;
-            }
-            
-            .header {
-                font-size: 48px;
-            }
-            
-            .potato-icon {
-                width: 120px;
-                height: 120px;
-            }
-        }
-        
-        @media (max-width: 480px) {
-            body {
-                padding: 15px 10px 30px 10px;
-                align-items: flex-start;
-                min-height: 100vh;
-                background-attachment: fixed;
-            }
-            
-            .container {
-                width: 100%;
-                min-height: calc(100vh - 45px);
-                display: flex;
-                flex-direction: column;
-                justify-content: flex-start;
-            }
-            
-            .header {
-                font-size: 36px;
-                flex-direction: column;
-                gap: 15px;
-                margin-bottom: 25px;
-                margin-top: 20px;
-            }
-            
-            .potato-icon {
-                width: 100px;
-                height: 100px;
-            }
-            
-            .weather-card {
-                padding: 30px 20px 40px 20px;
-                border-radius: 24px;
-                margin-bottom: 20px;
-                flex: 1;
-                display: flex;
-                flex-direction: column;
-            }
-            
-            .metrics-container {
-                grid-template-columns: 1fr;
-                gap: 35px;
-                margin-bottom: 20px;
-                text-align: center;
-            }
-            
-            .current-values {
-                display: none;
-            }
-            
-            .current-value {
-                font-size: 64px;
-            }
-            
-            .metric-section h2 {
-                font-size: 28px;
-                margin-bottom: 20px;
-            }
-            
-            .metric-label, .metric-value {
-                font-size: 20px;
-            }
-        }
-        
-        @media (max-width: 375px) {
-            .current-value {
-                font-size: 56px;
-            }
-            
-            .header {
-                font-size: 32px;
-                margin-top: 15px;
-            }
-            
-            .metric-section h2 {
-                font-size: 24px;
-            }
-            
-            .metric-label, .metric-value {
-                font-size: 18px;
-            }
-            
-            .weather-card {
-                padding: 25px 15px 35px 15px;
-            }
-            
-            body {
-                padding: 10px 10px 25px 10px;
-            }
-        }
-        
-        /* Fix for very tall phones in portrait */
-        @media (max-height: 700px) and (max-width: 480px) {
-            body {
-                align-items: flex-start;
-                padding-top: 20px;
-            }
-        }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <h1 class="header">
-            <svg class="potato-icon" viewBox="0 0 100 100" xmlns="http://www.w3.org/2000/svg">
-                <!-- Potato body -->
-                <ellipse cx="50" cy="55" rx="28" ry="35" fill="#D4A574" stroke="#B8956A" stroke-width="2"/>
-                
-                <!-- Potato eyes (little spots) -->
-                <ellipse cx="40" cy="45" rx="3" ry="2" fill="#8B7355"/>
-                <ellipse cx="60" cy="40" rx="2" ry="3" fill="#8B7355"/>
-                <ellipse cx="45" cy="65" rx="2" ry="2" fill="#8B7355"/>
-                <ellipse cx="58" cy="70" rx="3" ry="2" fill="#8B7355"/>
-                
-                <!-- Cute face -->
-                <circle cx="42" cy="50" r="2" fill="#654321"/>
-                <circle cx="58" cy="50" r="2" fill="#654321"/>
-                <path d="M 46 60 Q 50 65 54 60" stroke="#654321" stroke-width="2" fill="none" stroke-linecap="round"/>
-                
-                <!-- Small highlight -->
-                <ellipse cx="45" cy="42" rx="4" ry="6" fill="#E8C49A" opacity="0.7"/>
-            </svg>
-            Potato Sensor
-        </h1>
-        
-        <div class="weather-card">
-            <div class="metrics-container">
-                <div class="metric-section">
-                    <h2>Humidity</h2>
-                    <div class="metric-row">
-                        <span class="metric-label">High</span>
-                        <span class="metric-value" id="humidity-high">--%</span>
-                    </div>
-                    <div class="metric-row">
-                        <span class="metric-label">Low</span>
-                        <span class="metric-value" id="humidity-low">--%</span>
-                    </div>
-                    <div class="current-humidity">
-                        <div class="current-value humidity-value" id="current-humidity">--%</div>
-                    </div>
-                </div>
-                
-                <div class="metric-section">
-                    <h2>Temperature</h2>
-                    <div class="metric-row">
-                        <span class="metric-label">High</span>
-                        <span class="metric-value" id="temp-high">--°</span>
-                    </div>
-                    <div class="metric-row">
-                        <span class="metric-label">Low</span>
-                        <span class="metric-value" id="temp-low">--°</span>
-                    </div>
-                    <div class="current-temperature">
-                        <div class="current-value temperature-value" id="current-temperature">--°</div>
-                    </div>
-                </div>
-            </div>
-            
-            <div class="last-updated" id="last-updated">
-                Last updated: Never
-            </div>
-        </div>
-    </div>
-
-    <script>
-        // Called whenever we get new JSON from /sensor-data
-        function updateSensorData(data) {
-            // Current readings
-            document.getElementById('current-temperature').textContent = Math.round(data.temperature) + '°';
-            document.getElementById('current-humidity').textContent    = Math.round(data.humidity)    + '%';
-
-            // Min/Max from JSON
-            document.getElementById('temp-low').textContent      = Math.round(data.temp_low)    + '°';
-            document.getElementById('temp-high').textContent     = Math.round(data.temp_high)   + '°';
-            document.getElementById('humidity-low').textContent  = Math.round(data.hum_low)     + '%';
-            document.getElementById('humidity-high').textContent = Math.round(data.hum_high)    + '%';
-
-            // “Last updated”: convert UNIX timestamp (seconds) to JS Date
-            const tsMs = data.last_updated * 1000; 
-            const dt   = new Date(tsMs);
-            document.getElementById('last-updated').textContent =
-                'Last updated: ' + dt.toLocaleString();
-        }
-
-        // Fetch JSON from ESP32 every 3 seconds
-        function fetchSensorData() {
-            fetch('/sensor-data')
-                .then(response => response.json())
-                .then(json => updateSensorData(json))
-                .catch(error => console.error('Error fetching sensor-data:', error));
-        }
-
-        setInterval(fetchSensorData, 3000);
-        fetchSensorData(); // Initial call when page loads
-    </script>
-</body>
-</html>
-  )rawliteral";
-}
+#include <Arduino.h>
+#include <SPI.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <LittleFS.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1351.h>
+#include <esp_freertos_hooks.h>
+#include <stdarg.h>
+#include <time.h>           // Needed for NTP/time functions
+#include "app.h"            // Platform-independent application logic
+#include "hal.h"            // …which reaches the hardware through these calls
+#include "dht22.h"          // Interrupt-driven, non-blocking DHT22 driver
+#include "sht3x.h"          // Non-blocking SHT3x driver (I2C)
+#include "http_server.h"    // Non-blocking HTTP/1.1 server over lwIP sockets
+#include "trace.h"          // Event trace rings, served at /trace
+
+// ──────────────────────────────────────────────────────────────────────────────
+// USER CONFIGURATION: Change these to match your Wi-Fi SSID/password.
+// ──────────────────────────────────────────────────────────────────────────────
+const char* ssid     = "ssid";
+const char* password = "password";
+
+// Local time zone (POSIX TZ string) for the "today" min/max, which resets at
+// local midnight. E.g. "EST5EDT,M3.2.0,M11.1.0" or "CET-1CEST,M3.5.0,M10.5.0/3".
+const char* tzInfo   = "UTC0";
+
+// Collector the readings are pushed to in batches (see README, "Uplink"),
+// e.g. "http://192.168.1.10:8086/ingest". Empty = no uplink.
+const char* uplinkUrl = "";
+
+// Webhook each alert rule's firing/cleared transition is POSTed to as JSON
+// (see README, "Alerts"), e.g. "http://192.168.1.10:8086/alert". Plain HTTP
+// only. Empty = alerts show only on the OLED and in /metrics.
+const char* alertWebhookUrl = "";
+
+// Longest gap between reads while the room holds still (see README,
+// "Adaptive Sampling"); reads speed back up to every 2 s as soon as it
+// changes. Keep it well under the "sensor" alert's 60 s. 2000 = always 2 s.
+const uint32_t sampleMaxPeriodMs = 30000;
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 1) Pin Definitions (ESP32 DevKit ↔ Waveshare 1.5" SSD1351)
+// ──────────────────────────────────────────────────────────────────────────────
+static const uint8_t OLED_MOSI = 23;  // VSPI MOSI
+static const uint8_t OLED_SCLK = 18;  // VSPI SCLK
+static const uint8_t OLED_DC   = 16;  // Data/Command pin
+static const uint8_t OLED_RST  = 17;  // Reset pin
+static const uint8_t OLED_CS   = 5;   // Chip Select pin
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 2) Instantiate Adafruit_SSD1351 (SCREEN_WIDTH/HEIGHT come from hal.h)
+// ──────────────────────────────────────────────────────────────────────────────
+Adafruit_SSD1351 oled(SCREEN_WIDTH, SCREEN_HEIGHT, &SPI, OLED_CS, OLED_DC, OLED_RST);
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 3) Probes. One row per sensor, up to APP_MAX_SENSORS; the first row is the
+//    original DHT22 on GPIO 22. Each DHT22 needs a GPIO of its own; SHT3x
+//    probes share the I2C bus (SDA 21, SCL 19) at address 0x44 or 0x45.
+//    Reads are staggered by the application's scheduler, one at a time.
+// ──────────────────────────────────────────────────────────────────────────────
+#define DHTPIN   22
+static const uint8_t I2C_SDA = 21;
+static const uint8_t I2C_SCL = 19;
+
+Dht22 dht(DHTPIN);
+// Sht3x shtDoor(0x44);
+
+struct Probe {
+  HalSensorInfo info;
+  Dht22*        dht;                  // exactly one of these is set
+  Sht3x*        sht;
+};
+
+Probe probes[] = {
+  { { "pile", SENSOR_DHT22, 2000 }, &dht, nullptr },
+  // { { "door", SENSOR_SHT3X, 100 }, nullptr, &shtDoor },
+};
+static const size_t PROBE_COUNT = sizeof(probes) / sizeof(probes[0]);
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 4) HTTP server on port 80: a pool of keep-alive connections plus the
+//    sockets handed out by halHttpDetach() (see http_server.h)
+// ──────────────────────────────────────────────────────────────────────────────
+HttpServer http;
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 5) FreeRTOS tasks. Sensing and display share core 1; the web server runs on
+//    core 0 next to the Wi-Fi stack, so a slow HTTP client can't delay a
+//    sensor read and an OLED redraw can't delay HTTP.
+//
+//        task      core  prio  runs
+//        sensor     1     3    appSensorStep()
+//        display    1     1    appDisplayStep()
+//        web        0     2    http.process() + appWebStep()
+//        uplink     0     1    appUplinkStep(), only with an uplinkUrl; it
+//                              blocks in HTTPClient for each batch POST
+//        alert      0     1    appAlertStep(), only with an alertWebhookUrl;
+//                              blocks in HTTPClient for each webhook POST
+//
+//    Every task, and loop(), blocks until it has something to do, so the
+//    cores spend their time in the idle task (waiting for an interrupt):
+//
+//        sensor    its own deadline: the next read, or 1 ms ticks while one
+//                  is in flight (≈6 ms for a DHT22, 16 ms for an SHT3x)
+//        display   a new sample (task notification), else 1 s
+//        alert     a new sample, else its retry backoff or 60 s
+//        web       socket activity, a new sample (its wake socket) or a
+//                  connection timeout (see section C)
+//        loop()    a Wi-Fi event, else its next backoff/timeout deadline
+// ──────────────────────────────────────────────────────────────────────────────
+// Stack sizes in bytes (ESP-IDF counts FreeRTOS stacks in bytes). The sensor
+// task runs the decoders, the float formatting of the snapshot and, every few
+// minutes, a LittleFS append under the sample log: 4 KB left it too little
+// headroom. /metrics reports each task's low-water mark as
+// potato_task_stack_min_free_bytes; keep it above about 1 KB when changing
+// what a task does.
+static const uint32_t SENSOR_STACK  = 6144;
+static const uint32_t DISPLAY_STACK = 4096;
+static const uint32_t WEB_STACK     = 8192;
+static const uint32_t UPLINK_STACK  = 6144;
+static const uint32_t ALERT_STACK   = 6144;
+#ifndef CONFIG_ARDUINO_LOOP_STACK_SIZE
+#define CONFIG_ARDUINO_LOOP_STACK_SIZE 8192   // the core's default for loop()
+#endif
+
+TaskHandle_t sensorTaskHandle  = nullptr;
+TaskHandle_t displayTaskHandle = nullptr;
+TaskHandle_t webTaskHandle     = nullptr;
+TaskHandle_t uplinkTaskHandle  = nullptr;
+TaskHandle_t alertTaskHandle   = nullptr;
+TaskHandle_t loopTaskHandle    = nullptr;
+SemaphoreHandle_t historyLock  = nullptr;   // sensor task appends, web task streams
+bool fsMounted = false;                     // LittleFS is up (sample log)
+char unitId[16];                            // "potato-xxyyzz" from the MAC, for the uplink
+WiFiClient uplinkClient;
+WiFiClient alertClient;
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 6) Network bring-up, driven from loop() so boot never waits on it.
+//    Wi-Fi is retried with exponential backoff (1 s → 60 s) and re-entered
+//    whenever the link drops. NTP is started on the first connection; the
+//    application rebases boot-relative timestamps once the clock is valid.
+//    Wi-Fi events wake loop(); the recheck only covers a missed one.
+// ──────────────────────────────────────────────────────────────────────────────
+enum class NetState : uint8_t { Backoff, Connecting, Connected };
+NetState netState     = NetState::Backoff;
+uint32_t netSince     = 0;       // millis() when netState was entered
+uint32_t netBackoffMs = 0;       // wait before the next WiFi.begin()
+bool     ntpStarted   = false;
+static const uint32_t WIFI_CONNECT_TIMEOUT_MS = 15000;
+static const uint32_t WIFI_BACKOFF_MAX_MS     = 60000;
+static const uint32_t NET_RECHECK_MS          = 10000;
+
+// ──────────────────────────────────────────────────────────────────────────────
+// 7) Power. The web task sleeps in poll() on the server's sockets, so a new
+//    connection or request wakes it at once. A new sample wakes it through
+//    webWakeFd, a UDP socket connected to itself over lwIP's loopback:
+//    halNotifySample() sends it one byte. Otherwise poll() only returns for
+//    the next connection timeout or the end of WIFI_AWAKE_MS.
+//
+//    Wi-Fi modem sleep (the radio wakes only for the AP's DTIM beacons) is
+//    on while nobody is using the web server. It delays the first packet of
+//    a new connection by up to one DTIM interval (≈100–300 ms), so it is
+//    switched off for WIFI_AWAKE_MS after each request: the rest of a page
+//    load (/sensor-data, /history, /events) is answered at full speed.
+//    /events pushes don't need it off; the radio wakes to transmit.
+//
+//    Idle time is sampled from the tick interrupt: on each core, every tick
+//    notes whether that core's idle task was the one running.
+// ──────────────────────────────────────────────────────────────────────────────
+static const uint32_t WIFI_AWAKE_MS    = 5000;
+int               webWakeFd     = -1;       // readable after halNotifySample()
+volatile uint32_t lastRequestMs = 0;        // millis() of the last routed request
+bool              modemSleep    = true;     // as last set by WiFi.setSleep()
+
+TaskHandle_t      idleTask[2];
+volatile uint32_t cpuTicks[2], cpuIdleTicks[2];
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Forward declarations
+// ──────────────────────────────────────────────────────────────────────────────
+void sensorTask(void*);
+void displayTask(void*);
+void webTask(void*);
+void uplinkTask(void*);
+void alertTask(void*);
+uint32_t serviceNetwork();
+void updateModemSleep(uint32_t now);
+void onWifiEvent(arduino_event_id_t event);
+void startCpuSampling();
+bool openWebWake();
+
+void setup() {
+  // — Serial for debugging
+  Serial.begin(115200);
+  delay(200);
+
+  // — Initialize the probes (the I2C bus only if an SHT3x is fitted)
+  bool needI2c = false;
+  for (Probe& p : probes) {
+    if (p.dht) p.dht->begin();
+    needI2c = needI2c || p.sht;
+  }
+  if (needI2c) Wire.begin(I2C_SDA, I2C_SCL, 100000);
+
+  // — Initialize SPI for the OLED (SSD1351 uses VSPI MOSI/SCLK; MISO isn’t used)
+  SPI.begin(
+    OLED_SCLK,   // SCLK = GPIO 18
+    /* MISO */ -1,
+    OLED_MOSI,   // MOSI = GPIO 23
+    OLED_CS      // CS   = GPIO  5
+  );
+
+  // — Hardware reset pulse on the OLED’s RST pin
+  pinMode(OLED_RST, OUTPUT);
+  digitalWrite(OLED_RST, LOW);
+  delay(10);
+  digitalWrite(OLED_RST, HIGH);
+  delay(10);
+
+  // — Initialize the SSD1351 display (8 MHz SPI, 16-bit color)
+  oled.begin();
+
+  // ──────────────── Rotate 90° clockwise ────────────────
+  oled.setRotation(3);
+  // ────────────────────────────────────────────────────────
+
+  historyLock = xSemaphoreCreateMutex();
+
+  // — Flash filesystem for the sample log (formatted on first boot), and the
+  //   time zone up front so the log's "today" replays against local midnight
+  fsMounted = LittleFS.begin(true);
+  if (!fsMounted) Serial.println("LittleFS mount failed; sample log disabled");
+  setenv("TZ", tzInfo, 1);
+  tzset();
+
+  // — Wi-Fi station mode brings up the network stack so the server can bind
+  //   now; the actual connection (and NTP) is handled by loop()
+  WiFi.mode(WIFI_STA);
+  WiFi.setAutoReconnect(false);
+  WiFi.setSleep(modemSleep);
+  loopTaskHandle = xTaskGetCurrentTaskHandle();   // setup() runs in loop()'s task
+  WiFi.onEvent(onWifiEvent);
+  uint8_t mac[6];
+  WiFi.macAddress(mac);
+  snprintf(unitId, sizeof(unitId), "potato-%02x%02x%02x", mac[3], mac[4], mac[5]);
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Placeholder screen, empty snapshot and HTTP routes, then start serving
+  appSetup();
+  if (http.begin(80)) Serial.println("HTTP server started");
+  else                Serial.printf("HTTP server failed to start (errno %d)\n", errno);
+  if (!openWebWake()) Serial.printf("Web wake socket failed (errno %d); polling every 1 s\n", errno);
+
+  // ────────────────────────────────────────────────────────────────────────────
+  // Start the worker tasks (see section 5)
+  startCpuSampling();
+  xTaskCreatePinnedToCore(sensorTask,  "sensor",  SENSOR_STACK,  nullptr, 3, &sensorTaskHandle,  1);
+  xTaskCreatePinnedToCore(displayTask, "display", DISPLAY_STACK, nullptr, 1, &displayTaskHandle, 1);
+  xTaskCreatePinnedToCore(webTask,     "web",     WEB_STACK,     nullptr, 2, &webTaskHandle,     0);
+  if (halUplinkEnabled()) {
+    xTaskCreatePinnedToCore(uplinkTask, "uplink", UPLINK_STACK, nullptr, 1, &uplinkTaskHandle, 0);
+  }
+  if (halWebhookEnabled()) {
+    xTaskCreatePinnedToCore(alertTask,  "alert",  ALERT_STACK,  nullptr, 1, &alertTaskHandle,  0);
+  }
+}
+
+void loop() {
+  // Sensing, display and HTTP run in the tasks started by setup(); the Arduino
+  // loop task only looks after Wi-Fi and NTP, and sleeps in between.
+  const uint32_t t0 = micros();
+  TRACE_BEGIN(TRACE_NET_STEP, 0);
+  const uint32_t waitMs = serviceNetwork();
+  TRACE_END(TRACE_NET_STEP);
+  metrics.netStep.observe(micros() - t0);
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// A) sensorTask() → appSensorStep(), sleeping for as long as it allows
+// ──────────────────────────────────────────────────────────────────────────────
+void sensorTask(void*) {
+  for (;;) {
+    uint32_t ms = appSensorStep();
+    TickType_t ticks = pdMS_TO_TICKS(ms);
+    vTaskDelay(ticks > 0 ? ticks : 1);
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// B) displayTask() → woken by the sensor task per sample; the timeout catches
+//    burn-in phase changes
+// ──────────────────────────────────────────────────────────────────────────────
+void displayTask(void*) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+    appDisplayStep();
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// C) webTask() → serve HTTP; re-render /sensor-data and push /events once per
+//    new snapshot. Blocks in poll() until a socket is ready, a new sample
+//    arrives on webWakeFd, the next connection timeout is due, or modem
+//    sleep is due back on (section 7).
+// ──────────────────────────────────────────────────────────────────────────────
+void webTask(void*) {
+  pollfd fds[HTTP_POLL_FDS + 1];
+  for (;;) {
+    const int n = http.pollSet(fds);
+    fds[n] = { webWakeFd, POLLIN, 0 };             // poll() skips a negative fd
+    const uint32_t untilUs = http.untilTimeoutUs();
+    int timeoutMs = untilUs == UINT32_MAX ? -1 : (int)(untilUs / 1000 + 1);   // rounded up
+    if (!modemSleep) {
+      const uint32_t awake = millis() - lastRequestMs;
+      const int left = awake >= WIFI_AWAKE_MS ? 0 : (int)(WIFI_AWAKE_MS - awake);
+      if (timeoutMs < 0 || left < timeoutMs) timeoutMs = left;
+    }
+    if (webWakeFd < 0 && (timeoutMs < 0 || timeoutMs > 1000)) timeoutMs = 1000;
+    int ready = poll(fds, n + 1, timeoutMs);
+    if (ready > 0 && fds[n].revents) {
+      uint8_t drain[8];
+      while (recv(webWakeFd, drain, sizeof(drain), MSG_DONTWAIT) > 0) {}
+      ready--;
+    }
+    const uint32_t t0 = micros();
+    if (ready > 0) TRACE_BEGIN(TRACE_HTTP_PASS, 0);
+    if (http.process(fds, ready > 0 ? n : 0) > 0) lastRequestMs = millis();
+    if (ready > 0) {
+      TRACE_END(TRACE_HTTP_PASS);
+      metrics.httpService.observe(micros() - t0);
+    }
+    appWebStep();
+    updateModemSleep(millis());
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// D) uplinkTask() → appUplinkStep(), sleeping for as long as it allows
+//    (the step itself waits out each POST)
+// ──────────────────────────────────────────────────────────────────────────────
+void uplinkTask(void*) {
+  for (;;) {
+    uint32_t ms = appUplinkStep();
+    TickType_t ticks = pdMS_TO_TICKS(ms);
+    vTaskDelay(ticks > 0 ? ticks : 1);
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// D1) alertTask() → appAlertStep(); woken by each sample, since the sensor
+//     task may just have queued an alert
+// ──────────────────────────────────────────────────────────────────────────────
+void alertTask(void*) {
+  for (;;) {
+    uint32_t ms = appAlertStep();
+    if (ms > 0) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// E) serviceNetwork() → one step of the Wi-Fi / NTP state machine (section 6);
+//    returns how long loop() may sleep if no Wi-Fi event comes first
+// ──────────────────────────────────────────────────────────────────────────────
+uint32_t serviceNetwork() {
+  const uint32_t now = millis();
+
+  switch (netState) {
+    case NetState::Backoff:
+      if (now - netSince < netBackoffMs) return netBackoffMs - (now - netSince);
+      Serial.printf("Connecting to Wi-Fi SSID \"%s\" …\n", ssid);
+      WiFi.begin(ssid, password);
+      netState = NetState::Connecting;
+      netSince = now;
+      return WIFI_CONNECT_TIMEOUT_MS;
+
+    case NetState::Connecting:
+      if (WiFi.status() == WL_CONNECTED) {
+        Serial.print("Wi-Fi connected. IP = ");
+        Serial.println(WiFi.localIP());
+        netState     = NetState::Connected;
+        netSince     = now;
+        netBackoffMs = 0;
+        if (!ntpStarted) {
+          // Set up NTP time synchronization in the configured time zone.
+          // SNTP keeps polling on its own from here, across later reconnects.
+          configTzTime(tzInfo, "pool.ntp.org", "time.nist.gov");
+          ntpStarted = true;
+        }
+        return NET_RECHECK_MS;
+      }
+      if (now - netSince < WIFI_CONNECT_TIMEOUT_MS) return WIFI_CONNECT_TIMEOUT_MS - (now - netSince);
+      WiFi.disconnect();
+      netBackoffMs = netBackoffMs == 0 ? 1000 : min(netBackoffMs * 2, WIFI_BACKOFF_MAX_MS);
+      Serial.printf("Wi-Fi connect timed out; retrying in %lu s\n",
+                    (unsigned long)(netBackoffMs / 1000));
+      netState = NetState::Backoff;
+      netSince = now;
+      return netBackoffMs;
+
+    case NetState::Connected:
+      if (WiFi.status() == WL_CONNECTED) return NET_RECHECK_MS;
+      Serial.println("Wi-Fi connection lost");
+      WiFi.disconnect();
+      netBackoffMs = 1000;
+      netState     = NetState::Backoff;
+      netSince     = now;
+      return netBackoffMs;
+  }
+  return NET_RECHECK_MS;
+}
+
+// Runs in the Wi-Fi event task: only wake loop(), which does the work
+void onWifiEvent(arduino_event_id_t event) {
+  if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP || event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+    if (loopTaskHandle) xTaskNotifyGive(loopTaskHandle);
+  }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// F) Power helpers (section 7)
+// ──────────────────────────────────────────────────────────────────────────────
+// One byte to webWakeFd wakes the web task; sent from halNotifySample(). A
+// full receive queue already means a wakeup is pending, so drops are fine.
+bool openWebWake() {
+  const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) return false;
+  sockaddr_in addr = {};
+  addr.sin_family      = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t len = sizeof(addr);
+  if (bind(fd, (sockaddr*) &addr, sizeof(addr)) < 0 ||
+      getsockname(fd, (sockaddr*) &addr, &len) < 0 ||
+      connect(fd, (sockaddr*) &addr, sizeof(addr)) < 0) {
+    const int err = errno;
+    close(fd);
+    errno = err;
+    return false;
+  }
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  webWakeFd = fd;
+  return true;
+}
+
+// Radio fully awake while requests keep coming, modem sleep once they stop.
+// Only transitions call into the Wi-Fi driver.
+void updateModemSleep(uint32_t now) {
+  const bool sleep = now - lastRequestMs >= WIFI_AWAKE_MS;
+  if (sleep == modemSleep) return;
+  WiFi.setSleep(sleep);
+  modemSleep = sleep;
+}
+
+// Tick interrupts, one per core: FreeRTOS lives in IRAM, so the task-handle
+// lookups are safe here even while flash is busy
+static void IRAM_ATTR cpuTick(int cpu) {
+  cpuTicks[cpu]++;
+#if ESP_IDF_VERSION_MAJOR >= 5
+  if (xTaskGetCurrentTaskHandleForCore(cpu) == idleTask[cpu]) cpuIdleTicks[cpu]++;
+#else
+  if (xTaskGetCurrentTaskHandleForCPU(cpu) == idleTask[cpu]) cpuIdleTicks[cpu]++;
+#endif
+}
+static void IRAM_ATTR cpuTick0() { cpuTick(0); }
+static void IRAM_ATTR cpuTick1() { cpuTick(1); }
+
+void startCpuSampling() {
+  for (int cpu = 0; cpu < 2; cpu++) {
+#if ESP_IDF_VERSION_MAJOR >= 5
+    idleTask[cpu] = xTaskGetIdleTaskHandleForCore(cpu);
+#else
+    idleTask[cpu] = xTaskGetIdleTaskHandleForCPU(cpu);
+#endif
+  }
+  esp_register_freertos_tick_hook_for_cpu(cpuTick0, 0);
+  esp_register_freertos_tick_hook_for_cpu(cpuTick1, 1);
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// HAL implementation for the ESP32 (see hal.h)
+// ──────────────────────────────────────────────────────────────────────────────
+
+// — Clock / logging
+uint32_t halMillis()     { return millis(); }
+time_t   halTime()       { return time(nullptr); }
+uint32_t halPerfMicros() { return micros(); }
+
+// — Trace clock: CCOUNT of the running core, and the FreeRTOS tick (1 kHz)
+uint32_t halCycleCount()  { return ESP.getCycleCount(); }
+uint32_t halCyclesPerUs() { return getCpuFrequencyMhz(); }
+uint32_t halTickMs()      { return xTaskGetTickCount() * portTICK_PERIOD_MS; }
+uint8_t  halCpuId()       { return (uint8_t) xPortGetCoreID(); }
+
+void halLog(const char* fmt, ...) {
+  char buf[192];
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  Serial.print(buf);
+}
+
+// — Sensors
+size_t               halSensorCount()        { return PROBE_COUNT; }
+const HalSensorInfo& halSensorInfo(size_t i) { return probes[i].info; }
+uint32_t             halSensorMaxPeriodMs()  { return sampleMaxPeriodMs; }
+
+void halSensorStart(size_t i) {
+  if (probes[i].dht) probes[i].dht->start();
+  else               probes[i].sht->start();
+}
+
+void halSensorPoll(size_t i) {
+  if (probes[i].dht) probes[i].dht->poll();
+  else               probes[i].sht->poll();
+}
+
+bool halSensorBusy(size_t i) {
+  return probes[i].dht ? probes[i].dht->busy() : probes[i].sht->busy();
+}
+
+bool halSensorTakeResult(size_t i, Dht22Reading& r, Dht22Status& status) {
+  return probes[i].dht ? probes[i].dht->takeResult(r, status)
+                       : probes[i].sht->takeResult(r, status);
+}
+
+// — Display
+void halDisplayFillScreen(uint16_t color) { oled.fillScreen(color); }
+
+void halDisplayFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  oled.fillRect(x, y, w, h, color);
+}
+
+void halDisplayBlit(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* pixels) {
+  if (x < 0 || y < 0 || x + w > SCREEN_WIDTH || y + h > SCREEN_HEIGHT) {
+    oled.drawRGBBitmap(x, y, (uint16_t*) pixels, w, h);   // clips; one window, a transfer per row
+    return;
+  }
+  oled.startWrite();
+  oled.setAddrWindow(x, y, w, h);
+  oled.writePixels((uint16_t*) pixels, (uint32_t) w * h);
+  oled.endWrite();
+}
+
+// — HTTP (see http_server.h; handlers run inside http.process())
+void halHttpOn(const char* path, HalHttpHandler handler) { http.on(path, handler); }
+bool halHttpArg(const char* name, char* out, size_t cap) { return http.arg(name, out, cap); }
+bool halHttpHeaderIs(const char* name, const char* value) { return http.headerIs(name, value); }
+void halHttpSendHeader(const char* name, const char* value) { http.sendHeader(name, value); }
+
+void halHttpSend(int code, const char* contentType, const void* body, size_t len) {
+  http.send(code, contentType, body, len);
+}
+
+void halHttpSendStatic(int code, const char* contentType, const void* body, size_t len) {
+  http.sendStatic(code, contentType, body, len);
+}
+
+void halHttpBeginChunked(int code, const char* contentType) { http.beginChunked(code, contentType); }
+void halHttpChunk(const void* data, size_t len)             { http.chunk(data, len); }
+void halHttpEndChunked()                                    { http.endChunked(); }
+int  halHttpDetach()                                        { return http.detach(); }
+void halHttpInfo(HalHttpInfo* out)                          { http.info(out); }
+
+bool halStreamWrite(int id, const void* data, size_t len) { return http.streamWrite(id, data, len); }
+bool halStreamOpen(int id)                                { return http.streamOpen(id); }
+void halStreamClose(int id)                               { http.streamClose(id); }
+
+// — Concurrency
+void halHistoryLock()   { xSemaphoreTake(historyLock, portMAX_DELAY); }
+void halHistoryUnlock() { xSemaphoreGive(historyLock); }
+
+void halNotifySample() {
+  if (displayTaskHandle) xTaskNotifyGive(displayTaskHandle);
+  if (alertTaskHandle)   xTaskNotifyGive(alertTaskHandle);
+  if (webWakeFd >= 0) {
+    const uint8_t wake = 1;
+    send(webWakeFd, &wake, 1, MSG_DONTWAIT);
+  }
+}
+
+uint32_t halRandom() { return esp_random(); }
+
+// — Flash files
+bool halFsMounted() { return fsMounted; }
+
+size_t halFsSize(const char* path) {
+  if (!LittleFS.exists(path)) return 0;
+  File f = LittleFS.open(path, "r");
+  return f ? f.size() : 0;
+}
+
+size_t halFsRead(const char* path, uint32_t offset, void* buf, size_t len) {
+  File f = LittleFS.open(path, "r");
+  if (!f || !f.seek(offset)) return 0;
+  return f.read((uint8_t*) buf, len);
+}
+
+// LittleFS commits on close: a power cut mid-append leaves the old file
+bool halFsAppend(const char* path, const void* data, size_t len) {
+  File f = LittleFS.open(path, "a");
+  if (!f) return false;
+  return f.write((const uint8_t*) data, len) == len;
+}
+
+bool halFsRemove(const char* path) {
+  return !LittleFS.exists(path) || LittleFS.remove(path);
+}
+
+// — Uplink and alert webhook (one connection per POST; HTTPClient's Strings
+//   live only here)
+static int postTo(WiFiClient& client, const char* url, const char* contentType,
+                  const void* body, size_t len, uint32_t timeoutMs) {
+  if (WiFi.status() != WL_CONNECTED) return -1;
+  HTTPClient http;
+  http.setConnectTimeout(timeoutMs);
+  http.setTimeout(timeoutMs);
+  if (!http.begin(client, url)) return -1;
+  http.addHeader("Content-Type", contentType);
+  http.addHeader("X-Potato-Unit", unitId);
+  const int code = http.POST((uint8_t*) body, len);   // < 0: HTTPC_ERROR_*
+  http.end();
+  return code;
+}
+
+bool halUplinkEnabled() { return uplinkUrl[0] != '\0'; }
+
+int halUplinkPost(const void* body, size_t len, uint32_t timeoutMs) {
+  return postTo(uplinkClient, uplinkUrl, "application/octet-stream", body, len, timeoutMs);
+}
+
+bool halWebhookEnabled() { return alertWebhookUrl[0] != '\0'; }
+
+int halWebhookPost(const char* json, size_t len, uint32_t timeoutMs) {
+  return postTo(alertClient, alertWebhookUrl, "application/json", json, len, timeoutMs);
+}
+
+// — Heap and CPU
+void halHeapInfo(HalHeapInfo* out) {
+  out->freeBytes        = ESP.getFreeHeap();
+  out->minFreeBytes     = ESP.getMinFreeHeap();
+  out->largestFreeBlock = ESP.getMaxAllocHeap();
+}
+
+void halCpuInfo(HalCpuInfo* out) {
+  const uint64_t usPerTick = 1000000 / configTICK_RATE_HZ;
+  out->cpus    = 2;
+  out->sinceUs = (uint64_t) cpuTicks[0] * usPerTick;
+  for (int cpu = 0; cpu < 2; cpu++) out->idleUs[cpu] = (uint64_t) cpuIdleTicks[cpu] * usPerTick;
+}
+
+size_t halTaskStacks(HalTaskStack* out, size_t max) {
+  const struct { const char* name; uint32_t bytes; TaskHandle_t* handle; } tasks[] = {
+    { "sensor",  SENSOR_STACK,  &sensorTaskHandle },
+    { "display", DISPLAY_STACK, &displayTaskHandle },
+    { "web",     WEB_STACK,     &webTaskHandle },
+    { "uplink",  UPLINK_STACK,  &uplinkTaskHandle },
+    { "alert",   ALERT_STACK,   &alertTaskHandle },
+    { "loop",    CONFIG_ARDUINO_LOOP_STACK_SIZE, &loopTaskHandle },
+  };
+  size_t n = 0;
+  for (const auto& t : tasks) {
+    if (n == max || !*t.handle) continue;           // not started (uplink, alert)
+    out[n].name         = t.name;
+    out[n].sizeBytes    = t.bytes;
+    out[n].minFreeBytes = uxTaskGetStackHighWaterMark(*t.handle);
+    n++;
+  }
+  return n;
+}
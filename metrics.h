@@ -0,0 +1,77 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// metrics.h — fixed-size counters, gauges and latency histograms for /metrics
+//
+// Everything is statically sized and updated with relaxed atomics, so the
+// hot paths (task steps, HTTP handlers, the DHT read path) never allocate,
+// lock or format. Formatting happens only when /metrics is scraped.
+//
+// Histograms use one shared bucket layout (10 µs … 0.5 s) and store plain,
+// non-cumulative bucket counts; the exporter accumulates them into
+// Prometheus' cumulative `le` buckets.
+//
+// Every atomic is 32 bits: a 64-bit std::atomic is not lock-free on the
+// ESP32's Xtensa cores and would take a lock on each observe(). A
+// histogram's sum of µs therefore wraps after 2^32 µs (≈ 71.6 min) of
+// observed time; sumUs() widens it again on the reader's side.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+static const size_t METRIC_BUCKETS = 10;
+
+// Upper bounds in µs, and the same bounds as Prometheus `le` labels (seconds)
+static const uint32_t METRIC_BUCKET_US[METRIC_BUCKETS] = {
+  10, 50, 100, 500, 1000, 5000, 10000, 50000, 100000, 500000
+};
+static const char* const METRIC_BUCKET_LE[METRIC_BUCKETS] = {
+  "1e-05", "5e-05", "0.0001", "0.0005", "0.001", "0.005", "0.01", "0.05", "0.1", "0.5"
+};
+
+class MetricCounter {
+public:
+  void     inc(uint32_t n = 1) { v_.fetch_add(n, std::memory_order_relaxed); }
+  uint32_t value() const       { return v_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint32_t> v_{0};
+};
+
+class MetricGauge {
+public:
+  void     set(uint32_t v) { v_.store(v, std::memory_order_relaxed); }
+  uint32_t value() const   { return v_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint32_t> v_{0};
+};
+
+class MetricHistogram {
+public:
+  void observe(uint32_t us) {
+    size_t b = 0;
+    while (b < METRIC_BUCKETS && us > METRIC_BUCKET_US[b]) b++;
+    counts_[b].fetch_add(1, std::memory_order_relaxed);
+    sumUs_.fetch_add(us, std::memory_order_relaxed);
+  }
+
+  // Observations in bucket i alone (i == METRIC_BUCKETS is the +Inf overflow)
+  uint32_t bucket(size_t i) const { return counts_[i].load(std::memory_order_relaxed); }
+
+  // Total µs observed since boot. The 32-bit sum is extended by what it
+  // grew since the previous call, modulo 2^32, so the result keeps counting
+  // up as long as calls are less than one wrap (≈ 71.6 min of observed
+  // time) apart; a scrape every few minutes is plenty. One reader only:
+  // the /metrics exporter.
+  uint64_t sumUs() const {
+    const uint32_t now = sumUs_.load(std::memory_order_relaxed);
+    readUs_ += (uint32_t)(now - (uint32_t) readUs_);
+    return readUs_;
+  }
+
+private:
+  std::atomic<uint32_t> counts_[METRIC_BUCKETS + 1] = {};
+  std::atomic<uint32_t> sumUs_{0};
+  mutable uint64_t      readUs_ = 0;   // reader's widened sum; its low 32 bits are the last value seen
+};
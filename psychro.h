@@ -0,0 +1,126 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// psychro.h — dew point, absolute humidity and vapour-pressure deficit from
+// one temperature / relative-humidity reading, in integer arithmetic
+//
+// Everything hangs off the saturation vapour pressure over water, from the
+// Magnus formula with the WMO coefficients:
+//
+//   es(T) = 611.2 Pa · exp(17.62 · T / (243.12 °C + T))
+//
+//   actual pressure       e   = es(T) · RH
+//   dew point             Td  : es(Td) = e
+//   absolute humidity     AH  = e · Mw / (R · T)   (2.16679 g·K/J · e / T)
+//   vapour-pressure def.  VPD = es(T) − e
+//
+// es comes from a 1 °C table (−60…125 °C, the union of the sensors' ranges
+// plus room for dry-air dew points) and linear interpolation; the dew point
+// inverts the same table with a binary search. No exp/log, no floating
+// point, no 64-bit division, so it is cheap on the ESP32 and gives the same
+// bits on the host. host/psychro_check.cpp sweeps every 0.1 °C / 0.1 %RH
+// input pair against the formulas above in double precision and checks
+// these bounds:
+//
+//   dew point          ±0.07 °C                 (rounded to 0.1 °C)
+//   absolute humidity  ±0.2 % ±0.01 g/m³
+//   VPD                ±0.11 % of es(T) ±1 Pa   (rounded to 1 Pa)
+//
+// Interpolating an exponential along chords overestimates es a little
+// between knots, most at the cold end where the curve bends hardest.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+
+static const int16_t PSYCHRO_T10_MIN  = -600;      // table span, 0.1 °C
+static const int16_t PSYCHRO_T10_MAX  = 1250;
+static const int16_t PSYCHRO_DEW_NONE = INT16_MIN; // dew point below −60 °C (or 0 %RH)
+
+// es at each whole degree from −60 °C, in mPa (generated from the
+// formula above and rounded)
+static const uint32_t PSYCHRO_ES[] = {
+       1901,      2158,      2447,      2771,      3134,      3539,      3992,      4497,  // -60 °C
+       5060,      5686,      6382,      7155,      8011,      8960,     10010,     11171,  // -52 °C
+      12452,     13865,     15423,     17137,     19021,     21092,     23364,     25855,  // -44 °C
+      28584,     31571,     34836,     38403,     42297,     46543,     51169,     56205,  // -36 °C
+      61683,     67636,     74102,     81117,     88723,     96964,    105885,    115534,  // -28 °C
+     125965,    137232,    149392,    162508,    176645,    191871,    208259,    225886,  // -20 °C
+     244833,    265184,    287031,    310468,    335593,    362514,    391339,    422185,  // -12 °C
+     455173,    490431,    528093,    568301,    611200,    656946,    705700,    757632,  // -4 °C
+     812918,    871743,    934300,   1000793,   1071430,   1146433,   1226030,   1310462,  // 4 °C
+    1399976,   1494834,   1595306,   1701672,   1814226,   1933273,   2059129,   2192122,  // 12 °C
+    2332596,   2480904,   2637415,   2802511,   2976588,   3160057,   3353343,   3556889,  // 20 °C
+    3771149,   3996598,   4233724,   4483033,   4745050,   5020314,   5309386,   5612842,  // 28 °C
+    5931279,   6265314,   6615581,   6982737,   7367458,   7770442,   8192406,   8634094,  // 36 °C
+    9096266,   9579710,  10085234,  10613672,  11165880,  11742740,  12345158,  12974067,  // 44 °C
+   13630424,  14315214,  15029448,  15774163,  16550428,  17359335,  18202007,  19079598,  // 52 °C
+   19993287,  20944289,  21933843,  22963224,  24033735,  25146714,  26303529,  27505581,  // 60 °C
+   28754305,  30051169,  31397675,  32795361,  34245797,  35750593,  37311389,  38929867,  // 68 °C
+   40607743,  42346769,  44148737,  46015477,  47948855,  49950778,  52023192,  54168084,  // 76 °C
+   56387477,  58683439,  61058077,  63513540,  66052018,  68675743,  71386990,  74188079,  // 84 °C
+   77081369,  80069267,  83154220,  86338724,  89625316,  93016579,  96515143, 100123682,  // 92 °C
+  103844918, 107681619, 111636598, 115712717, 119912885, 124240061, 128697247, 133287499,  // 100 °C
+  138013918, 142879656, 147887913, 153041939, 158345035, 163800550, 169411885, 175182491,  // 108 °C
+  181115870, 187215575, 193485211, 199928434, 206548950, 213350521, 220336958, 227512126,  // 116 °C
+  234879941, 242444373,  // 124 °C
+};
+static const size_t PSYCHRO_ES_COUNT = sizeof(PSYCHRO_ES) / sizeof(PSYCHRO_ES[0]);
+static_assert(PSYCHRO_ES_COUNT == (PSYCHRO_T10_MAX - PSYCHRO_T10_MIN) / 10 + 1,
+              "one entry per degree");
+
+struct Psychro {
+  int16_t  dew10C;   // dew point, 0.1 °C (PSYCHRO_DEW_NONE when off the table)
+  uint32_t ah100;    // absolute humidity, 0.01 g/m³
+  uint32_t vpdPa;    // vapour-pressure deficit, Pa
+};
+
+// Saturation vapour pressure at t10C (clamped to the table), in mPa
+inline uint32_t psychroSaturation(int16_t t10C) {
+  if (t10C < PSYCHRO_T10_MIN) t10C = PSYCHRO_T10_MIN;
+  if (t10C > PSYCHRO_T10_MAX) t10C = PSYCHRO_T10_MAX;
+  const uint32_t from = (uint32_t)(t10C - PSYCHRO_T10_MIN);
+  const uint32_t i = from / 10, f = from % 10;
+  if (f == 0) return PSYCHRO_ES[i];
+  return PSYCHRO_ES[i] + ((PSYCHRO_ES[i + 1] - PSYCHRO_ES[i]) * f + 5) / 10;
+}
+
+// The temperature whose es is `e` (mPa), in 0.1 °C. `hint` bounds the
+// search from above: the dew point never exceeds the air temperature.
+inline int16_t psychroDewPoint(uint32_t e, int16_t hint = PSYCHRO_T10_MAX) {
+  if (e < PSYCHRO_ES[0]) return PSYCHRO_DEW_NONE;
+  if (e >= PSYCHRO_ES[PSYCHRO_ES_COUNT - 1]) return PSYCHRO_T10_MAX;
+
+  // Largest lo with ES[lo] <= e, among [0, n). Branch-free halving: the
+  // select compiles to a conditional move, so random inputs don't cost a
+  // mispredict per step.
+  size_t lo = 0, n = PSYCHRO_ES_COUNT - 1;
+  if (hint < PSYCHRO_T10_MAX) {
+    const size_t top = (size_t)((hint < PSYCHRO_T10_MIN ? PSYCHRO_T10_MIN : hint) - PSYCHRO_T10_MIN) / 10 + 1;
+    if (e < PSYCHRO_ES[top]) n = top;
+  }
+  while (n > 1) {
+    const size_t half = n / 2;
+    lo = PSYCHRO_ES[lo + half] <= e ? lo + half : lo;
+    n -= half;
+  }
+  const uint32_t step = PSYCHRO_ES[lo + 1] - PSYCHRO_ES[lo];
+  return (int16_t)(PSYCHRO_T10_MIN + (int) lo * 10 + (int)(((e - PSYCHRO_ES[lo]) * 10 + step / 2) / step));
+}
+
+// Everything derived from one reading: t10C in 0.1 °C, h10 in 0.1 %RH
+inline Psychro psychroDerive(int16_t t10C, uint16_t h10) {
+  if (h10 > 1000) h10 = 1000;
+  const uint32_t es = psychroSaturation(t10C);
+  const uint32_t e  = es / 1000 * h10 + (es % 1000 * h10 + 500) / 1000;   // es · h10 / 1000
+
+  // T in 0.05 K; 2.16679 g·K/J ≈ 1733 / 4 / 200 over e in 0.1 Pa. At 125 °C
+  // and 100 %RH the product is 4.20e9, just inside 32 bits.
+  if (t10C < PSYCHRO_T10_MIN) t10C = PSYCHRO_T10_MIN;
+  if (t10C > PSYCHRO_T10_MAX) t10C = PSYCHRO_T10_MAX;
+  const uint32_t tK20 = (uint32_t)(2 * t10C + 5463);
+
+  Psychro p;
+  p.dew10C = psychroDewPoint(e, t10C);
+  p.ah100  = (e / 100 * 1733 + tK20 * 2) / (tK20 * 4);
+  p.vpdPa  = (es - e + 500) / 1000;
+  return p;
+}
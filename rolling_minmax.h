@@ -0,0 +1,184 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// rolling_minmax.h — sliding-window and calendar-day min/max
+//
+// RollingMinMax<PERIOD, BLOCKS> tracks temperature/humidity extremes over the
+// last PERIOD·BLOCKS seconds. Samples are folded into PERIOD-second blocks;
+// when a block closes, its extremes enter four monotonic deques (t-min,
+// t-max, h-min, h-max). Each deque drops entries the new value dominates
+// from the back and blocks that left the window from the front, so its
+// front is always the window's extreme. Every sample is amortized O(1), a
+// query is O(1), and memory is fixed at BLOCKS + 2 entries per deque.
+//
+// The window edge moves in whole blocks: "24 h" over 5-minute blocks covers
+// between 24 h and 24 h 5 min. add() moves it to the sample's time; while
+// no samples come (a sensor outage) the caller moves it with expire(now),
+// so old extremes leave on time and an empty window reads as nothing.
+//
+// Values are fixed-point (0.1 °F, 0.1 %RH) like the history store.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+
+struct MinMax16 {
+  int16_t tMin, tMax;
+  int16_t hMin, hMax;
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Fixed-capacity ring deque that keeps its values monotonic. IS_MIN keeps
+// them increasing front→back (front = minimum); otherwise decreasing.
+// ──────────────────────────────────────────────────────────────────────────────
+template <size_t CAP, bool IS_MIN>
+class MonoDeque {
+public:
+  struct Entry {
+    uint32_t key;     // block start (seconds)
+    int16_t  v;
+  };
+
+  bool         empty() const { return n_ == 0; }
+  size_t       size()  const { return n_; }
+  const Entry& front() const { return e_[head_]; }
+
+  void push(uint32_t key, int16_t v) {
+    while (n_ > 0 && (IS_MIN ? back().v >= v : back().v <= v)) n_--;
+    if (n_ == CAP) popFront();    // only if the caller stopped expiring
+    e_[(head_ + n_) % CAP] = { key, v };
+    n_++;
+  }
+
+  // Drop entries whose key is below `cutoff`
+  void expire(uint32_t cutoff) {
+    while (n_ > 0 && front().key < cutoff) popFront();
+  }
+
+  void rebase(uint32_t offset, uint32_t from) {
+    for (size_t i = 0; i < n_; i++) {
+      Entry& e = e_[(head_ + i) % CAP];
+      if (e.key >= from) e.key += offset;
+    }
+  }
+
+private:
+  Entry& back() { return e_[(head_ + n_ - 1) % CAP]; }
+  void popFront() { head_ = (head_ + 1) % CAP; n_--; }
+
+  Entry  e_[CAP];
+  size_t head_ = 0, n_ = 0;
+};
+
+template <uint32_t PERIOD, size_t BLOCKS>
+class RollingMinMax {
+public:
+  static const uint32_t WINDOW = PERIOD * BLOCKS;
+
+  void add(uint32_t ts, int16_t t10, int16_t h10) {
+    if (open_ && ts < cur_.start) return;            // out of order; ignore
+    const uint32_t start = ts - ts % PERIOD;
+    if (open_ && start != cur_.start) close();
+    if (!open_) {
+      cur_.start = start;
+      cur_.mm = { t10, t10, h10, h10 };
+      open_ = true;
+    } else {
+      if (t10 < cur_.mm.tMin) cur_.mm.tMin = t10;
+      if (t10 > cur_.mm.tMax) cur_.mm.tMax = t10;
+      if (h10 < cur_.mm.hMin) cur_.mm.hMin = h10;
+      if (h10 > cur_.mm.hMax) cur_.mm.hMax = h10;
+    }
+
+    expire(ts);
+  }
+
+  // Drop the blocks that have left the window at `now`. A block [s, s+PERIOD)
+  // is out once s + PERIOD <= now − WINDOW; the open block too, and with it
+  // everything older.
+  void expire(uint32_t now) {
+    if (now < WINDOW + PERIOD) return;
+    const uint32_t cutoff = now - WINDOW - PERIOD + 1;
+    if (open_ && cur_.start < cutoff) open_ = false;
+    tMin_.expire(cutoff);
+    tMax_.expire(cutoff);
+    hMin_.expire(cutoff);
+    hMax_.expire(cutoff);
+  }
+
+  // Extremes over the window; false if it holds nothing
+  bool get(MinMax16* out) const {
+    if (!open_) return false;
+    *out = cur_.mm;
+    if (!tMin_.empty() && tMin_.front().v < out->tMin) out->tMin = tMin_.front().v;
+    if (!tMax_.empty() && tMax_.front().v > out->tMax) out->tMax = tMax_.front().v;
+    if (!hMin_.empty() && hMin_.front().v < out->hMin) out->hMin = hMin_.front().v;
+    if (!hMax_.empty() && hMax_.front().v > out->hMax) out->hMax = hMax_.front().v;
+    return true;
+  }
+
+  // Shift block keys at or above `from` by `offset` (provisional → UNIX
+  // time at NTP sync)
+  void rebase(uint32_t offset, uint32_t from) {
+    if (open_ && cur_.start >= from) cur_.start += offset;
+    tMin_.rebase(offset, from);
+    tMax_.rebase(offset, from);
+    hMin_.rebase(offset, from);
+    hMax_.rebase(offset, from);
+  }
+
+private:
+  void close() {
+    tMin_.push(cur_.start, cur_.mm.tMin);
+    tMax_.push(cur_.start, cur_.mm.tMax);
+    hMin_.push(cur_.start, cur_.mm.hMin);
+    hMax_.push(cur_.start, cur_.mm.hMax);
+    open_ = false;
+  }
+
+  struct Block {
+    uint32_t start;
+    MinMax16 mm;
+  };
+
+  Block cur_ = {};
+  bool  open_ = false;
+  MonoDeque<BLOCKS + 2, true>  tMin_, hMin_;
+  MonoDeque<BLOCKS + 2, false> tMax_, hMax_;
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Calendar-day min/max. The caller passes a local day number with every
+// sample (or -1 while the clock isn't set); a new day number resets the
+// extremes. Samples taken before the clock was set count towards the first
+// known day.
+// ──────────────────────────────────────────────────────────────────────────────
+class DayMinMax {
+public:
+  void roll(int32_t day) {
+    if (day < 0 || day == day_) return;
+    if (day_ >= 0) any_ = false;      // midnight passed
+    day_ = day;
+  }
+
+  void add(int16_t t10, int16_t h10) {
+    if (!any_) {
+      mm_ = { t10, t10, h10, h10 };
+      any_ = true;
+      return;
+    }
+    if (t10 < mm_.tMin) mm_.tMin = t10;
+    if (t10 > mm_.tMax) mm_.tMax = t10;
+    if (h10 < mm_.hMin) mm_.hMin = h10;
+    if (h10 > mm_.hMax) mm_.hMax = h10;
+  }
+
+  bool get(MinMax16* out) const {
+    if (!any_) return false;
+    *out = mm_;
+    return true;
+  }
+
+private:
+  int32_t  day_ = -1;
+  bool     any_ = false;
+  MinMax16 mm_  = {};
+};
@@ -0,0 +1,446 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// sample_log.h — append-only sample log in flash that survives reboots
+//
+// Samples are delta-encoded into a RAM frame and written as one append when
+// the frame is full or its oldest sample is LOG_FLUSH_AGE_S old, so flash
+// sees a few hundred bytes every few minutes instead of a write per sample.
+//
+// On flash the log is LOG_SEGMENTS fixed slot files used round-robin. Each
+// holds a run of self-contained frames:
+//
+//   LogFrameHeader (28 B) │ payload: one record per sample after the first
+//
+// A record is the difference to the previous sample:
+//
+//   0ttthhhh                         dt = LOG_STEP_S, dT ∈ [-4, 3], dH ∈ [-8, 7]
+//   1ddddddd  zz(dT) zz(dH)          dt = d (< 127), then zigzag varints
+//   11111111  v(dt) zz(dT) zz(dH)    any dt
+//
+// so a steady 2 s stream costs a little over a byte per sample. Slower
+// reads take the three-byte form, and with a frame flushed every
+// LOG_FLUSH_AGE_S its header weighs more: about 5.5 B per sample at 30 s,
+// which is still about a third of the bytes per hour. The CRC-32
+// covers header and payload; a frame torn by a power cut fails it. Scanning
+// stops at the first bad frame, and a segment with a damaged tail is never
+// appended to again — the next frame opens a fresh slot. When the current
+// slot is full the oldest one is erased and reused, bounding flash use at
+// LOG_SEGMENTS × LOG_SEGMENT_BYTES (≈ 2 weeks of 2 s samples, ≈ 7 weeks of
+// 30 s ones).
+//
+// Only samples with real (NTP) timestamps belong here; the caller decides.
+// SampleLog itself is single-task: one task appends, and replay() runs
+// before it starts. LogScanner reads straight from flash and may run on
+// another task while frames are being appended (see /export).
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include "hal.h"
+#include "history_store.h"
+
+static const uint32_t LOG_MAGIC         = 0x31474C50;    // "PLG1"
+static const size_t   LOG_FRAME_MAX     = 512;           // header + payload
+static const int      LOG_SEGMENTS      = 6;
+static const uint32_t LOG_SEGMENT_BYTES = 128 * 1024;
+static const uint32_t LOG_FLUSH_AGE_S   = 300;
+static const uint32_t LOG_STEP_S        = 2;             // one-byte record's dt (on-flash format)
+static const size_t   LOG_RECORD_MAX    = 1 + 5 + 3 + 3; // tag, dt, dT, dH
+static const size_t   LOG_PATH_MAX      = 24;
+
+struct LogFrameHeader {
+  uint32_t magic;
+  uint32_t seq;       // frame number, counts up across segments
+  uint32_t firstTs;   // the base sample
+  uint32_t lastTs;    // newest sample in the frame
+  int16_t  t10;
+  uint16_t h10;
+  uint16_t count;     // samples, including the base
+  uint16_t len;       // payload bytes after the header
+  uint32_t crc;       // CRC-32 of header (crc = 0) + payload
+};
+
+static const size_t LOG_PAYLOAD_MAX = LOG_FRAME_MAX - sizeof(LogFrameHeader);
+
+// Standard CRC-32 (zlib polynomial), nibble table: small and fast enough for
+// a few hundred bytes per flush and one pass over the log at boot. Chains
+// like zlib's: logCrc32(logCrc32(0, a), b) is the CRC of a‖b.
+inline uint32_t logCrc32(uint32_t crc, const void* data, size_t len) {
+  static const uint32_t T[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+    0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+  };
+  const uint8_t* p = (const uint8_t*) data;
+  crc = ~crc;
+  while (len--) {
+    crc ^= *p++;
+    crc = (crc >> 4) ^ T[crc & 15];
+    crc = (crc >> 4) ^ T[crc & 15];
+  }
+  return ~crc;
+}
+
+// Decode the samples of one checked frame, oldest first, into
+// visit(const HistSample&). Returns the number visited.
+template <typename F>
+inline uint32_t logDecodeFrame(const LogFrameHeader& h, const uint8_t* p, F&& visit) {
+  const uint8_t* end = p + h.len;
+  HistSample s;
+  s.ts  = h.firstTs;
+  s.t10 = h.t10;
+  s.h10 = h.h10;
+  visit(s);
+  uint32_t n = 1;
+  for (; n < h.count && p < end; n++) {
+    const uint8_t tag = *p++;
+    uint32_t dt;
+    int32_t  dT, dH;
+    if (!(tag & 0x80)) {
+      dt = LOG_STEP_S;
+      dT = (tag >> 4) - 4;
+      dH = (tag & 15) - 8;
+    } else {
+      uint32_t zT = 0, zH = 0;
+      dt = tag & 0x7F;
+      bool ok = true;
+      auto varint = [&](uint32_t* v) {
+        *v = 0;
+        for (int shift = 0; shift < 35 && p < end; shift += 7) {
+          const uint8_t b = *p++;
+          *v |= (uint32_t)(b & 0x7F) << shift;
+          if (!(b & 0x80)) return;
+        }
+        ok = false;
+      };
+      if (tag == 0xFF) varint(&dt);
+      varint(&zT);
+      varint(&zH);
+      if (!ok) break;
+      dT = (int32_t)(zT >> 1) ^ -(int32_t)(zT & 1);
+      dH = (int32_t)(zH >> 1) ^ -(int32_t)(zH & 1);
+    }
+    s.ts  += dt;
+    s.t10  = (int16_t)(s.t10 + dT);
+    s.h10  = (uint16_t)(s.h10 + dH);
+    visit(s);
+  }
+  return n;
+}
+
+inline void logSegmentPath(int s, char* out) { snprintf(out, LOG_PATH_MAX, "/plog%d.bin", s); }
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Frame encoder: samples go in, a sealed frame (header, CRC, records) comes
+// out. Used for the pending frame of the log and to frame RAM samples for
+// /export.
+// ──────────────────────────────────────────────────────────────────────────────
+class LogFrameBuilder {
+public:
+  uint32_t count()   const { return count_; }
+  uint32_t firstTs() const { return first_.ts; }
+
+  // True if `s` can't join this frame: no room left, or the frame would
+  // span LOG_FLUSH_AGE_S
+  bool full(const HistSample& s) const {
+    return count_ > 0 && (len_ + LOG_RECORD_MAX > LOG_PAYLOAD_MAX ||
+                          s.ts - first_.ts >= LOG_FLUSH_AGE_S);
+  }
+
+  // Timestamps must not decrease
+  void add(const HistSample& s) {
+    if (count_ == 0) first_ = s;
+    else             len_ += encode(frame_ + sizeof(LogFrameHeader) + len_, prev_, s);
+    prev_ = s;
+    count_++;
+  }
+
+  // Seal the frame at the front of data() and start a new one. Returns the
+  // frame's length in bytes.
+  size_t finish(uint32_t seq) {
+    LogFrameHeader h;
+    h.magic   = LOG_MAGIC;
+    h.seq     = seq;
+    h.firstTs = first_.ts;
+    h.lastTs  = prev_.ts;
+    h.t10     = first_.t10;
+    h.h10     = first_.h10;
+    h.count   = (uint16_t) count_;
+    h.len     = (uint16_t) len_;
+    h.crc     = 0;
+    h.crc     = logCrc32(logCrc32(0, &h, sizeof(h)), frame_ + sizeof(h), len_);
+    memcpy(frame_, &h, sizeof(h));
+    const size_t frameLen = sizeof(h) + len_;
+    count_ = 0;
+    len_   = 0;
+    return frameLen;
+  }
+
+  const uint8_t* data() const { return frame_; }
+
+private:
+  static size_t putVarint(uint8_t* p, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) { p[n++] = (uint8_t)(v | 0x80); v >>= 7; }
+    p[n++] = (uint8_t) v;
+    return n;
+  }
+
+  static uint32_t zigzag(int32_t v) { return ((uint32_t) v << 1) ^ (uint32_t)(v >> 31); }
+
+  static size_t encode(uint8_t* p, const HistSample& prev, const HistSample& s) {
+    const uint32_t dt = s.ts - prev.ts;
+    const int32_t  dT = s.t10 - prev.t10;
+    const int32_t  dH = (int32_t) s.h10 - (int32_t) prev.h10;
+    if (dt == LOG_STEP_S && dT >= -4 && dT <= 3 && dH >= -8 && dH <= 7) {
+      p[0] = (uint8_t)(((dT + 4) << 4) | (dH + 8));
+      return 1;
+    }
+    size_t n = 1;
+    if (dt < 0x7F) {
+      p[0] = (uint8_t)(0x80 | dt);
+    } else {
+      p[0] = 0xFF;
+      n += putVarint(p + n, dt);
+    }
+    n += putVarint(p + n, zigzag(dT));
+    n += putVarint(p + n, zigzag(dH));
+    return n;
+  }
+
+  HistSample first_ = {}, prev_ = {};
+  uint32_t   count_ = 0;
+  size_t     len_   = 0;
+  uint8_t    frame_[LOG_FRAME_MAX];
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Segment file reader. Reads through a small window so scanning costs one
+// filesystem call per LOG_READ_WINDOW bytes rather than two per frame.
+// ──────────────────────────────────────────────────────────────────────────────
+static const size_t LOG_READ_WINDOW = 2048;
+
+class LogFileReader {
+public:
+  void open(int slot) {
+    logSegmentPath(slot, path_);
+    size_  = (uint32_t) halFsSize(path_);
+    start_ = 0;
+    have_  = 0;
+  }
+
+  uint32_t size() const { return size_; }
+
+  // Read and check the frame at `off`. `payload` may be null to only walk.
+  bool frame(uint32_t off, LogFrameHeader* h, uint8_t* payload) {
+    h->seq = 0;
+    if (!read(off, h, sizeof(*h))) return false;
+    if (h->magic != LOG_MAGIC || h->len > LOG_PAYLOAD_MAX || h->count == 0) return false;
+    const uint8_t* p;
+    if (!view(off + sizeof(*h), h->len, &p)) return false;
+    LogFrameHeader zeroed = *h;
+    zeroed.crc = 0;
+    if (logCrc32(logCrc32(0, &zeroed, sizeof(zeroed)), p, h->len) != h->crc) return false;
+    if (payload) memcpy(payload, p, h->len);
+    return true;
+  }
+
+private:
+  // Point `p` at `len` bytes from `off` inside the window, refilling it there
+  // if needed (a frame always fits)
+  bool view(uint32_t off, size_t len, const uint8_t** p) {
+    if (off + len > size_) return false;
+    if (off < start_ || off + len > start_ + have_) {
+      start_ = off;
+      const size_t want = size_ - off < LOG_READ_WINDOW ? size_ - off : LOG_READ_WINDOW;
+      have_ = halFsRead(path_, off, buf_, want);
+      if (len > have_) return false;
+    }
+    *p = buf_ + (off - start_);
+    return true;
+  }
+
+  bool read(uint32_t off, void* dst, size_t len) {
+    const uint8_t* p;
+    if (!view(off, len, &p)) return false;
+    memcpy(dst, p, len);
+    return true;
+  }
+
+  char     path_[LOG_PATH_MAX];
+  uint32_t size_  = 0;
+  uint32_t start_ = 0;
+  size_t   have_  = 0;
+  uint8_t  buf_[LOG_READ_WINDOW];
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Walks every good frame oldest-first, straight from flash. It keeps no
+// link to the writer: frames must arrive with increasing seq, and anything
+// else (a slot recycled under the scanner, a frame still being written)
+// ends that slot, so a concurrent append can cost a reader frames but
+// never shows it stale or reordered ones.
+// ──────────────────────────────────────────────────────────────────────────────
+class LogScanner {
+public:
+  void open() {
+    n_ = 0;
+    LogFrameHeader h;
+    uint32_t seq[LOG_SEGMENTS];
+    for (int s = 0; s < LOG_SEGMENTS; s++) {
+      r_.open(s);
+      if (!r_.frame(0, &h, nullptr)) continue;
+      int i = n_++;
+      for (; i > 0 && seq[i - 1] > h.seq; i--) {
+        seq[i]   = seq[i - 1];
+        order_[i] = order_[i - 1];
+      }
+      seq[i]    = h.seq;
+      order_[i] = s;
+    }
+    idx_  = 0;
+    off_  = 0;
+    any_  = false;
+    if (n_ > 0) r_.open(order_[0]);
+  }
+
+  // Next frame; `payload` receives h->len bytes. False once all are read.
+  bool next(LogFrameHeader* h, uint8_t* payload) {
+    while (idx_ < n_) {
+      if (r_.frame(off_, h, payload) && (!any_ || h->seq > lastSeq_)) {
+        off_    += sizeof(*h) + h->len;
+        lastSeq_ = h->seq;
+        any_     = true;
+        return true;
+      }
+      if (++idx_ < n_) r_.open(order_[idx_]);
+      off_ = 0;
+    }
+    return false;
+  }
+
+private:
+  LogFileReader r_;
+  int      order_[LOG_SEGMENTS];
+  int      n_ = 0, idx_ = 0;
+  uint32_t off_ = 0, lastSeq_ = 0;
+  bool     any_ = false;
+};
+
+struct LogStats {
+  uint32_t framesWritten = 0;
+  uint32_t bytesWritten  = 0;
+  uint32_t writeErrors   = 0;   // failed appends; the frame is dropped
+  uint32_t rotations     = 0;   // segments (re)started from empty
+  uint32_t tornBytes     = 0;   // unreadable bytes found after the last good frame at boot
+};
+
+class SampleLog {
+public:
+  // Find the newest segment and where it ends. False (log disabled) if the
+  // platform has no filesystem.
+  bool begin() {
+    enabled_ = halFsMounted();
+    if (!enabled_) return false;
+
+    LogFileReader r;
+    LogFrameHeader h;
+    uint32_t activeSeq = 0;
+    for (int s = 0; s < LOG_SEGMENTS; s++) {
+      r.open(s);
+      if (r.frame(0, &h, nullptr) && (active_ < 0 || h.seq > activeSeq)) {
+        active_   = s;
+        activeSeq = h.seq;
+      }
+    }
+    if (active_ < 0) return true;
+
+    r.open(active_);
+    uint32_t off = 0;
+    while (r.frame(off, &h, nullptr)) {
+      off += sizeof(h) + h.len;
+      nextSeq_ = h.seq + 1;
+      lastTs_  = h.lastTs;
+    }
+    flushedTs_.store(lastTs_, std::memory_order_relaxed);
+    writeOff_ = off;
+    if (off < r.size()) {
+      stats_.tornBytes = r.size() - off;
+      needRotate_ = true;
+    }
+    return true;
+  }
+
+  // Decode every stored sample, oldest first, into visit(const HistSample&).
+  // Returns the number of samples visited.
+  template <typename F>
+  uint32_t replay(F visit) {
+    if (!enabled_) return 0;
+    LogScanner scan;
+    scan.open();
+    LogFrameHeader h;
+    uint8_t payload[LOG_PAYLOAD_MAX];
+    uint32_t samples = 0;
+    while (scan.next(&h, payload)) samples += logDecodeFrame(h, payload, visit);
+    return samples;
+  }
+
+  // Buffer one sample; writes a frame when the buffer is full or old enough.
+  // Samples older than the newest logged one are dropped.
+  void append(const HistSample& s) {
+    if (!enabled_ || s.ts < lastTs_) return;
+    if (pending_.full(s)) flush();
+    pending_.add(s);
+    lastTs_ = s.ts;
+  }
+
+  // Write the buffered samples now (e.g. before a planned restart).
+  void flush() {
+    if (!enabled_ || pending_.count() == 0) return;
+    const size_t frameLen = pending_.finish(nextSeq_);
+
+    char path[LOG_PATH_MAX];
+    if (active_ < 0 || needRotate_ || writeOff_ + frameLen > LOG_SEGMENT_BYTES) {
+      active_ = (active_ + 1) % LOG_SEGMENTS;
+      logSegmentPath(active_, path);
+      halFsRemove(path);
+      writeOff_   = 0;
+      needRotate_ = false;
+      stats_.rotations++;
+    }
+
+    logSegmentPath(active_, path);
+    if (!halFsAppend(path, pending_.data(), frameLen)) {
+      // Whatever reached flash is a torn frame; never append after it
+      stats_.writeErrors++;
+      needRotate_ = true;
+      return;
+    }
+    writeOff_ += frameLen;
+    nextSeq_++;
+    stats_.framesWritten++;
+    stats_.bytesWritten += frameLen;
+    flushedTs_.store(lastTs_, std::memory_order_release);
+  }
+
+  bool            enabled() const { return enabled_; }
+  uint32_t        lastTs()  const { return lastTs_; }    // newest sample (0 = none)
+  const LogStats& stats()   const { return stats_; }
+
+  // Newest sample already in flash; safe to read from any task. Samples
+  // after it are still in RAM.
+  uint32_t flushedTs() const { return flushedTs_.load(std::memory_order_acquire); }
+
+private:
+  bool     enabled_    = false;
+  int      active_     = -1;        // slot being appended to
+  bool     needRotate_ = false;     // active slot has a damaged tail
+  uint32_t writeOff_   = 0;
+  uint32_t nextSeq_    = 0;
+  uint32_t lastTs_     = 0;
+  std::atomic<uint32_t> flushedTs_{0};
+  LogFrameBuilder pending_;
+  LogStats        stats_;
+};
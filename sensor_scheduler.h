@@ -0,0 +1,127 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// sensor_scheduler.h — round-robin read scheduling for several probes
+//
+// Every probe has a period (the common cadence, raised to the probe's own
+// minimum interval) and a due time. At boot the due times are spread evenly
+// across the shortest period, so with N probes on a 2 s cadence one read
+// starts every 2/N s instead of N at once. Only one read is in flight at a
+// time (probes can share an I2C bus, and a DHT22 capture wants the CPU
+// quiet); when several are due, the most overdue goes first.
+//
+// Due times advance by whole periods, so a late start doesn't shift the
+// probe's phase — except that a probe is never restarted sooner than its
+// minimum interval, and one that fell a full period behind (a long stall)
+// is resynchronized instead of firing a burst of catch-up reads.
+//
+// The cadence can change on the fly (setPeriod(), driven by adaptive_rate.h)
+// without reads bunching up or any probe being read faster than the new
+// period. A longer period moves every pending read out by the difference,
+// which keeps their spacing. A shorter one lays them out afresh across the
+// new period, longest-waiting probe first, starting as soon as no probe
+// would come round sooner than one new period after its last read.
+//
+// Times are halMillis() values; all comparisons are wrap-safe.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+
+template <size_t N>
+class SensorScheduler {
+public:
+  // `count` probes (at most N) read every `periodMs`, each no more often
+  // than its `minIntervalMs[i]`; the first reads are staggered from `firstMs`
+  void begin(size_t count, uint32_t periodMs, const uint32_t* minIntervalMs, uint32_t firstMs) {
+    count_ = count < N ? count : N;
+    uint32_t spread = UINT32_MAX;
+    for (size_t i = 0; i < count_; i++) {
+      minInterval_[i] = minIntervalMs[i];
+      period_[i]      = periodMs > minIntervalMs[i] ? periodMs : minIntervalMs[i];
+      if (period_[i] < spread) spread = period_[i];
+    }
+    for (size_t i = 0; i < count_; i++) {
+      due_[i]       = firstMs + (uint32_t)((uint64_t) spread * i / count_);
+      lastStart_[i] = due_[i] - period_[i];
+    }
+  }
+
+  // New common cadence from `now` on (each probe still no faster than its
+  // minimum interval)
+  void setPeriod(uint32_t periodMs, uint32_t now) {
+    uint32_t spread = UINT32_MAX;
+    for (size_t i = 0; i < count_; i++) {
+      const uint32_t p = periodMs > minInterval_[i] ? periodMs : minInterval_[i];
+      if (p < spread) spread = p;
+    }
+    // Longer: shift. Shorter: collect, oldest last start first.
+    size_t order[N], n = 0;
+    for (size_t i = 0; i < count_; i++) {
+      const uint32_t p = periodMs > minInterval_[i] ? periodMs : minInterval_[i];
+      if (p >= period_[i]) {
+        due_[i] += p - period_[i];
+      } else {
+        size_t at = n++;
+        for (; at > 0 && (int32_t)(lastStart_[order[at - 1]] - lastStart_[i]) > 0; at--) {
+          order[at] = order[at - 1];
+        }
+        order[at] = i;
+      }
+      period_[i] = p;
+    }
+    if (n == 0) return;
+    uint32_t shift = 0;
+    for (size_t r = 0; r < n; r++) {
+      const int32_t early = (int32_t)(lastStart_[order[r]] + period_[order[r]] -
+                                      (now + (uint32_t)((uint64_t) spread * r / n)));
+      if (early > (int32_t) shift) shift = (uint32_t) early;
+    }
+    for (size_t r = 0; r < n; r++) {
+      due_[order[r]] = now + shift + (uint32_t)((uint64_t) spread * r / n);
+    }
+  }
+
+  uint32_t periodMs(size_t i) const { return period_[i]; }
+
+  size_t count() const { return count_; }
+
+  // The probe to start at `now`: the most overdue one whose turn has come,
+  // or -1 if none is due yet
+  int next(uint32_t now) const {
+    int best = -1;
+    uint32_t bestLate = 0;
+    for (size_t i = 0; i < count_; i++) {
+      if ((int32_t)(now - due_[i]) < 0) continue;
+      const uint32_t late = now - due_[i];
+      if (best < 0 || late > bestLate) { best = (int) i; bestLate = late; }
+    }
+    return best;
+  }
+
+  // Record that probe `i` started at `now`; returns how late that was (ms)
+  uint32_t started(size_t i, uint32_t now) {
+    const uint32_t late = now - due_[i];
+    lastStart_[i] = now;
+    due_[i] += period_[i];
+    if ((int32_t)(now - due_[i]) >= 0) due_[i] = now + period_[i];       // a period behind
+    if ((int32_t)(due_[i] - (now + minInterval_[i])) < 0) due_[i] = now + minInterval_[i];
+    return late;
+  }
+
+  // ms until the earliest due read (0 = one is due now)
+  uint32_t untilNext(uint32_t now) const {
+    uint32_t wait = UINT32_MAX;
+    for (size_t i = 0; i < count_; i++) {
+      const int32_t d = (int32_t)(due_[i] - now);
+      if (d <= 0) return 0;
+      if ((uint32_t) d < wait) wait = (uint32_t) d;
+    }
+    return wait;
+  }
+
+private:
+  size_t   count_ = 0;
+  uint32_t period_[N];
+  uint32_t minInterval_[N];
+  uint32_t due_[N];
+  uint32_t lastStart_[N];
+};
@@ -0,0 +1,62 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// seqlock.h — single-writer / multi-reader snapshot without locks
+//
+// The writer bumps the sequence to an odd value, copies the payload, then
+// bumps it back to even. A reader copies the payload between two sequence
+// loads and retries if they differ or were odd, so it can never observe a
+// half-written value (e.g. a new temperature paired with an old humidity).
+// Readers never block the writer; the writer never waits for readers.
+//
+// The payload is stored as relaxed atomic words so the concurrent copy is
+// well-defined C++ (no data race). T must be trivially copyable.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+template <typename T>
+class Seqlock {
+  static_assert(std::is_trivially_copyable<T>::value, "Seqlock payload must be trivially copyable");
+  static const size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+public:
+  Seqlock() {
+    for (size_t i = 0; i < WORDS; i++) data_[i].store(0, std::memory_order_relaxed);
+  }
+
+  // Single writer only.
+  void store(const T& v) {
+    uint32_t words[WORDS] = {};
+    memcpy(words, &v, sizeof(T));
+
+    const uint32_t s = seq_.load(std::memory_order_relaxed);
+    seq_.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; i++) data_[i].store(words[i], std::memory_order_relaxed);
+    seq_.store(s + 2, std::memory_order_release);
+  }
+
+  // Any number of concurrent readers.
+  T load() const {
+    uint32_t words[WORDS];
+    for (;;) {
+      const uint32_t s1 = seq_.load(std::memory_order_acquire);
+      if (s1 & 1) continue;                       // write in progress
+      for (size_t i = 0; i < WORDS; i++) words[i] = data_[i].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq_.load(std::memory_order_relaxed) == s1) break;
+    }
+    T out;
+    memcpy(&out, words, sizeof(T));
+    return out;
+  }
+
+  // Number of completed stores; cheap way to ask "anything new?".
+  uint32_t version() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+  std::atomic<uint32_t> seq_{0};
+  std::atomic<uint32_t> data_[WORDS];
+};
@@ -0,0 +1,76 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// sht3x.h — non-blocking SHT3x driver (I2C single-shot measurements)
+//
+// Same contract as the Dht22 driver, so the probe table can mix both:
+//
+//   start()  send the single-shot command and return; the sensor measures
+//            on its own for up to 15 ms
+//   poll()   called every loop(): once the measurement time has passed,
+//            reads the six result bytes and decodes them with sht3xDecode()
+//   takeResult()  hands out each finished attempt exactly once
+//
+// No clock stretching is used, so the bus is only held for the two short
+// transfers (≈0.3 ms and ≈0.6 ms at 100 kHz). Several sensors can share one
+// bus at different addresses; the scheduler never has two reads in flight.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <Arduino.h>
+#include <Wire.h>
+#include "sht3x_decode.h"
+
+class Sht3x {
+public:
+  explicit Sht3x(uint8_t addr = SHT3X_ADDR_DEFAULT, TwoWire& wire = Wire) : addr_(addr), wire_(wire) {}
+
+  bool busy() const { return measuring_; }
+
+  // Begin a read. Ignored while one is already in flight.
+  void start() {
+    if (busy()) return;
+    hasResult_ = false;
+    wire_.beginTransmission(addr_);
+    wire_.write((uint8_t)(SHT3X_CMD_SINGLE_HI >> 8));
+    wire_.write((uint8_t) SHT3X_CMD_SINGLE_HI);
+    if (wire_.endTransmission() != 0) {
+      finish(DHT22_TRUNCATED);                // no ACK: absent or unpowered
+      return;
+    }
+    startedAt_ = micros();
+    measuring_ = true;
+  }
+
+  void poll() {
+    if (!measuring_ || micros() - startedAt_ < SHT3X_MEASURE_US) return;
+    measuring_ = false;
+    uint8_t frame[SHT3X_FRAME_BYTES];
+    size_t n = 0;
+    if (wire_.requestFrom(addr_, (uint8_t) SHT3X_FRAME_BYTES) == SHT3X_FRAME_BYTES) {
+      while (n < SHT3X_FRAME_BYTES && wire_.available()) frame[n++] = (uint8_t) wire_.read();
+    }
+    finish(sht3xDecode(frame, n, &reading_));
+  }
+
+  // True once per finished attempt; `status` says whether `r` is valid.
+  bool takeResult(Dht22Reading& r, Dht22Status& status) {
+    if (!hasResult_) return false;
+    hasResult_ = false;
+    r      = reading_;
+    status = status_;
+    return true;
+  }
+
+private:
+  void finish(Dht22Status s) {
+    status_    = s;
+    hasResult_ = true;
+  }
+
+  const uint8_t addr_;
+  TwoWire&      wire_;
+  bool          measuring_ = false;
+  uint32_t      startedAt_ = 0;
+
+  bool          hasResult_ = false;
+  Dht22Status   status_    = DHT22_TRUNCATED;
+  Dht22Reading  reading_   = { 0, 0 };
+};
@@ -0,0 +1,56 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// sht3x_decode.h — pure SHT30/31/35 measurement decoder
+//
+// A single-shot measurement (command 0x2400: high repeatability, no clock
+// stretching) is read back as six bytes:
+//
+//   T msb, T lsb, CRC(T), RH msb, RH lsb, CRC(RH)
+//
+// with CRC-8 (poly 0x31, init 0xFF) over each 16-bit word, and
+//   T  = −45 + 175 · raw / 65535  °C
+//   RH =       100 · raw / 65535  %RH
+//
+// Results use the DHT22 reading/status types so app.cpp handles every probe
+// kind alike: a missing reply (NACK, short read) is DHT22_TRUNCATED and a CRC
+// mismatch DHT22_CHECKSUM.
+//
+// The I2C transfer is sht3x.h's; the simulator builds frames and decodes
+// them here too (host/hal_host.cpp).
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+#include "dht22_decode.h"
+
+static const uint8_t  SHT3X_ADDR_DEFAULT  = 0x44;    // ADDR pin low; 0x45 when high
+static const uint16_t SHT3X_CMD_SINGLE_HI = 0x2400;  // single shot, high repeatability
+static const uint32_t SHT3X_MEASURE_US    = 15500;   // datasheet max 15 ms
+static const size_t   SHT3X_FRAME_BYTES   = 6;
+
+inline uint8_t sht3xCrc8(const uint8_t* p, size_t len) {
+  uint8_t crc = 0xFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= p[i];
+    for (int b = 0; b < 8; b++) crc = (uint8_t)(crc & 0x80 ? (crc << 1) ^ 0x31 : crc << 1);
+  }
+  return crc;
+}
+
+inline Dht22Status sht3xDecode(const uint8_t* frame, size_t count, Dht22Reading* out) {
+  if (count < SHT3X_FRAME_BYTES) return DHT22_TRUNCATED;
+  if (sht3xCrc8(frame, 2) != frame[2] || sht3xCrc8(frame + 3, 2) != frame[5]) return DHT22_CHECKSUM;
+
+  const uint32_t rawT  = (uint32_t)(frame[0] << 8 | frame[1]);
+  const uint32_t rawRh = (uint32_t)(frame[3] << 8 | frame[4]);
+
+  // Rounded to 0.1; −450 + 1750·raw/65535 stays within int16 for any raw
+  const int16_t  t10 = (int16_t)(-450 + (int32_t)((rawT * 1750 + 32767) / 65535));
+  const uint16_t h10 = (uint16_t)((rawRh * 1000 + 32767) / 65535);
+
+  // SHT3x spec: −40…125 °C (RH always decodes to 0–100 %)
+  if (t10 < -400 || t10 > 1250) return DHT22_OUT_OF_RANGE;
+
+  out->t10C = t10;
+  out->h10  = h10;
+  return DHT22_OK;
+}
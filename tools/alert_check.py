@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""Drive the alert rules with a synthetic trace and check what the webhook gets.
+
+    cmake -S host -B build-host && cmake --build build-host
+    python3 tools/alert_check.py [--sim build-host/potato_sim]
+
+Writes a seven-hour storage-room trace that, in turn: spikes past 50 °F for
+less than the sprouting hold time (must stay quiet), ramps up through it
+(warming, then sprouting), hovers around the limit inside the hysteresis band
+(must not flap), cools back down, unplugs the probe for three minutes
+(sensor) and dries the air for 50 minutes (dry). potato_sim replays it flat
+out with --webhook pointed at a stand-in served by this script, which
+answers the first two POSTs with 503 to exercise the retry. Reads stay at
+the fixed 2 s cadence (--max-period 2s) so the expected times are exact.
+
+Every transition must arrive exactly once and in order; threshold rules must
+fire and clear within one sample period of when their hold time ran out.
+Exits 0 on success, 1 with what differs otherwise.
+"""
+import argparse
+import http.server
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import threading
+
+EPOCH = 1750000000
+PERIOD_S = 2            # APP_SENSOR_PERIOD_MS
+FAIL_FIRST = 2          # stand-in answers these POSTs with 503
+F = lambda c: c * 9 / 5 + 32
+
+
+def trace():
+    """(second, temp_c, humidity) rows every 10 s; None temp = probe unplugged."""
+    rows = []
+    for t in range(0, 25200, 10):
+        c, h = 8.0, 88.0
+        if 3600 <= t < 3840:
+            c = 10.6                                  # 4 min spike: under the 10 min hold
+        elif 7200 <= t < 10800:
+            c = 8.0 + 4.0 * (t - 7200) / 3600         # +7.2 °F/h
+        elif 10800 <= t < 14400:
+            c = 12.0
+        elif 14400 <= t < 16200:
+            c = 10.2 if (t // 60) % 2 else 9.8        # 50.4 / 49.6 °F, inside the band
+        if 18000 <= t < 18180:
+            c = None
+        if 19800 <= t < 22800:
+            h = 75.0
+        rows.append((t, None if c is None else round(c, 1), h))
+    return rows
+
+
+def expected_threshold(rows, pick, above, limit, hyst, hold):
+    """Transitions of a threshold rule, replaying the rule on 2 s samples."""
+    def value(t):
+        v = None
+        for r in rows:
+            if r[0] > t:
+                break
+            v = r
+        return None if v is None or v[1] is None else pick(v)
+    out, firing, since = [], False, None
+    for t in range(1, rows[-1][0] + 10, PERIOD_S):
+        v = value(t)
+        if v is None:
+            continue
+        x, lim = (v, limit) if above else (-v, -limit)
+        want = x < lim - hyst if firing else x > lim
+        if not want:
+            since = None
+            continue
+        since = t if since is None else since
+        if t - since >= hold:
+            firing, since = not firing, None
+            out.append(("firing" if firing else "cleared", t))
+    return out
+
+
+class Hook(http.server.BaseHTTPRequestHandler):
+    events, attempts = [], 0
+    lock = threading.Lock()
+
+    def do_POST(self):
+        body = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+        with Hook.lock:
+            Hook.attempts += 1
+            if Hook.attempts <= FAIL_FIRST:
+                self.send_response(503)
+            else:
+                Hook.events.append(json.loads(body))
+                self.send_response(204)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+    def log_message(self, *args):
+        pass
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--sim", default="build-host/potato_sim")
+    args = ap.parse_args()
+
+    work = tempfile.mkdtemp(prefix="alert_check.")
+    rows = trace()
+    csv = os.path.join(work, "trace.csv")
+    with open(csv, "w") as f:
+        f.write("seconds,temp_c,humidity\n")
+        for t, c, h in rows:
+            f.write("%d,,\n" % t if c is None else "%d,%.1f,%.1f\n" % (t, c, h))
+
+    server = http.server.ThreadingHTTPServer(("127.0.0.1", 0), Hook)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    hook = "http://127.0.0.1:%d/alert" % server.server_address[1]
+    with open(os.path.join(work, "sim.log"), "w") as log:
+        rc = subprocess.call([args.sim, "--fast", "--port", "0", "--csv", csv, "--epoch", str(EPOCH),
+                              "--max-period", "%ds" % PERIOD_S, "--webhook", hook], stderr=log)
+    server.shutdown()
+    if rc != 0:
+        print("alert_check: potato_sim exited with %d (log in %s)" % (rc, work), file=sys.stderr)
+        return 1
+
+    got = [(e["rule"], e["state"], e["time"] - EPOCH) for e in Hook.events]
+    print("alert_check: %d transitions delivered in %d POSTs" % (len(got), Hook.attempts))
+    for rule, state, t in got:
+        print("  %6d s  %-10s %s" % (t, rule, state))
+
+    # Threshold and staleness rules: exact times, one sample period of slack
+    want = {
+        "sprouting": expected_threshold(rows, lambda r: F(r[1]), True, 50.0, 1.0, 600),
+        "dry":       expected_threshold(rows, lambda r: r[2], False, 80.0, 2.0, 1800),
+        "sensor":    [("firing", 18000 + 60), ("cleared", 18180)],
+    }
+    problems = []
+    for rule, seq in want.items():
+        mine = [(s, t) for r, s, t in got if r == rule]
+        if [s for s, _ in mine] != [s for s, _ in seq]:
+            problems.append("%s: got %s, want %s" % (rule, mine, seq))
+            continue
+        for (s, t), (_, w) in zip(mine, seq):
+            if not w <= t <= w + PERIOD_S + 1:
+                problems.append("%s %s at %d s, want %d s (+%d)" % (rule, s, t, w, PERIOD_S))
+
+    # The rate rule: fires during the ramp and clears once it is over
+    warm = [(s, t) for r, s, t in got if r == "warming"]
+    if [s for s, _ in warm] != ["firing", "cleared"] or not 7200 < warm[0][1] < 9000 \
+            or not 10800 < warm[1][1] < 14400:
+        problems.append("warming: got %s, want firing during 7200-9000 s, cleared during 10800-14400 s" % warm)
+
+    for rule in ("cold", "damp"):
+        if any(r == rule for r, _, _ in got):
+            problems.append("%s fired; the trace never goes there" % rule)
+    if [t for _, _, t in got] != sorted(t for _, _, t in got):
+        problems.append("transitions delivered out of order")
+    if Hook.attempts != len(got) + FAIL_FIRST:
+        problems.append("%d POSTs for %d transitions + %d refused" % (Hook.attempts, len(got), FAIL_FIRST))
+
+    for p in problems:
+        print("  " + p)
+    if problems:
+        print("alert_check: FAILED (logs in %s)" % work)
+        return 1
+    print("alert_check: OK")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""Compare two potato_bench JSON results and flag regressions.
+
+    ./build-host/potato_bench --label v1.2 --json v1.2.json
+    ./build-host/potato_bench --label HEAD --json head.json
+    python3 tools/bench_compare.py v1.2.json head.json [--threshold 15]
+
+A benchmark regresses when its p50 or p99 grows by more than the threshold
+(percent, default 10), or when it allocates or produces more per call than
+before. The load scenario is compared on request p99, sensor lateness p99
+and requests per second, and the export scenario on samples per second
+(lower throughput is worse). Exits
+1 if anything regressed, so it can gate CI.
+
+Timings on a shared machine are noisy; compare runs from the same host and
+prefer the p50 column when the p99 flaps.
+"""
+import argparse
+import json
+import sys
+
+
+def pct(old: float, new: float) -> float:
+    if old == 0:
+        return 0.0 if new == 0 else float("inf")
+    return (new - old) * 100.0 / old
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("baseline")
+    ap.add_argument("candidate")
+    ap.add_argument("--threshold", type=float, default=10.0,
+                    help="allowed latency growth in percent (default 10)")
+    args = ap.parse_args()
+
+    with open(args.baseline) as f:
+        base = json.load(f)
+    with open(args.candidate) as f:
+        cand = json.load(f)
+
+    old = {b["name"]: b for b in base["benchmarks"]}
+    regressions = []
+
+    print("%-24s %12s %12s %8s %12s %12s %8s" %
+          ("benchmark", "p50 old", "p50 new", "Δ%", "p99 old", "p99 new", "Δ%"))
+    for b in cand["benchmarks"]:
+        a = old.get(b["name"])
+        if a is None:
+            print("%-24s (new)" % b["name"])
+            continue
+        d50 = pct(a["p50_ns"], b["p50_ns"])
+        d99 = pct(a["p99_ns"], b["p99_ns"])
+        print("%-24s %12d %12d %+8.1f %12d %12d %+8.1f" %
+              (b["name"], a["p50_ns"], b["p50_ns"], d50, a["p99_ns"], b["p99_ns"], d99))
+        if d50 > args.threshold or d99 > args.threshold:
+            regressions.append("%s: latency p50 %+.1f%%, p99 %+.1f%%" % (b["name"], d50, d99))
+        if b["allocs_per_call"] > a["allocs_per_call"]:
+            regressions.append("%s: allocations per call %.2f -> %.2f" %
+                               (b["name"], a["allocs_per_call"], b["allocs_per_call"]))
+        if b["bytes_per_call"] > a["bytes_per_call"] * (1 + args.threshold / 100.0):
+            regressions.append("%s: bytes per call %.0f -> %.0f" %
+                               (b["name"], a["bytes_per_call"], b["bytes_per_call"]))
+
+    if "load" in base and "load" in cand:
+        for key in ("latency_ns", "sensor_lateness_ns"):
+            d = pct(base["load"][key]["p99"], cand["load"][key]["p99"])
+            print("load %-19s p99 %12d -> %12d %+8.1f" %
+                  (key, base["load"][key]["p99"], cand["load"][key]["p99"], d))
+            if d > args.threshold:
+                regressions.append("load %s p99 %+.1f%%" % (key, d))
+        if "requests_per_s" in base["load"]:
+            d = pct(base["load"]["requests_per_s"], cand["load"]["requests_per_s"])
+            print("load %-19s     %12.0f -> %12.0f %+8.1f" %
+                  ("requests_per_s", base["load"]["requests_per_s"],
+                   cand["load"]["requests_per_s"], d))
+            if -d > args.threshold:
+                regressions.append("load throughput %+.1f%%" % d)
+        if cand["load"]["errors"] > base["load"]["errors"]:
+            regressions.append("load errors %d -> %d" %
+                               (base["load"]["errors"], cand["load"]["errors"]))
+
+    for fmt in sorted(set(base.get("export", {})) & set(cand.get("export", {}))):
+        a, b = base["export"][fmt], cand["export"][fmt]
+        d = pct(a["samples_per_s"], b["samples_per_s"])
+        print("export %-17s %12.0f -> %12.0f samples/s %+8.1f" %
+              (fmt, a["samples_per_s"], b["samples_per_s"], d))
+        if -d > args.threshold:
+            regressions.append("export %s throughput %+.1f%%" % (fmt, d))
+        if not b["ok"]:
+            regressions.append("export %s returned inconsistent data" % fmt)
+
+    if regressions:
+        print("\nRegressions (%s -> %s):" % (base.get("label") or args.baseline,
+                                             cand.get("label") or args.candidate))
+        for r in regressions:
+            print("  " + r)
+        return 1
+    print("\nNo regressions beyond %.0f%%." % args.threshold)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Stand-in collector for the uplink: receive sample batches, store per unit.
+
+    python3 tools/collector.py --port 8086 --dir collected
+    # device:     const char* uplinkUrl = "http://<this host>:8086/ingest";
+    # simulation: ./build-host/potato_sim --uplink http://127.0.0.1:8086/ingest
+
+Each POST body is a binary /export stream (see tools/export_decode.py) and
+the X-Potato-Unit header names the unit. Rows go to DIR/<unit>.csv as
+"timestamp,temperature_f,humidity", the same as /export?format=csv.
+
+The device sends at least once: a batch whose answer got lost, or samples
+after a reboot, arrive again. Timestamps already stored are skipped, so the
+files hold every sample exactly once. The 204 goes out only after the rows
+are fsync'd; a collector killed mid-batch has not acknowledged it, and the
+device resends. A row cut short by the kill is trimmed at startup.
+"""
+import argparse
+import os
+import re
+import sys
+from http.server import BaseHTTPRequestHandler, HTTPServer
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from export_decode import samples  # noqa: E402
+
+UNIT_RE = re.compile(r"^[A-Za-z0-9_.-]{1,32}$")
+HEADER = "timestamp,temperature_f,humidity\n"
+
+
+class Store:
+    def __init__(self, directory: str):
+        self.dir = directory
+        self.seen = {}          # unit -> set of stored timestamps
+        os.makedirs(directory, exist_ok=True)
+
+    def path(self, unit: str) -> str:
+        return os.path.join(self.dir, unit + ".csv")
+
+    def load(self, unit: str) -> set:
+        if unit in self.seen:
+            return self.seen[unit]
+        seen = set()
+        path = self.path(unit)
+        if os.path.exists(path):
+            with open(path, "rb+") as f:
+                data = f.read()
+                end = data.rfind(b"\n") + 1
+                if end != len(data):            # torn last row
+                    f.truncate(end)
+                    data = data[:end]
+            for line in data.decode().splitlines()[1:]:
+                seen.add(int(line.split(",", 1)[0]))
+        self.seen[unit] = seen
+        return seen
+
+    def add(self, unit: str, rows) -> int:
+        seen = self.load(unit)
+        fresh = [r for r in rows if r[0] not in seen]
+        if not fresh:
+            return 0
+        path = self.path(unit)
+        new_file = not os.path.exists(path) or os.path.getsize(path) == 0
+        with open(path, "a") as f:
+            if new_file:
+                f.write(HEADER)
+            for ts, t10, h10 in fresh:
+                f.write("%d,%.1f,%.1f\n" % (ts, t10 / 10, h10 / 10))
+            f.flush()
+            os.fsync(f.fileno())
+        seen.update(r[0] for r in fresh)
+        return len(fresh)
+
+
+def make_handler(store: Store, quiet: bool):
+    class Handler(BaseHTTPRequestHandler):
+        def do_POST(self):
+            unit = self.headers.get("X-Potato-Unit", "")
+            length = int(self.headers.get("Content-Length", "0"))
+            body = self.rfile.read(length)
+            if not UNIT_RE.match(unit) or len(body) != length:
+                self.send_error(400, "need X-Potato-Unit and the full body")
+                return
+            errors = []
+            try:
+                rows = list(samples(body, errors))
+            except (SystemExit, Exception) as e:      # not an export stream
+                self.send_error(400, "undecodable batch: %s" % e)
+                return
+            added = store.add(unit, rows)
+            for e in errors:
+                print("collector: %s: %s" % (unit, e), file=sys.stderr)
+            if not quiet:
+                print("collector: %s: %d samples, %d new" % (unit, len(rows), added),
+                      file=sys.stderr)
+            self.send_response(204)
+            self.end_headers()
+
+        def log_message(self, fmt, *args):
+            pass
+
+    return Handler
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--port", type=int, default=8086)
+    ap.add_argument("--bind", default="0.0.0.0")
+    ap.add_argument("--dir", default="collected", help="where <unit>.csv files go")
+    ap.add_argument("--quiet", action="store_true", help="log errors only")
+    args = ap.parse_args()
+
+    store = Store(args.dir)
+    server = HTTPServer((args.bind, args.port), make_handler(store, args.quiet))
+    if not args.quiet:
+        print("collector: listening on %s:%d, storing in %s/" % (args.bind, args.port, args.dir),
+              file=sys.stderr)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
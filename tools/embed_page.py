@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Gzip web/index.html into index_html_gz.h so the dashboard is served
+straight from flash.
+
+    python3 tools/embed_page.py          # regenerate index_html_gz.h
+    python3 tools/embed_page.py --check  # fail if the header is stale
+
+Run it after every edit to web/index.html. The output is deterministic
+(gzip mtime is pinned to 0), so an unchanged page yields an unchanged header
+and ETag. Before writing, the blob is decompressed again and compared with
+the source page; a mismatch aborts the build.
+
+Also usable as a PlatformIO pre-build script:
+    extra_scripts = pre:tools/embed_page.py
+"""
+import gzip
+import hashlib
+import os
+import sys
+
+ROOT   = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "web", "index.html")
+OUTPUT = os.path.join(ROOT, "index_html_gz.h")
+
+
+def render(page: bytes) -> str:
+    blob = gzip.compress(page, compresslevel=9, mtime=0)
+    if gzip.decompress(blob) != page:
+        sys.exit("embed_page: gzip round-trip does not reproduce web/index.html")
+
+    etag = hashlib.sha256(page).hexdigest()[:16]
+    lines = [
+        "#pragma once",
+        "// Generated by tools/embed_page.py from web/index.html — do not edit.",
+        "// %d bytes of HTML, %d bytes gzipped." % (len(page), len(blob)),
+        "#include <stdint.h>",
+        "#include <stddef.h>",
+        "",
+        'static const char     INDEX_HTML_ETAG[]  = "\\"%s\\"";' % etag,
+        "static const size_t   INDEX_HTML_GZ_LEN  = %d;" % len(blob),
+        "static const uint8_t  INDEX_HTML_GZ[]    = {",
+    ]
+    for i in range(0, len(blob), 16):
+        chunk = blob[i:i + 16]
+        lines.append("  " + ", ".join("0x%02x" % b for b in chunk) + ",")
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def main(argv) -> int:
+    with open(SOURCE, "rb") as f:
+        page = f.read().replace(b"\r\n", b"\n")
+    header = render(page)
+
+    current = None
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, "r", encoding="utf-8", newline="") as f:
+            current = f.read().replace("\r\n", "\n")
+
+    if "--check" in argv:
+        if current != header:
+            print("index_html_gz.h is stale; run tools/embed_page.py", file=sys.stderr)
+            return 1
+        return 0
+
+    if current != header:
+        with open(OUTPUT, "w", encoding="utf-8", newline="\r\n") as f:
+            f.write(header)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
+else:
+    # Imported by PlatformIO as an extra_script.
+    main([])
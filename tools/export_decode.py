@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Decode a binary /export stream into CSV.
+
+    curl -s 'http://potato.local/export?from=1750000000' -o season.bin
+    python3 tools/export_decode.py season.bin > season.csv
+    python3 tools/export_decode.py 'http://potato.local/export' --summary
+
+The input is a file, '-' for stdin, or an http:// URL to fetch. Output rows
+are "timestamp,temperature_f,humidity", the same as /export?format=csv.
+
+Format (little-endian): a 16-byte header
+
+    magic "PEX1", u8 version, u8 header length, u16 frame header length,
+    u32 from, u32 to
+
+followed by sample-log frames exactly as stored in flash (sample_log.h):
+
+    u32 magic "PLG1", u32 seq, u32 first ts, u32 last ts,
+    i16 temp (0.1 F), u16 humidity (0.1 %RH), u16 count, u16 payload length,
+    u32 CRC-32 over the header (CRC field zeroed) and the payload
+
+The first sample is in the header; each payload record is the change from
+the previous sample. Frames with a bad CRC are reported and skipped. Samples
+outside [from, to] are dropped, because frames are exported whole.
+"""
+import argparse
+import struct
+import sys
+import urllib.request
+import zlib
+
+EXPORT_HEADER = struct.Struct("<4sBBHII")
+FRAME_HEADER = struct.Struct("<4sIIIhHHHI")
+STEP_S = 2
+
+
+def varint(buf: bytes, i: int):
+    v = shift = 0
+    while True:
+        b = buf[i]
+        i += 1
+        v |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return v, i
+        shift += 7
+
+
+def unzigzag(v: int) -> int:
+    return (v >> 1) ^ -(v & 1)
+
+
+def decode_frame(head: tuple, payload: bytes):
+    _, _, ts, _, t10, h10, count, _, _ = head
+    yield ts, t10, h10
+    i = 0
+    for _ in range(count - 1):
+        tag = payload[i]
+        i += 1
+        if not tag & 0x80:
+            ts += STEP_S
+            t10 += (tag >> 4) - 4
+            h10 += (tag & 15) - 8
+        else:
+            dt = tag & 0x7F
+            if tag == 0xFF:
+                dt, i = varint(payload, i)
+            dT, i = varint(payload, i)
+            dH, i = varint(payload, i)
+            ts += dt
+            t10 += unzigzag(dT)
+            h10 += unzigzag(dH)
+        yield ts, t10, h10
+
+
+def samples(data: bytes, errors: list):
+    magic, version, head_len, frame_head_len, lo, hi = EXPORT_HEADER.unpack_from(data)
+    if magic != b"PEX1" or version != 1 or frame_head_len != FRAME_HEADER.size:
+        sys.exit("export_decode: not a version 1 potato export")
+    off = head_len
+    while off + FRAME_HEADER.size <= len(data):
+        head = FRAME_HEADER.unpack_from(data, off)
+        plen = head[7]
+        end = off + FRAME_HEADER.size + plen
+        if head[0] != b"PLG1" or end > len(data):
+            errors.append("malformed frame at byte %d; stopping" % off)
+            return
+        zeroed = data[off:off + FRAME_HEADER.size - 4] + b"\0\0\0\0"
+        payload = data[off + FRAME_HEADER.size:end]
+        if zlib.crc32(payload, zlib.crc32(zeroed)) != head[8]:
+            errors.append("bad CRC in frame %d at byte %d; skipped" % (head[1], off))
+        else:
+            for s in decode_frame(head, payload):
+                if lo <= s[0] <= hi:
+                    yield s
+        off = end
+
+
+def read_input(src: str) -> bytes:
+    if src.startswith("http://") or src.startswith("https://"):
+        with urllib.request.urlopen(src) as r:
+            return r.read()
+    if src == "-":
+        return sys.stdin.buffer.read()
+    with open(src, "rb") as f:
+        return f.read()
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("input", help="export file, '-' for stdin, or an http:// URL")
+    ap.add_argument("--summary", action="store_true",
+                    help="print count, span and min/max instead of CSV")
+    args = ap.parse_args()
+
+    errors = []
+    rows = samples(read_input(args.input), errors)
+    if args.summary:
+        n, first, last = 0, None, None
+        tmin = hmin = float("inf")
+        tmax = hmax = float("-inf")
+        for ts, t10, h10 in rows:
+            n += 1
+            first = ts if first is None else first
+            last = ts
+            tmin, tmax = min(tmin, t10), max(tmax, t10)
+            hmin, hmax = min(hmin, h10), max(hmax, h10)
+        if n:
+            print("%d samples, %d .. %d (%.1f days)" % (n, first, last, (last - first) / 86400))
+            print("temperature %.1f .. %.1f F, humidity %.1f .. %.1f %%" %
+                  (tmin / 10, tmax / 10, hmin / 10, hmax / 10))
+        else:
+            print("0 samples")
+    else:
+        out = sys.stdout
+        out.write("timestamp,temperature_f,humidity\n")
+        for ts, t10, h10 in rows:
+            out.write("%d,%.1f,%.1f\n" % (ts, t10 / 10, h10 / 10))
+
+    for e in errors:
+        print("export_decode: " + e, file=sys.stderr)
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
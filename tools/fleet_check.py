@@ -0,0 +1,248 @@
+#!/usr/bin/env python3
+"""Run potato_fleet against a small fleet of simulated units and check what it stored.
+
+    cmake -S host -B build-host && cmake --build build-host
+    python3 tools/fleet_check.py [--sim build-host/potato_sim] [--fleet build-host/potato_fleet]
+
+Starts three potato_sim units in real time (one, two and three probes,
+reading every 2 s), a stand-in that accepts connections and never answers,
+and a port nothing listens on, then scrapes them all every second for
+SECONDS. Halfway through the two-probe unit is killed and, a few seconds
+later, started again on the same port. Afterwards:
+
+  - every stored row of a sim unit that shares a timestamp with one of its
+    /history?res=raw rows has that row's temperature, humidity and dew
+    point (the killed unit's history is fetched just before the kill). The
+    one-probe unit's rows must all be history rows; with more probes the
+    room reading also changes on the reads in between room samples, and
+    those rows are new readings /history never kept
+  - timestamps strictly increase, and the healthy units have at least
+    COVERAGE of their readings from the scrape window stored
+  - the killed unit stored readings from both of its lives
+  - the refused port was tried a bounded number of times (backoff), the
+    silent stand-in timed out, and neither stored anything
+  - a --from/--to query returns exactly the matching rows of a full query
+  - garbage appended to a file (a torn block) is ignored by queries, cut
+    off by the next scrape, and the scrape resumes after the newest row
+
+Exits 0 on success, 1 with what differs otherwise.
+"""
+import argparse
+import json
+import os
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+import urllib.request
+
+SECONDS = 20
+KILL_AT, RESTART_AT = 7, 11
+COVERAGE = 0.9
+MAX_REFUSED_ATTEMPTS = 8          # 1 s interval, backoff doubling to 4 s
+
+
+def free_port():
+    with socket.socket() as s:
+        s.bind(("127.0.0.1", 0))
+        return s.getsockname()[1]
+
+
+def start_sim(sim, port, sensors, log):
+    return subprocess.Popen([sim, "--port", str(port), "--sensors", str(sensors), "--max-period", "2s"],
+                            stdout=log, stderr=log)
+
+
+def raw_history(port):
+    with urllib.request.urlopen("http://127.0.0.1:%d/history?res=raw" % port, timeout=5) as r:
+        return {row[0]: tuple(round(v * 10) for v in row[1:4]) for row in json.load(r)["samples"]}
+
+
+def wait_listening(port):
+    for _ in range(50):
+        try:
+            socket.create_connection(("127.0.0.1", port), timeout=0.2).close()
+            return True
+        except OSError:
+            time.sleep(0.1)
+    return False
+
+
+def silent_server(sock, stop):
+    """Accept and hold connections without ever answering."""
+    held = []
+    sock.settimeout(0.2)
+    while not stop.is_set():
+        try:
+            held.append(sock.accept()[0])
+        except socket.timeout:
+            pass
+    for c in held:
+        c.close()
+
+
+def query(fleet, store, unit, *extra):
+    out = subprocess.run([fleet, "query", "--dir", store, "--unit", unit] + list(extra),
+                         stdout=subprocess.PIPE, check=True, text=True).stdout
+    rows = []
+    for line in out.splitlines()[1:]:
+        f = line.split(",")
+        rows.append((int(f[0]), round(float(f[1]) * 10), round(float(f[2]) * 10), round(float(f[3]) * 10)))
+    return rows
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--sim", default="build-host/potato_sim")
+    ap.add_argument("--fleet", default=None, help="default: potato_fleet next to --sim")
+    args = ap.parse_args()
+    fleet = args.fleet or os.path.join(os.path.dirname(args.sim), "potato_fleet")
+
+    work = tempfile.mkdtemp(prefix="fleet_check.")
+    store = os.path.join(work, "store")
+    log = open(os.path.join(work, "units.log"), "w")
+    ports = {name: free_port() for name in ("one", "two", "three", "silent", "refused")}
+    sims = {name: start_sim(args.sim, ports[name], n, log)
+            for name, n in (("one", 1), ("two", 2), ("three", 3))}
+    silent = socket.socket()
+    silent.bind(("127.0.0.1", ports["silent"]))
+    silent.listen(8)
+    stop = threading.Event()
+    holder = threading.Thread(target=silent_server, args=(silent, stop))
+    holder.start()
+    problems = []
+    try:
+        for name in sims:
+            if not wait_listening(ports[name]):
+                print("fleet_check: sim %s never listened (log in %s)" % (name, work), file=sys.stderr)
+                return 1
+
+        units = os.path.join(work, "units.txt")
+        with open(units, "w") as f:
+            f.write("# fleet_check units\n")
+            for name, port in ports.items():
+                f.write("%s 127.0.0.1:%d\n" % (name, port))
+        report = os.path.join(work, "report.json")
+        with open(os.path.join(work, "fleet.log"), "w") as flog:
+            scraper = subprocess.Popen([fleet, "scrape", "--units", units, "--dir", store,
+                                        "--interval", "1s", "--timeout", "500ms", "--max-backoff", "4s",
+                                        "--flush", "5s", "--duration", "%ds" % SECONDS,
+                                        "--json", report], stderr=flog)
+            started = time.time()
+            time.sleep(KILL_AT)
+            history = {"two": raw_history(ports["two"])}
+            sims["two"].send_signal(signal.SIGKILL)
+            sims["two"].wait()
+            killed = time.time()
+            time.sleep(RESTART_AT - KILL_AT)
+            sims["two"] = start_sim(args.sim, ports["two"], 2, log)
+            scraper.wait()
+        ended = time.time()
+        if scraper.returncode != 0:
+            print("fleet_check: potato_fleet exited with %d (logs in %s)" % (scraper.returncode, work),
+                  file=sys.stderr)
+            return 1
+        for name in ("one", "three"):
+            history[name] = raw_history(ports[name])
+        after = raw_history(ports["two"])
+        history["two"].update(after)
+        stats = {u["name"]: u for u in json.load(open(report))["units"]}
+
+        for name in ("one", "two", "three"):
+            rows = query(fleet, store, name)
+            hist = history[name]
+            stray = [r for r in rows if r[0] in hist and hist[r[0]] != r[1:]]
+            extra = [r for r in rows if r[0] not in hist]
+            if stray:
+                problems.append("%s: %d of %d stored rows differ from /history, first %s (history has %s)"
+                                % (name, len(stray), len(rows), stray[0], hist.get(stray[0][0])))
+            if name == "one" and extra:
+                problems.append("one: %d stored rows have no /history row, first %s" % (len(extra), extra[0]))
+            if any(b[0] <= a[0] for a, b in zip(rows, rows[1:])):
+                problems.append("%s: timestamps do not strictly increase" % name)
+            # Readings the unit took while the scraper ran (its first and last
+            # seconds aside), against what was stored
+            lo, hi = int(started) + 2, int(ended) - 2
+            stored = {r[0] for r in rows}
+            if name == "two":
+                expect = [t for t in after if lo <= t <= hi]
+                got = [t for t in expect if t in stored]
+                before = [r for r in rows if r[0] < killed]
+                print("  %-6s %3d rows, %3d before the kill, %d of %d readings after the restart" %
+                      (name, len(rows), len(before), len(got), len(expect)))
+                if not before or not got:
+                    problems.append("two: %d rows before the kill, %d after the restart" %
+                                    (len(before), len(got)))
+                continue
+            expect = [t for t in hist if lo <= t <= hi]
+            got = [t for t in expect if t in stored]
+            print("  %-6s %3d rows, %d of %d readings in the window" % (name, len(rows), len(got), len(expect)))
+            if not expect or len(got) < COVERAGE * len(expect):
+                problems.append("%s: stored %d of %d readings" % (name, len(got), len(expect)))
+
+        for name in ("refused", "silent"):
+            s = stats[name]
+            print("  %-8s %d attempts, %d failures, %d timeouts, %d samples" %
+                  (name, s["attempts"], s["failures"], s["timeouts"], s["samples"]))
+            if s["samples"] or query(fleet, store, name):
+                problems.append("%s: stored readings" % name)
+        if not 2 <= stats["refused"]["attempts"] <= MAX_REFUSED_ATTEMPTS:
+            problems.append("refused: %d attempts, expected 2..%d" %
+                            (stats["refused"]["attempts"], MAX_REFUSED_ATTEMPTS))
+        if stats["silent"]["timeouts"] < 2:
+            problems.append("silent: %d timeouts" % stats["silent"]["timeouts"])
+
+        # Range query
+        rows = query(fleet, store, "one")
+        if len(rows) >= 3:
+            lo, hi = rows[len(rows) // 3][0], rows[2 * len(rows) // 3][0]
+            ranged = query(fleet, store, "one", "--from", str(lo), "--to", str(hi))
+            if ranged != [r for r in rows if lo <= r[0] <= hi]:
+                problems.append("one: --from %d --to %d returned %d rows, expected %d" %
+                                (lo, hi, len(ranged), len([r for r in rows if lo <= r[0] <= hi])))
+
+        # Torn tail: a half-written block after the good ones
+        path = os.path.join(store, "one.pfc")
+        size = os.path.getsize(path)
+        with open(path, "ab") as f:
+            f.write(b"PFC1" + b"\x07" * 30)
+        if query(fleet, store, "one") != rows:
+            problems.append("one: a torn tail changed the query result")
+        with open(units, "w") as f:
+            f.write("one 127.0.0.1:%d\n" % ports["one"])
+        subprocess.run([fleet, "scrape", "--units", units, "--dir", store, "--interval", "1s",
+                        "--duration", "5s"], stderr=subprocess.DEVNULL, check=True)
+        resumed = query(fleet, store, "one")
+        hist = raw_history(ports["one"])
+        if resumed[:len(rows)] != rows or len(resumed) <= len(rows):
+            problems.append("one: resuming kept %d of %d rows and added %d" %
+                            (len(resumed[:len(rows)]) if resumed[:len(rows)] == rows else 0,
+                             len(rows), len(resumed) - len(rows)))
+        elif any(hist.get(r[0]) != r[1:] for r in resumed[len(rows):]):
+            problems.append("one: rows stored after resuming are not in /history")
+        elif os.path.getsize(path) <= size:
+            problems.append("one: file did not grow after the torn tail was cut")
+        print("  torn tail cut, %d rows after resuming (%d before)" % (len(resumed), len(rows)))
+    finally:
+        stop.set()
+        holder.join()
+        silent.close()
+        for p in sims.values():
+            p.terminate()
+            p.wait()
+        log.close()
+
+    for p in problems:
+        print("  " + p)
+    if problems:
+        print("fleet_check: FAILED (logs in %s)" % work)
+        return 1
+    print("fleet_check: OK")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,246 @@
+#!/usr/bin/env python3
+"""Check /history's tiers and range queries after every ring has wrapped.
+
+    cmake -S host -B build-host && cmake --build build-host
+    python3 tools/history_check.py [--sim build-host/potato_sim]
+
+Replays 35 days of a noisy storage-room trace through potato_sim, longer
+than the 30 days the HOUR tier holds, so all three rings have wrapped. A
+first run lists every tier; a second run of the same trace lists them
+again and asks for ranges picked from the first listing. The check then
+looks at:
+
+  wraparound  each tier holds exactly its capacity, oldest first, in
+              order; minute and hour rows sit on their bucket boundaries
+  rollover    every minute the RAW tier fully covers matches its 1m row
+              (min, max and average rounded half away from zero), and
+              every hour the 1m tier covers has the min/max of its minute
+              rows and an average between theirs
+  ranges      from/to on a row, one second beside it, crossed, outside
+              the data, or only one of them given: exactly the listed
+              rows with from <= ts <= to, and "res" their spacing (the
+              tier's period, or for raw the mean gap between the rows)
+  auto        res=auto (and no res) picks the finest tier whose oldest
+              row reaches `from`, and an unknown res is refused
+
+Exits 0 on success, 1 with what differs otherwise.
+"""
+import argparse
+import json
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+EPOCH = 1750000000
+DAYS = 35
+CAPACITY = {"raw": 1800, "1m": 1440, "1h": 720}
+PERIOD = {"1m": 60, "1h": 3600}
+FULL = ["/history?res=raw", "/history?res=1m", "/history?res=1h"]
+
+
+def trace():
+    """(second, temp_c, humidity) every 30 s."""
+    rng = random.Random(1)
+    c, h, rows = 8.0, 88.0, []
+    for t in range(0, DAYS * 86400, 30):
+        c = min(max(c + rng.gauss(0, 0.05), 3.0), 14.0)
+        h = min(max(h + rng.gauss(0, 0.1), 70.0), 98.0)
+        spike = rng.random() < 0.002
+        rows.append((t, round(c + (rng.choice((-3, 3)) if spike else 0), 1),
+                     round(h + (rng.choice((-8, 8)) if spike else 0), 1)))
+    return rows
+
+
+def responses(raw):
+    """Split the sim's concatenated raw HTTP responses into JSON bodies."""
+    bodies = []
+    while raw:
+        head, _, rest = raw.partition(b"\r\n\r\n")
+        if b"Transfer-Encoding: chunked" in head:
+            body = b""
+            while True:
+                size, _, rest = rest.partition(b"\r\n")
+                size = int(size, 16)
+                body, rest = body + rest[:size], rest[size + 2:]
+                if size == 0:
+                    break
+        else:
+            length = int(head.split(b"Content-Length: ")[1].split(b"\r\n")[0])
+            body, rest = rest[:length], rest[length:]
+        bodies.append(json.loads(body))
+        raw = rest
+    return bodies
+
+
+def run_sim(sim, csv, targets, log):
+    run = subprocess.run([sim, "--fast", "--port", "0", "--csv", csv, "--epoch", str(EPOCH)]
+                         + [a for t in targets for a in ("--get", t)],
+                         stdout=subprocess.PIPE, stderr=log)
+    if run.returncode != 0:
+        return None
+    return responses(run.stdout)
+
+
+def spacing(name, rows):
+    """The "res" for these rows: the tier's period, or for raw the rounded
+    mean gap between them (2 s, the fastest read, for fewer than two)."""
+    if name != "raw":
+        return PERIOD[name]
+    if len(rows) < 2:
+        return 2
+    return int((rows[-1][0] - rows[0][0]) / (len(rows) - 1) + 0.5)
+
+
+def tenths(row, cols):
+    return [round(row[c] * 10) for c in cols]
+
+
+def avg(total, n):
+    """The store's integer average: rounded half away from zero."""
+    return (total + n // 2) // n if total >= 0 else -((-total + n // 2) // n)
+
+
+def check_tiers(tiers, problems):
+    """Wraparound and rollover over the full listings {name: rows}."""
+    for name, rows in tiers.items():
+        stamps = [r[0] for r in rows]
+        if len(rows) != CAPACITY[name]:
+            problems.append("%s: %d rows, a wrapped ring holds %d" % (name, len(rows), CAPACITY[name]))
+        if name == "raw":
+            if stamps != sorted(stamps):
+                problems.append("raw: rows out of order")
+        else:
+            if any(b <= a for a, b in zip(stamps, stamps[1:])):
+                problems.append("%s: rows not strictly increasing" % name)
+            if any(ts % PERIOD[name] for ts in stamps):
+                problems.append("%s: a row off its bucket boundary" % name)
+
+    # RAW → 1m: minutes after the oldest raw row and before the newest one's
+    raw, minutes, hours = tiers["raw"], tiers["1m"], tiers["1h"]
+    buckets = {}
+    for r in raw:
+        buckets.setdefault(r[0] // 60 * 60, []).append(r)
+    lo, hi = raw[0][0], raw[-1][0] // 60 * 60
+    covered = {m: rs for m, rs in buckets.items() if lo < m < hi}
+    by_ts = {r[0]: r for r in minutes}
+    for m, rs in sorted(covered.items()):
+        row = by_ts.get(m)
+        if row is None:
+            problems.append("1m: no row for minute %d, which RAW holds %d samples of" % (m, len(rs)))
+            continue
+        t = [tenths(r, [1])[0] for r in rs]
+        h = [tenths(r, [2])[0] for r in rs]
+        want = [avg(sum(t), len(t)), avg(sum(h), len(h)), min(t), max(t), min(h), max(h)]
+        if tenths(row, range(1, 7)) != want:
+            problems.append("1m row %d: %s, RAW gives %s" % (m, tenths(row, range(1, 7)), want))
+    extra = [ts for ts in by_ts if lo < ts < hi and ts not in covered]
+    if extra:
+        problems.append("1m: rows for minutes RAW has no samples in: %s" % extra[:5])
+
+    # 1m → 1h: hours after the oldest minute row
+    first_minute = minutes[0][0]
+    checked = 0
+    for row in hours:
+        if row[0] <= first_minute:
+            continue
+        inside = [m for m in minutes if row[0] <= m[0] < row[0] + 3600]
+        if not inside:
+            problems.append("1h row %d: no minute rows inside it" % row[0])
+            continue
+        t_avg, h_avg, t_lo, t_hi, h_lo, h_hi = tenths(row, range(1, 7))
+        if [t_lo, t_hi, h_lo, h_hi] != [min(tenths(m, [3])[0] for m in inside),
+                                        max(tenths(m, [4])[0] for m in inside),
+                                        min(tenths(m, [5])[0] for m in inside),
+                                        max(tenths(m, [6])[0] for m in inside)]:
+            problems.append("1h row %d: min/max differ from its %d minute rows" % (row[0], len(inside)))
+        avgs = [tenths(m, [1, 2]) for m in inside]
+        if not (min(a[0] for a in avgs) <= t_avg <= max(a[0] for a in avgs) and
+                min(a[1] for a in avgs) <= h_avg <= max(a[1] for a in avgs)):
+            problems.append("1h row %d: average outside its minute rows' averages" % row[0])
+        checked += 1
+    return len(covered), checked
+
+
+def range_cases(tiers):
+    """(target, tier, from, to) for ranges around the first run's rows."""
+    rng = random.Random(7)
+    for name, rows in tiers.items():
+        stamps = [r[0] for r in rows]
+        mid = stamps[len(stamps) // 2]
+        cases = [(stamps[0], stamps[0]), (stamps[-1], stamps[-1]), (stamps[0] - 100000, stamps[0] - 1),
+                 (stamps[-1] + 1, None), (None, mid), (mid, None)]
+        for _ in range(6):
+            a, b = sorted(rng.sample(stamps, 2))
+            cases += [(a, b), (a - 1, b + 1), (a + 1, b - 1), (b, a)]
+        for a, b in cases:
+            query = "res=" + name + "".join("&%s=%d" % (k, v) for k, v in (("from", a), ("to", b))
+                                             if v is not None)
+            yield "/history?" + query, name, a, b
+
+    # res=auto and no res: the finest tier whose oldest row reaches `from`
+    raw0, m0, h0 = tiers["raw"][0][0], tiers["1m"][0][0], tiers["1h"][0][0]
+    for a in (raw0, raw0 + 1, raw0 - 1, m0, m0 + 1, m0 - 1, h0, h0 - 1, 0):
+        want = "raw" if a >= raw0 else "1m" if a >= m0 else "1h"
+        yield "/history?res=auto&from=%d" % a, want, a, None
+        yield "/history?from=%d&to=%d" % (a, a + 7200), want, a, a + 7200
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--sim", default="build-host/potato_sim")
+    args = ap.parse_args()
+
+    work = tempfile.mkdtemp(prefix="history_check.")
+    csv = os.path.join(work, "trace.csv")
+    with open(csv, "w") as f:
+        f.write("seconds,temp_c,humidity\n")
+        for row in trace():
+            f.write("%d,%.1f,%.1f\n" % row)
+
+    with open(os.path.join(work, "sim.log"), "w") as log:
+        first = run_sim(args.sim, csv, FULL, log)
+        if first is None:
+            print("history_check: potato_sim exited with an error (log in %s)" % work, file=sys.stderr)
+            return 1
+        picked = {name: body["samples"] for name, body in zip(CAPACITY, first)}
+        cases = list(range_cases(picked))
+        second = run_sim(args.sim, csv, FULL + [c[0] for c in cases] + ["/history?res=5m"], log)
+        if second is None:
+            print("history_check: potato_sim exited with an error (log in %s)" % work, file=sys.stderr)
+            return 1
+
+    tiers = {name: body["samples"] for name, body in zip(CAPACITY, second)}
+    problems = []
+    minutes, hours = check_tiers(tiers, problems)
+    for (name, rows), body in zip(tiers.items(), second):
+        print("  %-3s %5d rows  %d..%d  res %d s" % (name, len(rows), rows[0][0], rows[-1][0], body["res"]))
+        if body["res"] != spacing(name, rows):
+            problems.append("/history?res=%s: res %d, rows are %d s apart" % (name, body["res"], spacing(name, rows)))
+    print("  rollover: %d minutes checked against RAW, %d hours against 1m" % (minutes, hours))
+
+    bodies = second[len(FULL):]
+    for (target, name, a, b), body in zip(cases, bodies):
+        lo = 0 if a is None else a
+        hi = 2 ** 32 - 1 if b is None else b
+        want = [r for r in tiers[name] if lo <= r[0] <= hi]
+        if body["samples"] != want:
+            problems.append("%s: %d rows, expected %d (%s)" % (target, len(body["samples"]), len(want), name))
+        elif body["res"] != spacing(name, want):
+            problems.append("%s: res %s, expected %d" % (target, body["res"], spacing(name, want)))
+    print("  ranges: %d queries" % len(cases))
+    if "error" not in bodies[-1]:
+        problems.append("/history?res=5m: accepted, expected an error")
+
+    for p in problems:
+        print("  " + p)
+    if problems:
+        print("history_check: FAILED (logs in %s)" % work)
+        return 1
+    print("history_check: OK")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
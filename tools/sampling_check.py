@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+"""Compare adaptive sampling with fixed 2 s reads on replayed storage-room traces.
+
+    cmake -S host -B build-host && cmake --build build-host
+    python3 tools/sampling_check.py [--sim build-host/potato_sim] [--keep DIR]
+                                    [--trace FILE]...
+
+Builds four traces the way a DHT22 would report them (0.1 °C / 0.1 %RH
+steps, one value per second, with the odd one-count flicker):
+
+  still    36 h of a closed room: a small day/night swing and nothing else
+  doors    the same room with ten door openings: a drop of 2-4 °C and
+           5-10 %RH within a minute or two, then a slow recovery
+  fans     ventilation for 45 min every 6 h: cooler and drier, then back
+  cooling  72 h of a room being brought down from 10 to 6 °C
+
+--trace adds a recorded one: a unit's /export?format=csv
+("timestamp,temperature_f,humidity", taken at a fixed 2 s), or a sim trace
+("seconds,temp_c,humidity"). Each reading is held until the next; gaps
+longer than RECORDED_GAP seconds are an outage, not compared. Recorded
+traces have no marked events, so only the share and error bounds apply.
+
+Each is replayed through potato_sim twice, with --max-period 2s (the old
+fixed cadence) and with the default adaptive one, and the stored samples
+are read back from /export. Between samples the stored series is joined
+by straight lines; the error is that line against the trace, second by
+second. For every trace the adaptive run must:
+
+  - store at most MAX_SHARE of the fixed run's samples (QUIET_SHARE on
+    the still trace)
+  - stay within RMS_SLACK of the fixed run's RMS error and within
+    MAX_ERROR of the trace everywhere
+  - catch every event's extreme (lowest temperature and humidity while a
+    door is open or the fans run) within EVENT_SLACK
+
+Prints a table per trace and exits 0 on success, 1 with what failed.
+"""
+import argparse
+import math
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+
+EPOCH = 1750000000
+MAX_SHARE = 0.5
+QUIET_SHARE = 0.15
+RMS_SLACK = (0.10, 0.30)        # °F, %RH over the fixed run's RMS
+MAX_ERROR = (1.5, 4.0)          # °F, %RH
+EVENT_SLACK = (0.5, 1.5)        # °F, %RH
+RECORDED_GAP = 60               # s
+
+
+def quantize(c, h):
+    return round(c, 1), round(min(max(h, 0.0), 100.0), 1)
+
+
+class Room:
+    """One value per second, with one-count flicker held for a few seconds."""
+
+    def __init__(self, seed):
+        self.rng = random.Random(seed)
+        self.flicker, self.until = (0.0, 0.0), 0
+
+    def read(self, t, c, h):
+        if t >= self.until:
+            self.flicker = (0.0, 0.0)
+            if self.rng.random() < 0.01:
+                self.flicker = (self.rng.choice((-0.1, 0.1)), self.rng.choice((-0.1, 0.1)))
+                self.until = t + self.rng.randint(2, 12)
+        return quantize(c + self.flicker[0], h + self.flicker[1])
+
+
+def base(t):
+    """Closed room: ±0.3 °C and ∓0.6 %RH over the day."""
+    day = math.sin(2 * math.pi * t / 86400)
+    return 7.5 + 0.3 * day, 90.0 - 0.6 * day
+
+
+def pulse(t, start, length, tau_in, tau_out):
+    """0 → 1 while on (time constant tau_in), back to 0 afterwards (tau_out)."""
+    if t < start:
+        return 0.0
+    on = 1 - math.exp(-min(t - start, length) / tau_in)
+    return on if t < start + length else on * math.exp(-(t - start - length) / tau_out)
+
+
+def trace_still():
+    room = Room(1)
+    return [room.read(t, *base(t)) for t in range(36 * 3600)], []
+
+
+def trace_doors():
+    rng = random.Random(2)
+    room = Room(2)
+    doors = []
+    for start in sorted(rng.sample(range(3600, 35 * 3600, 600), 10)):
+        doors.append((start, rng.randint(60, 300), rng.uniform(2, 4), rng.uniform(5, 10)))
+    rows = []
+    for t in range(36 * 3600):
+        c, h = base(t)
+        for start, length, dc, dh in doors:
+            p = pulse(t, start, length, 40, 900)
+            c, h = c - dc * p, h - dh * p
+        rows.append(room.read(t, c, h))
+    return rows, [(s, s + n) for s, n, _, _ in doors]
+
+
+def trace_fans():
+    room = Room(3)
+    runs = [(start, 2700) for start in range(3 * 3600, 36 * 3600, 6 * 3600)]
+    rows = []
+    for t in range(36 * 3600):
+        c, h = base(t)
+        for start, length in runs:
+            p = pulse(t, start, length, 300, 1800)
+            c, h = c - 2.0 * p, h - 8.0 * p
+        rows.append(room.read(t, c, h))
+    return rows, [(s, s + n) for s, n in runs]
+
+
+def trace_cooling():
+    room = Room(4)
+    rows = []
+    for t in range(72 * 3600):
+        c, h = base(t)
+        rows.append(room.read(t, c + 2.5 - 4.0 * t / (72 * 3600), h + 2.0 * t / (72 * 3600)))
+    return rows, []
+
+
+def trace_recorded(path):
+    """A recorded trace held to one value per second, None inside outages."""
+    readings = []
+    with open(path) as f:
+        fahrenheit = "temperature_f" in f.readline()
+        for line in f:
+            fields = line.strip().split(",")
+            if len(fields) < 3 or not fields[1]:
+                continue
+            t, v, h = float(fields[0]), float(fields[1]), float(fields[2])
+            readings.append((int(t), quantize((v - 32) * 5 / 9 if fahrenheit else v, h)))
+    readings.sort(key=lambda r: r[0])
+    t0, rows = readings[0][0], []
+    for (t, r), (t1, _) in zip(readings, readings[1:] + [(readings[-1][0] + 1, None)]):
+        if t - t0 < len(rows):
+            continue                        # a second already recorded
+        rows.append(r)
+        rows += [r if t1 - t <= RECORDED_GAP else None] * (t1 - t - 1)
+    return rows, []
+
+
+TRACES = [("still", trace_still), ("doors", trace_doors), ("fans", trace_fans), ("cooling", trace_cooling)]
+
+
+def to_f10(c):
+    """0.1 °C → 0.1 °F, rounded as the firmware does."""
+    return round((c * 9 / 5 + 32) * 10)
+
+
+def write_csv(path, rows):
+    """Only the seconds where the reading changes (the sim holds a row);
+    None is a sensor that does not answer."""
+    with open(path, "w") as f:
+        f.write("seconds,temp_c,humidity\n")
+        last = ()
+        for t, r in enumerate(rows):
+            if r != last:
+                f.write("%d,,\n" % t if r is None else "%d,%.1f,%.1f\n" % (t, r[0], r[1]))
+                last = r
+
+
+def run_sim(sim, csv, work, max_period):
+    flash = os.path.join(work, "flash-" + max_period)
+    shutil.rmtree(flash, ignore_errors=True)
+    with open(os.path.join(work, "sim-%s.log" % max_period), "w") as log:
+        out = subprocess.run([sim, "--fast", "--port", "0", "--csv", csv, "--epoch", str(EPOCH),
+                              "--flash-dir", flash, "--max-period", max_period,
+                              "--get", "/export?format=csv"], stdout=subprocess.PIPE, stderr=log)
+    if out.returncode != 0:
+        raise RuntimeError("potato_sim exited with %d (log in %s)" % (out.returncode, work))
+    body = out.stdout.partition(b"\r\n\r\n")[2]
+    if b"Transfer-Encoding: chunked" in out.stdout.partition(b"\r\n\r\n")[0]:
+        raw, body = body, b""
+        while True:
+            size, _, raw = raw.partition(b"\r\n")
+            size = int(size, 16)
+            if size == 0:
+                break
+            body, raw = body + raw[:size], raw[size + 2:]
+    samples = []
+    for line in body.decode().splitlines():
+        f = line.split(",")
+        if f[0].isdigit():
+            samples.append((int(f[0]) - EPOCH, round(float(f[1]) * 10), round(float(f[2]) * 10)))
+    return samples
+
+
+def errors(samples, truth):
+    """RMS and max error of the joined samples against every second of the
+    trace between the first and last sample, outages left out, per channel
+    (0.1 units)."""
+    sq, worst, n = [0.0, 0.0], [0.0, 0.0], 0
+    for (t0, *a), (t1, *b) in zip(samples, samples[1:]):
+        for t in range(t0, t1):
+            if truth[t] is None:
+                continue
+            for ch in (0, 1):
+                est = a[ch] + (b[ch] - a[ch]) * (t - t0) / (t1 - t0)
+                e = abs(est - truth[t][ch])
+                sq[ch] += e * e
+                worst[ch] = max(worst[ch], e)
+            n += 1
+    return [math.sqrt(s / max(n, 1)) / 10 for s in sq], [w / 10 for w in worst]
+
+
+def extremes(samples, truth, events):
+    """Worst miss of an event's lowest temperature and humidity (°F, %RH)."""
+    miss = [0.0, 0.0]
+    for start, end in events:
+        span = range(start, end + 1800)     # the low can come just after
+        for ch in (0, 1):
+            low = min(truth[t][ch] for t in span if t < len(truth))
+            got = min((s[1 + ch] for s in samples if start <= s[0] < end + 1800), default=None)
+            miss[ch] = max(miss[ch], (got - low) / 10 if got is not None else float("inf"))
+    return miss
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--sim", default="build-host/potato_sim")
+    ap.add_argument("--keep", help="write traces and logs here instead of a temporary directory")
+    ap.add_argument("--trace", action="append", default=[],
+                    help="also replay this recorded trace (/export?format=csv or sim CSV)")
+    args = ap.parse_args()
+    traces = TRACES + [(os.path.splitext(os.path.basename(path))[0], lambda path=path: trace_recorded(path))
+                       for path in args.trace]
+    work = args.keep or tempfile.mkdtemp(prefix="sampling_check.")
+    os.makedirs(work, exist_ok=True)
+
+    problems = []
+    print("  %-8s %-9s %8s %7s %9s %9s %9s %9s %9s %9s" %
+          ("trace", "cadence", "samples", "share", "rms °F", "max °F", "rms %RH", "max %RH",
+           "event °F", "event %RH"))
+    for name, build in traces:
+        rows, events = build()
+        csv = os.path.join(work, name + ".csv")
+        write_csv(csv, rows)
+        truth = [r and (to_f10(r[0]), round(r[1] * 10)) for r in rows]
+        result = {}
+        for label, period in (("fixed", "2s"), ("adaptive", "30s")):
+            samples = run_sim(args.sim, csv, work, period)
+            rms, worst = errors(samples, truth)
+            miss = extremes(samples, truth, events)
+            result[label] = (len(samples), rms, worst, miss)
+        fixed_n = result["fixed"][0]
+        for label in ("fixed", "adaptive"):
+            n, rms, worst, miss = result[label]
+            print("  %-8s %-9s %8d %6.1f%% %9.3f %9.2f %9.3f %9.2f %9s %9s" %
+                  (name, label, n, 100.0 * n / max(fixed_n, 1), rms[0], worst[0], rms[1], worst[1],
+                   "%.2f" % miss[0] if events else "-", "%.2f" % miss[1] if events else "-"))
+
+        n, rms, worst, miss = result["adaptive"]
+        share = QUIET_SHARE if name == "still" else MAX_SHARE
+        if n > share * fixed_n:
+            problems.append("%s: %d samples, more than %.0f%% of the fixed run's %d" %
+                            (name, n, share * 100, fixed_n))
+        for ch, unit in ((0, "°F"), (1, "%RH")):
+            if rms[ch] > result["fixed"][1][ch] + RMS_SLACK[ch]:
+                problems.append("%s: RMS error %.3f %s, fixed %.3f" % (name, rms[ch], unit, result["fixed"][1][ch]))
+            if worst[ch] > MAX_ERROR[ch]:
+                problems.append("%s: error up to %.2f %s" % (name, worst[ch], unit))
+            if events and miss[ch] > EVENT_SLACK[ch]:
+                problems.append("%s: missed an event's low by %.2f %s" % (name, miss[ch], unit))
+
+    for p in problems:
+        print("  " + p)
+    if problems:
+        print("sampling_check: FAILED (traces and logs in %s)" % work)
+        return 1
+    if not args.keep:
+        shutil.rmtree(work)
+    print("sampling_check: OK")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
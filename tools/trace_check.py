@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Check /trace: Chrome trace-event JSON that a viewer can load as is.
+
+    cmake -S host -B build-host && cmake --build build-host
+    python3 tools/trace_check.py [--sim build-host/potato_sim] [--seconds S]
+
+Runs potato_sim twice with three probes and fetches /trace on exit:
+
+  realtime  --speed 1 for S seconds (default 12). The host's trace clock
+            is nanoseconds in 32 bits, which wrap every 4.29 s, so the
+            ring spans several wraps the way a unit's spans the 17.9 s
+            cycle counter
+  fast      --fast over an hour of virtual time, so the ring has been
+            overwritten many times over
+
+For each, the body must parse as JSON, and:
+
+  - every event name is one trace.h knows, every "ph" is B, E, i or M
+  - each thread's timestamps never go backwards, and no two neighbours
+    are further apart than MAX_GAP_S (a miscounted wrap is a 4.29 s jump)
+  - B and E pair up by name, innermost first; only the ring's start may
+    hold an E whose B was overwritten, only its end a B still open
+  - read_start, take_reading and display_step are all there, and the
+    last event is /trace's own B
+  - realtime: the events span no more than the run itself
+
+Exits 0 on success, 1 with what failed.
+"""
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+KNOWN = {"read_start", "take_reading", "read_failed", "log_append", "display_step",
+         "draw_readings", "web_publish", "http_pass", "/", "/sensor-data", "/history",
+         "/events", "/metrics", "/export", "/trend", "/trace", "net_step",
+         "uplink_post", "alert_post"}
+REQUIRED = ("read_start", "take_reading", "display_step")
+MAX_GAP_S = 3.0
+
+
+def fetch_trace(sim, extra):
+    out = subprocess.run([sim, "--port", "0", "--sensors", "3", "--max-period", "2s",
+                          "--get", "/trace"] + extra,
+                         stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+    if out.returncode != 0:
+        raise RuntimeError("potato_sim exited with %d" % out.returncode)
+    head, _, raw = out.stdout.partition(b"\r\n\r\n")
+    if b" 200 " not in head.split(b"\r\n")[0]:
+        raise RuntimeError("GET /trace: " + head.split(b"\r\n")[0].decode())
+    body = b""
+    while True:
+        size, _, raw = raw.partition(b"\r\n")
+        size = int(size, 16)
+        if size == 0:
+            break
+        body, raw = body + raw[:size], raw[size + 2:]
+    return json.loads(body)
+
+
+def check(label, doc, max_span_s):
+    problems = []
+    events = [e for e in doc["traceEvents"] if e["ph"] != "M"]
+    names = {e["name"] for e in events}
+    for e in doc["traceEvents"]:
+        if e["ph"] not in ("B", "E", "i", "M"):
+            problems.append("%s: unknown phase %r" % (label, e["ph"]))
+        elif e["ph"] != "M" and e["name"] not in KNOWN:
+            problems.append("%s: unknown event %r" % (label, e["name"]))
+    for name in REQUIRED:
+        if name not in names:
+            problems.append("%s: no %s events" % (label, name))
+
+    by_tid = {}
+    for e in events:
+        by_tid.setdefault(e["tid"], []).append(e)
+    for tid, evs in by_tid.items():
+        stack, closed_any = [], False
+        for a, b in zip(evs, evs[1:]):
+            gap = (b["ts"] - a["ts"]) / 1e6
+            if gap < 0 or gap > MAX_GAP_S:
+                problems.append("%s: cpu %d: %.3f s from %s to %s" % (label, tid, gap, a["name"], b["name"]))
+                break
+        for e in evs:
+            if e["ph"] == "B":
+                stack.append(e["name"])
+            elif e["ph"] == "E":
+                if stack:
+                    if stack.pop() != e["name"]:
+                        problems.append("%s: cpu %d: %s ends out of order" % (label, tid, e["name"]))
+                        break
+                    closed_any = True
+                elif closed_any:
+                    problems.append("%s: cpu %d: %s ends without a begin" % (label, tid, e["name"]))
+                    break
+        span = (evs[-1]["ts"] - evs[0]["ts"]) / 1e6
+        print("  %-9s cpu %d  %4d events  %6.2f s  still open: %s" %
+              (label, tid, len(evs), span, ", ".join(stack) or "-"))
+        if max_span_s is not None and span > max_span_s:
+            problems.append("%s: cpu %d: events span %.2f s of a %.0f s run" % (label, tid, span, max_span_s))
+    if events and (events[-1]["name"], events[-1]["ph"]) != ("/trace", "B"):
+        problems.append("%s: last event is %s %s, not /trace's B" %
+                        (label, events[-1]["ph"], events[-1]["name"]))
+    print("  %-9s overwritten %d, cycles/µs %d" %
+          (label, doc["otherData"]["overwritten"], doc["otherData"]["cycles_per_us"]))
+    return problems
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--sim", default="build-host/potato_sim")
+    ap.add_argument("--seconds", type=float, default=12)
+    args = ap.parse_args()
+    if not os.path.exists(args.sim):
+        print("trace_check: no simulator at %s" % args.sim)
+        return 1
+
+    problems = []
+    realtime = fetch_trace(args.sim, ["--speed", "1", "--duration", "%gs" % args.seconds])
+    problems += check("realtime", realtime, args.seconds + 1)
+    fast = fetch_trace(args.sim, ["--fast", "--duration", "1h"])
+    problems += check("fast", fast, None)
+    if fast["otherData"]["overwritten"] == 0:
+        problems.append("fast: the ring never wrapped")
+
+    for p in problems:
+        print("  " + p)
+    if problems:
+        print("trace_check: FAILED")
+        return 1
+    print("trace_check: OK")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
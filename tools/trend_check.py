@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""Check /trend's streaming LTTB against a reference implementation.
+
+    cmake -S host -B build-host && cmake --build build-host
+    python3 tools/trend_check.py [--sim build-host/potato_sim]
+
+Replays ten days of a noisy storage-room trace (a random walk with short
+spikes and dips) through potato_sim, then asks it for /trend over several
+windows and point counts and for /history of every tier. For each /trend
+response the reference below runs textbook LTTB over the /history rows the
+device scanned (same tier, same from/to), once per series, and the picks
+must match exactly: same timestamps, same values, at most `points` of
+them, first and last sample kept.
+
+The reference follows Steinarsson's original loop. Its bucket edges and
+triangle areas are computed exactly (integers and Fractions) instead of in
+floating point, so a tie or an edge that rounds differently can't make an
+otherwise correct run fail. Exits 0 on success, 1 with what differs
+otherwise.
+"""
+import argparse
+import json
+import os
+import random
+import subprocess
+import sys
+import tempfile
+from fractions import Fraction
+
+EPOCH = 1750000000
+DAYS = 10
+CASES = [("1h", 16), ("1h", 100), ("1h", 500), ("90m", 40), ("24h", 16), ("24h", 50),
+         ("24h", 200), ("24h", 500), ("7d", 16), ("7d", 100), ("30d", 16), ("30d", 200)]
+
+
+def trace():
+    """(second, temp_c, humidity) every 30 s."""
+    rng = random.Random(20)
+    c, h, rows = 8.0, 88.0, []
+    for t in range(0, DAYS * 86400, 30):
+        c = min(max(c + rng.gauss(0, 0.05), 3.0), 14.0)
+        h = min(max(h + rng.gauss(0, 0.1), 70.0), 98.0)
+        spike = rng.random() < 0.002
+        rows.append((t, round(c + (rng.choice((-3, 3)) if spike else 0), 1),
+                     round(h + (rng.choice((-8, 8)) if spike else 0), 1)))
+    return rows
+
+
+def lttb(points, threshold):
+    """Reference LTTB over [(x, y)], exact arithmetic."""
+    n = len(points)
+    if threshold >= n or threshold < 3:
+        return list(points)
+    every = Fraction(n - 2, threshold - 2)
+    out, a = [points[0]], 0
+    for i in range(threshold - 2):
+        avg_start = int((i + 1) * every) + 1
+        avg_end = min(int((i + 2) * every) + 1, n)
+        span = points[avg_start:avg_end]
+        avg_x = Fraction(sum(p[0] for p in span), len(span))
+        avg_y = Fraction(sum(p[1] for p in span), len(span))
+        start, end = int(i * every) + 1, int((i + 1) * every) + 1
+        ax, ay = points[a]
+        best, pick = -1, start
+        for j in range(start, end):
+            area = abs((ax - avg_x) * (points[j][1] - ay) - (ax - points[j][0]) * (avg_y - ay))
+            if area > best:
+                best, pick = area, j
+        out.append(points[pick])
+        a = pick
+    out.append(points[-1])
+    return out
+
+
+def responses(raw):
+    """Split the sim's concatenated raw HTTP responses into JSON bodies."""
+    bodies = []
+    while raw:
+        head, _, rest = raw.partition(b"\r\n\r\n")
+        if b"Transfer-Encoding: chunked" in head:
+            body = b""
+            while True:
+                size, _, rest = rest.partition(b"\r\n")
+                size = int(size, 16)
+                body, rest = body + rest[:size], rest[size + 2:]
+                if size == 0:
+                    break
+        else:
+            length = int(head.split(b"Content-Length: ")[1].split(b"\r\n")[0])
+            body, rest = rest[:length], rest[length:]
+        bodies.append(json.loads(body))
+        raw = rest
+    return bodies
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--sim", default="build-host/potato_sim")
+    args = ap.parse_args()
+
+    work = tempfile.mkdtemp(prefix="trend_check.")
+    csv = os.path.join(work, "trace.csv")
+    with open(csv, "w") as f:
+        f.write("seconds,temp_c,humidity\n")
+        for row in trace():
+            f.write("%d,%.1f,%.1f\n" % row)
+
+    targets = ["/trend?window=%s&points=%d" % c for c in CASES]
+    targets += ["/history?res=raw", "/history?res=1m", "/history?res=1h"]
+    with open(os.path.join(work, "sim.log"), "w") as log:
+        run = subprocess.run([args.sim, "--fast", "--port", "0", "--csv", csv, "--epoch", str(EPOCH)]
+                             + [a for t in targets for a in ("--get", t)],
+                             stdout=subprocess.PIPE, stderr=log)
+    if run.returncode != 0:
+        print("trend_check: potato_sim exited with %d (log in %s)" % (run.returncode, work),
+              file=sys.stderr)
+        return 1
+    bodies = responses(run.stdout)
+    history = [h["samples"] for h in bodies[len(CASES):]]
+
+    problems = []
+    for (window, points), trend in zip(CASES, bodies):
+        # The tier scanned: 1m and 1h report their period, raw the mean gap
+        # between its rows in the window
+        tier = {60: 1, 3600: 2}.get(trend["res"], 0)
+        rows = [r for r in history[tier] if trend["from"] <= r[0] <= trend["to"]]
+        name = "window=%s points=%d" % (window, points)
+        gap = int((rows[-1][0] - rows[0][0]) / (len(rows) - 1) + 0.5) if len(rows) > 1 else 2
+        if tier == 0 and trend["res"] != gap:
+            problems.append("%s: res %d, raw rows are %d s apart" % (name, trend["res"], gap))
+        print("  %-22s res %4d s  %5d samples -> %3d / %3d points" %
+              (name, trend["res"], len(rows), len(trend["temperature"]), len(trend["humidity"])))
+        if trend["samples"] != len(rows):
+            problems.append("%s: scanned %d samples, /history has %d" % (name, trend["samples"], len(rows)))
+        for series, col in (("temperature", 1), ("humidity", 2)):
+            ref = lttb([(r[0], round(r[col] * 10)) for r in rows], points)
+            got = [(p[0], round(p[1] * 10)) for p in trend[series]]
+            if got != ref:
+                at = next((i for i, (g, w) in enumerate(zip(got, ref)) if g != w), min(len(got), len(ref)))
+                problems.append("%s %s: %d points, reference %d; first difference at %d: %s vs %s" %
+                                (name, series, len(got), len(ref), at,
+                                 got[at] if at < len(got) else None, ref[at] if at < len(ref) else None))
+            elif len(got) > points:
+                problems.append("%s %s: %d points, asked for %d" % (name, series, len(got), points))
+
+    for p in problems:
+        print("  " + p)
+    if problems:
+        print("trend_check: FAILED (logs in %s)" % work)
+        return 1
+    print("trend_check: OK, %d requests match the reference" % len(CASES))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
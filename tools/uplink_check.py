@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""Kill the collector mid-run and check the uplink loses nothing.
+
+    cmake -S host -B build-host && cmake --build build-host
+    python3 tools/uplink_check.py [--sim build-host/potato_sim]
+
+Runs potato_sim with a flash log and --uplink pointed at tools/collector.py,
+SIGKILLs the collector several times (one outage longer than the RAW
+history tier, so only the flash log can bridge it; others at random moments,
+possibly mid-POST), restarts it each time, and waits until the device
+reports the collector caught up. Then every sample in the device's own
+/export must be in the collector's CSV exactly once, nothing else may be,
+and the collected series may have no holes. The sim reads at a fixed 2 s
+(--max-period 2s), so a gap longer than two periods is a lost sample.
+Exits 0 on success, 1 with a summary of what differs otherwise.
+"""
+import argparse
+import os
+import random
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+import urllib.request
+
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+MAX_GAP_S = 4         # two sample periods
+
+
+def free_port() -> int:
+    with socket.socket() as s:
+        s.bind(("127.0.0.1", 0))
+        return s.getsockname()[1]
+
+
+def fetch(url: str) -> str:
+    with urllib.request.urlopen(url, timeout=10) as r:
+        return r.read().decode()
+
+
+def wait_port(port: int, deadline: float):
+    while time.time() < deadline:
+        try:
+            socket.create_connection(("127.0.0.1", port), timeout=0.2).close()
+            return
+        except OSError:
+            time.sleep(0.05)
+    sys.exit("uplink_check: nothing listening on port %d" % port)
+
+
+def metric(sim_port: int, name: str) -> float:
+    for line in fetch("http://127.0.0.1:%d/metrics" % sim_port).splitlines():
+        if line.startswith(name + " "):
+            return float(line.split()[1])
+    return float("nan")
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--sim", default="build-host/potato_sim")
+    ap.add_argument("--speed", type=float, default=1800,
+                    help="virtual seconds per real second (default 1800)")
+    ap.add_argument("--seed", type=int, default=1)
+    args = ap.parse_args()
+    rng = random.Random(args.seed)
+
+    work = tempfile.mkdtemp(prefix="uplink_check.")
+    sim_port, col_port = free_port(), free_port()
+    collector_cmd = [sys.executable, os.path.join(TOOLS, "collector.py"), "--quiet",
+                     "--port", str(col_port), "--bind", "127.0.0.1",
+                     "--dir", os.path.join(work, "collected")]
+    collector = subprocess.Popen(collector_cmd)
+    wait_port(col_port, time.time() + 10)
+    sim = subprocess.Popen([args.sim, "--speed", str(args.speed), "--port", str(sim_port),
+                            "--flash-dir", os.path.join(work, "flash"),
+                            "--uplink", "http://127.0.0.1:%d/ingest" % col_port,
+                            "--unit", "check", "--max-period", "2s"], stderr=open(os.path.join(work, "sim.log"), "w"))
+    wait_port(sim_port, time.time() + 10)
+
+    # Outages in real seconds: (up for, down for). At the default speed the
+    # 4 s one is two virtual hours, past the RAW tier's one.
+    outages = [(3, 4)] + [(rng.uniform(0.5, 2.5), rng.uniform(0.05, 1.5)) for _ in range(6)]
+    try:
+        for up, down in outages:
+            time.sleep(up)
+            collector.send_signal(signal.SIGKILL)
+            collector.wait()
+            time.sleep(down)
+            collector = subprocess.Popen(collector_cmd)
+            wait_port(col_port, time.time() + 10)
+
+        # Caught up: the collector's newest sample is at most two uplink
+        # periods old (virtual seconds)
+        deadline = time.time() + 60
+        lag = float("nan")
+        while time.time() < deadline:
+            lag = metric(sim_port, "potato_uplink_lag_seconds")
+            if lag <= 120:
+                break
+            time.sleep(0.2)
+        else:
+            print("uplink_check: collector still %s s behind" % lag, file=sys.stderr)
+            return 1
+
+        device = fetch("http://127.0.0.1:%d/export?format=csv" % sim_port).splitlines()[1:]
+    finally:
+        sim.send_signal(signal.SIGTERM)
+        sim.wait()
+        collector.send_signal(signal.SIGTERM)
+        collector.wait()
+
+    with open(os.path.join(work, "collected", "check.csv")) as f:
+        got = f.read().splitlines()[1:]
+    last = max((int(r.split(",")[0]) for r in got), default=0)
+    want = [r for r in device if int(r.split(",")[0]) <= last]
+    missing = sorted(set(want) - set(got))
+    # The sim keeps sampling and sending until SIGTERM, so rows newer than the
+    # export may have reached the collector after it was fetched
+    newest = max((int(r.split(",")[0]) for r in device), default=0)
+    extra = sorted(r for r in set(got) - set(device) if int(r.split(",")[0]) <= newest)
+    dupes = len(got) - len(set(got))
+    stamps = sorted({int(r.split(",")[0]) for r in got})
+    gap = max((b - a for a, b in zip(stamps, stamps[1:])), default=0)
+
+    print("uplink_check: %d samples on the device, %d at the collector (up to %d), "
+          "%d missing, %d unexpected, %d duplicated, longest gap %d s; %d outages"
+          % (len(device), len(got), last, len(missing), len(extra), dupes, gap, len(outages)))
+    for r in missing[:5]:
+        print("  missing    " + r)
+    for r in extra[:5]:
+        print("  unexpected " + r)
+    # The simulated probe never fails, so any hole in the series is a loss
+    ok = not missing and not extra and not dupes and len(want) > 0 and gap <= MAX_GAP_S
+    if ok:
+        print("uplink_check: OK (logs in %s)" % work)
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
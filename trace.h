@@ -0,0 +1,257 @@
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// trace.h — a flight recorder of what each CPU was doing, served at /trace
+//
+// Spans (TRACE_SCOPE, or TRACE_BEGIN/TRACE_END) and instants (TRACE_INSTANT)
+// go into a fixed ring per CPU, the oldest overwritten first. /trace streams
+// the rings as Chrome trace-event JSON for chrome://tracing or
+// ui.perfetto.dev, so when a unit stutters the last few seconds show which
+// step held which core, and for how long.
+//
+// Recording costs a few dozen cycles: the cycle counter, the tick, one
+// atomic add to claim a slot and four word stores. Tasks sharing a core may
+// preempt each other mid-record, so the slot is claimed with fetch_add and
+// published like a seqlock (its sequence written last, with release). A
+// reader skips any slot whose sequence isn't the one it expects: one still
+// being written, or already overwritten. Recording never locks, allocates
+// or formats.
+//
+// The cycle counter is 32 bits (it wraps every 17.9 s at 240 MHz), and the
+// two ESP32 cores' counters don't agree. So each event also carries
+// halTickMs(). The reader uses the tick to count the wraps between events
+// and to place each core's cycles on the common millisecond timeline.
+//
+// Build with POTATO_TRACE=0 to compile every TRACE_* macro, and the rings,
+// out entirely.
+// ──────────────────────────────────────────────────────────────────────────────
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "hal.h"
+
+#ifndef POTATO_TRACE
+#define POTATO_TRACE 1
+#endif
+
+// X(id, name, category, argument label or nullptr). The HTTP_* rows follow
+// AppRoute's order (app.h).
+#define TRACE_EVENTS(X)                                          \
+  X(READ_START,     "read_start",     "sensor",  "probe")        \
+  X(TAKE_READING,   "take_reading",   "sensor",  "probe")        \
+  X(READ_FAILED,    "read_failed",    "sensor",  "probe")        \
+  X(LOG_APPEND,     "log_append",     "sensor",  nullptr)        \
+  X(DISPLAY_STEP,   "display_step",   "display", nullptr)        \
+  X(DRAW_READINGS,  "draw_readings",  "display", "page")         \
+  X(WEB_PUBLISH,    "web_publish",    "web",     nullptr)        \
+  X(HTTP_PASS,      "http_pass",      "http",    nullptr)        \
+  X(HTTP_ROOT,      "/",              "http",    nullptr)        \
+  X(HTTP_SENSOR,    "/sensor-data",   "http",    nullptr)        \
+  X(HTTP_HISTORY,   "/history",       "http",    nullptr)        \
+  X(HTTP_EVENTS,    "/events",        "http",    nullptr)        \
+  X(HTTP_METRICS,   "/metrics",       "http",    nullptr)        \
+  X(HTTP_EXPORT,    "/export",        "http",    nullptr)        \
+  X(HTTP_TREND,     "/trend",         "http",    nullptr)        \
+  X(HTTP_TRACE,     "/trace",         "http",    nullptr)        \
+  X(NET_STEP,       "net_step",       "net",     nullptr)        \
+  X(UPLINK_POST,    "uplink_post",    "uplink",  "bytes")        \
+  X(ALERT_POST,     "alert_post",     "alert",   "bytes")
+
+enum TraceName : uint8_t {
+#define TRACE_ENUM(id, name, cat, arg) TRACE_##id,
+  TRACE_EVENTS(TRACE_ENUM)
+#undef TRACE_ENUM
+  TRACE_NAME_COUNT
+};
+
+struct TraceNameInfo {
+  const char* name;
+  const char* category;
+  const char* arg;              // label of the 16-bit argument; null: none
+};
+
+static const TraceNameInfo TRACE_NAME_INFO[TRACE_NAME_COUNT] = {
+#define TRACE_INFO(id, name, cat, arg) { name, cat, arg },
+  TRACE_EVENTS(TRACE_INFO)
+#undef TRACE_INFO
+};
+
+enum TracePhase : uint8_t {
+  TRACE_PHASE_BEGIN   = 'B',
+  TRACE_PHASE_END     = 'E',
+  TRACE_PHASE_INSTANT = 'i',
+};
+
+#if POTATO_TRACE
+
+static const uint32_t TRACE_RING_EVENTS = 256;   // per CPU
+static_assert((TRACE_RING_EVENTS & (TRACE_RING_EVENTS - 1)) == 0, "ring size must be a power of two");
+
+struct TraceEvent {
+  uint32_t   cycles;            // halCycleCount() on the recording CPU
+  uint32_t   tickMs;            // halTickMs() at the same moment
+  TraceName  name;
+  TracePhase phase;
+  uint16_t   arg;
+};
+
+// One CPU's ring. Any number of writers (the tasks on that CPU), one reader.
+class TraceRing {
+public:
+  void record(const TraceEvent& e) {
+    const uint32_t i = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& s = slots_[i & (TRACE_RING_EVENTS - 1)];
+    s.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.cycles.store(e.cycles, std::memory_order_relaxed);
+    s.tickMs.store(e.tickMs, std::memory_order_relaxed);
+    s.word.store((uint32_t) e.name | (uint32_t) e.phase << 8 | (uint32_t) e.arg << 16,
+                 std::memory_order_relaxed);
+    s.seq.store(i + 1, std::memory_order_release);
+  }
+
+  // Events ever claimed; event i lives in the ring while i ≥ head − size
+  uint32_t head() const { return head_.load(std::memory_order_acquire); }
+
+  // Event i, unless it is still being written or has been overwritten
+  bool read(uint32_t i, TraceEvent* out) const {
+    const Slot& s = slots_[i & (TRACE_RING_EVENTS - 1)];
+    if (s.seq.load(std::memory_order_acquire) != i + 1) return false;
+    out->cycles = s.cycles.load(std::memory_order_relaxed);
+    out->tickMs = s.tickMs.load(std::memory_order_relaxed);
+    const uint32_t w = s.word.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (s.seq.load(std::memory_order_relaxed) != i + 1) return false;
+    out->name  = (TraceName) (w & 0xff);
+    out->phase = (TracePhase) ((w >> 8) & 0xff);
+    out->arg   = (uint16_t) (w >> 16);
+    return out->name < TRACE_NAME_COUNT;
+  }
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> seq{0};         // index + 1 once complete; 0 while written
+    std::atomic<uint32_t> cycles{0}, tickMs{0}, word{0};
+  };
+
+  std::atomic<uint32_t> head_{0};
+  Slot slots_[TRACE_RING_EVENTS];
+};
+
+class TraceRecorder {
+public:
+  void record(TraceName name, TracePhase phase, uint16_t arg) {
+    const TraceEvent e = { halCycleCount(), halTickMs(), name, phase, arg };
+    rings_[halCpuId() % HAL_MAX_CPUS].record(e);
+  }
+
+  const TraceRing& ring(int cpu) const { return rings_[cpu]; }
+
+private:
+  TraceRing rings_[HAL_MAX_CPUS];
+};
+
+extern TraceRecorder tracer;    // defined in app.cpp
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Reading one CPU's ring oldest-first, each event placed in ns on the
+// halTickMs() timeline.
+//
+// begin() takes the ring's head as the end and makes one pass over what is
+// there. The newest event is the anchor. Every other event's cycle distance
+// from it is its 32-bit difference, plus as many wraps as the tick
+// difference says. The anchor's own time is the latest that no event's
+// tick contradicts: a tick is the floor of the true time, so each event
+// says the anchor is at least tick − distance. next() then walks from the
+// oldest event to that end. Events overwritten meanwhile are skipped and
+// counted, and events recorded after begin() wait for the next reader.
+// ──────────────────────────────────────────────────────────────────────────────
+class TraceCursor {
+public:
+  void begin(const TraceRing& ring, uint32_t cyclesPerUs) {
+    ring_        = &ring;
+    cyclesPerUs_ = cyclesPerUs ? cyclesPerUs : 1;
+    end_         = ring.head();
+    next_        = end_ > TRACE_RING_EVENTS ? end_ - TRACE_RING_EVENTS : 0;
+    lost_        = next_;
+    haveAnchor_  = false;
+    anchorNs_    = 0;
+    TraceEvent e;
+    for (uint32_t i = end_; i-- > next_;) {
+      if (!ring.read(i, &e)) continue;
+      if (!haveAnchor_) {
+        haveAnchor_ = true;
+        anchor_     = e;
+        anchorNs_   = (int64_t) e.tickMs * 1000000;
+        continue;
+      }
+      const int64_t bound = (int64_t) anchor_.tickMs * 1000000 +
+                            (int64_t)(int32_t)(e.tickMs - anchor_.tickMs) * 1000000 - offsetNs(e);
+      if (bound > anchorNs_) anchorNs_ = bound;
+    }
+  }
+
+  // Next event and its time, oldest first; false at the end
+  bool next(TraceEvent* e, uint64_t* ns) {
+    while (next_ < end_) {
+      if (!ring_->read(next_++, e)) {
+        lost_++;
+        continue;
+      }
+      const int64_t t = anchorNs_ + offsetNs(*e);
+      *ns = t > 0 ? (uint64_t) t : 0;
+      return true;
+    }
+    return false;
+  }
+
+  bool     empty() const { return !haveAnchor_; }
+  uint32_t lost()  const { return lost_; }   // overwritten before they could be read
+
+private:
+  // ns from the anchor to `e` (negative: before it)
+  int64_t offsetNs(const TraceEvent& e) const {
+    const int64_t perMs    = (int64_t) cyclesPerUs_ * 1000;
+    const int64_t expected = (int64_t)(int32_t)(e.tickMs - anchor_.tickMs) * perMs;
+    int64_t cycles = (int64_t)(uint32_t)(e.cycles - anchor_.cycles);
+    const int64_t wraps = (expected - cycles + (INT64_C(1) << 31)) >> 32;
+    cycles += wraps * (INT64_C(1) << 32);
+    return cycles * 1000 / cyclesPerUs_;
+  }
+
+  const TraceRing* ring_ = nullptr;
+  uint32_t   cyclesPerUs_ = 1;
+  uint32_t   end_ = 0, next_ = 0, lost_ = 0;
+  bool       haveAnchor_ = false;
+  TraceEvent anchor_ = {};
+  int64_t    anchorNs_ = 0;
+};
+
+// Closes its span when the scope ends
+class TraceScope {
+public:
+  TraceScope(TraceName name, uint16_t arg) : name_(name) { tracer.record(name, TRACE_PHASE_BEGIN, arg); }
+  ~TraceScope() { tracer.record(name_, TRACE_PHASE_END, 0); }
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+  TraceName name_;
+};
+
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b)  TRACE_CONCAT2(a, b)
+#define TRACE_SCOPE(name)             TraceScope TRACE_CONCAT(traceScope_, __LINE__)((name), 0)
+#define TRACE_SCOPE_ARG(name, arg)    TraceScope TRACE_CONCAT(traceScope_, __LINE__)((name), (uint16_t)(arg))
+#define TRACE_BEGIN(name, arg)        tracer.record((name), TRACE_PHASE_BEGIN, (uint16_t)(arg))
+#define TRACE_END(name)               tracer.record((name), TRACE_PHASE_END, 0)
+#define TRACE_INSTANT(name, arg)      tracer.record((name), TRACE_PHASE_INSTANT, (uint16_t)(arg))
+
+#else
+
+#define TRACE_SCOPE(name)             do {} while (0)
+#define TRACE_SCOPE_ARG(name, arg)    do {} while (0)
+#define TRACE_BEGIN(name, arg)        do {} while (0)
+#define TRACE_END(name)               do {} while (0)
+#define TRACE_INSTANT(name, arg)      do {} while (0)
+
+#endif